@@ -31,6 +31,8 @@
 #include <iomanip>
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
+#include <boost/range/iterator_range.hpp>
+#include "../test/verify.hpp"
 
 template <typename Tgpu, typename Tref>
 int miopenBNSpatialFwdInferHost(miopenTensorDescriptor_t& inputTensor,
@@ -209,22 +211,19 @@ template <typename Tgpu /* the data type used in GPU computations (usually half)
           typename Tref /* the data type used in CPU checkings (usually double) */>
 int miopenInferVerify(size_t size, const Tref* c_res, const Tgpu* top_ptr, Tref allowedEps)
 {
-    int match = 1;
-    for(size_t i = 0; i < size && match; i++)
+    int match    = 1;
+    const auto i = miopen::mismatch_tolerance(boost::make_iterator_range(c_res, c_res + size),
+                                              boost::make_iterator_range(top_ptr, top_ptr + size),
+                                              allowedEps);
+    if(i < size)
     {
-        Tref c_val     = c_res[i];
-        Tref g_val     = static_cast<Tref>(top_ptr[i]);
-        double err     = std::abs(c_val - g_val);
-        double err_rel = calculate_relative_error(c_val, g_val);
-        // if(err > 1e-6) printf("i: %d, cval: %f, gval: %f\n", i, c_val, g_val );
-        if((err > allowedEps && err_rel > allowedEps) || std::isnan(c_val) || std::isnan(g_val) ||
-           !std::isfinite(c_val) || !std::isfinite(g_val))
-        {
-            std::cout << "Difference in neuron layer: " << err << " too large at " << i
-                      << " c_v = " << c_val << " vs g_val = " << g_val
-                      << " tolerance = " << allowedEps << std::endl;
-            match = 0;
-        }
+        Tref c_val = c_res[i];
+        Tref g_val = static_cast<Tref>(top_ptr[i]);
+        double err = std::abs(c_val - g_val);
+        std::cout << "Difference in neuron layer: " << err << " too large at " << i
+                  << " c_v = " << c_val << " vs g_val = " << g_val << " tolerance = " << allowedEps
+                  << std::endl;
+        match = 0;
     }
 
     return (match);
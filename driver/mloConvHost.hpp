@@ -32,8 +32,11 @@
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 
 #include "calcerr.hpp"
+#include <../test/cpu_gemm.hpp>
+#include <../test/verify.hpp>
 
 //#if 0 // disable functions
 #if 1
@@ -60,13 +63,6 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
                  double d_alpha,
                  double d_beta)
 {
-    // mA
-
-    // mB
-
-    // mC
-    Dtype alpha = Dtype(d_alpha);
-    Dtype beta  = Dtype(d_beta);
     if((!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE) &&
         ((a_cols != b_rows) || (a_rows != c_rows) || (b_cols != c_cols))) ||
        ((a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE) &&
@@ -86,92 +82,21 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
         return;
     }
 
+    // Accumulates in Dtype, as it used to.
     size_t inner_loop = (!(a_flags & ADNN_MM_TRANSPOSE)) ? a_cols : a_rows;
-
-    if(!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[m * b_stride + k];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if((a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[m * a_stride + n] * b_ptr[m * b_stride + k];
-#if 0
-                    if (
-                        (n == 0 && k == 33
-                        || n == 1 && k == 32
-                        || n == 3 && k == 1
-                        || n == 4 && k == 0
-
-                        )
-                        && a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-                        )
-                    {
-                        printf("C:mm:%d %d %d   %11.9f %11.9f %11.9f %11.9f\n",
-                            n, k, m,
-                            mm_e, a_ptr[m*a_stride + n], b_ptr[m*b_stride + k], a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if(!(a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[k * b_stride + m];
-#if 0
-                    if (n == 0 && k == 6 && a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-                    {
-                        printf("%4d  %11.9f %11.9f %11.9f\n", m, mm_e, a_ptr[n*a_stride + m], b_ptr[k*b_stride + m]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] += a_ptr[m * a_stride + n] * b_ptr[k * b_stride + m];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
+    cpu_gemm<Dtype>((a_flags & ADNN_MM_TRANSPOSE) != 0,
+                    (b_flags & ADNN_MM_TRANSPOSE) != 0,
+                    c_rows,
+                    c_cols,
+                    inner_loop,
+                    d_alpha,
+                    a_ptr,
+                    a_stride,
+                    b_ptr,
+                    b_stride,
+                    d_beta,
+                    c_ptr,
+                    c_stride);
 }
 
 template <typename Dtype>
@@ -1053,12 +978,12 @@ bool mloVerify(const miopenTensorDescriptor_t& cpu_,
     std::tie(g_batch_stride, g_channel_stride, g_depth_stride, g_height_stride, g_width_stride) =
         miopen::GetNCDHW(spatial_dim, gpu.GetStrides());
 
-    Tcheck_ sqr_accum = static_cast<Tcheck_>(0);
-    Tcheck_ c_val_err = static_cast<Tcheck_>(0);
-    Tcheck_ g_val_err = static_cast<Tcheck_>(0);
-    Tcheck_ max_err   = max_abs_diff;
-    int max_b = 0, max_c = 0, max_i = 0, max_j = 0, max_k = 0;
-
+    // The elements in the NCDHW order, so that the errors are reduced over contiguous ranges.
+    const auto size = static_cast<std::size_t>(n_batchs) * n_channels * depth * height * width;
+    std::vector<Tcheck_> c_vals;
+    std::vector<Tcheck_> g_vals;
+    c_vals.reserve(size);
+    g_vals.reserve(size);
     for(int b = 0; b < n_batchs; ++b)
     {
         for(int c = 0; c < n_channels; ++c)
@@ -1069,39 +994,47 @@ bool mloVerify(const miopenTensorDescriptor_t& cpu_,
                 {
                     for(int i = 0; i < width; ++i)
                     {
-                        Tcheck_ c_val =
-                            c_ptr[b * c_batch_stride + c * c_channel_stride + k * c_depth_stride +
-                                  j * c_height_stride + i * c_width_stride];
-                        Tcheck_ g_val = static_cast<Tcheck_>(
+                        c_vals.push_back(c_ptr[b * c_batch_stride + c * c_channel_stride +
+                                               k * c_depth_stride + j * c_height_stride +
+                                               i * c_width_stride]);
+                        g_vals.push_back(static_cast<Tcheck_>(
                             g_ptr[b * g_batch_stride + c * g_channel_stride + k * g_depth_stride +
-                                  j * g_height_stride + i * g_width_stride]);
-
-                        sqr_accum += (c_val - g_val) * (c_val - g_val);
-                        Tcheck_ err = std::abs(c_val - static_cast<Tcheck_>(g_val));
-                        if(err > max_err)
-                        {
-                            max_err   = err;
-                            c_val_err = c_val;
-                            g_val_err = g_val;
-                            max_b     = b;
-                            max_c     = c;
-                            max_i     = i;
-                            max_j     = j;
-                            max_k     = k;
-                        }
+                                  j * g_height_stride + i * g_width_stride]));
                     }
                 }
             }
         }
     }
 
-    sqr_accum = std::sqrt(sqr_accum /
-                          (static_cast<Tcheck_>(n_batchs * n_channels * depth * height * width)));
+    const auto errors = miopen::range_errors(c_vals, g_vals);
+    Tcheck_ sqr_accum = std::sqrt(static_cast<Tcheck_>(errors.square_diff) /
+                                  static_cast<Tcheck_>(size));
 
     bool match = true;
 
     if(sqr_accum > max_sqr || std::isnan(sqr_accum) || !std::isfinite(sqr_accum))
     {
+        // The first of the largest errors, if it is above max_abs_diff.
+        Tcheck_ max_err   = max_abs_diff;
+        Tcheck_ c_val_err = static_cast<Tcheck_>(0);
+        Tcheck_ g_val_err = static_cast<Tcheck_>(0);
+        int max_b = 0, max_c = 0, max_i = 0, max_j = 0, max_k = 0;
+        for(std::size_t idx = 0; errors.max_abs_diff > max_abs_diff && idx < size; ++idx)
+        {
+            const auto err = std::abs(static_cast<double>(c_vals[idx]) - g_vals[idx]);
+            if(err != errors.max_abs_diff)
+                continue;
+            max_err   = static_cast<Tcheck_>(err);
+            c_val_err = c_vals[idx];
+            g_val_err = g_vals[idx];
+            max_i     = static_cast<int>(idx % width);
+            max_j     = static_cast<int>(idx / width % height);
+            max_k     = static_cast<int>(idx / width / height % depth);
+            max_c     = static_cast<int>(idx / width / height / depth % n_channels);
+            max_b     = static_cast<int>(idx / width / height / depth / n_channels);
+            break;
+        }
+
         std::cout << "Sqr error : " << std::fixed << std::setw(15) << std::setprecision(13)
                   << sqr_accum << " Max err: " << std::fixed << std::setw(15)
                   << std::setprecision(13) << max_err << " at " << max_b << ", " << max_c << ", ";
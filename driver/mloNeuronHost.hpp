@@ -37,6 +37,9 @@
 #include <iomanip>
 
 #include "miopen/float_equal.hpp"
+#include "../test/verify.hpp"
+
+#include <boost/range/iterator_range.hpp>
 
 ////////////////////////////////////////////////////////////
 //
@@ -58,12 +61,6 @@
 
 const float kBNLL_THRESHOLD = 50.;
 
-template <typename T>
-T calculate_relative_error(T uref, T u)
-{
-    return std::abs(u - uref) / std::max(std::numeric_limits<T>::epsilon(), std::abs(uref));
-}
-
 template <typename Tgpu_ /* the data type used in GPU computations (usually half) */,
           typename Tcheck_ /* the data type used in CPU checkings (usually double) */>
 int mloNeuronForwardRunHostAndVerify(int neuron_type,
@@ -127,22 +124,19 @@ int mloNeuronForwardRunHostAndVerify(int neuron_type,
     for(size_t i = 0; i < size; i++)
         c_res[i] = f(data[i]);
 
-    for(size_t i = 0; i < size && match; i++)
+    const auto i = miopen::mismatch_tolerance(boost::make_iterator_range(c_res, c_res + size),
+                                              boost::make_iterator_range(top_ptr, top_ptr + size),
+                                              allowedEps);
+    if(i < size)
     {
-        Tcheck_ c_val  = c_res[i];
-        Tcheck_ g_val  = static_cast<Tcheck_>(top_ptr[i]);
-        double err     = std::abs(c_val - g_val);
-        double err_rel = calculate_relative_error(c_val, g_val);
-
-        if((err > allowedEps && err_rel > allowedEps) || std::isnan(c_val) || std::isnan(g_val) ||
-           !std::isfinite(c_val) || !std::isfinite(g_val))
-        {
-            std::cout << "Difference in neuron layer: " << err << " too large at " << i
-                      << " x = " << data[i] << " "
-                      << " c_v = " << c_val << " vs g_val = " << g_val
-                      << " tolerance = " << allowedEps << std::endl;
-            match = 0;
-        }
+        Tcheck_ c_val = c_res[i];
+        Tcheck_ g_val = static_cast<Tcheck_>(top_ptr[i]);
+        double err    = std::abs(c_val - g_val);
+        std::cout << "Difference in neuron layer: " << err << " too large at " << i
+                  << " x = " << data[i] << " "
+                  << " c_v = " << c_val << " vs g_val = " << g_val
+                  << " tolerance = " << allowedEps << std::endl;
+        match = 0;
     }
 
     if(c_res)
@@ -231,23 +225,21 @@ int mloNeuronBackwardRunHostAndVerify(int neuron_type,
     for(size_t i = 0; i < size; i++)
         bot_df_cpu[i] = f(top_df_cpu[i], bot_cpu[i], top_cpu[i]);
 
-    for(size_t i = 0; i < size && match; ++i)
+    const auto i =
+        miopen::mismatch_tolerance(boost::make_iterator_range(bot_df_cpu, bot_df_cpu + size),
+                                   boost::make_iterator_range(bot_df_ptr, bot_df_ptr + size),
+                                   allowedEps);
+    if(i < size)
     {
-        Tcheck_ c_val  = bot_df_cpu[i];
-        Tcheck_ g_val  = static_cast<Tcheck_>(bot_df_ptr[i]);
-        double err     = std::abs(c_val - g_val);
-        double err_rel = calculate_relative_error(c_val, g_val);
-
-        if((err > allowedEps && err_rel > allowedEps) || std::isnan(c_val) || std::isnan(g_val) ||
-           !std::isfinite(c_val) || !std::isfinite(g_val))
-        {
-            std::cout << "Difference in neuron back-propagation: " << err << " too large at " << i
-                      << " dy = " << top_df_cpu[i] << " x = " << bot_cpu[i] << " y = " << top_cpu[i]
-                      << " "
-                      << " c_v = " << c_val << " vs g_val = " << g_val
-                      << " tolerance = " << allowedEps << std::endl;
-            match = 0;
-        }
+        Tcheck_ c_val = bot_df_cpu[i];
+        Tcheck_ g_val = static_cast<Tcheck_>(bot_df_ptr[i]);
+        double err    = std::abs(c_val - g_val);
+        std::cout << "Difference in neuron back-propagation: " << err << " too large at " << i
+                  << " dy = " << top_df_cpu[i] << " x = " << bot_cpu[i] << " y = " << top_cpu[i]
+                  << " "
+                  << " c_v = " << c_val << " vs g_val = " << g_val << " tolerance = " << allowedEps
+                  << std::endl;
+        match = 0;
     }
 
     if(bot_df_cpu)
@@ -33,6 +33,7 @@
 #include "miopen/tensor.hpp"
 #include "random.hpp"
 #include "timer.hpp"
+#include "../test/verify.hpp"
 
 #ifdef MIOPEN_BACKEND_HIP
 #ifndef CL_SUCCESS
@@ -393,23 +394,17 @@ int TensorOpDriver<Tgpu, Tref>::CheckTensor(std::vector<Tgpu>& cpu_res,
                                             std::vector<Tgpu>& gpu_res,
                                             double allowedEps)
 {
-    int match = 1;
-
-    for(auto idx = 0; idx < cpu_res.size() && match; ++idx)
+    int match      = 1;
+    const auto idx = miopen::mismatch_tolerance(cpu_res, gpu_res, allowedEps);
+    if(idx < cpu_res.size())
     {
-        Tref cpu_val   = cpu_res[idx];
-        Tref gpu_val   = static_cast<Tref>(gpu_res[idx]);
-        double err     = std::abs(cpu_val - gpu_val);
-        double err_rel = calculate_relative_error(cpu_val, gpu_val);
-
-        if((err > allowedEps && err_rel > allowedEps) || std::isnan(cpu_val) ||
-           std::isnan(gpu_val) || !std::isfinite(cpu_val) || !std::isfinite(gpu_val))
-        {
-            std::cout << "Difference in Tensor Op result: " << err << " too large at " << idx
-                      << " cpu value = " << cpu_val << " , gpu_val = " << gpu_val
-                      << " tolreance = " << allowedEps << std::endl;
-            match = 0;
-        }
+        Tref cpu_val = cpu_res[idx];
+        Tref gpu_val = static_cast<Tref>(gpu_res[idx]);
+        double err   = std::abs(cpu_val - gpu_val);
+        std::cout << "Difference in Tensor Op result: " << err << " too large at " << idx
+                  << " cpu value = " << cpu_val << " , gpu_val = " << gpu_val
+                  << " tolreance = " << allowedEps << std::endl;
+        match = 0;
     }
     return match;
 }
@@ -4749,6 +4749,20 @@ typedef enum
     miopenFindResultsOrderByWorkspaceSize = 1,
 } miopenFindResultsOrder_t;
 
+/*! @enum miopenFindSelectionPolicy_t
+ * Different ways to select the results of the find call, see
+ * miopenSetFindOptionSelectionPolicy.
+ */
+typedef enum
+{
+    miopenFindSelectionAll = 0, /*!< All the solutions within the workspace limit */
+    miopenFindSelectionParetoFront =
+        1, /*!< The solutions no other solution beats in both the time and the workspace size */
+    miopenFindSelectionMinWorkspaceWithinTimeTolerance =
+        2, /*!< The solutions within the time tolerance of the fastest one, the least workspace
+              first */
+} miopenFindSelectionPolicy_t;
+
 /*! @brief Initializes a problem object describing a convolution operation.
  *
  * @param problem      Pointer to the problem to initialize
@@ -4822,6 +4836,70 @@ miopenStatus_t miopenSetFindOptionResultsOrder(miopenFindOptions_t options,
  */
 miopenStatus_t miopenSetFindOptionWorkspaceLimit(miopenFindOptions_t options, size_t value);
 
+/*! @brief Sets the time limit of the tuning of a single solver, in seconds. Default value is the
+ * value of MIOPEN_TUNING_BUDGET_SECONDS, or zero, which means no limit.
+ *
+ * When the limit is reached the best solution found so far is used, and the progress of the
+ * tuning is saved to the user performance database to be resumed by the next tuning call.
+ *
+ * @param options    Options object to update
+ * @param value      Time limit in seconds
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenSetFindOptionTuningTimeLimit(miopenFindOptions_t options, float value);
+
+/*! @brief Sets the limit of the number of configurations evaluated by the tuning of a single
+ * solver. Default value is the value of MIOPEN_TUNING_BUDGET_EVALUATIONS, or zero, which means no
+ * limit.
+ *
+ * When the limit is reached the best solution found so far is used, and the progress of the
+ * tuning is saved to the user performance database to be resumed by the next tuning call.
+ *
+ * @param options    Options object to update
+ * @param value      Maximum number of evaluated configurations
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenSetFindOptionTuningEvaluationLimit(miopenFindOptions_t options, size_t value);
+
+/*! @brief Sets the selection policy find option. Default value is miopenFindSelectionAll.
+ *
+ * The policy is applied to the solutions within the workspace limit, using their time and
+ * workspace size. The solutions selected by miopenFindSelectionParetoFront are ordered as the
+ * results order find option says. The ones selected by
+ * miopenFindSelectionMinWorkspaceWithinTimeTolerance are ordered by the workspace size, then by
+ * the time.
+ *
+ * @param options    Options object to update
+ * @param value      Specifies which of the solutions found should be returned
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenSetFindOptionSelectionPolicy(miopenFindOptions_t options,
+                                                  miopenFindSelectionPolicy_t value);
+
+/*! @brief Sets the time tolerance find option used by
+ * miopenFindSelectionMinWorkspaceWithinTimeTolerance. Default value is 0.05.
+ *
+ * @param options    Options object to update
+ * @param value      Slowdown relative to the fastest solution, e.g. 0.05 selects the solutions at
+ * most 5% slower than the fastest one
+ * @return           miopenStatus_t
+ */
+miopenStatus_t miopenSetFindOptionTimeTolerance(miopenFindOptions_t options, float value);
+
+/*! @brief Applies the workspace limit, the selection policy and the results order find options to
+ * the solutions returned by the immediate mode, e.g. by miopenConvolutionForwardGetSolution.
+ *
+ * @param options       Find options. When null default values would be used
+ * @param solutions     Solutions to select from. The selected ones are moved to the front of the
+ * array
+ * @param solutionCount Pointer to the amount of solutions. Updated to the amount of the selected
+ * ones. Must not be null
+ * @return              miopenStatus_t
+ */
+miopenStatus_t miopenSelectConvSolutions(miopenFindOptions_t options,
+                                         miopenConvSolution_t* solutions,
+                                         size_t* solutionCount);
+
 /*! @brief The miopenSolution object describes a prepared solution.
  */
 MIOPEN_DECLARE_OBJECT(miopenSolution);
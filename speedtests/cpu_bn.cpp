@@ -0,0 +1,108 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+
+#include <driver.hpp>
+#include <cpu_bn.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace cpu_bn_speedtest {
+
+// Throughput of the host spatial batch norm, by default on a ResNet-50 layer with a large batch.
+// Usage: speedtest_cpu_bn [--batch N] [--channels N] [--size N] [--layout NCHW|NHWC]
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch, "batch");
+        add(channels, "channels");
+        add(size, "size");
+        add(layout, "layout");
+    }
+
+    void run()
+    {
+        if(layout != "NCHW" && layout != "NHWC")
+            MIOPEN_THROW("Unknown layout: " + layout);
+
+        auto l = cpu_bn_packed_layout(batch, channels, size * size);
+        if(layout == "NHWC")
+        {
+            l.c_stride = 1;
+            l.s_stride = channels;
+        }
+
+        const auto elements = static_cast<std::size_t>(batch) * channels * size * size;
+        auto x              = std::vector<float>(elements);
+        auto dy             = std::vector<float>(elements);
+        auto y              = std::vector<float>(elements);
+        for(std::size_t i = 0; i < elements; ++i)
+        {
+            x[i]  = static_cast<float>(std::rand() % 17) / 8.f - 1.f;
+            dy[i] = static_cast<float>(std::rand() % 17) / 8.f - 1.f;
+        }
+        auto scale = std::vector<float>(channels, 1.f);
+        auto bias  = std::vector<float>(channels, 0.f);
+        auto stats = std::vector<float>(4 * channels, 0.f);
+        auto grads = std::vector<float>(2 * channels, 0.f);
+
+        const auto fwd = Ms([&] {
+            cpu_bn_forward_train(l,
+                                 x.data(),
+                                 y.data(),
+                                 scale.data(),
+                                 bias.data(),
+                                 1e-5,
+                                 0.1,
+                                 stats.data(),
+                                 stats.data() + channels,
+                                 stats.data() + 2 * channels,
+                                 stats.data() + 3 * channels);
+        });
+        const auto bwd = Ms([&] {
+            cpu_bn_backward(l,
+                            x.data(),
+                            dy.data(),
+                            y.data(),
+                            scale.data(),
+                            grads.data(),
+                            grads.data() + channels,
+                            1e-5);
+        });
+
+        // Bytes moved: x twice and y once forward, x and dy twice and dx once backward.
+        const auto bytes = elements * sizeof(float);
+        std::cout << layout << " " << batch << "x" << channels << "x" << size << "x" << size
+                  << ": forward training " << fwd << " ms, " << 3. * bytes / fwd * 1e-6
+                  << " GB/s, backward " << bwd << " ms, " << 5. * bytes / bwd * 1e-6 << " GB/s"
+                  << std::endl;
+    }
+
+private:
+    std::string layout = "NCHW";
+    int batch          = 256;
+    int channels       = 256;
+    int size           = 56;
+
+    template <class F>
+    static double Ms(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}
+            .count();
+    }
+};
+
+} // namespace cpu_bn_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::cpu_bn_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
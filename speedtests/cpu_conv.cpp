@@ -0,0 +1,126 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+
+#include <driver.hpp>
+#include <tensor_holder.hpp>
+#include <cpu_conv.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace cpu_conv_speedtest {
+
+// Throughput of the im2col host convolutions vs the direct ones, by default on a ResNet-50 3x3
+// layer. The direct ones are slow, --naive 0 skips them for the large problems.
+// Usage: speedtest_cpu_conv [--batch N] [--channels N] [--filters N] [--size N] [--kernel N]
+//        [--stride N] [--groups N] [--direction fwd|bwd|wrw] [--naive 0|1]
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch, "batch");
+        add(channels, "channels");
+        add(filters, "filters");
+        add(size, "size");
+        add(kernel, "kernel");
+        add(stride, "stride");
+        add(groups, "groups");
+        add(direction, "direction");
+        add(naive, "naive");
+    }
+
+    void run()
+    {
+        if(direction != "fwd" && direction != "bwd" && direction != "wrw")
+            MIOPEN_THROW("Unknown direction: " + direction);
+
+        const auto pad      = kernel / 2;
+        const auto out_size = (size + 2 * pad - kernel) / stride + 1;
+        const auto pads      = std::vector<int>{pad, pad};
+        const auto strides   = std::vector<int>{stride, stride};
+        const auto dilations = std::vector<int>{1, 1};
+
+        auto in  = tensor<float>{std::vector<int>{batch, channels, size, size}};
+        auto wei = tensor<float>{std::vector<int>{filters, channels / groups, kernel, kernel}};
+        auto out = tensor<float>{std::vector<int>{batch, filters, out_size, out_size}};
+        for(auto* t : {&in, &wei, &out})
+            for(auto& x : t->data)
+                x = static_cast<float>(std::rand() % 17) / 8.f - 1.f;
+
+        const auto run_conv = [&](bool direct) {
+            if(direction == "fwd")
+            {
+                if(direct)
+                    cpu_convolution_forward_naive(
+                        2, in, wei, out, pads, strides, dilations, groups);
+                else
+                    cpu_convolution_forward(2, in, wei, out, pads, strides, dilations, groups);
+            }
+            else if(direction == "bwd")
+            {
+                if(direct)
+                    cpu_convolution_backward_data_naive(
+                        2, in, wei, out, pads, strides, dilations, groups);
+                else
+                    cpu_convolution_backward_data(
+                        2, in, wei, out, pads, strides, dilations, groups);
+            }
+            else
+            {
+                if(direct)
+                    cpu_convolution_backward_weight_naive(
+                        2, in, wei, out, pads, strides, dilations, groups);
+                else
+                    cpu_convolution_backward_weight(
+                        2, in, wei, out, pads, strides, dilations, groups);
+            }
+        };
+
+        const auto flops = 2. * batch * filters * out_size * out_size * (channels / groups) *
+                           kernel * kernel;
+        const auto im2col = Ms([&] { run_conv(false); });
+        std::cout << direction << " " << batch << "x" << channels << "x" << size << "x" << size
+                  << " * " << filters << "x" << channels / groups << "x" << kernel << "x"
+                  << kernel << ": im2col " << im2col << " ms, " << flops / im2col * 1e-6
+                  << " GFLOP/s";
+        if(naive != 0)
+        {
+            const auto direct = Ms([&] { run_conv(true); });
+            std::cout << ", direct " << direct << " ms, " << flops / direct * 1e-6
+                      << " GFLOP/s, speedup " << direct / im2col;
+        }
+        std::cout << std::endl;
+    }
+
+private:
+    std::string direction = "fwd";
+    int batch             = 8;
+    int channels          = 64;
+    int filters           = 64;
+    int size              = 56;
+    int kernel            = 3;
+    int stride            = 1;
+    int groups            = 1;
+    int naive             = 1;
+
+    template <class F>
+    static double Ms(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}
+            .count();
+    }
+};
+
+} // namespace cpu_conv_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::cpu_conv_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
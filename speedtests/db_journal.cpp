@@ -0,0 +1,87 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/db_journal.hpp>
+#include <miopen/ramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace miopen {
+namespace journal {
+
+struct TestKey
+{
+    int n;
+    void Serialize(std::ostream& s) const { s << (64 + n % 1024) << "-28-28-3x3-" << n; }
+};
+
+struct TestValues
+{
+    int n;
+    void Serialize(std::ostream& s) const
+    {
+        s << "ConvAsm1x1U," << (n % 97) * 0.1 << ",0,miopenConvolutionFwdAlgoDirect,<unused>";
+    }
+};
+
+// Measures sequential stores of distinct records into a user RamDb, as done by Find.
+// Usage: speedtest_db_journal [--records N] [--mode sync|journal]
+// The mode is process-wide, so run the test once per mode to compare.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(records, "records");
+        add(mode, "mode");
+    }
+
+    void run()
+    {
+        if(mode == "journal")
+            setenv("MIOPEN_DEBUG_DB_JOURNAL", "1", 1); // NOLINT (concurrency-mt-unsafe)
+        else if(mode != "sync")
+            MIOPEN_THROW("Unknown mode: " + mode);
+
+        TempFile dir{"miopen.speedtests.db_journal"};
+        const std::string path = dir.Path() + ".ufdb.txt";
+        auto& db               = RamDb::GetCached(path, false);
+
+        auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < records; ++i)
+            db.Update(TestKey{i}, "miopenConvolutionFwdAlgoDirect", TestValues{i});
+        const auto store_time = Ms(start);
+
+        start = std::chrono::steady_clock::now();
+        DbJournal::FlushAll();
+        const auto flush_time = Ms(start);
+
+        std::cout << mode << ": " << records << " stores: " << store_time << " ms ("
+                  << records / store_time * 1000 << " records/s), flush: " << flush_time
+                  << " ms, db size: " << boost::filesystem::file_size(path) << std::endl;
+    }
+
+private:
+    std::string mode = "sync";
+    int records      = 10000;
+
+    static double Ms(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}
+            .count();
+    }
+};
+
+} // namespace journal
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::journal::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/invoker_cache.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace invoker_cache {
+
+struct Layer
+{
+    std::size_t in_c, hw, out_c, k, stride, pad;
+};
+
+// Every convolution of a ResNet-50 forward pass, in execution order.
+static std::vector<Layer> ResNet50()
+{
+    auto layers = std::vector<Layer>{{3, 224, 64, 7, 2, 3}};
+    auto in_c   = std::size_t{64};
+    auto hw     = std::size_t{56};
+
+    const std::size_t blocks[] = {3, 4, 6, 3};
+    for(auto stage = 0; stage < 4; ++stage)
+    {
+        const auto width  = std::size_t{64} << stage;
+        const auto stride = stage == 0 ? 1 : 2;
+        for(auto block = std::size_t{0}; block < blocks[stage]; ++block)
+        {
+            const auto s = block == 0 ? stride : 1;
+            layers.push_back({in_c, hw, width, 1, 1, 0});
+            layers.push_back({width, hw, width, 3, s, 1});
+            if(block == 0)
+                layers.push_back({in_c, hw, width * 4, 1, s, 0});
+            hw /= s;
+            layers.push_back({width, hw, width * 4, 1, 1, 0});
+            in_c = width * 4;
+        }
+    }
+    return layers;
+}
+
+static conv::ProblemDescription MakeProblem(const Layer& layer, std::size_t batch)
+{
+    const auto out_hw = (layer.hw + 2 * layer.pad - layer.k) / layer.stride + 1;
+    const auto in     = TensorDescriptor{miopenFloat, {batch, layer.in_c, layer.hw, layer.hw}};
+    const auto wei    = TensorDescriptor{miopenFloat, {layer.out_c, layer.in_c, layer.k, layer.k}};
+    const auto out    = TensorDescriptor{miopenFloat, {batch, layer.out_c, out_hw, out_hw}};
+    const auto pad    = static_cast<int>(layer.pad);
+    const auto stride = static_cast<int>(layer.stride);
+    const auto conv   = ConvolutionDescriptor{{pad, pad}, {stride, stride}, {1, 1}};
+    return {in, wei, out, conv, conv::Direction::Forward};
+}
+
+// Measures the per call cost of finding an invoker for an immediate mode convolution, i.e.
+// building the network config and the cache lookup, over repeated ResNet-50 forward passes.
+// Usage: speedtest_invoker_cache [--passes N] [--mode flat|map]
+// "map" is the previous cache layout: nested std::map keyed by config and solver strings.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(passes, "passes");
+        add(mode, "mode");
+    }
+
+    void run()
+    {
+        const auto solver   = solver::Id{"ConvDirectNaiveConvFwd"};
+        const auto layers   = ResNet50();
+        auto problems       = std::vector<conv::ProblemDescription>{};
+        const Invoker dummy = [](const Handle&, const AnyInvokeParams&) {};
+        for(const auto& layer : layers)
+            problems.push_back(MakeProblem(layer, 32));
+
+        auto found       = std::size_t{0};
+        auto time        = 0.;
+        auto lookup_time = 0.;
+
+        if(mode == "flat")
+        {
+            InvokerCache cache;
+            for(const auto& problem : problems)
+                cache.Register(problem.BuildConfKey(), solver.ToString(), dummy);
+
+            const auto start = std::chrono::steady_clock::now();
+            for(auto pass = 0; pass < passes; ++pass)
+            {
+                for(const auto& problem : problems)
+                {
+                    const auto key = problem.GetInternedKey();
+                    if(cache.Get(key.GetNetworkConfig(), solver))
+                        ++found;
+                }
+            }
+            time = Ns(start);
+
+            // Same, but with the configs already built, i.e. the cache alone.
+            auto configs = std::vector<NetworkConfig>{};
+            for(const auto& problem : problems)
+                configs.push_back(problem.BuildConfKey());
+            auto lookup_found       = std::size_t{0};
+            const auto lookup_start = std::chrono::steady_clock::now();
+            for(auto pass = 0; pass < passes; ++pass)
+            {
+                for(const auto& config : configs)
+                {
+                    if(cache.Get(config, solver))
+                        ++lookup_found;
+                }
+            }
+            lookup_time = Ns(lookup_start) / lookup_found;
+        }
+        else if(mode == "map")
+        {
+            std::map<std::string, std::map<std::string, Invoker>> cache;
+            for(const auto& problem : problems)
+                cache[problem.BuildConfKey().ToString()][solver.ToString()] = dummy;
+
+            const auto start = std::chrono::steady_clock::now();
+            for(auto pass = 0; pass < passes; ++pass)
+            {
+                for(const auto& problem : problems)
+                {
+                    const auto item = cache.find(problem.BuildConfKey());
+                    if(item != cache.end() && item->second.count(solver.ToString()) != 0)
+                        ++found;
+                }
+            }
+            time = Ns(start);
+        }
+        else
+        {
+            MIOPEN_THROW("Unknown mode: " + mode);
+        }
+
+        const auto calls = passes * problems.size();
+        if(found != calls)
+            MIOPEN_THROW("Lookups failed: " + std::to_string(calls - found));
+
+        std::cout << mode << ": " << problems.size() << " layers, " << calls
+                  << " dispatches: " << time / calls << " ns per dispatch";
+        if(lookup_time != 0.)
+            std::cout << ", " << lookup_time << " ns of it in the cache";
+        std::cout << std::endl;
+    }
+
+private:
+    std::string mode = "flat";
+    int passes       = 10000;
+
+    static double Ns(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::nano>{std::chrono::steady_clock::now() - start}
+            .count();
+    }
+};
+
+} // namespace invoker_cache
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::invoker_cache::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/par_for.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace par_for_speedtest {
+
+// The previous par_for: a new thread for each of the equal chunks on every call.
+template <class F>
+void spawn_par_for(std::size_t n, std::size_t min_grain_size, F f)
+{
+    const auto threadsize =
+        std::min<std::size_t>(std::thread::hardware_concurrency(), n / min_grain_size);
+    if(threadsize <= 1)
+    {
+        for(std::size_t i = 0; i < n; i++)
+            f(i);
+        return;
+    }
+
+    std::vector<joinable_thread> threads;
+    const std::size_t grainsize = std::ceil(static_cast<double>(n) / threadsize);
+    for(std::size_t start = 0; start < n; start += grainsize)
+    {
+        threads.emplace_back([=] {
+            for(std::size_t i = start; i < std::min(n, start + grainsize); i++)
+                f(i);
+        });
+    }
+}
+
+// Compares the work-stealing par_for with the previous implementation.
+// "balanced" gives every index the same cost, in "skewed" the cost grows quadratically with the
+// index, like the outer loops of the reference convolutions over triangular ranges.
+// Usage: speedtest_par_for [--size N] [--work N] [--calls N] [--workload balanced|skewed]
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(size, "size");
+        add(work, "work");
+        add(calls, "calls");
+        add(workload, "workload");
+    }
+
+    void run()
+    {
+        if(workload != "balanced" && workload != "skewed")
+            MIOPEN_THROW("Unknown workload: " + workload);
+
+        const auto skewed = workload == "skewed";
+        auto results      = std::vector<double>(size);
+        const auto body   = [&](std::size_t i) {
+            const auto scale = skewed ? 3. * i * i / (static_cast<double>(size) * size) : 1.;
+            const auto steps = static_cast<std::size_t>(work * scale);
+            auto x           = static_cast<double>(i);
+            for(std::size_t s = 0; s < steps; s++)
+                x = std::sqrt(x + s);
+            results[i] = x;
+        };
+
+        const auto pool  = Ms([&] { par_for(size, 1, body); });
+        const auto spawn = Ms([&] { spawn_par_for(size, 1, body); });
+
+        std::cout << workload << ": " << size << " indices, " << calls
+                  << " calls, per call: work-stealing " << pool << " ms, thread per chunk "
+                  << spawn << " ms" << std::endl;
+    }
+
+private:
+    std::string workload = "balanced";
+    int size             = 4096;
+    int work             = 2000;
+    int calls            = 100;
+
+    template <class F>
+    double Ms(F f) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto call = 0; call < calls; ++call)
+            f();
+        return std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}
+                   .count() /
+               calls;
+    }
+};
+
+} // namespace par_for_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::par_for_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
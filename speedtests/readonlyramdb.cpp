@@ -0,0 +1,146 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/compiled_db.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace miopen {
+namespace rordb {
+
+// Compares cold start of ReadonlyRamDb backed by a text db against the compiled image.
+// Usage: speedtest_readonlyramdb [--db <system find-db>] [--records N] [--mode text|compiled|both]
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(db_path, "db");
+        add(records, "records");
+        add(mode, "mode");
+    }
+
+    void run()
+    {
+        TempFile text_dir{"miopen.speedtests.rordb.text"};
+        TempFile compiled_dir{"miopen.speedtests.rordb.compiled"};
+
+        // Each mode needs its own path as ReadonlyRamDb instances are cached per path forever.
+        const std::string text_path     = text_dir.Path() + ".fdb.txt";
+        const std::string compiled_path = compiled_dir.Path() + ".fdb.txt";
+
+        if(db_path.empty())
+            Generate(text_path);
+        else
+            boost::filesystem::copy_file(db_path, text_path);
+        boost::filesystem::copy_file(text_path, compiled_path);
+
+        const auto keys = ReadKeys(text_path);
+        std::cout << "Records: " << keys.size()
+                  << ", text db size: " << boost::filesystem::file_size(text_path) << std::endl;
+
+        if(mode == "text" || mode == "both")
+            Measure("text", text_path, keys);
+
+        if(mode == "compiled" || mode == "both")
+        {
+            const auto start = std::chrono::steady_clock::now();
+            CompiledDb::Compile(compiled_path, CompiledDb::GetPath(compiled_path));
+            std::cout << "compiled: conversion time: " << Ms(start) << " ms, image size: "
+                      << boost::filesystem::file_size(CompiledDb::GetPath(compiled_path))
+                      << std::endl;
+            Measure("compiled", compiled_path, keys);
+        }
+    }
+
+private:
+    std::string db_path;
+    std::string mode = "both";
+    int records      = 20000;
+
+    static double Ms(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}
+            .count();
+    }
+
+    static std::size_t Rss()
+    {
+        auto pages    = std::size_t{0};
+        auto resident = std::size_t{0};
+        std::ifstream("/proc/self/statm") >> pages >> resident;
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    void Generate(const std::string& path) const
+    {
+        std::ofstream file{path};
+
+        for(auto i = 0; i < records; ++i)
+        {
+            file << (64 + i % 1024) << "-" << (7 + i % 56) << "-" << (7 + i % 56) << "-3x3-"
+                 << i / 1024 << "-28-28-" << (1 + i % 256) << "-1x1-1x1-1x1-0-NCHW-FP32-F=";
+            file << "miopenConvolutionFwdAlgoDirect:ConvAsm1x1U," << (i % 97) * 0.1
+                 << ",0,miopenConvolutionFwdAlgoDirect,<unused>;"
+                 << "miopenConvolutionFwdAlgoWinograd:ConvBinWinogradRxSf3x2," << (i % 89) * 0.1
+                 << ",0,miopenConvolutionFwdAlgoWinograd,<unused>;"
+                 << "miopenConvolutionFwdAlgoGEMM:GemmFwd1x1_0_1," << (i % 83) * 0.1
+                 << ",1605632,rocBlas,<unused>" << std::endl;
+        }
+    }
+
+    static std::vector<std::string> ReadKeys(const std::string& path)
+    {
+        auto keys = std::vector<std::string>{};
+        auto file = std::ifstream{path};
+        auto line = std::string{};
+
+        while(std::getline(file, line))
+        {
+            const auto key_size = line.find('=');
+            if(key_size != std::string::npos && key_size != 0)
+                keys.emplace_back(line.substr(0, key_size));
+        }
+
+        return keys;
+    }
+
+    static void
+    Measure(const std::string& name, const std::string& path, const std::vector<std::string>& keys)
+    {
+        const auto rss_before = Rss();
+        auto start            = std::chrono::steady_clock::now();
+        const auto& db        = ReadonlyRamDb::GetCached(path, true);
+        const auto load_time  = Ms(start);
+        const auto rss_loaded = Rss();
+
+        start      = std::chrono::steady_clock::now();
+        auto found = std::size_t{0};
+        for(const auto& key : keys)
+            if(db.FindRecord(key))
+                ++found;
+        const auto lookup_time = Ms(start);
+
+        std::cout << name << ": load time: " << load_time << " ms, RSS growth: "
+                  << (rss_loaded - rss_before) / 1024 << " KiB, " << found
+                  << " lookups: " << lookup_time << " ms" << std::endl;
+    }
+};
+
+} // namespace rordb
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::rordb::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/search_strategy.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace search_strategy_speedtest {
+
+using solver::ConfigFields;
+using solver::SearchStrategyKind;
+
+// The search space resembles the ones of the implicit GEMM solvers: block size, tile sizes
+// per block and per thread and a switch, with the tiles restricted by the block size.
+std::vector<std::vector<int>> MakeSpace()
+{
+    std::vector<std::vector<int>> space;
+    for(int block : {64, 128, 256})
+        for(int m : {16, 32, 64, 128})
+            for(int n : {16, 32, 64, 128})
+                for(int k : {4, 8, 16, 32})
+                    for(int mt : {1, 2, 4, 8})
+                        for(int nt : {1, 2, 4, 8})
+                            for(int lds : {0, 1})
+                            {
+                                const auto threads = m * n / (mt * nt);
+                                if(threads * 2 < block || threads > block * 2 || k * m > 2048)
+                                    continue;
+                                space.push_back({block, m, n, k, mt, nt, lds});
+                            }
+    return space;
+}
+
+// Kernel time model of one problem: a smooth bowl around problem-specific optima of the fields,
+// the waste of the tiles on the problem size, and a deterministic per-config ruggedness.
+// The optima of all the problems are near common ones, which makes the perf-db informative.
+struct Problem
+{
+    std::size_t m_size;
+    std::size_t n_size;
+    std::vector<double> optimum;
+    std::vector<double> weight;
+    unsigned rugged_seed;
+
+    Problem(std::mt19937& gen)
+    {
+        std::uniform_int_distribution<std::size_t> size(50, 3000);
+        std::normal_distribution<double> shift(0., 0.6);
+        std::uniform_real_distribution<double> w(0.02, 0.12);
+        const std::vector<double> common{7., 5.5, 5.5, 3., 2., 2., 0.7};
+        m_size = size(gen);
+        n_size = size(gen);
+        for(auto c : common)
+        {
+            optimum.push_back(c + shift(gen));
+            weight.push_back(w(gen));
+        }
+        rugged_seed = gen();
+    }
+
+    double Time(const std::vector<int>& config) const
+    {
+        auto log_time = 0.;
+        for(std::size_t f = 0; f < config.size(); ++f)
+        {
+            const auto x = f + 1 < config.size() ? std::log2(config[f]) : config[f];
+            log_time += weight[f] * (x - optimum[f]) * (x - optimum[f]);
+        }
+        const auto m = static_cast<std::size_t>(config[1]);
+        const auto n = static_cast<std::size_t>(config[2]);
+        const auto waste =
+            static_cast<double>((m_size + m - 1) / m * m) / m_size * ((n_size + n - 1) / n * n) /
+            n_size;
+
+        auto hash = rugged_seed;
+        for(auto v : config)
+            hash = hash * 31 + v;
+        std::mt19937 rugged{hash};
+        return std::exp(log_time) * waste *
+               (1. + 0.05 * std::uniform_real_distribution<double>(-1., 1.)(rugged));
+    }
+};
+
+struct Result
+{
+    std::size_t measured     = 0; // Distinct configs, each of them needs to be built.
+    std::size_t measurements = 0; // Kernel runs.
+    double loss              = 0; // Of the chosen config vs the fastest one, relative.
+};
+
+// Mirrors GenericSearch: one probe, the average of 5 runs for the probes within 5% of the best,
+// the best average wins.
+Result Run(const Problem& problem,
+           const std::vector<std::vector<int>>& space,
+           const std::vector<ConfigFields>& fields,
+           SearchStrategyKind kind,
+           std::size_t budget,
+           const std::vector<ConfigFields>& known_best,
+           double noise,
+           unsigned seed)
+{
+    std::mt19937 gen{seed};
+    std::normal_distribution<double> jitter(0., noise);
+    const auto measure = [&](std::size_t i) {
+        return static_cast<float>(problem.Time(space[i]) * std::max(0.5, 1. + jitter(gen)));
+    };
+
+    auto strategy   = solver::MakeSearchStrategy(kind, fields, budget, known_best, seed);
+    auto best_time  = std::numeric_limits<float>::max();
+    auto best       = space.size();
+    auto is_counted = std::vector<bool>(space.size(), false);
+    Result result;
+
+    for(auto batch = strategy->Propose(); !batch.configs.empty(); batch = strategy->Propose())
+    {
+        std::vector<float> times;
+        for(const auto i : batch.configs)
+        {
+            auto time       = measure(i);
+            const auto runs = time / best_time < 1.05f ? std::max<std::size_t>(batch.runs, 5)
+                                                       : batch.runs;
+            for(std::size_t run = 1; run < runs; ++run)
+                time += measure(i);
+            time /= runs;
+            if(time < best_time)
+            {
+                best_time = time;
+                best      = i;
+            }
+            times.push_back(time);
+            result.measurements += runs;
+            if(!is_counted[i])
+                ++result.measured;
+            is_counted[i] = true;
+        }
+        strategy->Report(times);
+    }
+
+    auto fastest = std::numeric_limits<double>::max();
+    for(const auto& config : space)
+        fastest = std::min(fastest, problem.Time(config));
+    result.loss = problem.Time(space[best]) / fastest - 1.;
+    return result;
+}
+
+// Compares the search strategies on synthetic problems, see Problem.
+// The known best configs of the surrogate model are the fastest ones of other problems.
+// Usage: speedtest_search_strategy [--problems N] [--known N] [--noise X] [--budget N]
+// The budget defaults to the one GenericSearch uses, see MIOPEN_TUNING_STRATEGY_PERCENT.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(problems, "problems");
+        add(known, "known");
+        add(noise, "noise");
+        add(budget, "budget");
+    }
+
+    void run()
+    {
+        const auto space = MakeSpace();
+        std::vector<ConfigFields> fields;
+        for(const auto& config : space)
+        {
+            ConfigFields f;
+            for(auto v : config)
+                f.push_back(std::to_string(v));
+            fields.push_back(f);
+        }
+        const auto n_budget = budget > 0 ? static_cast<std::size_t>(budget)
+                                         : solver::GetSearchStrategyBudget(space.size());
+
+        std::mt19937 gen{2022};
+        std::vector<ConfigFields> known_best;
+        for(auto i = 0; i < known; ++i)
+        {
+            const Problem other{gen};
+            const auto fastest =
+                std::min_element(space.begin(), space.end(), [&](auto& l, auto& r) {
+                    return other.Time(l) < other.Time(r);
+                });
+            known_best.push_back(fields[fastest - space.begin()]);
+        }
+        std::vector<Problem> tested;
+        for(auto i = 0; i < problems; ++i)
+            tested.emplace_back(gen);
+
+        std::cout << space.size() << " configs, budget " << n_budget << ", " << problems
+                  << " problems, noise " << noise << std::endl;
+        std::cout << std::setw(12) << "strategy" << std::setw(12) << "configs" << std::setw(12)
+                  << "runs" << std::setw(12) << "reduction" << std::setw(12) << "mean loss"
+                  << std::setw(12) << "p90 loss" << std::setw(12) << "max loss" << std::endl;
+
+        for(const auto kind : {SearchStrategyKind::Exhaustive,
+                               SearchStrategyKind::Random,
+                               SearchStrategyKind::Halving,
+                               SearchStrategyKind::Coordinate,
+                               SearchStrategyKind::Surrogate})
+        {
+            std::vector<double> losses;
+            double measured     = 0;
+            double measurements = 0;
+            for(std::size_t p = 0; p < tested.size(); ++p)
+            {
+                const auto result =
+                    Run(tested[p], space, fields, kind, n_budget, known_best, noise, p);
+                losses.push_back(result.loss);
+                measured += result.measured;
+                measurements += result.measurements;
+            }
+            std::sort(losses.begin(), losses.end());
+            const auto mean = std::accumulate(losses.begin(), losses.end(), 0.) / losses.size();
+            std::cout << std::setw(12) << kind << std::setw(12) << measured / problems
+                      << std::setw(12) << measurements / problems << std::setw(11)
+                      << space.size() * problems / measured << 'x' << std::setw(11) << mean * 100
+                      << '%' << std::setw(11) << losses[losses.size() * 9 / 10] * 100 << '%'
+                      << std::setw(11) << losses.back() * 100 << '%' << std::endl;
+        }
+    }
+
+private:
+    int problems = 200;
+    int known    = 30;
+    double noise = 0.02;
+    int budget   = 0;
+};
+
+} // namespace search_strategy_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::search_strategy_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
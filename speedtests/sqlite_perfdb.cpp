@@ -0,0 +1,123 @@
+#include <miopen/config.h> // WORKAROUND_BOOST_ISSUE_392
+#include <miopen/problem_description.hpp>
+#include <miopen/sqlite_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#if MIOPEN_ENABLE_SQLITE
+
+namespace miopen {
+namespace sqlite_perfdb {
+
+struct TestValues
+{
+    int n = 0;
+    void Serialize(std::ostream& s) const { s << n << ",16,4,4"; }
+    bool Deserialize(const std::string& s)
+    {
+        n = std::stoi(s);
+        return true;
+    }
+};
+
+// Measures inserts and lookups per second of the user perf-db.
+// Usage: speedtest_sqlite_perfdb [--rows N] [--unbatched N]
+// Set MIOPEN_DEBUG_DISABLE_SQL_STMT_CACHE=1 to compare against preparing each statement.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(rows, "rows");
+        add(unbatched, "unbatched");
+    }
+
+    void run()
+    {
+        TempFile dir{"miopen.speedtests.sqlite_perfdb"};
+        SQLitePerfDb db(dir.Path() + ".udb", false);
+
+        // Each unbatched update is a transaction of its own, so only a few are measured.
+        auto start = std::chrono::steady_clock::now();
+        for(auto i = rows; i < rows + unbatched; ++i)
+            db.Update(MakeProblem(i), "ConvAsm1x1U", TestValues{i});
+        Report("unbatched inserts", unbatched, start);
+
+        start = std::chrono::steady_clock::now();
+        db.BeginBatch();
+        for(auto i = 0; i < rows; ++i)
+            db.Update(MakeProblem(i), "ConvAsm1x1U", TestValues{i});
+        db.CommitBatch();
+        Report("batched inserts", rows, start);
+
+        start      = std::chrono::steady_clock::now();
+        auto found = 0;
+        for(auto i = 0; i < rows; ++i)
+        {
+            auto values = TestValues{};
+            if(db.Load(MakeProblem(i), "ConvAsm1x1U", values) && values.n == i)
+                ++found;
+        }
+        Report("lookups", rows, start);
+
+        if(found != rows)
+            MIOPEN_THROW("Found " + std::to_string(found) + " of " + std::to_string(rows));
+    }
+
+private:
+    int rows      = 100000;
+    int unbatched = 100;
+
+    static ProblemDescription MakeProblem(int i)
+    {
+        auto problem              = ProblemDescription{conv::Direction::Forward};
+        problem.spatial_dims      = 2;
+        problem.n_inputs          = 64 + i % 1024;
+        problem.in_height         = 7 + i % 56;
+        problem.in_width          = 7 + i % 56;
+        problem.kernel_size_h     = 3;
+        problem.kernel_size_w     = 3;
+        problem.n_outputs         = 1 + i / 1024;
+        problem.batch_sz          = 1 + i % 256;
+        problem.pad_h             = 1;
+        problem.pad_w             = 1;
+        problem.kernel_stride_h   = 1;
+        problem.kernel_stride_w   = 1;
+        problem.kernel_dilation_h = 1;
+        problem.kernel_dilation_w = 1;
+        problem.in_layout         = "NCHW";
+        problem.in_data_type      = miopenFloat;
+        problem.weights_data_type = miopenFloat;
+        problem.out_data_type     = miopenFloat;
+        problem.group_counts      = 1;
+        return problem;
+    }
+
+    static void
+    Report(const std::string& name, int count, std::chrono::steady_clock::time_point start)
+    {
+        const auto seconds =
+            std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+        std::cout << name << ": " << count << " in " << seconds * 1000 << " ms, "
+                  << count / seconds << "/s" << std::endl;
+    }
+};
+
+} // namespace sqlite_perfdb
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::sqlite_perfdb::SpeedTestDriver>(argc, argv);
+    return 0;
+}
+
+#else
+
+int main() { return 0; }
+
+#endif
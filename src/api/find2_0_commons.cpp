@@ -112,6 +112,77 @@ miopenStatus_t miopenSetFindOptionWorkspaceLimit(miopenFindOptions_t options, si
     });
 }
 
+miopenStatus_t miopenSetFindOptionTuningTimeLimit(miopenFindOptions_t options, float value)
+{
+    MIOPEN_LOG_FUNCTION(options, value);
+
+    return miopen::try_([&] {
+        if(value < 0.0f)
+            MIOPEN_THROW(miopenStatusBadParm, "Tuning time limit cannot be negative.");
+        auto& options_deref = miopen::deref(options);
+        options_deref.tuning_budget.SetSeconds(value);
+    });
+}
+
+miopenStatus_t miopenSetFindOptionTuningEvaluationLimit(miopenFindOptions_t options, size_t value)
+{
+    MIOPEN_LOG_FUNCTION(options, value);
+
+    return miopen::try_([&] {
+        auto& options_deref = miopen::deref(options);
+        options_deref.tuning_budget.SetEvaluations(value);
+    });
+}
+
+miopenStatus_t miopenSetFindOptionSelectionPolicy(miopenFindOptions_t options,
+                                                  miopenFindSelectionPolicy_t value)
+{
+    MIOPEN_LOG_FUNCTION(options, value);
+
+    return miopen::try_([&] {
+        auto& options_deref            = miopen::deref(options);
+        options_deref.selection_policy = value;
+    });
+}
+
+miopenStatus_t miopenSetFindOptionTimeTolerance(miopenFindOptions_t options, float value)
+{
+    MIOPEN_LOG_FUNCTION(options, value);
+
+    return miopen::try_([&] {
+        if(!(value >= 0.0f))
+            MIOPEN_THROW(miopenStatusBadParm, "Time tolerance cannot be negative.");
+        auto& options_deref          = miopen::deref(options);
+        options_deref.time_tolerance = value;
+    });
+}
+
+miopenStatus_t miopenSelectConvSolutions(miopenFindOptions_t options,
+                                         miopenConvSolution_t* solutions,
+                                         size_t* solutionCount)
+{
+    MIOPEN_LOG_FUNCTION(options, solutionCount);
+
+    return miopen::try_([&] {
+        const auto& options_deref =
+            options == nullptr ? miopen::FindOptions{} : miopen::deref(options);
+        const auto count = miopen::deref(solutionCount);
+        if(count != 0 && solutions == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
+
+        auto costs = std::vector<miopen::SolutionCost>{};
+        costs.reserve(count);
+        for(auto i = std::size_t{0}; i < count; ++i)
+            costs.push_back({solutions[i].time, solutions[i].workspace_size});
+
+        const auto all      = std::vector<miopenConvSolution_t>(solutions, solutions + count);
+        const auto selected = options_deref.Select(costs);
+        for(auto i = std::size_t{0}; i < selected.size(); ++i)
+            solutions[i] = all[selected[i]];
+        *solutionCount = selected.size();
+    });
+}
+
 miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
                                    miopenProblem_t problem,
                                    miopenFindOptions_t options,
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/background_find.hpp>
+
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <exception>
+
+namespace miopen {
+
+BackgroundFind::BackgroundFind() : cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+BackgroundFind::~BackgroundFind()
+{
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+        queue.clear();
+    }
+    *cancelled = true;
+    changed.notify_all();
+    if(worker.joinable())
+        worker.join();
+}
+
+bool BackgroundFind::Schedule(const Handle& handle, const std::string& key, Job job)
+{
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        if(stopping || results.find(key) != results.end())
+            return false;
+        results.emplace(key, Result{});
+    }
+
+    // Created out of the lock, as it may take a while.
+    auto worker_handle = std::unique_ptr<Handle>{};
+    try
+    {
+        worker_handle            = handle.CreateWorkerHandle();
+        worker_handle->cancelled = cancelled;
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Cannot run the Find of " << key << " in background: " << ex.what());
+        const std::lock_guard<std::mutex> lock{mutex};
+        results[key].solutions = std::vector<miopenConvSolution_t>{};
+        return false;
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        queue.push_back({key, std::move(worker_handle), std::move(job)});
+        if(!worker.joinable())
+            worker = std::thread{[this]() { Run(); }};
+    }
+    changed.notify_all();
+    MIOPEN_LOG_I("Scheduled the Find of " << key);
+    return true;
+}
+
+boost::optional<std::vector<miopenConvSolution_t>>
+BackgroundFind::GetResult(const std::string& key) const
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto it = results.find(key);
+    if(it == results.end())
+        return boost::none;
+    return it->second.solutions;
+}
+
+boost::optional<std::vector<miopenConvSolution_t>>
+BackgroundFind::TakeResult(const std::string& key)
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto it = results.find(key);
+    if(it == results.end() || !it->second.solutions || it->second.taken)
+        return boost::none;
+    it->second.taken = true;
+    if(!it->second.solutions->empty())
+        --results_to_take;
+    return it->second.solutions;
+}
+
+void BackgroundFind::Wait() const
+{
+    auto lock = std::unique_lock<std::mutex>{mutex};
+    changed.wait(lock, [&]() { return stopping || (queue.empty() && !running); });
+}
+
+void BackgroundFind::Run()
+{
+    auto lock = std::unique_lock<std::mutex>{mutex};
+    while(true)
+    {
+        changed.wait(lock, [&]() { return stopping || !queue.empty(); });
+        if(stopping)
+            return;
+
+        auto task = std::move(queue.front());
+        queue.pop_front();
+        running = true;
+        lock.unlock();
+
+        auto solutions = std::vector<miopenConvSolution_t>{};
+        try
+        {
+            solutions = task.job(*task.handle);
+            MIOPEN_LOG_I("Found " << solutions.size() << " solutions of " << task.key);
+        }
+        catch(const std::exception& ex)
+        {
+            // The callers keep using the solutions they have.
+            if(*cancelled)
+                MIOPEN_LOG_I("The Find of " << task.key << " has been cancelled");
+            else
+                MIOPEN_LOG_W("The Find of " << task.key << " has failed: " << ex.what());
+        }
+        task.handle.reset();
+
+        lock.lock();
+        if(!solutions.empty())
+            ++results_to_take;
+        results[task.key].solutions = std::move(solutions);
+        running                     = false;
+        changed.notify_all();
+    }
+}
+
+} // namespace miopen
@@ -39,6 +39,9 @@
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cctype>
+#include <ctime>
 #include <fstream>
 #include <iostream>
 
@@ -46,6 +49,8 @@ namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CUSTOM_CACHE_DIR)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE_PURGE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CACHE_PURGE_DAYS)
 
 static boost::filesystem::path ComputeSysCachePath()
 {
@@ -57,6 +62,79 @@ static boost::filesystem::path ComputeSysCachePath()
         return p;
 }
 
+#ifdef MIOPEN_CACHE_DIR
+static bool IsNumber(const std::string& s)
+{
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return std::isdigit(c); });
+}
+
+// The last time anything in the directory has been written, or now if it cannot be told.
+static std::time_t GetLastWriteTime(const boost::filesystem::path& dir)
+{
+    boost::system::error_code error;
+    auto last = boost::filesystem::last_write_time(dir, error);
+    auto it   = boost::filesystem::recursive_directory_iterator{dir, error};
+    for(; !error && it != boost::filesystem::recursive_directory_iterator{}; it.increment(error))
+    {
+        boost::system::error_code entry_error;
+        const auto time = boost::filesystem::last_write_time(it->path(), entry_error);
+        if(!entry_error)
+            last = std::max(last, time);
+    }
+    return error ? std::time(nullptr) : last;
+}
+
+// Removes the caches of the other MIOpen versions, which are left behind by upgrades. The ones
+// written during the last MIOPEN_CACHE_PURGE_DAYS days are kept, as they may still be in use by
+// another installation.
+static void PurgeOtherVersions(const boost::filesystem::path& cache_root,
+                               const std::string& version)
+{
+    // Nothing here may throw: another process may be removing the same directories meanwhile.
+    boost::system::error_code error;
+    if(miopen::IsEnabled(MIOPEN_DISABLE_CACHE_PURGE{}) ||
+       !boost::filesystem::exists(cache_root, error))
+        return;
+
+    const auto max_idle_days = Value(MIOPEN_CACHE_PURGE_DAYS{}, 30);
+    const auto now           = std::time(nullptr);
+
+    auto it = boost::filesystem::directory_iterator{cache_root, error};
+    for(; !error && it != boost::filesystem::directory_iterator{}; it.increment(error))
+    {
+        const auto& entry = *it;
+        const auto name   = entry.path().filename().string();
+        const auto parts  = SplitDelim(name, '.');
+        if(name == version || parts.size() != 4 || !IsNumber(parts[0]) || !IsNumber(parts[1]) ||
+           !IsNumber(parts[2]))
+            continue;
+
+        boost::system::error_code entry_error;
+        if(!boost::filesystem::is_directory(entry.path(), entry_error) || entry_error)
+            continue;
+
+        const auto idle_days = std::difftime(now, GetLastWriteTime(entry.path())) / (24 * 3600);
+        if(idle_days < max_idle_days)
+        {
+            MIOPEN_LOG_I2("Keeping the kernel cache of MIOpen " << name << ", written "
+                                                                << idle_days << " days ago");
+            continue;
+        }
+
+        boost::filesystem::remove_all(entry.path(), entry_error);
+        if(entry_error)
+            MIOPEN_LOG_W("Unable to remove the kernel cache " << entry.path() << ": "
+                                                              << entry_error.message());
+        else
+            MIOPEN_LOG_I("Removed the kernel cache of MIOpen " << name);
+    }
+
+    if(error)
+        MIOPEN_LOG_W("Unable to list the kernel caches in " << cache_root << ": "
+                                                            << error.message());
+}
+#endif
+
 static boost::filesystem::path ComputeUserCachePath()
 {
 #ifdef MIOPEN_CACHE_DIR
@@ -72,6 +150,8 @@ static boost::filesystem::path ComputeUserCachePath()
 
     if(!boost::filesystem::exists(p) && !MIOPEN_DISABLE_USERDB)
         boost::filesystem::create_directories(p);
+    if(!MIOPEN_DISABLE_USERDB && (custom == nullptr || strlen(custom) == 0))
+        PurgeOtherVersions(p.parent_path(), version);
     return p;
 #else
     return {};
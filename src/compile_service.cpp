@@ -0,0 +1,230 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compile_service.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <exception>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
+
+CompileService& CompileService::Get()
+{
+    static CompileService service;
+    return service;
+}
+
+CompileService::~CompileService()
+{
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        stop = true;
+    }
+    wake.notify_all();
+    for(auto& worker : workers)
+        worker.join();
+}
+
+CompileService::RequestPtr CompileService::Enqueue(const Handle& handle,
+                                                   const std::string& program_name,
+                                                   const std::string& params,
+                                                   bool is_kernel_str,
+                                                   const std::string& kernel_src,
+                                                   CompilePriority priority)
+{
+    auto key = Key{handle.GetProgramScope(), program_name, params, is_kernel_str};
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto found = in_flight.find(key);
+
+    if(found != in_flight.end())
+    {
+        const auto& request = found->second;
+        if(!request->started && priority == CompilePriority::Foreground &&
+           request->priority == CompilePriority::Background)
+        {
+            background.erase(std::find(background.begin(), background.end(), request));
+            foreground.push_back(request);
+            request->priority = CompilePriority::Foreground;
+        }
+        MIOPEN_LOG_I2("Joining the build of " << program_name << " '" << params << '\'');
+        return request;
+    }
+
+    auto request = AddRequestUnsafe(std::move(key), handle, kernel_src, priority);
+    (priority == CompilePriority::Foreground ? foreground : background).push_back(request);
+    StartWorkersUnsafe();
+    wake.notify_one();
+    return request;
+}
+
+CompileService::RequestPtr CompileService::AddRequestUnsafe(Key key,
+                                                            const Handle& handle,
+                                                            const std::string& kernel_src,
+                                                            CompilePriority priority)
+{
+    auto request        = std::make_shared<Request>();
+    request->key        = std::move(key);
+    request->handle     = &handle;
+    request->kernel_src = kernel_src;
+    request->priority   = priority;
+    request->future     = request->promise.get_future().share();
+    in_flight.emplace(request->key, request);
+    return request;
+}
+
+void CompileService::StartWorkersUnsafe()
+{
+    const auto max_workers = std::max<std::size_t>(Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20), 1);
+    const auto queued      = foreground.size() + background.size();
+
+    if(workers.size() < max_workers && idle < queued)
+    {
+        workers.emplace_back([this]() { Run(); });
+        ++idle;
+    }
+}
+
+void CompileService::Run()
+{
+    std::unique_lock<std::mutex> lock{mutex};
+
+    while(true)
+    {
+        wake.wait(lock, [&]() { return stop || !foreground.empty() || !background.empty(); });
+        if(stop)
+            break;
+
+        auto& queue        = !foreground.empty() ? foreground : background;
+        const auto request = queue.front();
+        queue.pop_front();
+        request->started = true;
+        --idle;
+
+        lock.unlock();
+        Build(*request);
+        lock.lock();
+
+        ++idle;
+    }
+}
+
+void CompileService::Build(Request& request)
+{
+    try
+    {
+        request.promise.set_value(request.handle->LoadProgram(std::get<1>(request.key),
+                                                              std::get<2>(request.key),
+                                                              std::get<3>(request.key),
+                                                              request.kernel_src));
+    }
+    catch(...)
+    {
+        request.promise.set_exception(std::current_exception());
+    }
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto found = in_flight.find(request.key);
+    if(found != in_flight.end() && found->second.get() == &request)
+        in_flight.erase(found);
+}
+
+std::shared_future<Program> CompileService::Submit(const Handle& handle,
+                                                   const solver::KernelInfo& kernel,
+                                                   CompilePriority priority)
+{
+    return Enqueue(handle, kernel.kernel_file, kernel.comp_options, false, "", priority)->future;
+}
+
+std::vector<Program> CompileService::Compile(const Handle& handle,
+                                             const std::vector<solver::KernelInfo>& kernels,
+                                             CompilePriority priority)
+{
+    auto futures = std::vector<std::shared_future<Program>>{};
+    futures.reserve(kernels.size());
+    for(const auto& kernel : kernels)
+        futures.push_back(Submit(handle, kernel, priority));
+
+    // The handle has to stay alive until every build is done, even if one of them fails.
+    for(const auto& future : futures)
+        future.wait();
+
+    auto programs = std::vector<Program>{};
+    programs.reserve(futures.size());
+    for(const auto& future : futures)
+        programs.push_back(future.get());
+    return programs;
+}
+
+Program CompileService::Load(const Handle& handle,
+                             const std::string& program_name,
+                             const std::string& params,
+                             bool is_kernel_str,
+                             const std::string& kernel_src)
+{
+    auto key     = Key{handle.GetProgramScope(), program_name, params, is_kernel_str};
+    auto request = RequestPtr{};
+    auto build   = false;
+
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto found = in_flight.find(key);
+
+        if(found == in_flight.end())
+        {
+            request =
+                AddRequestUnsafe(std::move(key), handle, kernel_src, CompilePriority::Foreground);
+            build = true;
+        }
+        else
+        {
+            request = found->second;
+            if(!request->started)
+            {
+                auto& queue = request->priority == CompilePriority::Foreground ? foreground
+                                                                                : background;
+                queue.erase(std::find(queue.begin(), queue.end(), request));
+                build = true;
+            }
+        }
+
+        request->started = true;
+    }
+
+    if(build)
+        Build(*request);
+    else
+        MIOPEN_LOG_I2("Waiting for the build of " << program_name << " '" << params << '\'');
+
+    return request->future.get();
+}
+
+} // namespace miopen
@@ -0,0 +1,413 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compiled_db.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+constexpr char compiled_db_magic[8] = {'M', 'I', 'O', 'P', 'E', 'N', 'D', 'B'};
+
+class StringsBuilder
+{
+public:
+    CompiledDb::String Add(const std::string& str)
+    {
+        // IDs and VALUES are repeated over and over in find-db, so those are stored once.
+        const auto it = known.find(str);
+        if(it != known.end())
+            return it->second;
+
+        const auto ret = CompiledDb::String{static_cast<std::uint32_t>(data.size()),
+                                            static_cast<std::uint32_t>(str.size())};
+        data.append(str);
+        known.emplace(str, ret);
+        return ret;
+    }
+
+    const std::string& Data() const { return data; }
+
+private:
+    std::string data;
+    std::unordered_map<std::string, CompiledDb::String> known;
+};
+
+template <class T>
+void WriteArray(std::ostream& stream, const std::vector<T>& data)
+{
+    if(!data.empty())
+        stream.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+}
+
+// FNV-1a, the same on every platform unlike std::hash.
+constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ULL;
+
+std::uint64_t Hash(const char* data, std::size_t size, std::uint64_t hash = fnv_offset_basis)
+{
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool HashFile(const std::string& path, std::uint64_t& hash)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    if(!file)
+        return false;
+
+    hash        = fnv_offset_basis;
+    auto buffer = std::vector<char>(1 << 16);
+    while(file)
+    {
+        file.read(buffer.data(), buffer.size());
+        hash = Hash(buffer.data(), file.gcount(), hash);
+    }
+    return file.eof();
+}
+} // namespace
+
+struct CompiledDb::Mapping
+{
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+
+CompiledDb::CompiledDb()                      = default;
+CompiledDb::CompiledDb(CompiledDb&&) noexcept = default;
+CompiledDb& CompiledDb::operator=(CompiledDb&&) noexcept = default;
+CompiledDb::~CompiledDb()                                = default;
+
+std::string CompiledDb::GetPath(const std::string& text_db_path)
+{
+    const std::string text_ext = ".txt";
+
+    if(text_db_path.size() > text_ext.size() &&
+       text_db_path.compare(text_db_path.size() - text_ext.size(), text_ext.size(), text_ext) == 0)
+        return text_db_path.substr(0, text_db_path.size() - text_ext.size()) + ".bin";
+    return text_db_path + ".bin";
+}
+
+int CompiledDb::Compile(std::istream& text_db,
+                        std::ostream& compiled,
+                        const Source& source,
+                        const std::string& source_name)
+{
+    struct ParsedRecord
+    {
+        std::string key;
+        std::vector<Pair> pairs;
+        int line;
+    };
+
+    auto parsed  = std::vector<ParsedRecord>{};
+    auto strings = StringsBuilder{};
+    auto line    = std::string{};
+    auto n_line  = 0;
+
+    while(std::getline(text_db, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << source_name << "#" << n_line);
+            continue;
+        }
+
+        auto record = ParsedRecord{line.substr(0, key_size), {}, n_line};
+        auto ids    = std::vector<std::string>{};
+        auto ss     = std::istringstream{line.substr(key_size + 1)};
+        auto pair   = std::string{};
+
+        while(std::getline(ss, pair, ';'))
+        {
+            const auto id_size = pair.find(':');
+
+            if(id_size == std::string::npos)
+            {
+                MIOPEN_LOG_E("Ill-formed file: ID not found; skipped; key: " << record.key);
+                continue;
+            }
+
+            auto id = pair.substr(0, id_size);
+            if(std::find(ids.begin(), ids.end(), id) != ids.end())
+            {
+                MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << record.key);
+                continue;
+            }
+
+            record.pairs.push_back({strings.Add(id), strings.Add(pair.substr(id_size + 1))});
+            ids.emplace_back(std::move(id));
+        }
+
+        if(record.pairs.empty())
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: " << record.key << " form file "
+                                                                 << source_name << "#" << n_line);
+            continue;
+        }
+
+        parsed.emplace_back(std::move(record));
+    }
+
+    // Stable sort and unique keep the first occurence of a key, as ReadonlyRamDb does.
+    std::stable_sort(parsed.begin(), parsed.end(), [](const auto& l, const auto& r) {
+        return l.key < r.key;
+    });
+    parsed.erase(std::unique(parsed.begin(),
+                             parsed.end(),
+                             [](const auto& l, const auto& r) { return l.key == r.key; }),
+                 parsed.end());
+
+    auto records = std::vector<Record>{};
+    auto pairs   = std::vector<Pair>{};
+    records.reserve(parsed.size());
+
+    for(const auto& record : parsed)
+    {
+        records.push_back({strings.Add(record.key),
+                           static_cast<std::uint32_t>(pairs.size()),
+                           static_cast<std::uint32_t>(record.pairs.size()),
+                           static_cast<std::uint32_t>(record.line)});
+        pairs.insert(pairs.end(), record.pairs.begin(), record.pairs.end());
+    }
+
+    auto header = Header{};
+    std::copy(std::begin(compiled_db_magic), std::end(compiled_db_magic), header.magic);
+    header.version      = version;
+    header.record_count = records.size();
+    header.pair_count   = pairs.size();
+    header.source       = source;
+    header.strings_size = strings.Data().size();
+
+    compiled.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteArray(compiled, records);
+    WriteArray(compiled, pairs);
+    compiled.write(strings.Data().data(), strings.Data().size());
+
+    if(!compiled)
+        return -1;
+    return static_cast<int>(records.size());
+}
+
+bool CompiledDb::Compile(const std::string& text_db_path, const std::string& compiled_path)
+{
+    // The image is built from the contents read at once, so that they match the hash, even if
+    // the file is changed meanwhile.
+    auto source      = Source{};
+    source.read_time = std::time(nullptr);
+
+    boost::system::error_code ec;
+    source.mtime = boost::filesystem::last_write_time(text_db_path, ec);
+    auto file    = std::ifstream{text_db_path, std::ios::binary};
+    if(ec || !file)
+    {
+        MIOPEN_LOG_E("File is unreadable: " << text_db_path);
+        return false;
+    }
+
+    auto input = std::stringstream{};
+    input << file.rdbuf();
+    const auto contents = input.str();
+    source.size         = contents.size();
+    source.hash         = Hash(contents.data(), contents.size());
+
+    const auto temp_path = compiled_path + ".tmp";
+
+    {
+        auto output = std::ofstream{temp_path, std::ios::binary | std::ios::trunc};
+        if(!output)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << temp_path);
+            return false;
+        }
+
+        const auto records = Compile(input, output, source, text_db_path);
+        if(records < 0)
+        {
+            MIOPEN_LOG_E("Failed to write " << temp_path);
+            boost::filesystem::remove(temp_path);
+            return false;
+        }
+
+        MIOPEN_LOG_I("Compiled " << records << " records from " << text_db_path);
+    }
+
+    // Readers should never see a partially written image.
+    boost::filesystem::rename(temp_path, compiled_path);
+    return true;
+}
+
+bool CompiledDb::Open(const std::string& path, const std::string& source_path)
+{
+    namespace bip = boost::interprocess;
+
+    *this = CompiledDb{};
+
+    boost::system::error_code ec;
+    if(!boost::filesystem::exists(path, ec))
+        return false;
+
+    try
+    {
+        auto new_mapping    = std::make_unique<Mapping>();
+        new_mapping->file   = bip::file_mapping{path.c_str(), bip::read_only};
+        new_mapping->region = bip::mapped_region{new_mapping->file, bip::read_only};
+
+        const auto data = static_cast<const char*>(new_mapping->region.get_address());
+        if(!Validate(data, new_mapping->region.get_size(), path))
+            return false;
+
+        if(!IsBuiltFrom(source_path))
+        {
+            MIOPEN_LOG_W("Compiled db is out of date and ignored: " << path);
+            *this = CompiledDb{};
+            return false;
+        }
+
+        mapping = std::move(new_mapping);
+    }
+    catch(const bip::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map compiled db " << path << ": " << ex.what());
+        *this = CompiledDb{};
+        return false;
+    }
+
+    MIOPEN_LOG_I2("Mapped compiled db " << path << ", records: " << header->record_count);
+    return true;
+}
+
+bool CompiledDb::Validate(const char* data, std::size_t size, const std::string& path)
+{
+    if(size < sizeof(Header) ||
+       std::memcmp(data, compiled_db_magic, sizeof(compiled_db_magic)) != 0)
+    {
+        MIOPEN_LOG_E("Ill-formed compiled db: " << path);
+        return false;
+    }
+
+    const auto h = reinterpret_cast<const Header*>(data);
+    if(h->version != version)
+    {
+        MIOPEN_LOG_W("Compiled db version mismatch (" << h->version << " != " << version
+                                                      << "), ignored: " << path);
+        return false;
+    }
+
+    const auto expected_size = sizeof(Header) + std::uint64_t{h->record_count} * sizeof(Record) +
+                               std::uint64_t{h->pair_count} * sizeof(Pair) + h->strings_size;
+    if(expected_size != size)
+    {
+        MIOPEN_LOG_E("Ill-formed compiled db: size mismatch: " << path);
+        return false;
+    }
+
+    header  = h;
+    records = reinterpret_cast<const Record*>(data + sizeof(Header));
+    pairs   = reinterpret_cast<const Pair*>(records + h->record_count);
+    strings = reinterpret_cast<const char*>(pairs + h->pair_count);
+    return true;
+}
+
+bool CompiledDb::IsBuiltFrom(const std::string& source_path) const
+{
+    const auto& source = header->source;
+
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(source_path, ec);
+    if(ec || size != source.size)
+        return false;
+    const auto mtime = boost::filesystem::last_write_time(source_path, ec);
+    if(!ec && mtime == source.mtime && source.mtime < source.read_time)
+        return true;
+
+    auto hash = std::uint64_t{};
+    if(!HashFile(source_path, hash) || hash != source.hash)
+        return false;
+    MIOPEN_LOG_I2("Compiled db matches the contents of " << source_path);
+    return true;
+}
+
+const CompiledDb::Record* CompiledDb::Find(const char* key, std::size_t key_size) const
+{
+    if(!IsOpen())
+        return nullptr;
+
+    const auto in_bounds = [&](const String& str) {
+        return std::uint64_t{str.offset} + str.size <= header->strings_size;
+    };
+
+    const auto compare = [&](const Record& record) {
+        if(!in_bounds(record.key))
+            return 1; // Corrupted records sort last and are never matched.
+        const auto common = std::min<std::size_t>(record.key.size, key_size);
+        const auto ret    = std::memcmp(strings + record.key.offset, key, common);
+        if(ret != 0)
+            return ret;
+        return record.key.size < key_size ? -1 : (record.key.size > key_size ? 1 : 0);
+    };
+
+    const auto last = records + header->record_count;
+    const auto it   = std::lower_bound(
+        records, last, 0, [&](const Record& record, int) { return compare(record) < 0; });
+
+    if(it == last || compare(*it) != 0)
+        return nullptr;
+
+    if(std::uint64_t{it->first_pair} + it->pair_count > header->pair_count ||
+       !std::all_of(begin(*it), end(*it), [&](const Pair& pair) {
+           return in_bounds(pair.id) && in_bounds(pair.values);
+       }))
+    {
+        MIOPEN_LOG_E("Ill-formed compiled db record #" << (it - records));
+        return nullptr;
+    }
+
+    return it;
+}
+
+} // namespace miopen
@@ -83,7 +83,7 @@ void ProblemDescription::HeuristicUpdateLayouts()
     // If we did not find consistent layout, leave them as-is
 }
 
-void ProblemDescription::BuildConfKey(std::string& conf_key) const
+void ProblemDescription::BuildConfKeyImpl(std::string& conf_key) const
 {
     std::ostringstream ss;
 
@@ -123,7 +123,7 @@ void ProblemDescription::BuildConfKey(std::string& conf_key) const
     conf_key = ss.str();
 }
 
-void ProblemDescription::Serialize(std::ostream& stream) const
+void ProblemDescription::SerializeImpl(std::ostream& stream) const
 {
     const auto sep = '-';
     // Problem description with default layout
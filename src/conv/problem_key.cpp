@@ -0,0 +1,178 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_key.hpp>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/errors.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+constexpr std::size_t LayoutFields = 2;
+
+void PackLayout(const std::string& layout, std::int64_t* fields)
+{
+    if(layout.size() > LayoutFields * sizeof(std::int64_t))
+        MIOPEN_THROW("Layout is too long for a problem key: " + layout);
+    std::memcpy(fields, layout.data(), layout.size());
+}
+
+} // namespace
+
+ProblemKey::ProblemKey(const ProblemDescription& problem)
+{
+    auto field      = fields.begin();
+    const auto push = [&](std::int64_t value) { *field++ = value; };
+    const auto pack = [&](const std::string& layout) {
+        PackLayout(layout, &*field);
+        field += LayoutFields;
+    };
+
+    push(problem.GetSpatialDims());
+    push(problem.GetInChannels());
+    push(problem.GetInDepth());
+    push(problem.GetInHeight());
+    push(problem.GetInWidth());
+    push(problem.GetWeightsDepth());
+    push(problem.GetWeightsHeight());
+    push(problem.GetWeightsWidth());
+    push(problem.GetOutChannels());
+    push(problem.GetOutDepth());
+    push(problem.GetOutHeight());
+    push(problem.GetOutWidth());
+    push(problem.GetInBatchSize());
+    pack(problem.GetInLayout());
+    pack(problem.GetWeightsLayout());
+    pack(problem.GetOutLayout());
+    push(problem.GetInDataType());
+    push(problem.GetWeightsDataType());
+    push(problem.GetOutDataType());
+    push(problem.GetPadD());
+    push(problem.GetPadH());
+    push(problem.GetPadW());
+    push(problem.GetKernelStrideD());
+    push(problem.GetKernelStrideH());
+    push(problem.GetKernelStrideW());
+    push(problem.GetDilationD());
+    push(problem.GetDilationH());
+    push(problem.GetDilationW());
+    push(problem.GetGroupCount());
+    push(static_cast<std::int64_t>(problem.GetDirection()));
+    push(problem.GetBias());
+    assert(field == fields.end());
+
+    // FNV-1a
+    std::uint64_t value = 14695981039346656037ULL;
+    for(const auto f : fields)
+    {
+        value ^= static_cast<std::uint64_t>(f);
+        value *= 1099511628211ULL;
+    }
+    hash = static_cast<std::size_t>(value);
+}
+
+struct InternedProblemKey::Entry
+{
+    ProblemKey key;
+    std::size_t id;
+    NetworkConfig network_config;
+    std::string db_key;
+};
+
+namespace {
+
+struct ProblemKeyTable
+{
+    std::mutex mutex;
+    std::unordered_map<ProblemKey, std::unique_ptr<InternedProblemKey::Entry>, ProblemKey::Hasher>
+        entries;
+};
+
+ProblemKeyTable& GetProblemKeyTable()
+{
+    static ProblemKeyTable table;
+    return table;
+}
+
+} // namespace
+
+InternedProblemKey InternedProblemKey::Get(const ProblemDescription& problem)
+{
+    const auto key = ProblemKey{problem};
+
+    // Immediate mode calls tend to repeat the same problem on a thread.
+    thread_local const Entry* last = nullptr;
+    if(last != nullptr && last->key == key)
+        return {*last};
+
+    auto& table = GetProblemKeyTable();
+    {
+        const std::lock_guard<std::mutex> lock{table.mutex};
+        const auto it = table.entries.find(key);
+        if(it != table.entries.end())
+        {
+            last = it->second.get();
+            return {*last};
+        }
+    }
+
+    std::string network_config;
+    problem.BuildConfKeyImpl(network_config);
+    std::ostringstream db_key;
+    problem.SerializeImpl(db_key);
+
+    const std::lock_guard<std::mutex> lock{table.mutex};
+    auto& entry = table.entries[key];
+    if(!entry)
+    {
+        const auto id = table.entries.size();
+        entry         = std::make_unique<Entry>(
+            Entry{key, id, NetworkConfig{network_config, id}, db_key.str()});
+    }
+    last = entry.get();
+    return {*last};
+}
+
+std::size_t InternedProblemKey::GetId() const { return entry->id; }
+
+const ProblemKey& InternedProblemKey::GetKey() const { return entry->key; }
+
+const NetworkConfig& InternedProblemKey::GetNetworkConfig() const { return entry->network_config; }
+
+const std::string& InternedProblemKey::GetDbKey() const { return entry->db_key; }
+
+} // namespace conv
+} // namespace miopen
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_cache.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/ramdb.hpp>
+
+#include <chrono>
+#include <mutex>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_DB_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DB_CACHE_VALIDATION_INTERVAL_MS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DB_CACHE_CAPACITY)
+
+namespace miopen {
+
+static std::int64_t GetValidationInterval()
+{
+    static const auto interval =
+        std::chrono::duration_cast<ramdb_clock::duration>(std::chrono::milliseconds{
+            EnvvarValue(MIOPEN_DEBUG_DB_CACHE_VALIDATION_INTERVAL_MS{}.value(), 1000)})
+            .count();
+    return interval;
+}
+
+static std::size_t GetShardCapacity()
+{
+    constexpr auto shards         = RcuMap<std::string, DbCache*>::shard_count;
+    static const std::size_t size = EnvvarValue(MIOPEN_DEBUG_DB_CACHE_CAPACITY{}.value(), 16384);
+    return (size + shards - 1) / shards;
+}
+
+static bool IsCacheDisabled()
+{
+    static const auto disabled = IsEnabled(MIOPEN_DEBUG_DISABLE_DB_CACHE{});
+    return disabled;
+}
+
+/// Returns the value under the key, or inserts the one made by create().
+/// Values are never removed, so they may be kept by the caller.
+template <class TValue, class TCreate>
+static TValue GetOrCreate(RcuMap<std::string, TValue>& map,
+                          std::mutex& mutex,
+                          const std::string& key,
+                          TCreate&& create)
+{
+    auto ret = TValue{};
+
+    if(map.Visit(key, [&](TValue value) { return (ret = value) != nullptr; }))
+        return ret;
+
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    if(map.Visit(key, [&](TValue value) { return (ret = value) != nullptr; }))
+        return ret;
+
+    ret = create();
+    map.Insert(key, ret);
+    return ret;
+}
+
+DbCache::DbCache(const std::string& user_path_)
+    : user_path(user_path_),
+      local_writes(GetLocalWrites(user_path)),
+      entries(GetShardCapacity()),
+      user_db_time(RamDb::GetDbModificationTime(user_path).time_since_epoch().count())
+{
+}
+
+DbCache*
+DbCache::GetCached(const std::string& installed_path, const std::string& user_path, bool merge)
+{
+    if(IsCacheDisabled())
+        return nullptr;
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static RcuMap<std::string, DbCache*> instances;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+
+    // Like RamDb instances, these are never deleted: there are only a few of them per process.
+    const auto key = installed_path + (merge ? "\n+" : "\n-") + user_path;
+    return GetOrCreate(instances, mutex, key, [&]() { return new DbCache{user_path}; });
+}
+
+std::atomic<std::uint64_t>* DbCache::GetLocalWrites(const std::string& user_path)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static RcuMap<std::string, std::atomic<std::uint64_t>*> writes;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+
+    // Shared by all caches over the user db, never deleted either.
+    return GetOrCreate(
+        writes, mutex, user_path, []() { return new std::atomic<std::uint64_t>{0}; });
+}
+
+void DbCache::Invalidate(const std::string& user_path)
+{
+    if(!IsCacheDisabled())
+        GetLocalWrites(user_path)->fetch_add(1);
+}
+
+std::uint64_t DbCache::GetStamp()
+{
+    const auto now  = ramdb_clock::now().time_since_epoch().count();
+    auto next_check = next_validation.load();
+
+    // Only a reader that wins the race checks the time file, the rest go on with the cache.
+    if(now >= next_check &&
+       next_validation.compare_exchange_strong(next_check, now + GetValidationInterval()))
+    {
+        const auto time = RamDb::GetDbModificationTime(user_path).time_since_epoch().count();
+        if(user_db_time.exchange(time) != time)
+        {
+            MIOPEN_LOG_I2("Db has been modified, dropping cached records: " << user_path);
+            external_writes.fetch_add(1);
+        }
+    }
+
+    return local_writes->load() + external_writes.load();
+}
+
+} // namespace miopen
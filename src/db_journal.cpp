@@ -0,0 +1,447 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_journal.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <unordered_map>
+
+#include <signal.h>
+#include <unistd.h>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DB_JOURNAL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DB_JOURNAL_FLUSH_INTERVAL_MS)
+
+namespace miopen {
+
+// Number of pending ops which wakes the flushing thread up before the interval has passed.
+constexpr std::size_t JournalBatchSize = 1024;
+
+static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+
+static std::chrono::milliseconds GetFlushInterval()
+{
+    return std::chrono::milliseconds{Value(MIOPEN_DEBUG_DB_JOURNAL_FLUSH_INTERVAL_MS{}, 1000)};
+}
+
+namespace {
+
+struct JournalRegistry
+{
+    std::mutex mutex;
+    std::vector<DbJournal*> journals;
+
+    ~JournalRegistry()
+    {
+        // Journals of the leaked RamDb instances are never destroyed, so pending ops are
+        // applied here at exit. This object is created after any LockFile the journals use.
+        const std::lock_guard<std::mutex> lock{mutex};
+        for(auto journal : journals)
+            journal->Shutdown();
+    }
+};
+
+} // namespace
+
+static JournalRegistry& GetRegistry()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static JournalRegistry registry;
+    return registry;
+}
+
+void DbJournal::Op::Apply(boost::optional<DbRecord>& record) const
+{
+    switch(kind)
+    {
+    case Store:
+    case Update: {
+        auto new_record = DbRecord{key};
+        if(!payload.empty() && !new_record.ParseContents(payload))
+        {
+            MIOPEN_LOG_E("Error parsing journaled payload under the key: " << key);
+            return;
+        }
+        if(kind == Update && record)
+            new_record.Merge(*record);
+        if(new_record.GetSize() == 0)
+            record = boost::none;
+        else
+            record = std::move(new_record);
+        break;
+    }
+    case Remove: record = boost::none; break;
+    case RemoveId:
+        if(record && record->EraseValues(payload) && record->GetSize() == 0)
+            record = boost::none;
+        break;
+    }
+}
+
+DbJournal::Op DbJournal::Op::From(Kind kind, const DbRecord& record)
+{
+    auto ss = std::ostringstream{};
+    record.WriteIdsAndValues(ss);
+    auto payload = ss.str();
+    if(!payload.empty() && payload.back() == '\n')
+        payload.pop_back();
+    return {kind, record.GetKey(), std::move(payload)};
+}
+
+DbJournal::DbJournal(const std::string& db_path_,
+                     LockFile& lock_file_,
+                     std::function<void(bool)> on_flush_)
+    : db_path(db_path_), lock_file(lock_file_), on_flush(std::move(on_flush_))
+{
+}
+
+DbJournal::~DbJournal()
+{
+    Shutdown();
+
+    if(!worker_started)
+        return;
+
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.journals.erase(std::remove(registry.journals.begin(), registry.journals.end(), this),
+                            registry.journals.end());
+}
+
+bool DbJournal::IsEnabled()
+{
+    return !DisableUserDbFileIO && miopen::IsEnabled(MIOPEN_DEBUG_DB_JOURNAL{});
+}
+
+std::string DbJournal::GetLogPath(const std::string& db_path, int pid)
+{
+    return db_path + ".journal." + std::to_string(pid);
+}
+
+void DbJournal::FlushAll()
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+    for(auto journal : registry.journals)
+        journal->Flush();
+}
+
+static void ReadLog(const std::string& path, std::vector<DbJournal::Op>& ops)
+{
+    auto file   = std::ifstream{path};
+    auto line   = std::string{};
+    auto n_line = 0;
+
+    while(std::getline(file, line))
+    {
+        ++n_line;
+        const auto key_size = line.find('=', 1);
+
+        if(line.size() < 2 || key_size == std::string::npos || key_size == 1)
+        {
+            MIOPEN_LOG_E("Ill-formed journal entry: " << path << "#" << n_line);
+            continue;
+        }
+
+        ops.push_back({static_cast<DbJournal::Op::Kind>(line[0]),
+                       line.substr(1, key_size - 1),
+                       line.substr(key_size + 1)});
+    }
+}
+
+static bool IsDeadProcess(int pid)
+{
+    return pid > 0 && pid != static_cast<int>(::getpid()) && ::kill(pid, 0) != 0 &&
+           errno != EPERM;
+}
+
+void DbJournal::OpenLogUnsafe()
+{
+    const auto pid      = static_cast<int>(::getpid());
+    const auto log_path = GetLogPath(db_path, pid);
+
+    // A log with our pid can only be left by a dead process, and no other one touches it now.
+    ReadLog(log_path, replayed);
+
+    const auto db_file = boost::filesystem::path(db_path);
+    const auto prefix  = db_file.filename().string() + ".journal.";
+    auto ec            = boost::system::error_code{};
+
+    // Logs of other dead processes are only read when flushing: another process may replay
+    // them meanwhile, and its newer writes must not be overwritten by the stale ops.
+    for(auto it = boost::filesystem::directory_iterator{db_file.parent_path(), ec};
+        !ec && it != boost::filesystem::directory_iterator{};
+        it.increment(ec))
+    {
+        const auto name = it->path().filename().string();
+        if(name.compare(0, prefix.size(), prefix) != 0)
+            continue;
+        if(IsDeadProcess(std::atoi(name.c_str() + prefix.size())))
+            dead_logs.push_back(it->path().string());
+    }
+
+    log.open(log_path, std::ios::app);
+    if(!log)
+        MIOPEN_LOG_W("Journal file is unwritable: " << log_path);
+    else
+        boost::filesystem::permissions(log_path, boost::filesystem::all_all, ec);
+    pending_count += replayed.size() + dead_logs.size();
+}
+
+void DbJournal::AppendUnsafe(Op op)
+{
+    if(!log.is_open())
+        OpenLogUnsafe();
+
+    log << static_cast<char>(op.kind) << op.key << '=' << op.payload << '\n';
+    log.flush();
+    pending.emplace_back(std::move(op));
+    const auto count = ++pending_count;
+
+    if(!worker_started)
+    {
+        {
+            auto& registry = GetRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            registry.journals.push_back(this);
+        }
+        worker         = std::thread{[this]() { Run(); }};
+        worker_started = true;
+    }
+
+    if(count >= JournalBatchSize)
+    {
+        const std::lock_guard<std::mutex> lock{wake_mutex};
+        flush_requested = true;
+        wake.notify_one();
+    }
+}
+
+bool DbJournal::ApplyOps(const std::string& path, const std::vector<Op>& ops)
+{
+    auto records = std::unordered_map<std::string, boost::optional<DbRecord>>{};
+    auto added   = std::vector<std::string>{};
+
+    for(const auto& op : ops)
+        if(records.emplace(op.key, boost::none).second)
+            added.push_back(op.key);
+
+    const auto get_key = [](const std::string& line) {
+        const auto key_size = line.find('=');
+        return key_size == std::string::npos ? std::string{} : line.substr(0, key_size);
+    };
+
+    auto lines = std::vector<std::string>{};
+    {
+        auto from = std::ifstream{path};
+        auto line = std::string{};
+
+        while(std::getline(from, line))
+        {
+            if(line.empty())
+                continue;
+
+            const auto it = records.find(get_key(line));
+            if(it != records.end())
+            {
+                auto record = DbRecord{it->first};
+                if(record.ParseContents(line.substr(it->first.size() + 1)))
+                    it->second = std::move(record);
+                else
+                    MIOPEN_LOG_E("Error parsing payload under the key: " << it->first
+                                                                         << " form file " << path);
+            }
+            lines.emplace_back(std::move(line));
+        }
+    }
+
+    for(const auto& op : ops)
+        op.Apply(records.find(op.key)->second);
+
+    const auto temp_path = path + ".temp";
+    {
+        auto to = std::ofstream{temp_path};
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_path);
+            return false;
+        }
+
+        for(const auto& line : lines)
+        {
+            const auto it = records.find(get_key(line));
+            if(it == records.end())
+            {
+                to << line << '\n';
+                continue;
+            }
+            if(it->second)
+                it->second->WriteContents(to);
+            // Written in place, so it shall not be appended below.
+            records.erase(it);
+        }
+
+        for(const auto& key : added)
+        {
+            const auto it = records.find(key);
+            if(it != records.end() && it->second)
+                it->second->WriteContents(to);
+        }
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_path);
+            return false;
+        }
+    }
+
+    auto ec = boost::system::error_code{};
+    boost::filesystem::rename(temp_path, path, ec);
+    if(ec)
+    {
+        MIOPEN_LOG_E("Unable to replace " << path << ": " << ec.message());
+        return false;
+    }
+    boost::filesystem::permissions(path, boost::filesystem::all_all, ec);
+    return true;
+}
+
+bool DbJournal::Flush()
+{
+    if(pending_count == 0)
+        return true;
+
+    const auto lock = std::unique_lock<LockFile>(lock_file, GetLockTimeout());
+    if(!lock)
+    {
+        MIOPEN_LOG_W("Db lock has failed to lock, journal flush is postponed: " << db_path);
+        return false;
+    }
+    return FlushUnsafe();
+}
+
+bool DbJournal::FlushUnsafe()
+{
+    if(pending.empty() && replayed.empty() && dead_logs.empty())
+        return true;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto ops         = replayed;
+    auto read_logs   = std::vector<std::string>{};
+
+    for(const auto& path : dead_logs)
+    {
+        // The log may have been replayed by another process, or its pid reused since.
+        const auto name = boost::filesystem::path(path).filename().string();
+        const auto pid  = std::atoi(name.c_str() + name.rfind('.') + 1);
+        if(!boost::filesystem::exists(path) || !IsDeadProcess(pid))
+            continue;
+
+        MIOPEN_LOG_I("Replaying db journal of a dead process: " << path);
+        ReadLog(path, ops);
+        read_logs.push_back(path);
+    }
+
+    const auto complete = ops.empty();
+    ops.insert(ops.end(), pending.begin(), pending.end());
+
+    if(!ApplyOps(db_path, ops))
+        return false;
+
+    // The log is reopened by the next append, so none is left behind by an idle process.
+    log.close();
+    read_logs.push_back(GetLogPath(db_path, static_cast<int>(::getpid())));
+
+    auto ec = boost::system::error_code{};
+    for(const auto& path : read_logs)
+        boost::filesystem::remove(path, ec);
+
+    pending.clear();
+    replayed.clear();
+    dead_logs.clear();
+    pending_count = 0;
+    on_flush(complete);
+
+    MIOPEN_LOG_I2("Flushed " << ops.size() << " journaled ops to " << db_path << " in "
+                             << std::chrono::duration<float, std::milli>{
+                                    std::chrono::steady_clock::now() - start}
+                                    .count()
+                             << " ms");
+    return true;
+}
+
+void DbJournal::Run()
+{
+    auto lock = std::unique_lock<std::mutex>{wake_mutex};
+
+    while(!stop)
+    {
+        wake.wait_for(lock, GetFlushInterval(), [&]() { return stop || flush_requested; });
+        flush_requested = false;
+        lock.unlock();
+
+        try
+        {
+            Flush();
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_E("Journal flush has failed: " << ex.what());
+        }
+
+        lock.lock();
+    }
+}
+
+void DbJournal::Shutdown()
+{
+    {
+        const std::lock_guard<std::mutex> lock{wake_mutex};
+        stop = true;
+        wake.notify_one();
+    }
+
+    if(worker.joinable())
+        worker.join();
+
+    // The thread may have been stopped before it had a chance to flush.
+    Flush();
+}
+
+} // namespace miopen
@@ -0,0 +1,309 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_merge.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/tuning_checkpoint.hpp>
+
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+
+bool IsCheckpointId(const std::string& id)
+{
+    const auto pos = id.find("_checkpoint");
+    return pos != std::string::npos &&
+           solver::TuningCheckpoint::IsDbId(id, id.substr(0, pos));
+}
+
+} // namespace
+
+DbKind DbMerger::GetKind(const std::string& path)
+{
+    return EndsWith(path, ".fdb.txt") || EndsWith(path, ".ufdb.txt") ? DbKind::Find : DbKind::Perf;
+}
+
+DbMerger::Format DbMerger::GetFormat(const std::string& path)
+{
+    std::ifstream file{path, std::ios::binary};
+    if(!file)
+        MIOPEN_THROW("Cannot open " + path);
+
+    // See https://www.sqlite.org/fileformat.html
+    static const std::string sqlite_header{"SQLite format 3", sizeof("SQLite format 3")};
+    std::string header(sqlite_header.size(), '\0');
+    file.read(&header[0], header.size());
+    return file && header == sqlite_header ? Format::SQLite : Format::Text;
+}
+
+float DbMerger::GetBestTime(const DbRecord& record, const std::string& solver_id)
+{
+    auto best         = std::numeric_limits<float>::max();
+    const auto config = record.map.find(solver_id);
+    if(config == record.map.end())
+        return best;
+
+    for(const auto& pair : record.map)
+    {
+        solver::TuningCheckpoint checkpoint;
+        if(solver::TuningCheckpoint::IsDbId(pair.first, solver_id) &&
+           checkpoint.Deserialize(pair.second) && checkpoint.IsComplete() &&
+           checkpoint.best_config == config->second)
+            best = std::min(best, checkpoint.best_time);
+    }
+    return best;
+}
+
+bool DbMerger::IsBetter(const std::string& id, const DbRecord& self, const DbRecord& that) const
+{
+    const auto& mine   = self.map.at(id);
+    const auto& theirs = that.map.at(id);
+
+    if(kind == DbKind::Find)
+    {
+        FindDbData mine_data;
+        FindDbData theirs_data;
+        if(!theirs_data.Deserialize(theirs))
+            return false;
+        return !mine_data.Deserialize(mine) || theirs_data.time < mine_data.time;
+    }
+
+    if(IsCheckpointId(id))
+    {
+        solver::TuningCheckpoint mine_checkpoint;
+        solver::TuningCheckpoint theirs_checkpoint;
+        if(!theirs_checkpoint.Deserialize(theirs))
+            return false;
+        if(!mine_checkpoint.Deserialize(mine))
+            return true;
+        if(mine_checkpoint.IsComplete() != theirs_checkpoint.IsComplete())
+            return theirs_checkpoint.IsComplete();
+        if(!theirs_checkpoint.IsComplete())
+            return theirs_checkpoint.next > mine_checkpoint.next;
+        return theirs_checkpoint.best_time < mine_checkpoint.best_time;
+    }
+
+    return GetBestTime(that, id) < GetBestTime(self, id);
+}
+
+void DbMerger::Add(const std::string& path)
+{
+    const auto db_format = GetFormat(path);
+    if(format != Format::Unknown && format != db_format)
+        MIOPEN_THROW("Cannot merge text and SQLite dbs: " + path);
+    format = db_format;
+
+    if(format == Format::Text)
+    {
+        AddText(path);
+        return;
+    }
+#if MIOPEN_ENABLE_SQLITE
+    if(kind == DbKind::Perf)
+    {
+        AddSQLite(path);
+        return;
+    }
+#endif
+    MIOPEN_THROW("Unsupported db format: " + path);
+}
+
+void DbMerger::Write(const std::string& path) const
+{
+    if(format != Format::SQLite)
+    {
+        WriteText(path);
+        return;
+    }
+#if MIOPEN_ENABLE_SQLITE
+    WriteSQLite(path);
+#else
+    MIOPEN_THROW("Unsupported db format: " + path);
+#endif
+}
+
+void DbMerger::AddRecord(const DbRecord& record)
+{
+    const auto it = records.find(record.GetKey());
+    if(it == records.end())
+    {
+        records.emplace(record.GetKey(), record);
+        return;
+    }
+
+    it->second.Merge(record, [&](const auto& id, const auto& self, const auto& that) {
+        const auto is_better = IsBetter(id, self, that);
+        if(is_better)
+            ++n_replaced;
+        return is_better;
+    });
+}
+
+void DbMerger::AddText(const std::string& path)
+{
+    std::ifstream file{path};
+    if(!file)
+        MIOPEN_THROW("Cannot open " + path);
+
+    std::string line;
+    auto n_line = 0;
+    while(std::getline(file, line))
+    {
+        ++n_line;
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        DbRecord record{line.substr(0, key_size)};
+        if(key_size == std::string::npos || !record.ParseContents(line.substr(key_size + 1)))
+        {
+            MIOPEN_LOG_E("Ill-formed record, skipped: " << path << ':' << n_line);
+            continue;
+        }
+        AddRecord(record);
+    }
+}
+
+void DbMerger::WriteText(const std::string& path) const
+{
+    std::ofstream file{path};
+    if(!file)
+        MIOPEN_THROW("Cannot open " + path);
+
+    for(const auto& record : records)
+        record.second.WriteContents(file);
+
+    if(!file)
+        MIOPEN_THROW("Cannot write " + path);
+}
+
+#if MIOPEN_ENABLE_SQLITE
+void DbMerger::AddSQLite(const std::string& path)
+{
+    const SQLite sql{path, true};
+    if(!sql.Valid())
+        MIOPEN_THROW("Cannot open " + path);
+
+    // The record keys are made of the columns of the config table, so that the same problem
+    // has the same key in all the dbs.
+    std::map<std::string, std::string> keys;
+    for(const auto& row : sql.Exec("SELECT * FROM config;"))
+    {
+        auto columns = std::map<std::string, std::string>(row.begin(), row.end());
+        const auto config_id = columns.at("id");
+        columns.erase("id");
+
+        std::ostringstream key;
+        for(const auto& column : columns)
+            key << column.first << '=' << column.second << ';';
+        keys.emplace(config_id, key.str());
+        sqlite_configs.emplace(key.str(), columns);
+    }
+
+    std::map<std::string, DbRecord> db_records;
+    for(const auto& row : sql.Exec("SELECT config, solver, params FROM perf_db;"))
+    {
+        const auto key = keys.find(row.at("config"));
+        if(key == keys.end())
+        {
+            MIOPEN_LOG_E("No config " << row.at("config") << " for a perf_db row: " << path);
+            continue;
+        }
+        auto& record = db_records.emplace(key->second, DbRecord{key->second}).first->second;
+        record.map[row.at("solver")] = row.at("params");
+    }
+
+    for(const auto& record : db_records)
+        AddRecord(record.second);
+}
+
+void DbMerger::WriteSQLite(const std::string& path) const
+{
+    boost::filesystem::remove(path);
+    {
+        const SQLitePerfDb tables{path, false}; // Creates the tables.
+    }
+
+    SQLite sql{path, false};
+    if(!sql.Valid())
+        MIOPEN_THROW("Cannot open " + path);
+
+    const auto step = [&](const std::string& query, const std::vector<std::string>& values) {
+        auto stmt = SQLite::Statement{sql, query, values};
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    };
+
+    SQLite::Batch batch{sql};
+    for(const auto& record : records)
+    {
+        const auto& columns = sqlite_configs.at(record.first);
+        std::vector<std::string> names;
+        std::vector<std::string> clauses;
+        std::vector<std::string> values;
+        for(const auto& column : columns)
+        {
+            names.push_back(column.first);
+            clauses.push_back(column.first + " = ?");
+            values.push_back(column.second);
+        }
+
+        step("INSERT OR IGNORE INTO config(" + JoinStrings(names, ", ") + ") VALUES(" +
+                 JoinStrings(std::vector<std::string>(names.size(), "?"), ", ") + ");",
+             values);
+
+        const auto insert = "INSERT OR REPLACE INTO perf_db(config, solver, params) "
+                            "VALUES((SELECT id FROM config WHERE " +
+                            JoinStrings(clauses, " AND ") + "), ?, ?);";
+        for(const auto& pair : record.second.map)
+        {
+            auto row_values = values;
+            row_values.push_back(pair.first);
+            row_values.push_back(pair.second);
+            step(insert, row_values);
+        }
+    }
+    batch.Commit();
+}
+#endif
+
+} // namespace miopen
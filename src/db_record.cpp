@@ -29,6 +29,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <miopen/config.h>
 #include <miopen/db_record.hpp>
@@ -151,4 +152,21 @@ void DbRecord::Merge(const DbRecord& that)
         map[that_pair.first] = that_pair.second;
     }
 }
+
+void DbRecord::Merge(const DbRecord& that, const MergePredicate& is_better)
+{
+    if(key != that.key)
+        return;
+
+    std::vector<std::string> replaced;
+    for(const auto& that_pair : that.map)
+    {
+        if(map.find(that_pair.first) != map.end() && is_better(that_pair.first, *this, that))
+            replaced.push_back(that_pair.first);
+    }
+
+    Merge(that);
+    for(const auto& id : replaced)
+        SetValues(id, that.map.at(id));
+}
 } // namespace miopen
@@ -0,0 +1,708 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/fallback_ranking.hpp>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <ostream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_MODEL)
+
+namespace miopen {
+
+constexpr std::size_t ProblemFeatures::count;
+
+namespace {
+
+/// The problem as seen in its find-db key. Depths are zero for 2D problems.
+struct RawProblem
+{
+    int spatial_dims = 2;
+    std::size_t n    = 0;
+    std::size_t c    = 0;
+    std::size_t k    = 0;
+    std::size_t in[3]{};  // DHW
+    std::size_t out[3]{}; // DHW
+    std::size_t fil[3]{}; // DHW
+    int pad[2]{};         // HW
+    int stride[2]{};      // HW
+    int dilation[2]{};    // HW
+    int group_count = 1;
+    int direction   = 0; // F, B, W
+    int data_type   = 0; // miopenDataType_t of the input
+    int layout      = 0; // Default, channels last, other
+};
+
+float Log2(double value) { return static_cast<float>(std::log2(std::max(value, 1.0))); }
+
+ProblemFeatures MakeFeatures(const RawProblem& p)
+{
+    const auto in_size  = static_cast<double>(p.in[0] > 0 ? p.in[0] : 1) * p.in[1] * p.in[2];
+    const auto out_size = static_cast<double>(p.out[0] > 0 ? p.out[0] : 1) * p.out[1] * p.out[2];
+    const auto fil_size = static_cast<double>(p.fil[0] > 0 ? p.fil[0] : 1) * p.fil[1] * p.fil[2];
+    const auto c_per_group = static_cast<double>(p.c) / std::max(p.group_count, 1);
+
+    auto features = ProblemFeatures{};
+    auto& v       = features.values;
+    v[0]          = static_cast<float>(p.spatial_dims);
+    v[1]          = Log2(p.n);
+    v[2]          = Log2(p.c);
+    v[3]          = Log2(p.k);
+    for(auto i = 0; i < 3; ++i)
+    {
+        v[4 + i]  = Log2(p.in[i]);
+        v[7 + i]  = Log2(p.out[i]);
+        v[10 + i] = static_cast<float>(p.fil[i]);
+    }
+    for(auto i = 0; i < 2; ++i)
+    {
+        v[13 + i] = static_cast<float>(p.pad[i]);
+        v[15 + i] = static_cast<float>(p.stride[i]);
+        v[17 + i] = static_cast<float>(p.dilation[i]);
+    }
+    v[19] = Log2(p.group_count);
+    v[20] = static_cast<float>(p.direction);
+    v[21] = static_cast<float>(p.data_type);
+    v[22] = static_cast<float>(p.layout);
+    v[23] = Log2(2.0 * p.n * p.k * c_per_group * out_size * fil_size);
+    v[24] = Log2(p.n * (p.c * in_size + p.k * out_size) + p.k * c_per_group * fil_size);
+    return features;
+}
+
+int GetLayoutCode(const std::string& layout)
+{
+    if(layout == "NCHW" || layout == "NCDHW")
+        return 0;
+    if(layout == "NHWC" || layout == "NDHWC")
+        return 1;
+    return 2;
+}
+
+bool ParseDataType(const std::string& name, int& data_type)
+{
+    // The key has the names of all three types if they differ, e.g. INT8INT8INT32.
+    auto length = std::size_t{0};
+    for(const auto type : {miopenHalf,
+                           miopenFloat,
+                           miopenInt32,
+                           miopenInt8,
+                           miopenInt8x4,
+                           miopenBFloat16,
+                           miopenDouble})
+    {
+        const auto type_name = GetDataTypeName(type);
+        if(StartsWith(name, type_name) && type_name.size() > length)
+        {
+            data_type = static_cast<int>(type);
+            length    = type_name.size();
+        }
+    }
+    return length > 0;
+}
+
+template <class T>
+bool ParseDims(const std::string& s, std::size_t dims, T* values)
+{
+    const auto items = SplitDelim(s, 'x');
+    if(items.size() != dims)
+        return false;
+    for(auto i = std::size_t{0}; i < dims; ++i)
+        values[i] = static_cast<T>(std::stoll(items[i]));
+    return true;
+}
+
+} // namespace
+
+ProblemFeatures::ProblemFeatures(const conv::ProblemDescription& problem)
+{
+    const auto is_3d = problem.GetSpatialDims() > 2;
+
+    auto p         = RawProblem{};
+    p.spatial_dims = static_cast<int>(problem.GetSpatialDims());
+    p.n            = problem.GetInBatchSize();
+    p.c            = problem.GetInChannels();
+    p.k            = problem.GetOutChannels();
+    p.in[0]        = is_3d ? problem.GetInDepth() : 0;
+    p.in[1]        = problem.GetInHeight();
+    p.in[2]        = problem.GetInWidth();
+    p.out[0]       = is_3d ? problem.GetOutDepth() : 0;
+    p.out[1]       = problem.GetOutHeight();
+    p.out[2]       = problem.GetOutWidth();
+    p.fil[0]       = is_3d ? problem.GetWeightsDepth() : 0;
+    p.fil[1]       = problem.GetWeightsHeight();
+    p.fil[2]       = problem.GetWeightsWidth();
+    p.pad[0]       = problem.GetPadH();
+    p.pad[1]       = problem.GetPadW();
+    p.stride[0]    = problem.GetKernelStrideH();
+    p.stride[1]    = problem.GetKernelStrideW();
+    p.dilation[0]  = problem.GetDilationH();
+    p.dilation[1]  = problem.GetDilationW();
+    p.group_count  = problem.GetGroupCount();
+    p.data_type    = static_cast<int>(problem.GetInDataType());
+    p.layout       = GetLayoutCode(problem.GetInLayout());
+
+    switch(problem.GetDirection())
+    {
+    case conv::Direction::Forward: p.direction = 0; break;
+    case conv::Direction::BackwardData: p.direction = 1; break;
+    case conv::Direction::BackwardWeights: p.direction = 2; break;
+    }
+
+    *this = MakeFeatures(p);
+}
+
+bool ProblemFeatures::Parse(const std::string& db_key, ProblemFeatures& features)
+{
+    auto p           = RawProblem{};
+    const auto split = db_key.find('_');
+    if(split != std::string::npos)
+    {
+        const auto optional = db_key.substr(split + 1);
+        if(!StartsWith(optional, "g"))
+            return false;
+        p.group_count = std::atoi(optional.c_str() + 1);
+        if(p.group_count < 1)
+            return false;
+    }
+
+    const auto items = SplitDelim(db_key.substr(0, split), '-');
+    // c-[d-]h-w-fil-k-[d-]h-w-n-pad-stride-dilation-bias-layout[-layout-layout]-type-direction
+    if(items.size() < 15)
+        return false;
+    if(items[3].find('x') != std::string::npos)
+        p.spatial_dims = 2;
+    else if(items[4].find('x') != std::string::npos)
+        p.spatial_dims = 3;
+    else
+        return false;
+
+    const auto dims    = static_cast<std::size_t>(p.spatial_dims);
+    const auto offset  = 3 - dims; // Index of the first used of DHW.
+    const auto n_fixed = 8 + 2 * dims;
+    if(items.size() != n_fixed + 3 && items.size() != n_fixed + 5)
+        return false;
+
+    try
+    {
+        auto i = std::size_t{0};
+        p.c    = std::stoull(items[i++]);
+        for(auto d = offset; d < 3; ++d)
+            p.in[d] = std::stoull(items[i++]);
+        if(!ParseDims(items[i++], dims, p.fil + offset))
+            return false;
+        p.k = std::stoull(items[i++]);
+        for(auto d = offset; d < 3; ++d)
+            p.out[d] = std::stoull(items[i++]);
+        p.n = std::stoull(items[i++]);
+
+        // Only the H and W of the pads, strides and dilations are used.
+        int pad[3]{}, stride[3]{}, dilation[3]{};
+        if(!ParseDims(items[i++], dims, pad) || !ParseDims(items[i++], dims, stride) ||
+           !ParseDims(items[i++], dims, dilation))
+            return false;
+        std::copy(pad + dims - 2, pad + dims, p.pad);
+        std::copy(stride + dims - 2, stride + dims, p.stride);
+        std::copy(dilation + dims - 2, dilation + dims, p.dilation);
+        ++i; // Bias.
+        p.layout = GetLayoutCode(items[i]);
+    }
+    catch(const std::exception&)
+    {
+        return false;
+    }
+
+    if(!ParseDataType(items[items.size() - 2], p.data_type))
+        return false;
+
+    const auto& direction = items.back();
+    if(direction == "F")
+        p.direction = 0;
+    else if(direction == "B")
+        p.direction = 1;
+    else if(direction == "W")
+        p.direction = 2;
+    else
+        return false;
+
+    features = MakeFeatures(p);
+    return true;
+}
+
+const char* ProblemFeatures::GetName(std::size_t index)
+{
+    static const char* const names[] = {
+        "spatial_dims", "log2_n",     "log2_c",        "log2_k",         "log2_in_d",
+        "log2_in_h",    "log2_in_w",  "log2_out_d",    "log2_out_h",     "log2_out_w",
+        "fil_d",        "fil_h",      "fil_w",         "pad_h",          "pad_w",
+        "stride_h",     "stride_w",   "dilation_h",    "dilation_w",     "log2_group_count",
+        "direction",    "data_type",  "layout",        "log2_flops",     "log2_elements",
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == count, "");
+    if(index >= count)
+        MIOPEN_THROW(miopenStatusInternalError);
+    return names[index];
+}
+
+std::vector<float> ProblemFeatures::GetKind() const
+{
+    auto kind = std::vector<float>{values[0]};
+    kind.insert(kind.end(), values.begin() + 10, values.begin() + 23);
+    return kind;
+}
+
+float ProblemFeatures::GetSizeDistance(const ProblemFeatures& other) const
+{
+    auto distance = 0.0f;
+    for(auto i = 1; i < 10; ++i)
+    {
+        const auto weight = (i == 2 || i == 3) ? 2.0f : 1.0f;
+        distance += weight * std::pow(values[i] - other.values[i], 2.0f);
+    }
+    return std::sqrt(distance);
+}
+
+float ProblemFeatures::GetLog2Flops() const { return values[23]; }
+
+std::vector<FallbackRecord> ReadFallbackRecords(const std::string& find_db_path)
+{
+    std::ifstream file{find_db_path};
+    if(!file)
+        MIOPEN_THROW("Cannot open " + find_db_path);
+
+    auto records = std::vector<FallbackRecord>{};
+    auto line    = std::string{};
+    auto n_line  = 0;
+    while(std::getline(file, line))
+    {
+        ++n_line;
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos)
+            continue;
+
+        auto record = FallbackRecord{};
+        record.key  = line.substr(0, key_size);
+        if(!ProblemFeatures::Parse(record.key, record.features))
+        {
+            MIOPEN_LOG_W(find_db_path << ":" << n_line << ": unsupported key: " << record.key);
+            continue;
+        }
+
+        for(const auto& pair : SplitDelim(line.substr(key_size + 1), ';'))
+        {
+            const auto id_size = pair.find(':');
+            auto data          = FindDbData{};
+            if(id_size == std::string::npos || !data.Deserialize(pair.substr(id_size + 1)))
+            {
+                MIOPEN_LOG_W(find_db_path << ":" << n_line << ": malformed values: " << pair);
+                continue;
+            }
+            if(data.time > 0.0f)
+                record.times.emplace_back(data.solver_id, data.time);
+        }
+
+        if(!record.times.empty())
+            records.emplace_back(std::move(record));
+    }
+    return records;
+}
+
+float FallbackRanking::Tree::Predict(const ProblemFeatures& features) const
+{
+    auto i = 0;
+    while(nodes[i].feature >= 0)
+    {
+        const auto& node = nodes[i];
+        i = features.values[node.feature] <= node.threshold ? node.left : node.right;
+    }
+    return nodes[i].value;
+}
+
+float FallbackRanking::SolverModel::Predict(const ProblemFeatures& features) const
+{
+    auto log2_time = base;
+    for(const auto& tree : trees)
+        log2_time += tree.Predict(features);
+    return log2_time;
+}
+
+boost::optional<float> FallbackRanking::Estimate(const std::string& solver_id,
+                                                 const ProblemFeatures& features) const
+{
+    const auto it = solvers.find(solver_id);
+    if(it == solvers.end())
+        return boost::none;
+    return std::exp2(it->second.Predict(features));
+}
+
+namespace {
+
+struct Sample
+{
+    const ProblemFeatures* features;
+    float residual;
+};
+
+struct Split
+{
+    int feature     = -1;
+    float threshold = 0.0f;
+    double gain     = 0.0;
+};
+
+/// Finds the split of the samples reducing the squared error of the residuals the most.
+Split FindSplit(const std::vector<Sample>& samples,
+                const std::vector<std::size_t>& indices,
+                std::size_t min_leaf_size)
+{
+    const auto n = indices.size();
+    auto total   = 0.0;
+    for(const auto i : indices)
+        total += samples[i].residual;
+
+    auto best   = Split{};
+    auto sorted = indices;
+    for(auto f = std::size_t{0}; f < ProblemFeatures::count; ++f)
+    {
+        const auto value = [&](std::size_t i) { return samples[i].features->values[f]; };
+        std::sort(
+            sorted.begin(), sorted.end(), [&](auto l, auto r) { return value(l) < value(r); });
+
+        auto left = 0.0;
+        for(auto j = std::size_t{1}; j < n; ++j)
+        {
+            left += samples[sorted[j - 1]].residual;
+            if(j < min_leaf_size || n - j < min_leaf_size)
+                continue;
+            const auto lower = value(sorted[j - 1]);
+            const auto upper = value(sorted[j]);
+            if(lower == upper) // NOLINT (clang-diagnostic-float-equal)
+                continue;
+
+            const auto right = total - left;
+            const auto gain  = left * left / j + right * right / (n - j) - total * total / n;
+            if(gain > best.gain + 1e-9)
+            {
+                best.feature   = static_cast<int>(f);
+                best.threshold = lower + (upper - lower) / 2;
+                best.gain      = gain;
+            }
+        }
+    }
+    return best;
+}
+
+int Grow(FallbackRanking::Tree& tree,
+         const std::vector<Sample>& samples,
+         const std::vector<std::size_t>& indices,
+         std::size_t depth,
+         const FallbackTrainingOptions& options)
+{
+    const auto node = static_cast<int>(tree.nodes.size());
+    tree.nodes.emplace_back();
+
+    const auto split =
+        depth < options.depth ? FindSplit(samples, indices, options.min_leaf_size) : Split{};
+    if(split.feature < 0)
+    {
+        auto sum = 0.0;
+        for(const auto i : indices)
+            sum += samples[i].residual;
+        tree.nodes[node].value = static_cast<float>(options.learning_rate * sum / indices.size());
+        return node;
+    }
+
+    auto left  = std::vector<std::size_t>{};
+    auto right = std::vector<std::size_t>{};
+    for(const auto i : indices)
+    {
+        if(samples[i].features->values[split.feature] <= split.threshold)
+            left.push_back(i);
+        else
+            right.push_back(i);
+    }
+
+    tree.nodes[node].feature   = split.feature;
+    tree.nodes[node].threshold = split.threshold;
+    const auto left_node       = Grow(tree, samples, left, depth + 1, options);
+    tree.nodes[node].left      = left_node;
+    const auto right_node      = Grow(tree, samples, right, depth + 1, options);
+    tree.nodes[node].right     = right_node;
+    return node;
+}
+
+} // namespace
+
+FallbackRanking FallbackRanking::Train(const std::vector<FallbackRecord>& records,
+                                       const FallbackTrainingOptions& options)
+{
+    auto samples = std::map<std::string, std::vector<Sample>>{};
+    for(const auto& record : records)
+        for(const auto& time : record.times)
+            samples[time.first].push_back({&record.features, std::log2(time.second)});
+
+    auto ranking = FallbackRanking{};
+    for(auto& solver : samples)
+    {
+        auto& solver_samples = solver.second;
+        if(solver_samples.size() < std::max<std::size_t>(options.min_solver_records, 1))
+            continue;
+
+        auto model = SolverModel{};
+        model.base = std::accumulate(solver_samples.begin(),
+                                     solver_samples.end(),
+                                     0.0f,
+                                     [](auto sum, const auto& s) { return sum + s.residual; }) /
+                     solver_samples.size();
+        for(auto& sample : solver_samples)
+            sample.residual -= model.base;
+
+        auto indices = std::vector<std::size_t>(solver_samples.size());
+        std::iota(indices.begin(), indices.end(), 0);
+
+        for(auto t = std::size_t{0}; t < options.trees; ++t)
+        {
+            auto tree = Tree{};
+            Grow(tree, solver_samples, indices, 0, options);
+            for(auto& sample : solver_samples)
+                sample.residual -= tree.Predict(*sample.features);
+            model.trees.emplace_back(std::move(tree));
+        }
+
+        MIOPEN_LOG_I2(solver.first << ": " << solver_samples.size() << " records");
+        ranking.solvers.emplace(solver.first, std::move(model));
+    }
+    return ranking;
+}
+
+FallbackReport FallbackRanking::Evaluate(const std::vector<FallbackRecord>& records) const
+{
+    auto report        = FallbackReport{};
+    auto log2_slowdown = 0.0;
+    auto squared_error = 0.0;
+    auto n_estimated   = std::size_t{0};
+
+    for(const auto& record : records)
+    {
+        auto best_time  = std::numeric_limits<float>::max();
+        auto first_time = 0.0f;
+        auto first_rank = std::numeric_limits<float>::max();
+        auto n_known    = 0;
+
+        for(const auto& time : record.times)
+        {
+            const auto it = solvers.find(time.first);
+            if(it == solvers.end())
+                continue;
+
+            const auto log2_estimate = it->second.Predict(record.features);
+            squared_error += std::pow(log2_estimate - std::log2(time.second), 2);
+            ++n_estimated;
+            ++n_known;
+
+            best_time = std::min(best_time, time.second);
+            if(log2_estimate < first_rank)
+            {
+                first_rank = log2_estimate;
+                first_time = time.second;
+            }
+        }
+
+        if(n_known < 2)
+            continue;
+        ++report.records;
+        if(first_time <= best_time)
+            ++report.top1;
+        log2_slowdown += std::log2(first_time / best_time);
+    }
+
+    if(report.records > 0)
+        report.mean_slowdown = static_cast<float>(std::exp2(log2_slowdown / report.records));
+    if(n_estimated > 0)
+        report.rms_log2_error = static_cast<float>(std::sqrt(squared_error / n_estimated));
+    return report;
+}
+
+std::ostream& operator<<(std::ostream& os, const FallbackReport& report)
+{
+    os << "records: " << report.records << ", top-1: " << report.top1;
+    if(report.records > 0)
+        os << " (" << 100.0f * report.top1 / report.records << "%)";
+    return os << ", mean slowdown: " << report.mean_slowdown
+              << ", rms log2 error: " << report.rms_log2_error;
+}
+
+namespace {
+const char* const file_magic = "MIOpenFallbackRanking";
+const int file_version       = 1;
+} // namespace
+
+void FallbackRanking::Write(std::ostream& stream) const
+{
+    stream.precision(std::numeric_limits<float>::max_digits10);
+    stream << file_magic << ' ' << file_version << ' ' << ProblemFeatures::count << '\n';
+    for(const auto& solver : solvers)
+    {
+        stream << "solver " << solver.first << ' ' << solver.second.base << ' '
+               << solver.second.trees.size() << '\n';
+        for(const auto& tree : solver.second.trees)
+        {
+            stream << "tree " << tree.nodes.size() << '\n';
+            for(const auto& node : tree.nodes)
+                stream << node.feature << ' ' << node.threshold << ' ' << node.left << ' '
+                       << node.right << ' ' << node.value << '\n';
+        }
+    }
+}
+
+FallbackRanking FallbackRanking::Read(std::istream& stream)
+{
+    // Far above any trained model, and keeps the node indices within int.
+    constexpr std::size_t max_count = 1 << 20;
+
+    const auto expect = [&](bool condition, const std::string& what) {
+        if(!condition || !stream)
+            MIOPEN_THROW("Malformed fallback ranking model: " + what);
+    };
+
+    auto magic         = std::string{};
+    auto version       = 0;
+    auto feature_count = std::size_t{0};
+    stream >> magic >> version >> feature_count;
+    expect(magic == file_magic, "header");
+    expect(version == file_version, "version " + std::to_string(version));
+    expect(feature_count == ProblemFeatures::count, "features " + std::to_string(feature_count));
+
+    auto ranking = FallbackRanking{};
+    auto tag     = std::string{};
+    while(stream >> tag)
+    {
+        expect(tag == "solver", tag);
+        auto id      = std::string{};
+        auto model   = SolverModel{};
+        auto n_trees = std::size_t{0};
+        stream >> id >> model.base >> n_trees;
+        expect(!id.empty(), "solver");
+
+        expect(n_trees <= max_count, id + " trees " + std::to_string(n_trees));
+
+        // The counts are not trusted to allocate ahead: a truncated file ends at the stream end.
+        for(auto t = std::size_t{0}; t < n_trees; ++t)
+        {
+            auto n_nodes = std::size_t{0};
+            stream >> tag >> n_nodes;
+            expect(tag == "tree" && n_nodes > 0 && n_nodes <= max_count, id + " tree");
+            auto tree = Tree{};
+            for(auto i = std::size_t{0}; i < n_nodes; ++i)
+            {
+                auto node = Node{};
+                stream >> node.feature >> node.threshold >> node.left >> node.right >> node.value;
+                // Children after the parent make the trees finite.
+                const auto is_child = [&](int child) {
+                    return child > static_cast<int>(i) && child < static_cast<int>(n_nodes);
+                };
+                expect(node.feature < 0 ||
+                           (node.feature < static_cast<int>(ProblemFeatures::count) &&
+                            is_child(node.left) && is_child(node.right)),
+                       id + " node " + std::to_string(i));
+                tree.nodes.push_back(node);
+            }
+            model.trees.emplace_back(std::move(tree));
+        }
+        ranking.solvers.emplace(id, std::move(model));
+    }
+    return ranking;
+}
+
+FallbackRanking FallbackRanking::Load(const std::string& path)
+{
+    std::ifstream file{path};
+    if(!file)
+        MIOPEN_THROW("Cannot open " + path);
+    return Read(file);
+}
+
+std::string FallbackRanking::GetInstalledPath(Handle& handle)
+{
+    const auto file_name = handle.GetDbBasename() + "." + GetSystemFindDbSuffix() + ".fbr.txt";
+    return (boost::filesystem::path(GetSystemDbPath()) / file_name).string();
+}
+
+const FallbackRanking& FallbackRanking::GetInstalled(Handle& handle)
+{
+    static const auto empty = FallbackRanking{};
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_MODEL{}))
+        return empty;
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::map<std::string, FallbackRanking>{};
+    const auto path       = GetInstalledPath(handle);
+    const auto it         = instances.find(path);
+    if(it != instances.end())
+        return it->second;
+
+    auto ranking = FallbackRanking{};
+    if(boost::filesystem::exists(path))
+    {
+        try
+        {
+            ranking = Load(path);
+            MIOPEN_LOG_I2("Loaded fallback ranking of " << ranking.GetSolverCount()
+                                                        << " solvers: " << path);
+        }
+        catch(const std::exception& ex)
+        {
+            // Including bad_alloc, so that a broken model never breaks the immediate mode.
+            MIOPEN_LOG_W(ex.what() << ", the fallback uses WTI");
+        }
+    }
+    else
+    {
+        MIOPEN_LOG_I2("No fallback ranking: " << path);
+    }
+    return instances.emplace(path, std::move(ranking)).first->second;
+}
+
+} // namespace miopen
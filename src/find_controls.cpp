@@ -30,18 +30,23 @@
 #include <miopen/miopen_internal.h>
 #include <miopen/logger.hpp>
 #include <miopen/env.hpp>
+#include <miopen/errors.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/stringutils.hpp>
 
 #include <boost/optional.hpp>
 
 #include <ostream>
+#include <sstream>
 #include <cstdlib>
 #include <cstring>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_ENFORCE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FIND_ONLY_SOLVER)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_MODE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_BUDGET_SECONDS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_BUDGET_EVALUATIONS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_SHARD)
 
 namespace miopen {
 
@@ -169,6 +174,7 @@ const char* ToCString(const FindMode::Values mode)
     case FindMode::Values::Hybrid: return "HYBRID";
     case FindMode::Values::DeprecatedFastHybrid: break;
     case FindMode::Values::DynamicHybrid: return "DYNAMIC_HYBRID";
+    case FindMode::Values::Background: return "BACKGROUND";
     case FindMode::Values::End_: break;
     }
     return "<Unknown>";
@@ -195,6 +201,8 @@ FindMode::Values GetFindModeValueImpl2()
         return FindMode::Values::Hybrid;
     else if(str == "DYNAMIC_HYBRID")
         return FindMode::Values::DynamicHybrid;
+    else if(str == "BACKGROUND")
+        return FindMode::Values::Background;
     else
     { // Nop. Fall down & try numerics.
     }
@@ -235,5 +243,68 @@ static_assert(miopenConvolutionFindModeHybrid ==
 static_assert(miopenConvolutionFindModeDynamicHybrid ==
                   static_cast<miopenConvolutionFindMode_t>(FindMode::Values::DynamicHybrid),
               "API is not in sync with the implementation.");
+static_assert(miopenConvolutionFindModeBackground ==
+                  static_cast<miopenConvolutionFindMode_t>(FindMode::Values::Background),
+              "API is not in sync with the implementation.");
+
+TuningBudget::TuningBudget()
+    : seconds(static_cast<float>(Value(MIOPEN_TUNING_BUDGET_SECONDS{}))),
+      evaluations(Value(MIOPEN_TUNING_BUDGET_EVALUATIONS{}))
+{
+}
+
+std::ostream& operator<<(std::ostream& os, const TuningBudget& obj)
+{
+    if(!obj.IsLimited())
+        return os << "unlimited";
+    if(obj.seconds > 0.0f)
+        os << obj.seconds << " sec";
+    if(obj.seconds > 0.0f && obj.evaluations > 0)
+        os << ", ";
+    if(obj.evaluations > 0)
+        os << obj.evaluations << " evaluations";
+    return os;
+}
+
+namespace {
+
+TuningShard GetTuningShardImpl()
+{
+    const char* const p_asciz = miopen::GetStringEnv(MIOPEN_TUNING_SHARD{});
+    if(p_asciz == nullptr || std::strlen(p_asciz) == 0)
+        return {0, 1};
+
+    std::istringstream ss{p_asciz};
+    std::size_t index = 0;
+    std::size_t count = 0;
+    char slash        = 0;
+    ss >> index >> slash >> count;
+    if(ss.fail() || !ss.eof() || slash != '/' || index >= count)
+    {
+        MIOPEN_LOG_NQE("Wrong MIOPEN_TUNING_SHARD, expected k/N with 0 <= k < N: " << p_asciz);
+        return {0, 1};
+    }
+    return {index, count};
+}
+
+} // namespace
+
+TuningShard::TuningShard()
+{
+    static const TuningShard shard = GetTuningShardImpl();
+    *this                          = shard;
+}
+
+TuningShard::TuningShard(std::size_t index_, std::size_t count_) : index(index_), count(count_)
+{
+    if(count == 0 || index >= count)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Wrong tuning shard: " + std::to_string(index) + '/' + std::to_string(count));
+}
+
+std::ostream& operator<<(std::ostream& os, const TuningShard& obj)
+{
+    return os << obj.index << '/' << obj.count;
+}
 
 } // namespace miopen
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/find_db_index.hpp>
+
+#include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/readonlyramdb.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace miopen {
+
+bool FindDbIndex::Add(const DbRecord& record)
+{
+    auto entry = Entry{};
+    entry.key  = record.GetKey();
+    if(!ProblemFeatures::Parse(entry.key, entry.features))
+        return false;
+
+    for(const auto& pair : record.As<FindDbData>())
+        entry.values.emplace_back(pair.first, pair.second);
+
+    kinds[entry.features.GetKind()].emplace_back(std::move(entry));
+    ++size;
+    return true;
+}
+
+std::vector<FindDbIndex::Neighbour> FindDbIndex::Query(const ProblemFeatures& features,
+                                                       std::size_t k) const
+{
+    auto neighbours = std::vector<Neighbour>{};
+    const auto kind = kinds.find(features.GetKind());
+    if(kind == kinds.end() || k == 0)
+        return neighbours;
+
+    neighbours.reserve(kind->second.size());
+    for(const auto& entry : kind->second)
+        neighbours.push_back({&entry, features.GetSizeDistance(entry.features)});
+
+    const auto nearest = neighbours.begin() + std::min(k, neighbours.size());
+    std::partial_sort(
+        neighbours.begin(), nearest, neighbours.end(), [](const auto& l, const auto& r) {
+            return l.distance < r.distance;
+        });
+    neighbours.erase(nearest, neighbours.end());
+    return neighbours;
+}
+
+const FindDbIndex& FindDbIndex::GetInstalled(Handle& handle)
+{
+    static const auto empty = FindDbIndex{};
+    if(!debug::testing_find_db_enabled || IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}))
+        return empty;
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    const auto path = debug::testing_find_db_path_override()
+                          ? *debug::testing_find_db_path_override()
+                          : FindDbRecord::GetInstalledPath(handle);
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::map<std::string, FindDbIndex>{};
+    const auto it         = instances.find(path);
+    if(it != instances.end())
+        return it->second;
+
+    auto index     = FindDbIndex{};
+    auto n_skipped = 0;
+    ReadonlyRamDb::GetCached(path, false).ForEachRecord([&](const DbRecord& record) {
+        if(!index.Add(record))
+            ++n_skipped;
+    });
+    MIOPEN_LOG_I2("Indexed " << index.GetSize() << " records of " << path << ", skipped "
+                             << n_skipped);
+    return instances.emplace(path, std::move(index)).first->second;
+}
+
+} // namespace miopen
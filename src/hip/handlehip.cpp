@@ -259,6 +259,15 @@ void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
     MIOPEN_LOG_NQI(*this);
 }
 
+std::unique_ptr<Handle> Handle::CreateWorkerHandle() const
+{
+    this->impl->set_ctx();
+    auto stream          = this->impl->create_stream();
+    auto handle          = std::make_unique<Handle>(stream.get());
+    handle->impl->stream = std::move(stream);
+    return handle;
+}
+
 miopenAcceleratorQueue_t Handle::GetStream() const { return impl->stream.get(); }
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
@@ -406,6 +415,7 @@ Program Handle::LoadProgram(const std::string& program_name,
         auto p = HIPOCProgram{
             program_name, params, is_kernel_str, this->GetTargetProperties(), kernel_src};
         ct.Log("Kernel", is_kernel_str ? std::string() : program_name);
+        p.impl->options = params;
 
 // Save to cache
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
@@ -430,10 +440,17 @@ Program Handle::LoadProgram(const std::string& program_name,
     }
     else
     {
-        return HIPOCProgram{program_name, hsaco};
+        auto p          = HIPOCProgram{program_name, hsaco};
+        p.impl->options = params;
+        return p;
     }
 }
 
+std::uintptr_t Handle::GetProgramScope() const
+{
+    return static_cast<std::uintptr_t>(this->impl->device);
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -446,6 +463,13 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+KernelCacheStats Handle::GetKernelCacheStats() const { return this->impl->cache.GetStats(); }
+
+void Handle::SetKernelCacheLimits(std::size_t max_bytes, std::size_t max_programs) const
+{
+    this->impl->cache.SetLimits(max_bytes, max_programs);
+}
+
 void Handle::ClearProgram(const std::string& program_name, const std::string& params) const
 {
     this->impl->cache.ClearProgram(program_name, params);
@@ -60,6 +60,12 @@ static std::string DimToFormattedString(const size_t* dims, size_t count)
 
 void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 {
+    if(simulate)
+    {
+        simulate();
+        return;
+    }
+
 #ifndef NDEBUG
     MIOPEN_LOG_I2("kernel_name = "
                   << GetName() << ", global_work_dim = " << DimToFormattedString(gdims.data(), 3)
@@ -130,6 +136,27 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 HIPOCKernelInvoke HIPOCKernel::Invoke(hipStream_t stream,
                                       std::function<void(hipEvent_t, hipEvent_t)> callback) const
 {
+    auto* const recorder = KernelTimeRecorder::Get();
+    if(callback && recorder != nullptr)
+    {
+        callback = [callback, recorder, launch = GetLaunch()](hipEvent_t start, hipEvent_t stop) {
+            auto time = 0.0f;
+            if(hipEventElapsedTime(&time, start, stop) == hipSuccess)
+                recorder->Record(launch, time);
+            callback(start, stop);
+        };
+    }
     return HIPOCKernelInvoke{stream, fun, ldims, gdims, name, callback};
 }
+
+KernelLaunch HIPOCKernel::GetLaunch() const
+{
+    auto launch    = KernelLaunch{};
+    launch.program = program.impl != nullptr ? program.impl->program : std::string{};
+    launch.kernel  = name;
+    launch.options = program.impl != nullptr ? program.impl->options : std::string{};
+    launch.ldims   = ldims;
+    launch.gdims   = gdims;
+    return launch;
+}
 } // namespace miopen
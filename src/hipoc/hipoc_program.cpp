@@ -39,6 +39,7 @@
 #include <miopen/write_file.hpp>
 #include <miopen/env.hpp>
 #include <miopen/comgr.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/optional.hpp>
 
 #include <cstring>
@@ -184,11 +185,12 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
                                    const boost::filesystem::path& filespec)
     : program(program_name), hsaco_file(filespec)
 {
-    module = CreateModule(hsaco_file);
+    module           = CreateModule(hsaco_file);
+    code_object_size = boost::filesystem::file_size(hsaco_file);
 }
 
 HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name, const std::string& blob)
-    : program(program_name) ///, module(CreateModuleInMem(blob))
+    : program(program_name), code_object_size(blob.size()) ///, module(CreateModuleInMem(blob))
 {
     if(nullptr !=
        miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{})) /// \todo Finish off this spaghetti eventually.
@@ -215,6 +217,10 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
         {
             module = CreateModule(hsaco_file);
         }
+        boost::system::error_code ec;
+        const auto size = boost::filesystem::file_size(hsaco_file, ec);
+        if(!ec)
+            code_object_size = size;
     }
 }
 
@@ -394,4 +400,13 @@ void HIPOCProgram::FreeCodeObjectFileStorage()
 
 bool HIPOCProgram::IsCodeObjectInMemory() const { return !impl->binary.empty(); };
 
+std::size_t HIPOCProgram::GetCodeObjectSize() const
+{
+    if(impl == nullptr)
+        return 0;
+    if(!impl->binary.empty())
+        return impl->binary.size();
+    return impl->code_object_size;
+}
+
 } // namespace miopen
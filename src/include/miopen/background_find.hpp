@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BACKGROUND_FIND_HPP_
+#define GUARD_MIOPEN_BACKGROUND_FIND_HPP_
+
+#include <miopen/miopen.h>
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Runs the Find of the problems on a worker thread, so that the callers need not to wait for
+/// it, see FindMode::Values::Background. Each job runs with a handle of its own, created by
+/// Handle::CreateWorkerHandle(), and returns the solutions it has found, sorted by time.
+/// It is owned by the handle the Find is run for, see Handle::GetBackgroundFind().
+class BackgroundFind
+{
+public:
+    using Job = std::function<std::vector<miopenConvSolution_t>(Handle&)>;
+
+    BackgroundFind();
+    BackgroundFind(const BackgroundFind&) = delete;
+    BackgroundFind& operator=(const BackgroundFind&) = delete;
+    /// Drops the jobs not started yet and cancels the running one, see Handle::cancelled.
+    /// It waits only for the solver being run then.
+    ~BackgroundFind();
+
+    /// Schedules the job of the key, unless it has been scheduled already. Returns false then.
+    bool Schedule(const Handle& handle, const std::string& key, Job job);
+
+    /// Returns the solutions found by the job of the key, none if it is not done.
+    boost::optional<std::vector<miopenConvSolution_t>> GetResult(const std::string& key) const;
+    /// Same as GetResult(), but returns each result once. Later calls return none.
+    boost::optional<std::vector<miopenConvSolution_t>> TakeResult(const std::string& key);
+    /// Tells without locking if there are non-empty results not taken yet, so that the callers
+    /// need not build the keys once all of them have been taken.
+    bool HasResultsToTake() const { return results_to_take.load() != 0; }
+
+    /// Waits until all the jobs scheduled are done.
+    void Wait() const;
+
+private:
+    struct Task
+    {
+        std::string key;
+        std::unique_ptr<Handle> handle;
+        Job job;
+    };
+
+    void Run();
+
+    mutable std::mutex mutex;
+    mutable std::condition_variable changed;
+    std::deque<Task> queue;
+    struct Result
+    {
+        /// None while the job is pending.
+        boost::optional<std::vector<miopenConvSolution_t>> solutions;
+        bool taken = false;
+    };
+
+    std::unordered_map<std::string, Result> results;
+    std::atomic<std::size_t> results_to_take{0};
+    bool running  = false;
+    bool stopping = false;
+    /// Shared with the worker handles.
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    std::thread worker;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BACKGROUND_FIND_HPP_
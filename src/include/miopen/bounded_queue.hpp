@@ -0,0 +1,145 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BOUNDED_QUEUE_HPP_
+#define GUARD_MIOPEN_BOUNDED_QUEUE_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace miopen {
+
+/// Blocking FIFO queue of limited capacity, connecting producer threads to consumer threads.
+template <class T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(std::size_t capacity_) : capacity(std::max<std::size_t>(capacity_, 1))
+    {
+    }
+
+    /// Waits while the queue is full. Returns false, dropping the item, once it is closed.
+    bool Push(T item)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        not_full.wait(lock, [&]() { return closed || items.size() < capacity; });
+        if(closed)
+            return false;
+        items.push_back(std::move(item));
+        lock.unlock();
+        not_empty.notify_one();
+        return true;
+    }
+
+    /// Waits while the queue is empty. Returns false when it is closed and nothing is left.
+    bool Pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        not_empty.wait(lock, [&]() { return closed || !items.empty(); });
+        if(items.empty())
+            return false;
+        item = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+        return true;
+    }
+
+    /// No more items can be pushed, the ones already queued can still be popped.
+    void Close()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            closed = true;
+        }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+private:
+    std::size_t capacity;
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::deque<T> items;
+    bool closed = false;
+};
+
+/// Runs the producer of a queue in a thread of its own. The queue is closed when the producer is
+/// done, or when the consumer leaves early, so that none of them keeps waiting for the other.
+template <class Queue>
+class QueueProducer
+{
+public:
+    template <class F>
+    QueueProducer(Queue& queue_, F produce) : queue(queue_)
+    {
+        thread = std::thread([this, produce]() {
+            try
+            {
+                produce();
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+            queue.Close();
+        });
+    }
+
+    QueueProducer(const QueueProducer&) = delete;
+    QueueProducer& operator=(const QueueProducer&) = delete;
+
+    ~QueueProducer()
+    {
+        if(thread.joinable())
+        {
+            queue.Close();
+            thread.join();
+        }
+    }
+
+    /// Waits for the producer and rethrows what it has thrown, if anything.
+    void Join()
+    {
+        thread.join();
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    Queue& queue;
+    std::thread thread;
+    std::exception_ptr error;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BOUNDED_QUEUE_HPP_
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/kernel.hpp>
+#include <miopen/kernel_info.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+enum class CompilePriority
+{
+    /// Precompilation for tuning.
+    Background,
+    /// Something the user is waiting for.
+    Foreground,
+};
+
+/// Process-wide pool of compiler threads.
+/// Requests for the same program and build options on the same device are coalesced, i.e.
+/// all of the requesters wait for the single build in flight. Queued foreground requests
+/// are served before background ones. The handle must outlive the returned futures.
+class CompileService
+{
+public:
+    static CompileService& Get();
+
+    CompileService(const CompileService&) = delete;
+    CompileService& operator=(const CompileService&) = delete;
+    ~CompileService();
+
+    std::shared_future<Program>
+    Submit(const Handle& handle, const solver::KernelInfo& kernel, CompilePriority priority);
+
+    /// Submits all of the kernels and waits for them.
+    std::vector<Program> Compile(const Handle& handle,
+                                 const std::vector<solver::KernelInfo>& kernels,
+                                 CompilePriority priority);
+
+    /// Builds the program in the calling thread, unless the same build is already in flight.
+    /// A queued request for it is taken over instead of waiting for a worker.
+    Program Load(const Handle& handle,
+                 const std::string& program_name,
+                 const std::string& params,
+                 bool is_kernel_str,
+                 const std::string& kernel_src);
+
+private:
+    // scope, program name, params, is_kernel_str
+    using Key = std::tuple<std::uintptr_t, std::string, std::string, bool>;
+
+    struct Request
+    {
+        Key key;
+        const Handle* handle;
+        std::string kernel_src;
+        CompilePriority priority;
+        bool started = false;
+        std::promise<Program> promise;
+        std::shared_future<Program> future;
+    };
+
+    using RequestPtr = std::shared_ptr<Request>;
+
+    CompileService() = default;
+
+    RequestPtr Enqueue(const Handle& handle,
+                       const std::string& program_name,
+                       const std::string& params,
+                       bool is_kernel_str,
+                       const std::string& kernel_src,
+                       CompilePriority priority);
+    RequestPtr AddRequestUnsafe(Key key,
+                                const Handle& handle,
+                                const std::string& kernel_src,
+                                CompilePriority priority);
+    void StartWorkersUnsafe();
+    void Run();
+    void Build(Request& request);
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::map<Key, RequestPtr> in_flight;
+    std::deque<RequestPtr> foreground;
+    std::deque<RequestPtr> background;
+    std::vector<std::thread> workers;
+    std::size_t idle = 0;
+    bool stop = false;
+};
+
+} // namespace miopen
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILED_DB_HPP_
+#define GUARD_MIOPEN_COMPILED_DB_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace miopen {
+
+/// Compiled (binary) form of a readonly text db, see db_record.hpp for the text format.
+/// The file is intended to be memory-mapped and used in place, without parsing.
+///
+/// Layout (all integers are host-endian):
+///   Header
+///   Record[record_count]  - sorted by key
+///   Pair[pair_count]      - ID:VALUES pairs, grouped by record
+///   char[strings_size]    - keys, IDs and VALUES, not null-terminated
+class CompiledDb
+{
+public:
+    static constexpr std::uint32_t version = 2;
+
+    /// The text db an image is built from. Used to detect stale images, see Open().
+    struct Source
+    {
+        std::uint64_t size = 0;
+        std::int64_t mtime = 0; // Seconds since the epoch.
+        std::uint64_t hash = 0; // FNV-1a of the contents.
+        /// Seconds since the epoch when the text db has begun to be read. A change made within
+        /// the second of mtime may leave mtime as is, so mtime tells nothing unless it is older.
+        std::int64_t read_time = 0;
+    };
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t record_count;
+        std::uint32_t pair_count;
+        std::uint32_t reserved;
+        Source source;
+        std::uint64_t strings_size;
+    };
+
+    struct String
+    {
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    struct Record
+    {
+        String key;
+        std::uint32_t first_pair;
+        std::uint32_t pair_count;
+        /// Line number within the source text db, for diagnostics.
+        std::uint32_t line;
+    };
+
+    struct Pair
+    {
+        String id;
+        String values;
+    };
+
+    CompiledDb();
+    CompiledDb(CompiledDb&&) noexcept;
+    CompiledDb& operator=(CompiledDb&&) noexcept;
+    ~CompiledDb();
+
+    /// Returns path of the compiled image that corresponds to the text db.
+    /// "*.txt" is replaced with "*.bin", ".bin" is appended otherwise.
+    static std::string GetPath(const std::string& text_db_path);
+
+    /// Converts text db into its compiled form.
+    /// Ill-formed lines are skipped with an error message, on duplicate keys the first wins.
+    ///
+    /// Returns number of records written or -1 in case of an error.
+    static int Compile(std::istream& text_db,
+                       std::ostream& compiled,
+                       const Source& source,
+                       const std::string& source_name);
+
+    static bool Compile(const std::string& text_db_path, const std::string& compiled_path);
+
+    /// Maps compiled image into memory. Fails if the file is absent or ill-formed, or if it was
+    /// built from a text db other than the one at source_path. The text db is the same if it has
+    /// the same size and mtime, the mtime being older than the image. Otherwise, e.g. once the
+    /// dbs are installed or copied, it is hashed, and the contents decide.
+    bool Open(const std::string& path, const std::string& source_path);
+
+    bool IsOpen() const { return records != nullptr; }
+    std::size_t GetSize() const { return IsOpen() ? header->record_count : 0; }
+
+    /// Binary searches for the key. Returns nullptr if not found.
+    const Record* Find(const char* key, std::size_t key_size) const;
+    const Record* Find(const std::string& key) const { return Find(key.data(), key.size()); }
+
+    const Record* begin() const { return records; }
+    const Record* end() const { return records + GetSize(); }
+
+    const Pair* begin(const Record& record) const { return pairs + record.first_pair; }
+    const Pair* end(const Record& record) const { return begin(record) + record.pair_count; }
+
+    std::string Get(const String& str) const { return {strings + str.offset, str.size}; }
+
+private:
+    struct Mapping;
+
+    std::unique_ptr<Mapping> mapping;
+    const Header* header  = nullptr;
+    const Record* records = nullptr;
+    const Pair* pairs     = nullptr;
+    const char* strings   = nullptr;
+
+    bool Validate(const char* data, std::size_t size, const std::string& path);
+    bool IsBuiltFrom(const std::string& source_path) const;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILED_DB_HPP_
@@ -28,6 +28,7 @@
 
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/convolution.hpp>
+#include <miopen/conv/problem_key.hpp>
 #include <miopen/names.hpp>
 #include <miopen/sqlite_db.hpp>
 #include <miopen/tensor.hpp>
@@ -361,16 +362,16 @@ struct ProblemDescription
 
     void HeuristicUpdateLayouts();
 
-    void BuildConfKey(std::string& conf_key) const;
+    InternedProblemKey GetInternedKey() const { return InternedProblemKey::Get(*this); }
 
-    NetworkConfig BuildConfKey() const
+    void BuildConfKey(std::string& conf_key) const
     {
-        std::string ret;
-        BuildConfKey(ret);
-        return NetworkConfig{ret};
+        conf_key = GetInternedKey().GetNetworkConfig().ToString();
     }
 
-    void Serialize(std::ostream& stream) const;
+    NetworkConfig BuildConfKey() const { return GetInternedKey().GetNetworkConfig(); }
+
+    void Serialize(std::ostream& stream) const { stream << GetInternedKey().GetDbKey(); }
 
     friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
     {
@@ -413,6 +414,11 @@ struct ProblemDescription
     }
 
 private:
+    friend class InternedProblemKey;
+
+    void BuildConfKeyImpl(std::string& conf_key) const;
+    void SerializeImpl(std::ostream& stream) const;
+
     TensorDescriptor in;
     TensorDescriptor weights;
     TensorDescriptor out;
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/names.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+namespace conv {
+
+struct ProblemDescription;
+
+/// Fixed-width binary form of a convolution problem.
+/// Holds every field that BuildConfKey() and Serialize() encode, so two problems
+/// with equal keys produce equal network configs and equal db keys.
+class ProblemKey
+{
+public:
+    ProblemKey() = default;
+    explicit ProblemKey(const ProblemDescription& problem);
+
+    std::size_t GetHash() const { return hash; }
+
+    friend bool operator==(const ProblemKey& left, const ProblemKey& right)
+    {
+        return left.hash == right.hash && left.fields == right.fields;
+    }
+    friend bool operator!=(const ProblemKey& left, const ProblemKey& right)
+    {
+        return !(left == right);
+    }
+
+    struct Hasher
+    {
+        std::size_t operator()(const ProblemKey& key) const { return key.GetHash(); }
+    };
+
+private:
+    static constexpr std::size_t field_count = 34;
+
+    std::array<std::int64_t, field_count> fields = {};
+    std::size_t hash                             = 0;
+};
+
+/// Process-wide handle to a unique ProblemKey.
+/// Equal problems share the same entry, so the hot lookup paths may compare and hash
+/// the id alone. The string forms are built once, when the key is first seen.
+class InternedProblemKey
+{
+public:
+    static InternedProblemKey Get(const ProblemDescription& problem);
+
+    /// Never zero.
+    std::size_t GetId() const;
+    const ProblemKey& GetKey() const;
+    /// Carries the id, see NetworkConfig::GetInternedId().
+    const NetworkConfig& GetNetworkConfig() const;
+    const std::string& GetDbKey() const;
+
+    struct Entry;
+
+private:
+    InternedProblemKey(const Entry& entry_) : entry(&entry_) {}
+
+    const Entry* entry;
+};
+
+} // namespace conv
+} // namespace miopen
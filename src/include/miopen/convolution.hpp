@@ -414,7 +414,7 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                                      std::size_t workSpaceSize,
                                      bool exhaustiveSearch) const;
 
-    void ConvolutionBackwardWeights(const Handle& handle,
+    void ConvolutionBackwardWeights(Handle& handle,
                                     const void* alpha,
                                     const TensorDescriptor& dyDesc,
                                     ConstData_t dy,
@@ -437,6 +437,7 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
     int group_count;
     float lowp_quant; // quantization factor for low precision
     FindMode findMode;
+    TuningBudget tuningBudget;
     ConvolutionAttribute attribute;
 
     void ConvBwdGemm(Handle& handle,
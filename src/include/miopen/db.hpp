@@ -26,6 +26,7 @@
 #ifndef GUARD_MIOPEN_DB_HPP_
 #define GUARD_MIOPEN_DB_HPP_
 
+#include <miopen/db_cache.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/rank.hpp>
 
@@ -196,72 +197,132 @@ public:
           _user(GetDbInstance<TUser>(user_path, false))
 #endif
     {
+        if(IsDbCacheable<TUser>{})
+            cache = DbCache::GetCached(installed_path, user_path, merge_records);
     }
 
-    template <bool merge = merge_records, std::enable_if_t<merge>* = nullptr, typename... U>
-    auto FindRecord(const U&... args)
-    {
-        auto users     = _user.FindRecord(args...);
-        auto installed = _installed.FindRecord(args...);
-
-        if(users && installed)
-        {
-            users->Merge(installed.value());
-            return users;
-        }
-
-        if(users)
-            return users;
-
-        return installed;
-    }
-
-    template <bool merge = merge_records, std::enable_if_t<!merge>* = nullptr, typename... U>
+    template <typename... U>
     auto FindRecord(const U&... args)
     {
-        auto users = _user.FindRecord(args...);
-        return users ? users : _installed.FindRecord(args...);
+        return FindRecordCached(IsDbCacheable<TUser>{}, args...);
     }
 
     template <typename... U>
     auto StoreRecord(const U&... args)
     {
+        InvalidateCache();
         return _user.StoreRecord(args...);
     }
 
     template <typename... U>
     auto UpdateRecord(U&... args)
     {
+        InvalidateCache();
         return _user.UpdateRecord(args...);
     }
 
     template <typename... U>
     auto RemoveRecord(const U&... args)
     {
+        InvalidateCache();
         return _user.RemoveRecord(args...);
     }
 
     template <typename... U>
     auto Update(const U&... args)
     {
+        InvalidateCache();
         return _user.Update(args...);
     }
 
     template <typename... U>
     auto Load(U&... args)
     {
-        if(_user.Load(args...))
-            return true;
-        return _installed.Load(args...);
+        using IsCached = std::integral_constant<bool, IsDbCacheable<TUser>{} && merge_records>;
+        return LoadCached(IsCached{}, args...);
     }
 
     template <typename... U>
     auto Remove(const U&... args)
     {
+        InvalidateCache();
         return _user.Remove(args...);
     }
 
+    /// The values found in both dbs are all appended, the user ones first.
+    template <class TValue>
+    bool LoadAll(const std::string& id, std::vector<TValue>& values)
+    {
+        const auto user      = _user.LoadAll(id, values);
+        const auto installed = _installed.LoadAll(id, values);
+        return user || installed;
+    }
+
 private:
+    DbCache* cache = nullptr;
+
+    void InvalidateCache()
+    {
+        if(cache != nullptr)
+            cache->Invalidate();
+    }
+
+    template <class TKey>
+    boost::optional<DbRecord> FindRecordCached(std::true_type, const TKey& key)
+    {
+        if(cache == nullptr)
+            return FindRecordUncached(key);
+        return cache->Find(DbCache::GetKey(key), [&]() { return FindRecordUncached(key); });
+    }
+
+    template <typename... U>
+    auto FindRecordCached(std::false_type, const U&... args)
+    {
+        return FindRecordUncached(args...);
+    }
+
+    /// With merged records, the merged record holds the same VALUES under the ID as a
+    /// search in the user db first and in the installed one then would find.
+    template <class TProblem, class TValue>
+    bool LoadCached(std::true_type, const TProblem& problem, const std::string& id, TValue& values)
+    {
+        const auto record = FindRecord(problem);
+        return record && record->GetValues(id, values);
+    }
+
+    template <typename... U>
+    auto LoadCached(std::false_type, U&... args)
+    {
+        if(_user.Load(args...))
+            return true;
+        return _installed.Load(args...);
+    }
+
+    template <bool merge = merge_records, std::enable_if_t<merge>* = nullptr, typename... U>
+    auto FindRecordUncached(const U&... args)
+    {
+        auto users     = _user.FindRecord(args...);
+        auto installed = _installed.FindRecord(args...);
+
+        if(users && installed)
+        {
+            users->Merge(installed.value());
+            return users;
+        }
+
+        if(users)
+            return users;
+
+        return installed;
+    }
+
+    template <bool merge = merge_records, std::enable_if_t<!merge>* = nullptr, typename... U>
+    auto FindRecordUncached(const U&... args)
+    {
+        auto users = _user.FindRecord(args...);
+        return users ? users : _installed.FindRecord(args...);
+    }
+
     template <class TDb, class TRet = decltype(TDb::GetCached("", true))>
     static TRet GetDbInstance(rank<1>, const std::string& path, bool warn_if_unreadable)
     {
@@ -337,6 +398,12 @@ public:
         return Measure("Remove", [&]() { return inner.Remove(args...); });
     }
 
+    template <typename... U>
+    bool LoadAll(U&... args)
+    {
+        return Measure("LoadAll", [&]() { return inner.LoadAll(args...); });
+    }
+
 private:
     TInnerDb inner;
 
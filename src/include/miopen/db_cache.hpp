@@ -0,0 +1,392 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_CACHE_HPP_
+#define GUARD_MIOPEN_DB_CACHE_HPP_
+
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace miopen {
+
+/// Read-mostly concurrent hash map.
+///
+/// Each shard is an open addressing table of pointers to immutable nodes. Readers never lock:
+/// they register in one of two per-shard reader counters and follow the pointers. Writers are
+/// serialized per shard. A new key is stored into a free slot in place; the table (pointers
+/// only, not the nodes) is copied just when it has to grow or to shed the tombstones left by
+/// evictions. A replaced node or table is reclaimed once the writer has flipped the counter
+/// phase twice and readers of both phases are gone. This is the counter-based flavour of
+/// userspace RCU, so replacing a value and evicting are relatively expensive.
+///
+/// If shard_capacity is not 0, inserting a new key into a full shard evicts an entry which
+/// has not been visited since the clock hand passed it last (the CLOCK policy).
+/// TKey and TValue shall be default constructible.
+template <class TKey, class TValue, class THash = std::hash<TKey>>
+class RcuMap
+{
+public:
+    static constexpr std::size_t shard_count = 64;
+
+    explicit RcuMap(std::size_t shard_capacity_ = 0) : shard_capacity(shard_capacity_)
+    {
+        for(auto& shard : shards)
+            shard.table.store(new Table{min_table_size});
+    }
+
+    RcuMap(const RcuMap&) = delete;
+    RcuMap& operator=(const RcuMap&) = delete;
+
+    ~RcuMap()
+    {
+        for(auto& shard : shards)
+            DeleteWithNodes(shard.table.load());
+    }
+
+    /// Calls func(const TValue&) for the value under the key, if any.
+    /// Returns false if the key was not found, or the value returned by func otherwise.
+    template <class TFunc>
+    bool Visit(const TKey& key, TFunc&& func) const
+    {
+        const auto hash  = THash{}(key);
+        auto& shard      = shards[hash % shard_count];
+        const auto phase = shard.phase.load() & 1;
+        shard.readers[phase].fetch_add(1);
+        const auto* const node = shard.table.load()->FindNode(key, hash);
+        auto ret               = false;
+        if(node != nullptr)
+        {
+            node->visited.store(true, std::memory_order_relaxed);
+            ret = func(node->value);
+        }
+        shard.readers[phase].fetch_sub(1);
+        return ret;
+    }
+
+    void Insert(const TKey& key, TValue value)
+    {
+        const auto hash = THash{}(key);
+        auto& shard     = shards[hash % shard_count];
+        const std::lock_guard<std::mutex> lock{shard.write_mutex};
+        auto node   = std::make_unique<const Node>(key, hash, std::move(value));
+        auto* table = shard.table.load();
+
+        if(auto* const slot = table->FindSlot(key, hash))
+        {
+            const auto* const old = slot->exchange(node.release());
+            Synchronize(shard);
+            delete old;
+            return;
+        }
+
+        if(shard_capacity != 0 && shard.size >= shard_capacity)
+            Evict(shard);
+        if((shard.used + 1) * 2 > table->size)
+            table = Rebuild(shard);
+
+        auto& slot = table->FindFreeSlot(hash);
+        if(slot.load() == nullptr)
+            ++shard.used;
+        slot.store(node.release());
+        ++shard.size;
+    }
+
+    void Clear()
+    {
+        for(auto& shard : shards)
+        {
+            const std::lock_guard<std::mutex> lock{shard.write_mutex};
+            const auto* const old = shard.table.exchange(new Table{min_table_size});
+            shard.used            = 0;
+            shard.size            = 0;
+            shard.hand            = 0;
+            Synchronize(shard);
+            DeleteWithNodes(old);
+        }
+    }
+
+    std::size_t GetSize() const
+    {
+        auto size = std::size_t{0};
+        for(auto& shard : shards)
+        {
+            const std::lock_guard<std::mutex> lock{shard.write_mutex};
+            size += shard.size;
+        }
+        return size;
+    }
+
+private:
+    static constexpr std::size_t min_table_size = 8;
+
+    struct Node
+    {
+        Node(const TKey& key_, std::size_t hash_, TValue value_)
+            : key(key_), hash(hash_), value(std::move(value_))
+        {
+        }
+
+        bool Is(const TKey& key_, std::size_t hash_) const { return hash == hash_ && key == key_; }
+
+        const TKey key;
+        const std::size_t hash;
+        const TValue value;
+        mutable std::atomic<bool> visited{false};
+    };
+
+    using Slot = std::atomic<const Node*>;
+
+    /// Marks the slots of the evicted nodes, so that probing goes on past them.
+    static const Node* Tombstone()
+    {
+        static const Node tombstone{TKey{}, 0, TValue{}};
+        return &tombstone;
+    }
+
+    /// The size is a power of two. At least half of the slots are always null, which ends
+    /// every probe.
+    struct Table
+    {
+        explicit Table(std::size_t size_) : size(size_), slots(new Slot[size_])
+        {
+            for(auto i = std::size_t{0}; i < size; ++i)
+                slots[i].store(nullptr);
+        }
+
+        const std::size_t size;
+        const std::unique_ptr<Slot[]> slots;
+
+        std::size_t Next(std::size_t i) const { return (i + 1) & (size - 1); }
+        // The lowest bits of the hash have already been used to choose the shard.
+        std::size_t First(std::size_t hash) const { return (hash / shard_count) & (size - 1); }
+
+        const Node* FindNode(const TKey& key, std::size_t hash) const
+        {
+            for(auto i = First(hash);; i = Next(i))
+            {
+                const auto* const node = slots[i].load();
+                if(node == nullptr || (node != Tombstone() && node->Is(key, hash)))
+                    return node;
+            }
+        }
+
+        /// Shall be called by the writer only, so that the slot is not changed meanwhile.
+        Slot* FindSlot(const TKey& key, std::size_t hash) const
+        {
+            for(auto i = First(hash);; i = Next(i))
+            {
+                const auto* const node = slots[i].load();
+                if(node == nullptr)
+                    return nullptr;
+                if(node != Tombstone() && node->Is(key, hash))
+                    return &slots[i];
+            }
+        }
+
+        Slot& FindFreeSlot(std::size_t hash) const
+        {
+            auto i = First(hash);
+            while(slots[i].load() != nullptr && slots[i].load() != Tombstone())
+                i = Next(i);
+            return slots[i];
+        }
+    };
+
+    struct Shard
+    {
+        // Padding keeps counters of the neighbouring shards in separate cache lines.
+        char padding[64];
+        mutable std::atomic<unsigned> readers[2] = {{0}, {0}};
+        std::atomic<unsigned> phase{0};
+        std::atomic<Table*> table{nullptr};
+        mutable std::mutex write_mutex;
+        // The rest is guarded by the write_mutex.
+        std::size_t used = 0; // Slots holding either a node or a tombstone.
+        std::size_t size = 0; // Slots holding a node.
+        std::size_t hand = 0; // Slot the clock hand points to.
+    };
+
+    const std::size_t shard_capacity;
+    std::array<Shard, shard_count> shards;
+
+    static void Synchronize(Shard& shard)
+    {
+        // A reader may have fetched the phase before the flip and registered after it, so
+        // both counters are drained in turn. Readers arriving meanwhile use the other one.
+        for(auto i = 0; i < 2; ++i)
+        {
+            const auto drained = shard.phase.fetch_xor(1) & 1;
+            while(shard.readers[drained].load() != 0)
+                std::this_thread::yield();
+        }
+    }
+
+    static void DeleteWithNodes(const Table* table)
+    {
+        for(auto i = std::size_t{0}; i < table->size; ++i)
+        {
+            const auto* const node = table->slots[i].load();
+            if(node != Tombstone())
+                delete node;
+        }
+        delete table;
+    }
+
+    static Table* Rebuild(Shard& shard)
+    {
+        const auto* const old = shard.table.load();
+        auto size             = min_table_size;
+        while(size < (shard.size + 1) * 4)
+            size *= 2;
+
+        // The nodes are shared by both tables until the old one is reclaimed.
+        auto table = std::make_unique<Table>(size);
+        for(auto i = std::size_t{0}; i < old->size; ++i)
+        {
+            const auto* const node = old->slots[i].load();
+            if(node != nullptr && node != Tombstone())
+                table->FindFreeSlot(node->hash).store(node);
+        }
+
+        shard.table.store(table.get());
+        shard.used = shard.size;
+        shard.hand = 0;
+        Synchronize(shard);
+        delete old;
+        return table.release();
+    }
+
+    static void Evict(Shard& shard)
+    {
+        const auto& table = *shard.table.load();
+
+        // Visited nodes get a second chance, so this ends within two turns of the hand.
+        for(;; shard.hand = table.Next(shard.hand))
+        {
+            auto& slot             = table.slots[shard.hand];
+            const auto* const node = slot.load();
+            if(node == nullptr || node == Tombstone() || node->visited.exchange(false))
+                continue;
+
+            slot.store(Tombstone());
+            --shard.size;
+            Synchronize(shard);
+            delete node;
+            return;
+        }
+    }
+};
+
+template <class TDb>
+struct IsDbCacheable : std::false_type
+{
+};
+
+/// Process-wide cache of records found in a pair of installed and user dbs, see MultiFileDb.
+///
+/// Hits take no locks and do not touch the filesystem. Records are invalidated by writes to
+/// their user db made by this process, and by writes made by other processes, which are
+/// detected by means of db modification time files (see RamDb::GetTimeFilePath). The latter
+/// are checked by a single reader once per MIOPEN_DEBUG_DB_CACHE_VALIDATION_INTERVAL_MS.
+/// Each cache holds up to MIOPEN_DEBUG_DB_CACHE_CAPACITY records, see RcuMap for eviction.
+class DbCache
+{
+public:
+    /// Returns nullptr if the cache is disabled.
+    static DbCache*
+    GetCached(const std::string& installed_path, const std::string& user_path, bool merge);
+
+    /// Invalidates records of all caches over the user db. Shall be called after each write
+    /// to the db.
+    static void Invalidate(const std::string& user_path);
+
+    /// Invalidates records of all caches over the user db of this one.
+    void Invalidate() { local_writes->fetch_add(1); }
+
+    static const std::string& GetKey(const std::string& key) { return key; }
+
+    template <class TProblem>
+    static std::string GetKey(const TProblem& problem)
+    {
+        return DbRecord{problem}.GetKey();
+    }
+
+    /// Returns cached record, or calls fill() to obtain and cache it.
+    template <class TFill>
+    boost::optional<DbRecord> Find(const std::string& key, TFill&& fill)
+    {
+        // The stamp must be taken before fill() so that concurrent writes are never missed.
+        const auto stamp = GetStamp();
+        auto ret         = boost::optional<DbRecord>{};
+
+        const auto hit = entries.Visit(key, [&](const std::shared_ptr<const Entry>& entry) {
+            if(entry->stamp != stamp)
+                return false;
+            ret = entry->record;
+            return true;
+        });
+
+        if(hit)
+            return ret;
+
+        ret = fill();
+        entries.Insert(key, std::make_shared<const Entry>(Entry{stamp, ret}));
+        return ret;
+    }
+
+private:
+    struct Entry
+    {
+        std::uint64_t stamp;
+        boost::optional<DbRecord> record;
+    };
+
+    std::string user_path;
+    std::atomic<std::uint64_t>* local_writes;
+    RcuMap<std::string, std::shared_ptr<const Entry>> entries;
+    std::atomic<std::int64_t> next_validation{0};
+    std::atomic<std::int64_t> user_db_time;
+    std::atomic<std::uint64_t> external_writes{0};
+
+    DbCache(const std::string& user_path_);
+
+    std::uint64_t GetStamp();
+    static std::atomic<std::uint64_t>* GetLocalWrites(const std::string& user_path);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_CACHE_HPP_
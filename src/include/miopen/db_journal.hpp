@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_JOURNAL_HPP_
+#define GUARD_MIOPEN_DB_JOURNAL_HPP_
+
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+class LockFile;
+
+/// Write-behind journal of a user db file.
+///
+/// Updates are appended to a per-process log next to the db file and applied to the db file
+/// in batches by a background thread, so a store costs an append instead of a locked rewrite
+/// of the whole file. A batch is applied under the db lock file in one pass over the db.
+/// Logs left behind by dead processes are replayed by the next process updating the db.
+///
+/// Members with the Unsafe suffix shall be called with the db lock file held exclusively.
+class DbJournal
+{
+public:
+    struct Op
+    {
+        enum Kind : char
+        {
+            Store    = 'S',
+            Update   = 'U',
+            Remove   = 'R',
+            RemoveId = 'D',
+        };
+
+        Kind kind;
+        std::string key;
+        /// Ids and values for Store and Update, the id for RemoveId.
+        std::string payload;
+
+        /// Applies the op to the current state of the record, none meaning no record.
+        void Apply(boost::optional<DbRecord>& record) const;
+
+        static Op From(Kind kind, const DbRecord& record);
+    };
+
+    /// on_flush is called under the db lock after the db file has been rewritten. Its argument
+    /// is false if ops which have not been appended by this object were applied, i.e. logs of
+    /// dead processes were replayed.
+    DbJournal(const std::string& db_path_,
+              LockFile& lock_file_,
+              std::function<void(bool)> on_flush_);
+    DbJournal(const DbJournal&) = delete;
+    DbJournal& operator=(const DbJournal&) = delete;
+    ~DbJournal();
+
+    static bool IsEnabled();
+    static std::string GetLogPath(const std::string& db_path, int pid);
+    /// Flushes journals of all dbs of the process.
+    static void FlushAll();
+
+    void AppendUnsafe(Op op);
+    const std::vector<Op>& GetPendingUnsafe() const { return pending; }
+
+    /// Applies all the pending ops to the db file.
+    bool Flush();
+    /// Stops the flushing thread and applies the pending ops.
+    void Shutdown();
+
+private:
+    std::string db_path;
+    LockFile& lock_file;
+    std::function<void(bool)> on_flush;
+
+    std::vector<Op> pending;
+    /// Ops of a log left by a dead process with our pid.
+    std::vector<Op> replayed;
+    /// Logs of other dead processes found when the log was opened, read under the db lock.
+    std::vector<std::string> dead_logs;
+    std::atomic<std::size_t> pending_count{0};
+    std::ofstream log;
+
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool flush_requested = false;
+    bool stop            = false;
+    std::thread worker;
+    bool worker_started = false;
+
+    static bool ApplyOps(const std::string& path, const std::vector<Op>& ops);
+    bool FlushUnsafe();
+    void OpenLogUnsafe();
+    void Run();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_JOURNAL_HPP_
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_DB_MERGE_HPP_
+#define GUARD_MIOPEN_DB_MERGE_HPP_
+
+#include <miopen/config.h>
+#include <miopen/db_record.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace miopen {
+
+enum class DbKind
+{
+    Perf,
+    Find,
+};
+
+/// Combines the records of several dbs of the same kind, e.g. the user perf-dbs of the shards of
+/// a tuning split across processes, see TuningShard. When more than one db has VALUES for the
+/// same KEY and ID, the fastest ones are kept:
+/// - find-db: the ones with the lowest time;
+/// - perf-db: the config with the lowest best time in the finished tuning checkpoints of the
+///   record, see TuningCheckpoint. A config without one loses to a config with one. Otherwise
+///   the config added first is kept, like DbRecord::Merge() does.
+///
+/// Text dbs and, if MIOpen is built with SQLite, SQLite perf-dbs are supported. All the dbs
+/// merged must be in the same format.
+class DbMerger
+{
+public:
+    DbMerger(DbKind kind_) : kind(kind_) {}
+
+    /// Find-dbs are named *.fdb.txt (system) and *.ufdb.txt (user).
+    static DbKind GetKind(const std::string& path);
+
+    /// Reads the db and merges its records in. Throws if the db cannot be read or is in a
+    /// format other than the ones added before.
+    void Add(const std::string& path);
+
+    /// Writes the merged records to the db, replacing its contents.
+    void Write(const std::string& path) const;
+
+    std::size_t GetRecordCount() const { return records.size(); }
+    /// Number of VALUES replaced by faster ones.
+    std::size_t GetReplacedCount() const { return n_replaced; }
+
+    bool IsBetter(const std::string& id, const DbRecord& self, const DbRecord& that) const;
+
+private:
+    enum class Format
+    {
+        Unknown, // No db added yet.
+        Text,
+        SQLite,
+    };
+
+    DbKind kind;
+    Format format = Format::Unknown;
+    std::map<std::string, DbRecord> records;
+    std::size_t n_replaced = 0;
+    // Columns of the SQLite config table, by record KEY.
+    std::map<std::string, std::map<std::string, std::string>> sqlite_configs;
+
+    static Format GetFormat(const std::string& path);
+    static float GetBestTime(const DbRecord& record, const std::string& solver_id);
+
+    void AddRecord(const DbRecord& record);
+    void AddText(const std::string& path);
+    void WriteText(const std::string& path) const;
+#if MIOPEN_ENABLE_SQLITE
+    void AddSQLite(const std::string& path);
+    void WriteSQLite(const std::string& path) const;
+#endif
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_MERGE_HPP_
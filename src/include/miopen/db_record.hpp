@@ -31,6 +31,7 @@
 #include <miopen/logger.hpp>
 
 #include <cassert>
+#include <functional>
 #include <istream>
 #include <sstream>
 #include <string>
@@ -198,6 +199,14 @@ public:
     ///      this.Merge(that) = {ID1:VALUE1, ID2:VALUE2}
     void Merge(const DbRecord& that);
 
+    /// Decides if the VALUES of ID in that record should replace the ones in this record.
+    using MergePredicate =
+        std::function<bool(const std::string& id, const DbRecord& self, const DbRecord& that)>;
+
+    /// Same as Merge(that), but the VALUES of the IDs present in both records are taken from
+    /// that record when is_better() says so. is_better() sees both records unchanged.
+    void Merge(const DbRecord& that, const MergePredicate& is_better);
+
     /// Obtains VALUES from an object of class T and sets it in record (in association with ID,
     /// under the current KEY).
     /// T shall have the "void Serialize(std::ostream&) const" member function available.
@@ -244,6 +253,8 @@ public:
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
     friend class RamDb;
+    friend class DbJournal;
+    friend class DbMerger;
 };
 
 } // namespace miopen
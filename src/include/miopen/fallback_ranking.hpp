@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_FALLBACK_RANKING_HPP_
+#define GUARD_MIOPEN_FALLBACK_RANKING_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+namespace conv {
+struct ProblemDescription;
+} // namespace conv
+
+/// Numeric features of a convolution problem, e.g. the sizes of the tensors, as the model of
+/// FallbackRanking sees them. The sizes are log2-scaled.
+struct ProblemFeatures
+{
+    static constexpr std::size_t count = 25;
+
+    std::vector<float> values;
+
+    ProblemFeatures() : values(count, 0.0f) {}
+    ProblemFeatures(const conv::ProblemDescription& problem);
+
+    /// Gets the features from the find-db key of a problem, e.g. 64-56-56-3x3-64-56-56-16-1x1-
+    /// 1x1-1x1-0-NCHW-FP32-F. The same features are got from the problem and from its key.
+    static bool Parse(const std::string& db_key, ProblemFeatures& features);
+
+    static const char* GetName(std::size_t index);
+
+    /// The features other than the sizes of the tensors: the filter, pads, strides, dilations,
+    /// groups, direction, data type and layout.
+    std::vector<float> GetKind() const;
+    /// Between the log2 sizes of the tensors of the problems, channels weighted twice.
+    float GetSizeDistance(const ProblemFeatures& other) const;
+    float GetLog2Flops() const;
+};
+
+/// The times of the solvers recorded in the find-db for a problem.
+struct FallbackRecord
+{
+    std::string key;
+    ProblemFeatures features;
+    std::vector<std::pair<std::string, float>> times; // Solver id, ms.
+};
+
+/// Reads the records of a text find-db. The records with the keys that can't be parsed are
+/// skipped.
+std::vector<FallbackRecord> ReadFallbackRecords(const std::string& find_db_path);
+
+struct FallbackTrainingOptions
+{
+    std::size_t trees         = 64;
+    std::size_t depth         = 4;
+    std::size_t min_leaf_size = 4;
+    float learning_rate       = 0.2f;
+    /// The solvers with less records are not modelled.
+    std::size_t min_solver_records = 16;
+};
+
+/// How well the model ranks the solvers of the records it was not trained on.
+struct FallbackReport
+{
+    /// With the times of at least two solvers the model knows.
+    std::size_t records = 0;
+    /// Where the fastest solver is ranked first.
+    std::size_t top1 = 0;
+    /// Geometric mean of the time of the solver ranked first relative to the fastest one.
+    float mean_slowdown = 1.0f;
+    /// Of the estimated times.
+    float rms_log2_error = 0.0f;
+
+    friend std::ostream& operator<<(std::ostream& os, const FallbackReport& report);
+};
+
+/// Ranks the solvers by their times estimated by a model learned from the find-db, for the
+/// problems missed by the find-db. Used by the immediate mode fallback instead of the WTI of
+/// the solvers it has learned about.
+///
+/// The model of each solver is an ensemble of gradient-boosted regression trees estimating
+/// log2 of its time from ProblemFeatures. It is trained offline by MIOpenTrainFallback and
+/// stored in a small text file next to the system find-db.
+class FallbackRanking
+{
+public:
+    struct Node
+    {
+        int feature     = -1; // Leaf if negative.
+        float threshold = 0.0f;
+        int left        = -1; // Taken if the feature is less or equal to the threshold.
+        int right       = -1;
+        float value     = 0.0f; // Of a leaf.
+    };
+
+    struct Tree
+    {
+        std::vector<Node> nodes;
+
+        float Predict(const ProblemFeatures& features) const;
+    };
+
+    struct SolverModel
+    {
+        float base = 0.0f;
+        std::vector<Tree> trees;
+
+        float Predict(const ProblemFeatures& features) const;
+    };
+
+    /// Returns the model installed for the device, loaded once. Empty if there is none or if
+    /// disabled by MIOPEN_DEBUG_CONV_IMMED_FALLBACK_MODEL.
+    static const FallbackRanking& GetInstalled(Handle& handle);
+    static std::string GetInstalledPath(Handle& handle);
+
+    /// Throws on the malformed files.
+    static FallbackRanking Load(const std::string& path);
+    static FallbackRanking Read(std::istream& stream);
+    void Write(std::ostream& stream) const;
+
+    static FallbackRanking Train(const std::vector<FallbackRecord>& records,
+                                 const FallbackTrainingOptions& options = {});
+    FallbackReport Evaluate(const std::vector<FallbackRecord>& records) const;
+
+    bool IsEmpty() const { return solvers.empty(); }
+    std::size_t GetSolverCount() const { return solvers.size(); }
+
+    /// Returns the time in ms, none if the model of the solver is absent.
+    boost::optional<float> Estimate(const std::string& solver_id,
+                                    const ProblemFeatures& features) const;
+
+private:
+    std::map<std::string, SolverModel> solvers;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FALLBACK_RANKING_HPP_
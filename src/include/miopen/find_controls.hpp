@@ -32,6 +32,7 @@
 
 #include <boost/optional.hpp>
 
+#include <cstddef>
 #include <ostream>
 
 namespace miopen {
@@ -116,6 +117,7 @@ public:
         Hybrid,
         DeprecatedFastHybrid,
         DynamicHybrid,
+        Background,
         End_,
         Default_ = MIOPEN_DEFAULT_FIND_MODE,
     };
@@ -157,9 +159,63 @@ public:
         return value == Values::DynamicHybrid && IsEnabled(context);
     }
 
+    template <class Context>
+    bool IsBackground(const Context& context) const
+    {
+        return value == Values::Background && IsEnabled(context);
+    }
+
     friend std::ostream& operator<<(std::ostream&, const FindMode&);
 };
 
+/// Limits the auto-tuning of one problem by one solver. The search stops once either limit is
+/// reached and returns the best config found so far. Zero means no limit.
+class TuningBudget
+{
+    float seconds;
+    std::size_t evaluations;
+
+public:
+    /// Takes the defaults from MIOPEN_TUNING_BUDGET_SECONDS and MIOPEN_TUNING_BUDGET_EVALUATIONS.
+    TuningBudget();
+
+    float GetSeconds() const { return seconds; }
+    std::size_t GetEvaluations() const { return evaluations; }
+    void SetSeconds(float const v) { seconds = v; }
+    void SetEvaluations(std::size_t const v) { evaluations = v; }
+
+    bool IsLimited() const { return seconds > 0.0f || evaluations > 0; }
+    bool IsExhausted(float const elapsed_seconds, std::size_t const n_evaluated) const
+    {
+        return (seconds > 0.0f && elapsed_seconds >= seconds) ||
+               (evaluations > 0 && n_evaluated >= evaluations);
+    }
+
+    friend std::ostream& operator<<(std::ostream&, const TuningBudget&);
+};
+
+/// Part of the tuning space searched by this process, for the tuning split across processes.
+/// The configs are enumerated in the same order everywhere, and shard k of N takes every N-th
+/// config starting from the k-th one. The user perf-dbs of the shards are combined by
+/// MIOpenMergeDb afterwards.
+class TuningShard
+{
+    std::size_t index;
+    std::size_t count;
+
+public:
+    /// Takes the default from MIOPEN_TUNING_SHARD, "k/N" with 0 <= k < N. Not sharded if unset.
+    TuningShard();
+    TuningShard(std::size_t index_, std::size_t count_);
+
+    std::size_t GetIndex() const { return index; }
+    std::size_t GetCount() const { return count; }
+
+    bool IsSharded() const { return count > 1; }
+
+    friend std::ostream& operator<<(std::ostream&, const TuningShard&);
+};
+
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_FIND_CONTROLS_HPP_
@@ -139,6 +139,8 @@ public:
     auto end() { return content->As<FindDbData>().end(); }
     bool empty() const { return !content.is_initialized(); }
 
+    static std::string GetInstalledPath(Handle& handle);
+
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
                                           const TProblemDescription& problem,
@@ -174,7 +176,6 @@ private:
 
     static bool HasKernel(Handle& handle, const FindDbKCacheKey& key);
 
-    static std::string GetInstalledPath(Handle& handle);
     static std::string GetInstalledPathEmbed(Handle& handle);
     static std::string GetInstalledPathFile(Handle& handle);
     static std::string GetUserPath(Handle& handle);
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_FIND_DB_INDEX_HPP_
+#define GUARD_MIOPEN_FIND_DB_INDEX_HPP_
+
+#include <miopen/fallback_ranking.hpp>
+#include <miopen/perf_field.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+class DbRecord;
+struct Handle;
+
+/// Finds the problems of the system find-db most similar to a problem it misses, so that the
+/// immediate mode fallback can try the solutions found for them first. Similar problems are of
+/// the same kind (see ProblemFeatures::GetKind()) and differ only in the sizes of the tensors,
+/// e.g. batch or image size. The nearest ones have the least ProblemFeatures::GetSizeDistance().
+class FindDbIndex
+{
+public:
+    struct Entry
+    {
+        std::string key;
+        ProblemFeatures features;
+        std::vector<std::pair<std::string, FindDbData>> values; // By algorithm.
+    };
+
+    struct Neighbour
+    {
+        const Entry* entry;
+        float distance;
+    };
+
+    /// Returns the index of the installed find-db of the device, built once.
+    static const FindDbIndex& GetInstalled(Handle& handle);
+
+    /// Returns false if the key of the record can't be parsed.
+    bool Add(const DbRecord& record);
+
+    /// Returns up to k nearest entries, the nearest first.
+    std::vector<Neighbour> Query(const ProblemFeatures& features, std::size_t k) const;
+
+    bool IsEmpty() const { return size == 0; }
+    std::size_t GetSize() const { return size; }
+
+private:
+    std::map<std::vector<float>, std::vector<Entry>> kinds;
+    std::size_t size = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_DB_INDEX_HPP_
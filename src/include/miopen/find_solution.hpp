@@ -34,6 +34,7 @@
 #include <miopen/handle.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/tuning_checkpoint.hpp>
 
 #include <limits>
 #include <vector>
@@ -63,11 +64,21 @@ auto FindSolutionImpl(
     }
     else
     {
+        TuningCheckpoint checkpoint;
+        const auto shard = TuningShard{};
+        const auto checkpoint_id =
+            TuningCheckpoint::GetDbId(s.SolverDbId(), shard.GetIndex(), shard.GetCount());
         if((context.do_search || enforce.IsSearch(context)) &&
            (context.db_update || enforce.IsDbUpdate(context)))
         {
             MIOPEN_LOG_W("Perf Db: load skipped: " << s.SolverDbId() << ", enforce: " << enforce);
         }
+        else if((context.do_search || enforce.IsSearch(context)) &&
+                db.Load(context.problem, checkpoint_id, checkpoint) && !checkpoint.IsComplete())
+        {
+            MIOPEN_LOG_W("Perf Db: load skipped: " << s.SolverDbId()
+                                                   << ", resuming unfinished search");
+        }
         else
         {
             using PerformanceConfig = decltype(s.GetDefaultPerformanceConfig(context));
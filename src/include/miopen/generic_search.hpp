@@ -28,27 +28,40 @@
 #define GUARD_MIOPEN_GENERIC_SEARCH_HPP_
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/bounded_queue.hpp>
+#include <miopen/compile_service.hpp>
 #include <miopen/config.h>
 #include <miopen/conv/context.hpp>
 #include <miopen/conv_solution.hpp>
 #include <miopen/env.hpp>
+#include <miopen/find_controls.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/invoke_params.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/measurement_policy.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/search_strategy.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/tuning_checkpoint.hpp>
 #include <miopen/type_traits.hpp>
 
 #include <vector>
+#include <algorithm>
 #include <cstdlib>
+#include <functional>
+#include <exception>
+#include <future>
 #include <limits>
 #include <iterator>
 #include <chrono>
 #include <cassert>
+#include <sstream>
 
 namespace miopen {
 namespace solver {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_PIPELINE_DEPTH)
 
 /// This STL-like container together with corresponding iterator provide access
 /// to a set of all available performance configs for the given problem config.
@@ -77,7 +90,8 @@ template <typename PerformanceConfig, typename Context>
 class ComputedIterator : public std::iterator<std::input_iterator_tag, PerformanceConfig>
 {
     PerformanceConfig v;
-    const Context* p; // For Next().
+    const Context* p;       // For Next().
+    std::size_t stride = 1; // Valid configs per increment, see ComputedContainer::Shard().
 
     ComputedIterator& Next()
     {
@@ -96,10 +110,16 @@ class ComputedIterator : public std::iterator<std::input_iterator_tag, Performan
     }
 
     // Implements container's begin()
-    ComputedIterator(const Context& problem, const bool spare) : v(spare), p(&problem)
+    ComputedIterator(const Context& problem,
+                     const bool spare,
+                     const std::size_t first,
+                     const std::size_t stride_)
+        : v(spare), p(&problem), stride(stride_)
     {
         if(!v.IsValid(*p))
             Next();
+        for(std::size_t i = 0; i < first && p != nullptr; ++i)
+            Next();
     }
 
 public:
@@ -107,7 +127,12 @@ public:
     ComputedIterator() : v(), p(nullptr) {}
     // STL-like iterator shall be copy contructible. The default copy ctor is ok.
 
-    ComputedIterator& operator++() { return Next(); }
+    ComputedIterator& operator++()
+    {
+        for(std::size_t i = 0; i < stride && p != nullptr; ++i)
+            Next();
+        return *this;
+    }
     const PerformanceConfig& operator*() const { return v; }
     bool operator!=(ComputedIterator const& other) const
     {
@@ -136,6 +161,8 @@ class ComputedContainer
                      //
                      // Nevertheless, a Solver is free to either use or not use this capability
                      // (i.e. it is ok for PerformanceConfig(bool) to ignore its parameter).
+    std::size_t shard_index = 0;
+    std::size_t shard_count = 1;
 
     /// \note We do not add 'const' to keep the object assignable
     /// for the sake of flexibility. Nevertheless, all element accesses of
@@ -148,8 +175,19 @@ public:
         : problem(problem_), spare(spare_)
     {
     }
-    const_iterator begin() const { return {problem, spare}; }
+    const_iterator begin() const { return {problem, spare, shard_index, shard_count}; }
     const_iterator end() const { return {}; }
+
+    /// Every count-th config starting from the index-th one. The configs are always enumerated in
+    /// the same order, so the shards 0..count-1 are disjoint and together cover the container.
+    ComputedContainer Shard(const std::size_t index, const std::size_t count) const
+    {
+        assert(index < count);
+        auto shard        = *this;
+        shard.shard_index = shard_index + index * shard_count;
+        shard.shard_count = shard_count * count;
+        return shard;
+    }
 };
 
 template <typename PerformanceConfig>
@@ -157,6 +195,7 @@ class HeartBeat
 {
     size_t n_within_beat;
     size_t n_best;
+    size_t n_first; // Configs evaluated before the search was resumed.
     float best_time; // within beat
     float elapsed_cumulative;
     Timer timer;
@@ -170,16 +209,18 @@ class HeartBeat
     }
 
 public:
-    HeartBeat() : n_within_beat(), n_best(), best_time(), elapsed_cumulative() {}
+    HeartBeat() : n_within_beat(), n_best(), n_first(), best_time(), elapsed_cumulative() {}
 
-    void Start()
+    void Start(const size_t n_first_ = 0)
     {
+        n_first            = n_first_;
         elapsed_cumulative = 0.0f;
         best_config        = PerformanceConfig();
         Continue();
     }
 
-    void Monitor(const bool is_recent_failed,
+    /// Returns true on each beat, i.e. when the progress is reported.
+    bool Monitor(const bool is_recent_failed,
                  const float recent_time,
                  const size_t n_recent,
                  const float total_best,
@@ -199,15 +240,18 @@ public:
         {
             elapsed_cumulative += elapsed;
             const float eta_sec =
-                n_recent != 0u ? (static_cast<float>(n_total - n_recent) *
-                                  (elapsed_cumulative / static_cast<float>(n_recent)) / 1000.0f)
-                               : 0.0f; // paraniod
+                n_recent > n_first
+                    ? (static_cast<float>(n_total - n_recent) *
+                       (elapsed_cumulative / static_cast<float>(n_recent - n_first)) / 1000.0f)
+                    : 0.0f; // paraniod
             MIOPEN_LOG_W(n_recent << '/' << n_failed << '/' << n_total << ' ' << total_best
                                   << ", best within recent " << n_within_beat << ": " << best_time
                                   << " #" << n_best << ' ' << best_config << ", ETA:" << eta_sec
                                   << " sec.");
             Continue();
+            return true;
         }
+        return false;
     }
 };
 
@@ -334,147 +378,391 @@ auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParam
     auto& profile_h = context.GetStream();
     AutoEnableProfiling enableProfiling{profile_h};
 
-    auto all_configs       = GetAllConfigs(s, context);
+    const auto shard       = TuningShard{};
+    const auto all_configs = GetAllConfigs(s, context).Shard(shard.GetIndex(), shard.GetCount());
     const int n_runs_total = std::distance(all_configs.begin(), all_configs.end());
+    if(shard.IsSharded())
+        MIOPEN_LOG_W(s.SolverDbId() << ": Tuning shard " << shard << " of " << n_runs_total
+                                    << " configs");
 
     bool is_passed  = false; // left false only if all iterations failed.
     float best_time = std::numeric_limits<float>::max();
     size_t n_failed = 0;
     size_t n_best   = 0;
-    HeartBeat<PerformanceConfig> heartbeat;
-    heartbeat.Start();
 
-    if(!miopen::IsCacheDisabled()) // Otherwise precompilation is useless.
+    if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
     {
-        std::vector<KernelInfo> kernels;
-        for(const auto& current_config : all_configs)
+        if(!miopen::IsCacheDisabled()) // Otherwise precompilation is useless.
         {
-            ConvSolution current_solution = s.GetSolution(context, current_config);
-            for(auto&& kernel : current_solution.construction_params)
+            std::vector<KernelInfo> kernels;
+            for(const auto& current_config : all_configs)
             {
-                if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
-                    continue;
-                kernels.push_back(kernel);
+                ConvSolution current_solution = s.GetSolution(context, current_config);
+                for(auto&& kernel : current_solution.construction_params)
+                {
+                    if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
+                        continue;
+                    kernels.push_back(kernel);
+                }
             }
+            std::ignore = PrecompileKernels(profile_h, kernels);
         }
-        std::ignore = PrecompileKernels(profile_h, kernels);
+
+        MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
+                     "Running kernels on GPU is disabled. Search skipped");
     }
 
-    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+    // Exhaustive search measures every config. The other strategies choose a subset of the space
+    // by the times measured so far, see search_strategy.hpp.
+    const auto strategy_kind = GetSearchStrategyKind();
+    const auto is_exhaustive = strategy_kind == SearchStrategyKind::Exhaustive;
+    const auto n_planned     = is_exhaustive
+                               ? static_cast<size_t>(n_runs_total)
+                               : GetSearchStrategyBudget(static_cast<size_t>(n_runs_total));
+
+    // A search stopped by its budget (or killed) leaves a checkpoint in the user perf-db.
+    // Configs are enumerated in the same order every time, so the search resumes from the index.
+    // Only the exhaustive search can be resumed this way.
+    auto db                  = GetDb(context);
+    const auto checkpoint_id =
+        TuningCheckpoint::GetDbId(s.SolverDbId(), shard.GetIndex(), shard.GetCount());
+    const auto& budget       = context.problem.conv_problem.GetConv().tuningBudget;
+    bool has_checkpoint      = false;
+    size_t n_first           = 0;
+
+    if(is_exhaustive && !context.disable_perfdb_access)
     {
-        size_t n_current = 0;
-        for(const auto& current_config : all_configs)
+        TuningCheckpoint checkpoint;
+        PerformanceConfig config;
+        if(db.Load(context.problem, checkpoint_id, checkpoint))
         {
-            float elapsed_time = 0.0f;
-            int ret            = 0;
-            MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
-                              << current_config);
+            has_checkpoint = true;
+            if(checkpoint.total != static_cast<size_t>(n_runs_total) ||
+               checkpoint.next > checkpoint.total)
+            {
+                MIOPEN_LOG_W("Checkpoint does not match the search space, starting over");
+            }
+            else if(!checkpoint.best_config.empty() &&
+                    !(config.Deserialize(checkpoint.best_config) &&
+                      s.IsValidPerformanceConfig(context, config)))
+            {
+                MIOPEN_LOG_W("Invalid config in the checkpoint, starting over");
+            }
+            else
+            {
+                n_first  = checkpoint.next;
+                n_failed = checkpoint.n_failed;
+                if(!checkpoint.best_config.empty())
+                {
+                    is_passed   = true;
+                    best_config = config;
+                    best_time   = checkpoint.best_time;
+                    n_best      = checkpoint.n_best;
+                }
+                MIOPEN_LOG_W("Resuming the search from #" << n_first << '/' << n_failed << '/'
+                                                          << n_runs_total << ", best #" << n_best
+                                                          << ' ' << best_time << ' '
+                                                          << best_config);
+            }
+        }
+    }
 
-            ConvSolution current_solution;
-            Invoker invoker;
+    const auto save_checkpoint = [&](const size_t next) {
+        const auto is_complete = next == static_cast<size_t>(n_runs_total);
+        if((!is_exhaustive && !is_complete) || context.disable_perfdb_access)
+            return;
+        TuningCheckpoint checkpoint;
+        checkpoint.next      = next;
+        checkpoint.total     = n_runs_total;
+        checkpoint.n_failed  = n_failed;
+        checkpoint.n_best    = n_best;
+        checkpoint.best_time = best_time;
+        if(is_passed)
+        {
+            std::ostringstream config;
+            best_config.Serialize(config);
+            checkpoint.best_config = config.str();
+        }
+        db.Update(context.problem, checkpoint_id, checkpoint);
+        has_checkpoint = true;
+    };
+
+    if(budget.IsLimited())
+        MIOPEN_LOG_I("Tuning budget: " << budget);
+    Timer budget_timer;
+    budget_timer.start();
+    HeartBeat<PerformanceConfig> heartbeat;
+    heartbeat.Start(n_first);
 
-            try
-            {
-                current_solution = s.GetSolution(context, current_config);
-                if(default_solution.workspace_sz != current_solution.workspace_sz)
+    // The solutions are built on the compile service while the ones before them are measured.
+    // The queue bounds the number of programs waiting for the measurement.
+    struct Candidate
+    {
+        PerformanceConfig config;
+        ConvSolution solution;
+        std::vector<std::shared_future<Program>> programs;
+        std::exception_ptr error;
+    };
+
+    size_t n_current    = n_first;
+    bool is_interrupted = false;
+
+    // The probe of each config warms it up.
+    auto measurement_policy = MeasurementPolicy{};
+    measurement_policy.SetWarmupRuns(0);
+    MIOPEN_LOG_I2("Measurement policy: " << measurement_policy);
+
+    // Measures the configs in their order, skipping the first n_skip of them. Each config is run
+    // `runs` times, or 5 times if the 1st probe is close to the best, and the average is taken.
+    // The times are appended in the same order, failed configs get the max float.
+    const auto evaluate =
+        [&](const auto& configs, const size_t n_skip, const int runs, std::vector<float>& times) {
+            BoundedQueue<Candidate> candidates{Value(MIOPEN_DEBUG_TUNING_PIPELINE_DEPTH{}, 64)};
+            // The builds refer to the profiling handle, so none of them may be left behind.
+            const auto wait_for_builds = [](const std::vector<std::shared_future<Program>>& ps) {
+                for(const auto& program : ps)
+                    program.wait();
+            };
+            const auto produce = [&, producer_context = context]() {
+                size_t n_produced = 0;
+                for(const auto& current_config : configs)
                 {
-                    ret = -2;
-                    MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                     << "Workspace size should not depend on PerformanceConfig: "
-                                     << default_solution.workspace_sz
-                                     << " != " << current_solution.workspace_sz);
+                    if(n_produced++ < n_skip)
+                        continue;
+                    Candidate candidate;
+                    candidate.config = current_config;
+                    try
+                    {
+                        candidate.solution = s.GetSolution(producer_context, current_config);
+                        for(auto&& kernel : candidate.solution.construction_params)
+                            candidate.programs.push_back(CompileService::Get().Submit(
+                                profile_h, kernel, CompilePriority::Background));
+                    }
+                    catch(...)
+                    {
+                        candidate.error = std::current_exception();
+                    }
+                    const auto programs = candidate.programs;
+                    if(!candidates.Push(std::move(candidate)))
+                    {
+                        wait_for_builds(programs);
+                        break;
+                    }
                 }
+            };
+            QueueProducer<BoundedQueue<Candidate>> producer{candidates, produce};
 
-                invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
-                                                   current_solution.construction_params);
-                invoker(profile_h, invoke_ctx);
-                elapsed_time = profile_h.GetKernelTime();
-            }
-            catch(...)
+            Candidate candidate;
+            while(candidates.Pop(candidate))
             {
-                ret = 1;
-            }
+                const auto& current_config = candidate.config;
+                float elapsed_time         = 0.0f;
+                int ret                    = 0;
+                MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
+                                  << current_config);
 
-            MIOPEN_LOG_T("##"
-                         << "(n_current, n_failed, n_runs_total):  " << n_current << '/' << n_failed
-                         << '/' << n_runs_total << " elapsed_time: " << elapsed_time
-                         << ", best_time: " << best_time << ", " << current_config);
+                ConvSolution current_solution;
+                Invoker invoker;
 
-            if(ret == 0)
-            {
-                // Smooth the jitter of measurements:
-                // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-                // then re-run it 4 times more and compute average time,
-                // and decide using average of all 5 attempts vs. the best.
-                if(elapsed_time / best_time < 1.05f)
+                try
                 {
-                    MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time
-                                                          << " = " << (elapsed_time / best_time));
+                    if(candidate.error)
+                        std::rethrow_exception(candidate.error);
+                    current_solution = std::move(candidate.solution);
+                    if(default_solution.workspace_sz != current_solution.workspace_sz)
+                    {
+                        ret = -2;
+                        MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                                         << "Workspace size should not depend on "
+                                            "PerformanceConfig: "
+                                         << default_solution.workspace_sz
+                                         << " != " << current_solution.workspace_sz);
+                    }
 
-                    try
+                    for(std::size_t i = 0; i < candidate.programs.size(); ++i)
                     {
-                        for(int i = 0; i < 4; ++i)
-                        {
-                            invoker(profile_h, invoke_ctx);
-                            elapsed_time += profile_h.GetKernelTime();
-                        }
+                        const auto& kernel  = current_solution.construction_params[i];
+                        const auto& program = candidate.programs[i].get();
+                        if(!profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
+                            profile_h.AddProgram(program, kernel.kernel_file, kernel.comp_options);
                     }
-                    catch(...)
+
+                    invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
+                                                       current_solution.construction_params);
+                    invoker(profile_h, invoke_ctx);
+                    elapsed_time = profile_h.GetKernelTime();
+                }
+                catch(...)
+                {
+                    ret = 1;
+                }
+
+                MIOPEN_LOG_T("##"
+                             << "(n_current, n_failed, n_runs_total):  " << n_current << '/'
+                             << n_failed << '/' << n_runs_total << " elapsed_time: "
+                             << elapsed_time << ", best_time: " << best_time << ", "
+                             << current_config);
+
+                if(ret == 0)
+                {
+                    // Smooth the jitter of measurements:
+                    // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
+                    // then measure it as the policy says and decide using the reduced time.
+                    // The probe warms the kernel up. The configs far from the best are measured
+                    // again only if the strategy asks for more runs.
+                    const auto is_near_best = elapsed_time / best_time < 1.05f;
+                    if(is_near_best)
+                        MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / "
+                                                              << best_time << " = "
+                                                              << (elapsed_time / best_time));
+
+                    if(is_near_best || runs > 1)
                     {
-                        ret = 1;
+                        try
+                        {
+                            const auto stats = measurement_policy.Measure(
+                                [&]() {
+                                    invoker(profile_h, invoke_ctx);
+                                    return profile_h.GetKernelTime();
+                                },
+                                static_cast<std::size_t>(runs));
+                            MIOPEN_LOG_I2("Measured: " << stats);
+                            elapsed_time = stats.time;
+                        }
+                        catch(...)
+                        {
+                            ret = 1;
+                        }
                     }
 
                     if(ret == 0)
                     {
                         is_passed = true;
-                        elapsed_time /= 5;
                         if(elapsed_time < best_time)
                         {
-                            MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                             << ' ' << elapsed_time << " < " << best_time << ' '
-                                             << current_config);
+                            MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/'
+                                             << n_runs_total << ' ' << elapsed_time << " < "
+                                             << best_time << ' ' << current_config);
                             best_config = current_config;
                             best_time   = elapsed_time;
                             n_best      = n_current;
                         }
-                        else
+                        else if(is_near_best || runs > 1)
                         {
                             MIOPEN_LOG_I2("Average is not better: " << elapsed_time
                                                                     << " >= " << best_time);
                         }
                     }
                 }
-            }
 
-            // Banchmarked kernels will not be used anymore.
-            // Now we can delete Program objects that belong to OCL/HIP
-            // runtime and free the associated resources (memory, file handles...)
-            for(const auto& kernelInfo : current_solution.construction_params)
-                profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
+                // Banchmarked kernels will not be used anymore.
+                // Now we can delete Program objects that belong to OCL/HIP
+                // runtime and free the associated resources (memory, file handles...)
+                for(const auto& kernelInfo : current_solution.construction_params)
+                    profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
+                wait_for_builds(candidate.programs);
+                candidate.programs.clear();
 
-            if(ret != 0)
-            {
-                MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                 << " Failed rc=" << ret);
-                ++n_failed;
+                if(ret != 0)
+                {
+                    MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                                     << " Failed rc=" << ret);
+                    ++n_failed;
+                }
+                times.push_back(ret == 0 ? elapsed_time : std::numeric_limits<float>::max());
+                const bool is_beat = heartbeat.Monitor(ret != 0,
+                                                       elapsed_time,
+                                                       n_current,
+                                                       best_time,
+                                                       n_failed,
+                                                       n_planned,
+                                                       current_config);
+                ++n_current;
+
+                if((!is_exhaustive || n_current < n_planned) &&
+                   budget.IsExhausted(budget_timer.elapsed_ms() / 1000.0f, n_current - n_first))
+                {
+                    if(is_exhaustive)
+                        MIOPEN_LOG_W("Tuning budget (" << budget << ") exhausted at #"
+                                                       << n_current << '/' << n_runs_total
+                                                       << ", the next search will resume from "
+                                                          "there");
+                    else
+                        MIOPEN_LOG_W("Tuning budget (" << budget << ") exhausted at #"
+                                                       << n_current << '/' << n_planned);
+                    is_interrupted = true;
+                    break;
+                }
+                if(is_beat)
+                    save_checkpoint(n_current);
             }
-            heartbeat.Monitor(ret != 0,
-                              elapsed_time,
-                              n_current,
-                              best_time,
-                              n_failed,
-                              n_runs_total,
-                              current_config);
-            ++n_current;
-        }
+
+            // The candidates queued when the budget is exhausted are dropped, yet their builds
+            // are still done before leaving, as well as the one the producer is holding.
+            candidates.Close();
+            if(is_interrupted)
+                save_checkpoint(n_current);
+            while(candidates.Pop(candidate))
+                wait_for_builds(candidate.programs);
+            producer.Join();
+        };
+
+    if(is_exhaustive)
+    {
+        std::vector<float> times;
+        evaluate(all_configs, n_first, 1, times);
     }
     else
     {
-        MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
-                     "Running kernels on GPU is disabled. Search skipped");
+        std::vector<PerformanceConfig> space_configs;
+        std::vector<ConfigFields> space;
+        for(const auto& config : all_configs)
+        {
+            space_configs.push_back(config);
+            space.push_back(GetConfigFields(config));
+        }
+
+        std::vector<ConfigFields> known_best;
+        if(strategy_kind == SearchStrategyKind::Surrogate && !context.disable_perfdb_access)
+        {
+            std::vector<PerformanceConfig> known;
+            db.LoadAll(s.SolverDbId(), known);
+            for(const auto& config : known)
+                known_best.push_back(GetConfigFields(config));
+        }
+
+        // The same problem is searched along the same path.
+        std::ostringstream problem;
+        context.problem.Serialize(problem);
+        const auto seed = static_cast<unsigned>(std::hash<std::string>{}(problem.str()));
+
+        MIOPEN_LOG_W(s.SolverDbId() << ": " << strategy_kind << " search of up to " << n_planned
+                                    << " configs, " << known_best.size() << " known");
+        const auto strategy =
+            MakeSearchStrategy(strategy_kind, space, n_planned, known_best, seed);
+        for(auto batch = strategy->Propose(); !batch.configs.empty() && !is_interrupted;
+            batch      = strategy->Propose())
+        {
+            std::vector<PerformanceConfig> configs;
+            configs.reserve(batch.configs.size());
+            for(const auto i : batch.configs)
+                configs.push_back(space_configs[i]);
+            std::vector<float> times;
+            evaluate(configs, 0, static_cast<int>(batch.runs), times);
+            if(is_interrupted)
+                break;
+            strategy->Report(times);
+        }
     }
 
-    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
+    // A shard keeps the checkpoint of the finished search, as the best time of the shard is needed
+    // when the perf-dbs of the shards are merged.
+    if(!is_interrupted && shard.IsSharded())
+        save_checkpoint(n_runs_total);
+    else if(!is_interrupted && has_checkpoint)
+        db.Remove(context.problem, checkpoint_id);
+
+    MIOPEN_LOG_W("Done: " << n_current << '/' << n_failed << '/' << n_planned << ", best #"
                           << n_best << ' ' << best_time << ' ' << best_config);
 
     if(!is_passed)
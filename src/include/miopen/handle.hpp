@@ -27,10 +27,12 @@
 #define GUARD_MIOPEN_CONTEXT_HPP_
 
 #include <miopen/config.h>
+#include <miopen/background_find.hpp>
 #include <miopen/kernel_info.hpp>
 #include <miopen/common.hpp>
 #include <miopen/invoker_cache.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/kernel_cache_stats.hpp>
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
 #include <miopen/object.hpp>
@@ -42,6 +44,8 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <ios>
@@ -83,6 +87,28 @@ struct Handle : miopenHandle
     miopenAcceleratorQueue_t GetStream() const;
     void SetStream(miopenAcceleratorQueue_t streamID) const;
 
+    /// Creates a handle of the same device with a stream of its own, which does not wait for
+    /// the work of this handle, e.g. to run Find in background.
+    std::unique_ptr<Handle> CreateWorkerHandle() const;
+
+    /// The Find of the problems run in background for this handle. The jobs are dropped when the
+    /// handle is destroyed.
+    BackgroundFind& GetBackgroundFind() const
+    {
+        if(!background_find)
+            background_find = std::make_unique<BackgroundFind>();
+        return *background_find;
+    }
+
+    /// Set for the worker handles of the background Find, which gives up between the solvers
+    /// once it is raised.
+    std::shared_ptr<const std::atomic<bool>> cancelled;
+    void ThrowIfCancelled() const
+    {
+        if(cancelled && *cancelled)
+            MIOPEN_THROW("The Find has been cancelled");
+    }
+
     void SetAllocator(miopenAllocatorFunction allocator,
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
@@ -135,10 +161,18 @@ struct Handle : miopenHandle
                         bool is_kernel_str,
                         const std::string& kernel_src) const;
 
+    /// Programs built for one handle can be used by any handle with the same scope.
+    std::uintptr_t GetProgramScope() const;
     bool HasProgram(const std::string& program_name, const std::string& params) const;
     void ClearProgram(const std::string& program_name, const std::string& params) const;
     void AddProgram(Program prog, const std::string& program_name, const std::string& params) const;
 
+    KernelCacheStats GetKernelCacheStats() const;
+    /// Caps the programs kept by the handle, 0 means unlimited. The least recently used ones
+    /// are evicted first. Defaults come from MIOPEN_DEBUG_KERNEL_CACHE_MAX_BYTES and
+    /// MIOPEN_DEBUG_KERNEL_CACHE_MAX_PROGRAMS.
+    void SetKernelCacheLimits(std::size_t max_bytes, std::size_t max_programs) const;
+
     void Finish() const;
     void Flush() const;
 
@@ -232,7 +266,7 @@ public:
                          const std::string& solver,
                          const boost::optional<AlgorithmName>& algo = boost::none)
     {
-        invokers.Register({config, solver}, invoker);
+        invokers.Register(config, solver, invoker);
         if(algo.has_value())
             invokers.SetAsFound1_0(config, *algo, solver);
     }
@@ -248,7 +282,7 @@ public:
         {
             MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            return invokers.Get(config, *solver);
         }
         MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and algorithm "
                                                           << algo->ToString());
@@ -271,6 +305,9 @@ private:
 private:
 #endif
     InvokerCache invokers;
+    /// The last one, so that the background Find is done with the handle before the rest of it
+    /// is destroyed.
+    mutable std::unique_ptr<BackgroundFind> background_find;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Handle& handle) { return handle.Print(os); }
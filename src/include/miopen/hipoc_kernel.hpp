@@ -32,6 +32,7 @@
 #include <miopen/hipoc_program.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/op_kernel_args.hpp>
+#include <miopen/simulated_device.hpp>
 #include <vector>
 #include <memory.h>
 
@@ -125,6 +126,8 @@ struct HIPOCKernelInvoke
     std::array<size_t, 3> gdims = {};
     std::string name;
     std::function<void(hipEvent_t, hipEvent_t)> callback;
+    /// Replaces the launch on the SimulatedDevice.
+    std::function<void()> simulate;
 
     // Workaround for aggregate types in c++11
     HIPOCKernelInvoke() {}
@@ -195,7 +198,9 @@ struct HIPOCKernel
         std::copy(global_dims.begin(), global_dims.end(), gdims.begin());
 
         kernel_module = name;
-        auto status   = hipModuleGetFunction(&fun, program.GetModule(), kernel_module.c_str());
+        if(SimulatedDevice::IsEnabled()) // There is no module.
+            return;
+        auto status = hipModuleGetFunction(&fun, program.GetModule(), kernel_module.c_str());
         if(hipSuccess != status)
             MIOPEN_THROW_HIP_STATUS(status,
                                     "Failed to get function: " + kernel_module + " from " +
@@ -204,6 +209,8 @@ struct HIPOCKernel
 
     HIPOCKernelInvoke Invoke(hipStream_t stream,
                              std::function<void(hipEvent_t, hipEvent_t)> callback = nullptr) const;
+
+    KernelLaunch GetLaunch() const;
 };
 
 } // namespace miopen
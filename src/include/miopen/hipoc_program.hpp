@@ -62,6 +62,8 @@ struct HIPOCProgram
     /// \return True if CO blob resides in-memory.
     /// False if CO resides on filesystem.
     bool IsCodeObjectInMemory() const;
+    /// \return Size of the code object in bytes, 0 if unknown.
+    std::size_t GetCodeObjectSize() const;
     void FreeCodeObjectFileStorage();
 };
 } // namespace miopen
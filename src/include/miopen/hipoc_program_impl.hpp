@@ -55,6 +55,10 @@ struct HIPOCProgramImpl
     hipModulePtr module;
     boost::optional<TmpDir> dir;
     std::vector<char> binary;
+    /// Size of the code object the module was loaded from, if it is not kept in binary.
+    std::size_t code_object_size = 0;
+    /// Build options. With the names, identify the kernel launches for SimulatedDevice.
+    std::string options;
 
 #if !MIOPEN_USE_COMGR
     void
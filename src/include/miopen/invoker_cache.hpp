@@ -28,47 +28,111 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/names.hpp>
+#include <miopen/solver_id.hpp>
 
 #include <boost/optional.hpp>
 
-#include <map>
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <shared_mutex>
 #include <string>
-#include <utility>
+#include <vector>
 
 namespace miopen {
 
 class InvokerCache
 {
 public:
-    // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    InvokerCache() = default;
+    InvokerCache(InvokerCache&& other) noexcept;
+    InvokerCache& operator=(InvokerCache&& other) noexcept;
 
-    boost::optional<const Invoker&> operator[](const Key& key) const;
+    boost::optional<const Invoker&> Get(const NetworkConfig& network_config,
+                                        const solver::Id& solver_id) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
+    boost::optional<const Invoker&> GetFound1_0(const NetworkConfig& network_config,
                                                 const std::string& algorithm) const;
-    boost::optional<const std::string&> GetFound1_0SolverId(const std::string& network_config,
+    boost::optional<const std::string&> GetFound1_0SolverId(const NetworkConfig& network_config,
                                                             const std::string& algorithm) const;
 
-    void Register(const Key& key, const Invoker& invoker);
+    void Register(const NetworkConfig& network_config,
+                  const std::string& solver_id,
+                  const Invoker& invoker);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
+    void SetAsFound1_0(const NetworkConfig& network_config,
                        const std::string& algorithm,
                        const std::string& solver_id);
 
 private:
-    struct Item
+    // Never changed after registration, so readers may keep pointers to them.
+    struct InvokerEntry
     {
-        // algorithm -> solver_id
-        // for find 1.0
-        std::map<std::string, std::string> found_1_0;
-        // solver_id -> invoker
-        std::map<std::string, Invoker> invokers;
+        NetworkConfig network_config;
+        solver::Id solver;
+        std::string solver_id;
+        Invoker invoker;
     };
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    struct Found1_0Entry
+    {
+        NetworkConfig network_config;
+        std::string algorithm;
+        const InvokerEntry* best;
+    };
+
+    // Open addressing with linear probing over indices into a stable container.
+    class FlatIndex
+    {
+    public:
+        template <class Match>
+        std::size_t Find(std::size_t hash, const Match& match) const
+        {
+            if(slots.empty())
+                return npos;
+            const auto mask = slots.size() - 1;
+            for(auto i = hash & mask;; i = (i + 1) & mask)
+            {
+                const auto& slot = slots[i];
+                if(slot.index == npos)
+                    return npos;
+                if(slot.hash == hash && match(slot.index))
+                    return slot.index;
+            }
+        }
+
+        void Insert(std::size_t hash, std::size_t index);
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    private:
+        struct Slot
+        {
+            std::size_t hash  = 0;
+            std::size_t index = npos;
+        };
+
+        std::vector<Slot> slots;
+        std::size_t size = 0;
+    };
+
+    static std::size_t HashOf(const NetworkConfig& network_config, const solver::Id& solver);
+    static std::size_t HashOf(const NetworkConfig& network_config, const std::string& algorithm);
+
+    const InvokerEntry* FindUnsafe(const NetworkConfig& network_config,
+                                   const solver::Id& solver) const;
+    std::size_t FindFound1_0Unsafe(const NetworkConfig& network_config,
+                                   const std::string& algorithm) const;
+
+    mutable std::shared_timed_mutex mutex;
+    std::deque<InvokerEntry> invokers;
+    FlatIndex invokers_index;
+    std::deque<Found1_0Entry> found_1_0;
+    FlatIndex found_1_0_index;
+    // Immediate mode tends to run the same invoker again and again.
+    mutable std::atomic<const InvokerEntry*> last_used{nullptr};
 };
 
 } // namespace miopen
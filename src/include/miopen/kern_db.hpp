@@ -75,35 +75,50 @@ struct KernelConfig
            << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);";
         return ss.str();
     }
-    std::string Where() const
-    {
-        std::ostringstream ss;
-        ss << "(kernel_name = '" << kernel_name << "')"
-           << " AND (kernel_args = '" << kernel_args << "')";
-        return ss.str();
-    }
+    static std::string WhereClause() { return "(kernel_name = ?) AND (kernel_args = ?)"; }
+    std::vector<std::string> WhereValues() const { return {kernel_name, kernel_args}; }
 };
 
+/// Kernel binaries stored in the user database are content-addressed: kern_db rows keep only
+/// the md5 of the binary and the binary itself is stored once in kern_blob, however many kernels
+/// it is built for. Rows with the binary inline, as in the system databases, are still read.
 class KernDb : public SQLiteBase<KernDb>
 {
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
+    bool has_blob_table    = false;
+    std::size_t size_limit = 0;
 
 public:
+    /// How a binary is stored in kern_blob.
+    enum class Codec
+    {
+        None = 0,
+        Bz2  = 1,
+        Lz   = 2,
+    };
+
     KernDb(const std::string& filename_, bool is_system);
     // This constructor is only intended for testing
     KernDb(const std::string& filename_,
            bool is_system_,
            std::function<std::string(std::string, bool*)> compress_fn_,
            std::function<std::string(std::string, unsigned int)> decompress_fn_);
+
+    /// Total size of the stored binaries above which the least recently used ones are removed,
+    /// 0 means unlimited. Defaults to MIOPEN_USER_KERNEL_DB_MAX_MB.
+    void SetSizeLimit(std::size_t bytes) { size_limit = bytes; }
+    /// Size of the binaries stored in kern_blob, after compression.
+    std::size_t GetBlobsSize() const;
+
     template <typename T>
     bool RemoveRecordUnsafe(const T& problem_config)
     {
         if(filename.empty())
             return true;
-        auto del_query =
-            "DELETE FROM " + T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, del_query};
+        static const auto del_query =
+            "DELETE FROM " + T::table_name() + " WHERE " + T::WhereClause() + ";";
+        auto stmt = SQLite::Statement{sql, del_query, problem_config.WhereValues()};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
             return true;
@@ -119,22 +134,24 @@ public:
     {
         if(filename.empty())
             return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
+        static const auto select_query =
+            "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " + T::table_name() +
+            " WHERE " + T::WhereClause() + ";";
+        auto stmt = SQLite::Statement{sql, select_query, problem_config.WhereValues()};
         // only one result field
         // assert one row
         auto rc = stmt.Step(sql);
         if(rc == SQLITE_ROW)
         {
-            auto compressed_blob           = stmt.ColumnBlob(0);
-            auto md5_hash                  = stmt.ColumnText(1);
-            auto uncompressed_size         = stmt.ColumnInt64(2);
+            auto compressed_blob   = stmt.ColumnBlob(0);
+            auto md5_hash          = stmt.ColumnText(1);
+            auto uncompressed_size = stmt.ColumnInt64(2);
+            if(compressed_blob.empty() && has_blob_table)
+                return FindBlob(md5_hash);
             std::string& decompressed_blob = compressed_blob;
             if(uncompressed_size != 0)
             {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
+                decompressed_blob = decompress(compressed_blob, uncompressed_size);
             }
             auto new_md5 = md5(decompressed_blob);
             if(new_md5 != md5_hash)
@@ -151,35 +168,36 @@ public:
     template <typename T>
     bool StoreRecordUnsafe(const T& problem_config)
     {
-        if(filename.empty())
+        if(filename.empty() || !has_blob_table)
             return false;
-        auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
-                            "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
-        auto md5_sum           = md5(problem_config.kernel_blob);
-        auto uncompressed_size = problem_config.kernel_blob.size();
-        bool success           = false;
-        auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
-        auto stmt              = SQLite::Statement{sql, insert_query};
+        static const auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
+                                         "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
+                                         "uncompressed_size) VALUES(?, ?, x'', ?, 0);";
+        const auto md5_sum = md5(problem_config.kernel_blob);
+
+        // A failed insert rolls the blob back too, so none is left without a row.
+        SQLite::Batch batch{sql};
+        StoreBlob(md5_sum, problem_config.kernel_blob);
+        auto stmt = SQLite::Statement{sql, insert_query};
         stmt.BindText(1, problem_config.kernel_name);
         stmt.BindText(2, problem_config.kernel_args);
-        if(!success)
-        {
-            stmt.BindBlob(3, problem_config.kernel_blob);
-            stmt.BindInt64(5, 0);
-        }
-        else
-        {
-            stmt.BindBlob(3, compressed_blob);
-            stmt.BindInt64(5, uncompressed_size);
-        }
-        stmt.BindText(4, md5_sum);
-
+        stmt.BindText(3, md5_sum);
         auto rc = stmt.Step(sql);
         if(rc != SQLITE_DONE)
             MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        Evict();
+        batch.Commit();
         return true;
     }
+
+private:
+    boost::optional<std::string> FindBlob(const std::string& md5_hash);
+    void StoreBlob(const std::string& md5_hash, const std::string& blob);
+    /// Removes the least recently used binaries, and the kernels built to them, until the
+    /// stored size fits into the limit.
+    void Evict();
+    /// Drops everything stored by other MIOpen or compiler versions.
+    void PurgeOtherVersions();
 };
 } // namespace miopen
 #endif
@@ -44,8 +44,10 @@
 
 #include <miopen/handle.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/kernel_cache_stats.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <list>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -55,14 +57,26 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * Programs are kept in LRU order. When a limit on the number of programs or on their
+ * code object bytes is set, the least recently used programs are evicted together with
+ * the kernels built from them. References returned by GetKernels() stay valid only
+ * until the next program is added.
  */
 class KernelCache
 {
 
 public:
-    using Key        = std::pair<std::string, std::string>;
+    using Key = std::pair<std::string, std::string>;
+
+    struct ProgramEntry
+    {
+        Program program;
+        std::size_t bytes;
+        std::list<Key>::iterator lru;
+    };
+
     using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using ProgramMap = std::unordered_map<Key, ProgramEntry, SimpleHash>;
 
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
@@ -90,11 +104,27 @@ public:
 
     void AddProgram(Program prog, const std::string& program_name, std::string params);
 
+    KernelCacheStats GetStats() const;
+    /// 0 means unlimited.
+    void SetLimits(std::size_t max_bytes, std::size_t max_programs);
+
     KernelCache();
 
 private:
     KernelMap kernel_map;
     ProgramMap program_map;
+    // Most recently used program first.
+    std::list<Key> lru;
+    // Kernel key -> keys of the programs its kernels were built from, and back.
+    std::unordered_map<Key, std::vector<Key>, SimpleHash> kernel_programs;
+    std::unordered_map<Key, std::vector<Key>, SimpleHash> program_kernels;
+    KernelCacheStats stats;
+
+    void TouchProgram(const Key& key);
+    void InsertProgram(const Key& key, const Program& program);
+    void EraseProgram(ProgramMap::iterator it);
+    void EraseKernels(const Key& key);
+    void Evict(const Key& keep);
 };
 
 } // namespace miopen
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+namespace miopen {
+
+/// Counters of the per-handle cache of compiled programs and kernels.
+struct KernelCacheStats
+{
+    /// Program and kernel lookups served from the cache.
+    std::size_t hits = 0;
+    /// Program and kernel lookups that were not.
+    std::size_t misses = 0;
+    /// Programs dropped to stay within the limits, with the kernels built from them.
+    std::size_t evictions = 0;
+    std::size_t programs  = 0;
+    std::size_t kernels   = 0;
+    /// Code object bytes held by the cached programs.
+    std::size_t bytes = 0;
+    /// Limits, 0 means unlimited.
+    std::size_t max_bytes    = 0;
+    std::size_t max_programs = 0;
+};
+
+} // namespace miopen
@@ -35,6 +35,7 @@
 namespace miopen {
 
 struct Handle;
+enum class CompilePriority;
 
 namespace solver {
 
@@ -50,6 +51,11 @@ struct KernelInfo
     friend std::ostream& operator<<(std::ostream& os, const KernelInfo& k);
 };
 
+/// Builds the kernels on the compile service threads, without adding them to the handle.
+std::vector<Program> PrecompileKernels(const Handle& h,
+                                       const std::vector<KernelInfo>& kernels,
+                                       CompilePriority priority);
+/// Same as above with the background priority used for tuning.
 std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels);
 
 } // namespace solver
@@ -0,0 +1,42 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LZ_HPP_
+#define GUARD_MIOPEN_LZ_HPP_
+
+#include <string>
+
+namespace miopen {
+
+/// Fast byte-oriented LZ77 codec producing the LZ4 block format. It compresses code objects
+/// nearly as well as bzip2 at a fraction of the cost, and decompresses much faster.
+/// The data is returned as is and *compressed is set to false when it does not shrink.
+std::string lz_compress(const std::string& s, bool* compressed = nullptr);
+/// Throws when the data is corrupt or does not decompress to exactly size bytes.
+std::string lz_decompress(const std::string& s, unsigned int size);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LZ_HPP_
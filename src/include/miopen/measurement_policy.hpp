@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_MEASUREMENT_POLICY_HPP_
+#define GUARD_MIOPEN_MEASUREMENT_POLICY_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+namespace miopen {
+
+enum class TimingReduction
+{
+    Median,
+    TrimmedMean, // Mean of the samples between the 20th and 80th percentile.
+    Mean,
+};
+
+std::ostream& operator<<(std::ostream& os, TimingReduction reduction);
+
+/// Kernel time in ms reduced from a number of runs.
+struct TimingStats
+{
+    float time          = 0.0f;
+    float variance      = 0.0f; // Of the single run times, outliers excluded.
+    std::size_t runs    = 0;    // Warmup runs excluded.
+    std::size_t inliers = 0;    // Runs the variance is estimated from.
+
+    /// Half-width of the 95% confidence interval of the time, relative to the time.
+    float RelativeCI() const;
+
+    friend std::ostream& operator<<(std::ostream& os, const TimingStats& stats);
+};
+
+/// How the kernel times are measured when the solutions are compared: by Find (find-db) and by
+/// the auto-tune (perf-db). The kernel is run a few times to warm up the caches and clocks, then
+/// until the confidence interval of the time is narrow enough, and the samples are reduced by a
+/// statistic that is robust to outliers.
+class MeasurementPolicy
+{
+    std::size_t warmup_runs;
+    std::size_t min_runs;
+    std::size_t max_runs;
+    float max_relative_ci;
+    TimingReduction reduction;
+
+public:
+    /// Takes the defaults from MIOPEN_MEASURE_WARMUP_RUNS, MIOPEN_MEASURE_MIN_RUNS,
+    /// MIOPEN_MEASURE_MAX_RUNS, MIOPEN_MEASURE_CI_PERCENT and MIOPEN_MEASURE_REDUCTION.
+    MeasurementPolicy();
+
+    std::size_t GetWarmupRuns() const { return warmup_runs; }
+    std::size_t GetMinRuns() const { return min_runs; }
+    std::size_t GetMaxRuns() const { return max_runs; }
+    float GetMaxRelativeCI() const { return max_relative_ci; }
+    TimingReduction GetReduction() const { return reduction; }
+    void SetWarmupRuns(std::size_t const v) { warmup_runs = v; }
+    void SetMinRuns(std::size_t const v) { min_runs = v; }
+    void SetMaxRuns(std::size_t const v) { max_runs = v; }
+    void SetMaxRelativeCI(float const v) { max_relative_ci = v; }
+    void SetReduction(TimingReduction const v) { reduction = v; }
+
+    /// Measures the kernel by calling run, which launches it once and returns its time in ms.
+    /// At least min_runs_ runs are made if that is more than the policy says.
+    /// Exceptions thrown by run are propagated.
+    TimingStats Measure(const std::function<float()>& run, std::size_t min_runs_ = 0) const;
+
+    /// Reduces the samples. Does not run anything, so may be used for the times got elsewhere.
+    TimingStats Reduce(std::vector<float> samples) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const MeasurementPolicy& policy);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MEASUREMENT_POLICY_HPP_
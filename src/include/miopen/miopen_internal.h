@@ -65,6 +65,12 @@ extern "C" {
  * compilation time.slow-compiling kernels. Faster start-up times than Hybrid Find, but GPU
  * performance may be a bit worse.
  *
+ * * Background: Checks the Find-db for an entry. If there is a hit, uses that entry. If there is a
+ * miss, utilizes the Immediate mode fallback at once and runs the Normal Find of the problem on a
+ * background thread, with a stream of its own. Its results are written to the user Find-db and
+ * used by the later calls for the same problem. No start-up delay, and no GPU performance drop
+ * once the background Find is done.
+ *
  * * The default find mode may be queried by using the miopenGetConvolutionFindMode API described
  * below
  */
@@ -75,6 +81,7 @@ typedef enum
     miopenConvolutionFindModeHybrid        = 3, /*!< Hybrid mode */
     miopenConvolutionFindModeReserved_4    = 4, /*!< Reserved - do not use */
     miopenConvolutionFindModeDynamicHybrid = 5, /*!< Dynamic Hybrid mode */
+    miopenConvolutionFindModeBackground    = 6, /*!< Background mode */
 } miopenConvolutionFindMode_t;
 
 /*! @brief Sets the Find Mode attribute in the convolution descriptor.
@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <string>
 
 namespace miopen {
@@ -34,11 +36,32 @@ struct NetworkConfig
 {
     NetworkConfig() = default;
     explicit NetworkConfig(const std::string& value_) : value(value_) {}
+    NetworkConfig(const std::string& value_, std::size_t interned_id_)
+        : value(value_), interned_id(interned_id_)
+    {
+    }
     operator std::string() const { return value; }
     std::string ToString() const { return value; }
+    /// Non-zero when the config was made from an interned problem key
+    /// (see conv::InternedProblemKey). Equal ids mean equal values.
+    std::size_t GetInternedId() const { return interned_id; }
+    std::size_t GetHash() const { return hash; }
+
+    friend bool operator==(const NetworkConfig& left, const NetworkConfig& right)
+    {
+        if(left.interned_id != 0 && left.interned_id == right.interned_id)
+            return true;
+        return left.hash == right.hash && left.value == right.value;
+    }
+    friend bool operator!=(const NetworkConfig& left, const NetworkConfig& right)
+    {
+        return !(left == right);
+    }
 
 private:
     std::string value;
+    std::size_t interned_id = 0;
+    std::size_t hash        = std::hash<std::string>{}(value);
 };
 
 struct AlgorithmName
@@ -27,12 +27,13 @@
 #ifndef MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
+#include <miopen/thread_pool.hpp>
+
 #include <algorithm>
-#include <cassert>
-#include <cmath>
-#include <functional>
-#include <numeric>
-#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
 
 #ifdef __MINGW32__
 #include <mingw.thread.h>
@@ -59,51 +60,106 @@ struct joinable_thread : std::thread
     }
 };
 
-struct thread_factory
+struct par_for_state
 {
+    std::size_t n         = 0;
+    std::size_t grainsize = 1;
+    std::size_t runners   = 1;
+    cancel_token* token   = nullptr;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> running{0};
+    std::atomic<bool> failed{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    bool stopped() const
+    {
+        return failed.load(std::memory_order_relaxed) || (token != nullptr && token->cancelled());
+    }
+
+    // Chunks shrink with the remaining work, large ones keep the overhead low for balanced work
+    // and the small ones at the end balance the skewed one.
+    bool grab(std::size_t& start, std::size_t& last)
+    {
+        const auto taken = std::min(n, next.load(std::memory_order_relaxed));
+        const auto chunk = std::max(grainsize, (n - taken) / (2 * runners));
+        start            = next.fetch_add(chunk, std::memory_order_relaxed);
+        if(start >= n)
+            return false;
+        last = std::min(n, start + chunk);
+        return true;
+    }
+
     template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
+    void run(F f)
     {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
+        std::size_t start = 0;
+        std::size_t last  = 0;
+        try
+        {
+            while(!stopped() && grab(start, last))
             {
-                f(i);
+                for(std::size_t i = start; i < last && !stopped(); i++)
+                    f(i);
             }
-        });
-        work += grainsize;
-        return result;
+        }
+        catch(...)
+        {
+            const std::lock_guard<std::mutex> lock{error_mutex};
+            if(!error)
+                error = std::current_exception();
+            failed = true;
+        }
+        running.fetch_sub(1, std::memory_order_acq_rel);
     }
 };
 
+/// Runs f(i) for every i in [0, n) on at most threadsize threads of the shared pool. The
+/// calling thread takes part in it. The first exception thrown by f cancels the indices that
+/// have not started yet and is rethrown here.
 template <class F>
-void par_for_impl(std::size_t n, std::size_t threadsize, F f)
+void par_for_impl(std::size_t n,
+                  std::size_t threadsize,
+                  std::size_t grainsize,
+                  cancel_token* token,
+                  F f)
 {
+    auto& pool = thread_pool::get();
+    threadsize = std::min(threadsize, pool.size());
+
     if(threadsize <= 1)
     {
-        for(std::size_t i = 0; i < n; i++)
+        for(std::size_t i = 0; i < n && (token == nullptr || !token->cancelled()); i++)
             f(i);
+        return;
     }
-    else
+
+    par_for_state state;
+    state.n         = n;
+    state.grainsize = std::max<std::size_t>(grainsize, 1);
+    state.runners   = threadsize;
+    state.token     = token;
+    state.running   = threadsize;
+
+    for(std::size_t i = 1; i < threadsize; i++)
+        pool.push([&state, &f] { state.run(f); });
+    state.run(f);
+
+    // The tasks refer to this frame, so wait for all of them even if the work is done.
+    while(state.running.load(std::memory_order_acquire) != 0)
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        if(!pool.try_run_one())
+            std::this_thread::yield();
     }
+
+    if(state.error)
+        std::rethrow_exception(state.error);
 }
 
 template <class F>
-void par_for(std::size_t n, std::size_t min_grain, F f)
+void par_for_impl(std::size_t n, std::size_t threadsize, F f)
 {
-    const auto threadsize =
-        std::min<std::size_t>(std::thread::hardware_concurrency(), n / min_grain);
-    par_for_impl(n, threadsize, f);
+    par_for_impl(n, threadsize, 1, nullptr, f);
 }
 
 struct min_grain
@@ -111,11 +167,24 @@ struct min_grain
     std::size_t n = 0;
 };
 
+template <class F>
+void par_for(std::size_t n, min_grain mg, cancel_token& token, F f)
+{
+    const auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), n / mg.n);
+    par_for_impl(n, threadsize, mg.n, &token, f);
+}
+
 template <class F>
 void par_for(std::size_t n, min_grain mg, F f)
 {
     const auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), n / mg.n);
-    par_for_impl(n, threadsize, f);
+    par_for_impl(n, threadsize, mg.n, nullptr, f);
+}
+
+template <class F>
+void par_for(std::size_t n, std::size_t min_grain_size, F f)
+{
+    par_for(n, min_grain{min_grain_size}, f);
 }
 
 template <class F>
@@ -136,16 +205,12 @@ void par_for(std::size_t n, max_threads mt, F f)
     par_for_impl(n, std::min(threadsize, n), f);
 }
 
+/// Same as par_for with max_threads, kept for the old callers. The indices used to be dealt
+/// round-robin to the threads, now they are taken one by one as the threads get free.
 template <class F>
 void par_for_strided(std::size_t n, max_threads mt, F f)
 {
-    auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), mt.n);
-    par_for_impl(threadsize, threadsize, [&](auto start) {
-        for(std::size_t i = start; i < n; i += threadsize)
-        {
-            f(i);
-        }
-    });
+    par_for(n, mt, f);
 }
 
 } // namespace miopen
@@ -41,6 +41,7 @@ struct PerfField
     std::string solver_id;
     float time;
     std::size_t workspace;
+    float variance = 0.0f;
 
     bool operator<(const PerfField& p) const { return (time < p.time); }
 };
@@ -54,14 +55,21 @@ struct FindDbData : solver::Serializable<FindDbData>
     /// solver doesn't use kernel cache and doesn't require a validation of built kernel existence.
     // Todo: remove when all finds will support invokers
     FindDbKCacheKey kcache_key;
+    /// Of the kernel time measurements, see MeasurementPolicy. Zero if unknown.
+    float variance;
 
-    FindDbData() : solver_id("<invalid>"), time(-1), workspace(-1) {}
+    FindDbData() : solver_id("<invalid>"), time(-1), workspace(-1), variance(0) {}
 
     FindDbData(const std::string& solver_id_,
                float time_,
                std::size_t workspace_,
-               const FindDbKCacheKey& kcache_key_)
-        : solver_id(solver_id_), time(time_), workspace(workspace_), kcache_key(kcache_key_)
+               const FindDbKCacheKey& kcache_key_,
+               float variance_ = 0.0f)
+        : solver_id(solver_id_),
+          time(time_),
+          workspace(workspace_),
+          kcache_key(kcache_key_),
+          variance(variance_)
     {
         if(!kcache_key.IsValid())
             MIOPEN_THROW("Invalid kernel cache key: " + kcache_key.algorithm_name + ", " +
@@ -76,6 +84,14 @@ struct FindDbData : solver::Serializable<FindDbData>
         f(self.workspace, "workspace");
         f(self.kcache_key.algorithm_name, "kcache_key::algorithm_name");
         f(self.kcache_key.network_config, "kcache_key::network_confing");
+        f(self.variance, "variance");
+    }
+
+    /// The records written before the variance was stored are read with zero variance.
+    bool Deserialize(const std::string& s)
+    {
+        return solver::Serializable<FindDbData>::Deserialize(s) ||
+               solver::Serializable<FindDbData>::Deserialize(s + ",0");
     }
 };
 
@@ -26,14 +26,18 @@
 #pragma once
 
 #include <miopen/db.hpp>
+#include <miopen/db_journal.hpp>
 #include <miopen/db_record.hpp>
 
 #include <boost/optional.hpp>
 
 #include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <sstream>
+#include <vector>
 
 // Value of one enables experimental write-through feature of RamDb.
 // It provides some performance gain in case of multi-threaded cache write operations.
@@ -61,6 +65,7 @@ public:
     RamDb& operator=(RamDb&&) = delete;
 
     static std::string GetTimeFilePath(const std::string& path);
+    static ramdb_clock::time_point GetDbModificationTime(const std::string& path);
     static RamDb& GetCached(const std::string& path, bool is_system);
 
     static RamDb& GetCached(const std::string& path,
@@ -89,6 +94,20 @@ public:
         return record->GetValues(id, value);
     }
 
+    /// Appends VALUES under the ID from all the records, e.g. all the tuned configs of a solver.
+    /// Returns false if there are none.
+    template <class TValue>
+    bool LoadAll(const std::string& id, std::vector<TValue>& values)
+    {
+        const auto size = values.size();
+        ForEachRecord([&](const DbRecord& record) {
+            TValue value;
+            if(record.GetValues(id, value))
+                values.push_back(value);
+        });
+        return values.size() > size;
+    }
+
     bool StoreRecord(const DbRecord& record);
     bool UpdateRecord(DbRecord& record);
     bool RemoveRecord(const std::string& key);
@@ -130,17 +149,26 @@ private:
 
     ramdb_clock::time_point file_read_time;
     std::map<std::string, CacheItem> cache;
+    std::unique_ptr<DbJournal> journal;
 
     boost::optional<miopen::DbRecord> FindRecordUnsafe(const std::string& problem);
+    void ForEachRecord(const std::function<void(const DbRecord&)>& f);
 
     bool ValidateUnsafe();
     void Prefetch();
+    void ApplyJournalUnsafe();
+    void OnJournalFlushUnsafe(bool is_complete);
 
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
     void UpdateCacheEntryUnsafe(const DbRecord& record);
 #endif
 };
 
+template <>
+struct IsDbCacheable<RamDb> : std::true_type
+{
+};
+
 /// \todo This is modified copy of code from db.hpp. Make a proper fix.
 template <>
 // cppcheck-suppress noConstructor
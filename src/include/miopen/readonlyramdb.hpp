@@ -26,13 +26,16 @@
 #ifndef MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 #define MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 
+#include <miopen/compiled_db.hpp>
 #include <miopen/db_record.hpp>
 
 #include <boost/optional.hpp>
 
+#include <functional>
 #include <unordered_map>
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace miopen {
 
@@ -50,6 +53,10 @@ public:
     boost::optional<DbRecord> FindRecord(const std::string& problem) const
     {
         MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+
+        if(compiled.IsOpen())
+            return FindCompiledRecord(problem);
+
         const auto it = cache.find(problem);
 
         if(it == cache.end())
@@ -87,6 +94,22 @@ public:
         return record->GetValues(id, value);
     }
 
+    /// Appends VALUES under the ID from all the records, e.g. all the tuned configs of a solver.
+    /// Returns false if there are none.
+    template <class TValue>
+    bool LoadAll(const std::string& id, std::vector<TValue>& values) const
+    {
+        const auto size = values.size();
+        ForEachRecord([&](const DbRecord& record) {
+            TValue value;
+            if(record.GetValues(id, value))
+                values.push_back(value);
+        });
+        return values.size() > size;
+    }
+
+    void ForEachRecord(const std::function<void(const DbRecord&)>& f) const;
+
 private:
     struct CacheItem
     {
@@ -96,6 +119,7 @@ private:
 
     std::string db_path;
     std::unordered_map<std::string, CacheItem> cache;
+    CompiledDb compiled;
 
     ReadonlyRamDb(const ReadonlyRamDb&) = default;
     ReadonlyRamDb(ReadonlyRamDb&&)      = default;
@@ -104,6 +128,8 @@ private:
 
     void Prefetch(bool warn_if_unreadable);
     void ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable);
+    bool TryOpenCompiled();
+    boost::optional<DbRecord> FindCompiledRecord(const std::string& problem) const;
 };
 
 } // namespace miopen
@@ -28,17 +28,33 @@
 
 #include <miopen/miopen.h>
 
+#include <miopen/find_controls.hpp>
 #include <miopen/object.hpp>
 
+#include <cstddef>
 #include <limits>
+#include <vector>
 
 namespace miopen {
 
+struct SolutionCost
+{
+    float time;
+    std::size_t workspace;
+};
+
 struct FindOptions : miopenFindOptions
 {
-    bool exhaustive_search                 = false;
-    miopenFindResultsOrder_t results_order = miopenFindResultsOrderByTime;
-    std::size_t workspace_limit            = std::numeric_limits<std::size_t>::max();
+    bool exhaustive_search                       = false;
+    miopenFindResultsOrder_t results_order       = miopenFindResultsOrderByTime;
+    std::size_t workspace_limit                  = std::numeric_limits<std::size_t>::max();
+    miopenFindSelectionPolicy_t selection_policy = miopenFindSelectionAll;
+    float time_tolerance                         = 0.05f;
+    TuningBudget tuning_budget;
+
+    /// Applies the workspace limit, the selection policy and the results order. Returns the
+    /// indices of the selected candidates, in the order of the results.
+    std::vector<std::size_t> Select(const std::vector<SolutionCost>& candidates) const;
 };
 
 } // namespace miopen
@@ -54,6 +70,16 @@ inline std::ostream& operator<<(std::ostream& stream, const miopen::FindOptions&
     case miopenFindResultsOrderByWorkspaceSize: stream << "by workspace size"; break;
     }
     stream << ", workspace limit: " << options.workspace_limit;
+    stream << ", selection: ";
+    switch(options.selection_policy)
+    {
+    case miopenFindSelectionAll: stream << "all"; break;
+    case miopenFindSelectionParetoFront: stream << "pareto front"; break;
+    case miopenFindSelectionMinWorkspaceWithinTimeTolerance:
+        stream << "min workspace within " << options.time_tolerance << " of the best time";
+        break;
+    }
+    stream << ", tuning budget: " << options.tuning_budget;
     stream << ")";
     return stream;
 }
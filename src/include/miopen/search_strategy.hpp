@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+#define GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Decides which performance configs GenericSearch measures, and in which order.
+/// All but Exhaustive measure a fraction of the search space, see MIOPEN_TUNING_STRATEGY.
+enum class SearchStrategyKind
+{
+    Exhaustive, // Every config, in the order of enumeration.
+    Random,     // Uniform sample.
+    Halving,    // Uniform sample, survivors of each round are re-measured with more runs.
+    Coordinate, // Descent along one tunable field at a time, from the best of a small sample.
+    Surrogate,  // Descent from the configs ranked best by a model of the perf-db records.
+};
+
+std::ostream& operator<<(std::ostream& os, SearchStrategyKind kind);
+
+/// Reads MIOPEN_TUNING_STRATEGY.
+SearchStrategyKind GetSearchStrategyKind();
+
+/// Number of configs a non-exhaustive strategy aims to measure out of space_size,
+/// see MIOPEN_TUNING_STRATEGY_PERCENT.
+std::size_t GetSearchStrategyBudget(std::size_t space_size);
+
+/// Configs as the strategies see them: the tunable fields, split out of the serialized form.
+/// This way the strategies work with any PerformanceConfig.
+using ConfigFields = std::vector<std::string>;
+
+ConfigFields SplitConfigFields(const std::string& serialized);
+
+template <class PerformanceConfig>
+ConfigFields GetConfigFields(const PerformanceConfig& config)
+{
+    std::ostringstream ss;
+    config.Serialize(ss);
+    return SplitConfigFields(ss.str());
+}
+
+struct SearchBatch
+{
+    std::vector<std::size_t> configs; // Indices into the search space.
+    std::size_t runs = 1;             // Number of measurements to average for each config.
+};
+
+class SearchStrategy
+{
+public:
+    virtual ~SearchStrategy() = default;
+
+    /// Returns the next configs to measure. Empty batch ends the search.
+    virtual SearchBatch Propose() = 0;
+
+    /// Reports the times of the last proposed batch, in the same order.
+    /// Failed configs are reported as std::numeric_limits<float>::max().
+    virtual void Report(const std::vector<float>& times) = 0;
+};
+
+/// \param space      All the valid configs, in the order of enumeration.
+/// \param budget     Number of distinct configs to measure, see GetSearchStrategyBudget().
+/// \param known_best Configs the solver has been tuned to for other problems, e.g. from the
+///                   perf-db. Used by the Surrogate strategy, which falls back to Coordinate
+///                   when there are none.
+/// \param seed       Seed of the random choices, the search is reproducible for the same seed.
+std::unique_ptr<SearchStrategy> MakeSearchStrategy(SearchStrategyKind kind,
+                                                   const std::vector<ConfigFields>& space,
+                                                   std::size_t budget,
+                                                   const std::vector<ConfigFields>& known_best,
+                                                   unsigned seed);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
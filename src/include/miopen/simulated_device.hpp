@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_SIMULATED_DEVICE_HPP_
+#define GUARD_MIOPEN_SIMULATED_DEVICE_HPP_
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+/// A kernel launch as seen by the cost models of the simulated device.
+struct KernelLaunch
+{
+    std::string program;
+    std::string kernel;
+    std::string options; // Build options.
+    std::array<std::size_t, 3> ldims = {};
+    std::array<std::size_t, 3> gdims = {};
+
+    /// program|kernel|gdims|ldims|options, e.g. MIOpenConv1x1.cl|MIOpenConv1x1|64,1,1|64,1,1|-DX=1
+    std::string GetKey() const;
+};
+
+class KernelCostModel
+{
+public:
+    virtual ~KernelCostModel() = default;
+
+    /// Returns the time of the launch in ms, none if the model can't tell it.
+    virtual boost::optional<float> GetTime(const KernelLaunch& launch) const = 0;
+};
+
+/// Estimates the time from the launch geometry: the groups run in rounds, as many at once as the
+/// wave and group slots of the compute units let, and a round lasts the latency of a wave or the
+/// time the unit takes to issue its resident waves, whichever is longer. So the tail of the last
+/// round, partial waves and low occupancy cost time. The work of a work item is not known, so
+/// it is taken to be the same for every launch.
+class AnalyticCostModel : public KernelCostModel
+{
+public:
+    AnalyticCostModel(std::size_t compute_units_) : compute_units(compute_units_) {}
+
+    boost::optional<float> GetTime(const KernelLaunch& launch) const override;
+
+private:
+    std::size_t compute_units;
+};
+
+/// Replays the times recorded by KernelTimeRecorder on a real device: the median of the times
+/// recorded for the launch.
+class ReplayCostModel : public KernelCostModel
+{
+public:
+    /// Throws if the file can't be read.
+    void Load(const std::string& path);
+    void Add(const std::string& key, float time);
+    std::size_t GetSize() const { return times.size(); }
+
+    boost::optional<float> GetTime(const KernelLaunch& launch) const override;
+
+private:
+    std::unordered_map<std::string, std::vector<float>> times;
+};
+
+/// Appends the times of the kernels profiled on the device to a file, one "time<TAB>key" line
+/// per launch, see KernelLaunch::GetKey().
+class KernelTimeRecorder
+{
+public:
+    KernelTimeRecorder(const std::string& path);
+
+    /// Returns the recorder of the file set by MIOPEN_DEBUG_KERNEL_TIME_RECORD, null if unset.
+    static KernelTimeRecorder* Get();
+
+    void Record(const KernelLaunch& launch, float time);
+
+private:
+    std::mutex mutex;
+    std::ofstream file;
+};
+
+/// Makes the HIPNOGPU backend run no kernels, but give their times by the cost models, so that
+/// Find and the auto-tune can be tested without a device. Enabled by
+/// MIOPEN_DEBUG_SIMULATED_DEVICE set to ANALYTIC or to the path of the times recorded by
+/// KernelTimeRecorder, which are replayed, the launches not recorded being estimated by
+/// AnalyticCostModel. The simulated device has MIOPEN_DEBUG_SIMULATED_DEVICE_CU compute units,
+/// 64 by default.
+class SimulatedDevice
+{
+public:
+    using CostModels = std::vector<std::shared_ptr<const KernelCostModel>>;
+
+    static bool IsEnabled();
+    static std::size_t GetComputeUnits();
+
+    /// Replaces the cost models set by the environment, e.g. for the tests. The first model that
+    /// can tell the time of a launch is used. Empty disables the simulation.
+    static void SetCostModels(CostModels models);
+
+    /// Returns 0 if none of the models can tell the time.
+    static float GetTime(const KernelLaunch& launch);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SIMULATED_DEVICE_HPP_
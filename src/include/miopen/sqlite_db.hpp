@@ -131,6 +131,37 @@ struct SQLiteSerializable
         return std::make_tuple(query, values);
     }
 
+    /// Values for the placeholders of both WhereClause() and InsertQuery(), in order.
+    std::vector<std::string> QueryValues() const
+    {
+        std::vector<std::string> values;
+        Derived::Visit(static_cast<const Derived&>(*this),
+                       [&](const std::string& value, const std::string& name) {
+                           std::ignore = name;
+                           values.push_back(value);
+                       });
+        Derived::Visit(static_cast<const Derived&>(*this),
+                       [&](const int value, const std::string name) {
+                           std::ignore = name;
+                           values.push_back(std::to_string(value));
+                       });
+        return values;
+    }
+
+    // The text of queries depends only on the set of fields of Derived, which is the same for
+    // all of its objects. So it is built once and is the key of the prepared statement cache.
+    const std::string& CachedWhereClause() const
+    {
+        static const auto clause = std::get<0>(WhereClause());
+        return clause;
+    }
+
+    const std::string& CachedInsertQuery() const
+    {
+        static const auto query = std::get<0>(InsertQuery());
+        return query;
+    }
+
     std::string CreateQuery() const
     {
         std::vector<std::string> str_fields;
@@ -201,6 +232,32 @@ public:
     SQLite& operator=(const SQLite&) = delete;
     bool Valid() const;
     result_type Exec(const std::string& query) const;
+    /// Starts a transaction unless one has been started already. Transactions are counted,
+    /// only the outermost CommitBatch() commits. Each BeginBatch() shall be matched by either
+    /// CommitBatch() or RollbackBatch(), see Batch.
+    void BeginBatch();
+    /// A failed commit rolls the transaction back. So does the outermost commit if a nested
+    /// batch has been rolled back, and then it throws.
+    void CommitBatch();
+    /// Rolls the transaction back, or marks it to be rolled back if the batch is nested.
+    void RollbackBatch();
+
+    /// Begins a batch, which is rolled back on destruction unless committed.
+    class Batch
+    {
+    public:
+        Batch(SQLite& sql_);
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+        ~Batch();
+
+        void Commit();
+
+    private:
+        SQLite& sql;
+        bool done = false;
+    };
+
     int Changes() const;
     int Retry(std::function<int()>) const;
     static int Retry(std::function<int()> f, std::string filename);
@@ -370,6 +427,38 @@ public:
         return reinterpret_cast<Derived*>(this)->LoadUnsafe(args...);
     }
 
+    template <typename... U>
+    inline bool LoadAll(U&&... args)
+    {
+        if(!is_system && DisableUserDbFileIO)
+            return false;
+        return reinterpret_cast<Derived*>(this)->LoadAllUnsafe(args...);
+    }
+
+    /// Makes all the writes until the matching CommitBatch() a single transaction, so a
+    /// sequence of updates is synced to the disk once instead of once per update.
+    /// The transaction is shared by all the threads using this db.
+    void BeginBatch()
+    {
+        if(is_system || DisableUserDbFileIO || dbInvalid)
+            return;
+        sql.BeginBatch();
+    }
+
+    void CommitBatch()
+    {
+        if(is_system || DisableUserDbFileIO || dbInvalid)
+            return;
+        sql.CommitBatch();
+    }
+
+    void RollbackBatch()
+    {
+        if(is_system || DisableUserDbFileIO || dbInvalid)
+            return;
+        sql.RollbackBatch();
+    }
+
     std::string filename;
     bool dbInvalid;
     SQLite sql;
@@ -403,11 +492,8 @@ public:
     template <class T>
     inline void InsertConfig(const T& prob_desc)
     {
-        std::string clause;
-        std::vector<std::string> vals;
-        std::tie(clause, vals) = prob_desc.InsertQuery();
-        auto stmt              = SQLite::Statement{sql, clause, vals};
-        auto rc                = stmt.Step(sql);
+        auto stmt = SQLite::Statement{sql, prob_desc.CachedInsertQuery(), prob_desc.QueryValues()};
+        auto rc   = stmt.Step(sql);
         if(rc != SQLITE_DONE)
             MIOPEN_THROW(miopenStatusInternalError,
                          "Failed to insert config: " + sql.ErrorMessage());
@@ -417,11 +503,9 @@ public:
     template <class T>
     inline std::string GetConfigIDs(const T& prob_desc)
     {
-        std::string clause;
-        std::vector<std::string> vals;
-        std::tie(clause, vals) = prob_desc.WhereClause();
-        auto query = "SELECT id FROM " + prob_desc.table_name() + " WHERE ( " + clause + " );";
-        auto stmt  = SQLite::Statement{sql, query, vals};
+        static const auto query = "SELECT id FROM " + prob_desc.table_name() + " WHERE ( " +
+                                  prob_desc.CachedWhereClause() + " );";
+        auto stmt = SQLite::Statement{sql, query, prob_desc.QueryValues()};
         while(true)
         {
             auto rc = stmt.Step(sql);
@@ -438,19 +522,16 @@ public:
     {
         if(dbInvalid)
             return boost::none;
-        std::string clause;
-        std::vector<std::string> values;
-        std::tie(clause, values) = problem_config.WhereClause();
         // clang-format off
-        auto select_query =
+        static const auto select_query =
             "SELECT solver, params "
             "FROM perf_db "
             "INNER JOIN " + problem_config.table_name() + " "
             "ON perf_db.config = " + problem_config.table_name() +".id "
             "WHERE "
-            "( " + clause + " );";
+            "( " + problem_config.CachedWhereClause() + " );";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, select_query, values};
+        auto stmt = SQLite::Statement{sql, select_query, problem_config.QueryValues()};
         DbRecord rec;
         while(true)
         {
@@ -477,17 +558,16 @@ public:
     {
         if(dbInvalid)
             return false;
-        std::string clause;
-        std::vector<std::string> values;
-        std::tie(clause, values) = problem_config.WhereClause();
         // clang-format off
-        auto query =
+        static const auto query =
             "DELETE FROM perf_db "
             "WHERE config IN ("
             "SELECT id FROM config WHERE ( "
-            + clause + " ) )"
-            "AND solver == '" +  id + "' ;";
+            + problem_config.CachedWhereClause() + " ) )"
+            "AND solver == ? ;";
         // clang-format on
+        auto values = problem_config.QueryValues();
+        values.push_back(id);
         auto stmt = SQLite::Statement{sql, query, values};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
@@ -508,13 +588,11 @@ public:
     {
         if(dbInvalid)
             return boost::none;
+        auto vals = problem_config.QueryValues();
         // UPSERT the value
         {
-            std::string clause;
-            std::vector<std::string> vals;
-            std::tie(clause, vals) = problem_config.InsertQuery();
-            auto stmt              = SQLite::Statement{sql, clause, vals};
-            auto rc                = stmt.Step(sql);
+            auto stmt = SQLite::Statement{sql, problem_config.CachedInsertQuery(), vals};
+            auto rc   = stmt.Step(sql);
             if(rc != SQLITE_DONE)
                 MIOPEN_THROW(miopenStatusInternalError,
                              "Failed to insert config: " + sql.ErrorMessage());
@@ -526,17 +604,14 @@ public:
         {
             std::ostringstream params;
             values.Serialize(params);
-            std::string clause;
-            std::vector<std::string> vals(2);
-            std::tie(clause, vals) = problem_config.WhereClause();
 
             // clang-format off
-            std::string query =
+            static const auto query =
                 "INSERT OR REPLACE INTO "
                 "perf_db(config, solver, params) "
                 "VALUES("
                 "(SELECT id FROM " + problem_config.table_name() +  " "
-                "WHERE ( " + clause + " ) ) , ? , ?);";
+                "WHERE ( " + problem_config.CachedWhereClause() + " ) ) , ? , ?);";
             // clang-format on
             vals.push_back(id);
             vals.push_back(params.str());
@@ -570,17 +645,14 @@ public:
     {
         if(dbInvalid)
             return true;
-        std::string clause;
-        std::vector<std::string> values;
-        std::tie(clause, values) = problem_config.WhereClause();
         // clang-format off
-        auto query =
+        static const auto query =
             "DELETE FROM perf_db "
             "WHERE config IN ("
             "SELECT id FROM config WHERE ( "
-            + clause + " ))";
+            + problem_config.CachedWhereClause() + " ))";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, query, values};
+        auto stmt = SQLite::Statement{sql, query, problem_config.QueryValues()};
         auto rc   = stmt.Step(sql);
         if(rc != SQLITE_DONE)
         {
@@ -608,6 +680,35 @@ public:
             return false;
         return record->GetValues(id, values);
     }
+
+    /// Appends VALUES under the ID from all the records, e.g. all the tuned configs of a solver.
+    /// Class V shall have "bool Deserialize(const std::string& str)" member function available.
+    ///
+    /// Returns false if there are none.
+    template <class V>
+    inline bool LoadAllUnsafe(const std::string& id, std::vector<V>& values)
+    {
+        if(dbInvalid)
+            return false;
+        static const auto query = std::string{"SELECT params FROM perf_db WHERE solver = ? ;"};
+        auto stmt               = SQLite::Statement{sql, query, {id}};
+        const auto size         = values.size();
+        while(true)
+        {
+            auto rc = stmt.Step(sql);
+            if(rc == SQLITE_ROW)
+            {
+                V value;
+                if(value.Deserialize(stmt.ColumnText(0)))
+                    values.push_back(value);
+            }
+            else if(rc == SQLITE_DONE)
+                break;
+            else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        }
+        return values.size() > size;
+    }
 };
 } // namespace miopen
 #endif
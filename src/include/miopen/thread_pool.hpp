@@ -0,0 +1,211 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef MIOPEN_GUARD_MLOPEN_THREAD_POOL_HPP
+#define MIOPEN_GUARD_MLOPEN_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef __MINGW32__
+#include <mingw.thread.h>
+#else
+#include <thread>
+#endif
+
+namespace miopen {
+
+/// Lets the caller stop a par_for early. Indices that have not started yet are skipped.
+struct cancel_token
+{
+    void cancel() { flag.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return flag.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> flag{false};
+};
+
+/// Work-stealing pool shared by the par_for calls of the process.
+/// Every worker pushes and pops its own tasks at the back of its queue and steals from the front
+/// of the others. Threads that are not workers push to a queue of their own. A thread waiting for
+/// its tasks runs queued tasks meanwhile, so nested par_for calls do not deadlock.
+class thread_pool
+{
+public:
+    using task = std::function<void()>;
+
+    explicit thread_pool(std::size_t workers_count)
+    {
+        for(std::size_t i = 0; i < workers_count + 1; ++i)
+            queues.push_back(std::make_unique<task_queue>());
+        for(std::size_t i = 0; i < workers_count; ++i)
+            workers.emplace_back([this, i] { run(i); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{sleep_mutex};
+            stop = true;
+        }
+        wake.notify_all();
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    /// The calling thread counts as one of the threads, so there is one worker less than cores.
+    static thread_pool& get()
+    {
+        static thread_pool pool{std::max(std::thread::hardware_concurrency(), 1u) - 1};
+        return pool;
+    }
+
+    /// Number of threads a par_for can use, including the calling one.
+    std::size_t size() const { return workers.size() + 1; }
+
+    void push(task t)
+    {
+        auto& queue = *queues[own_queue()];
+        {
+            const std::lock_guard<std::mutex> lock{queue.mutex};
+            queue.tasks.push_back(std::move(t));
+        }
+        queued.fetch_add(1);
+        if(sleeping.load() > 0)
+        {
+            {
+                const std::lock_guard<std::mutex> lock{sleep_mutex};
+            }
+            wake.notify_one();
+        }
+    }
+
+    /// Runs one queued task, the latest own one or the oldest one of another queue.
+    bool try_run_one()
+    {
+        auto t = task{};
+        if(!pop(t))
+            return false;
+        t();
+        return true;
+    }
+
+private:
+    struct task_queue
+    {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    struct worker_info
+    {
+        const thread_pool* pool = nullptr;
+        std::size_t index       = 0;
+    };
+
+    static worker_info& this_worker()
+    {
+        static thread_local worker_info info;
+        return info;
+    }
+
+    std::size_t own_queue() const
+    {
+        const auto& info = this_worker();
+        return info.pool == this ? info.index : workers.size();
+    }
+
+    bool pop(task& t)
+    {
+        const auto own = own_queue();
+        {
+            auto& queue = *queues[own];
+            const std::lock_guard<std::mutex> lock{queue.mutex};
+            if(!queue.tasks.empty())
+            {
+                t = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+
+        for(std::size_t i = 1; i < queues.size(); ++i)
+        {
+            auto& queue = *queues[(own + i) % queues.size()];
+            const std::lock_guard<std::mutex> lock{queue.mutex};
+            if(!queue.tasks.empty())
+            {
+                t = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void run(std::size_t index)
+    {
+        this_worker() = worker_info{this, index};
+
+        while(true)
+        {
+            if(try_run_one())
+                continue;
+
+            std::unique_lock<std::mutex> lock{sleep_mutex};
+            sleeping.fetch_add(1);
+            wake.wait(lock, [&] { return stop || queued.load() > 0; });
+            sleeping.fetch_sub(1);
+            if(stop)
+                break;
+        }
+    }
+
+    std::vector<std::unique_ptr<task_queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> queued{0};
+    std::atomic<std::size_t> sleeping{0};
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stop = false;
+};
+
+} // namespace miopen
+
+#endif
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_TUNING_CHECKPOINT_HPP_
+#define GUARD_MIOPEN_TUNING_CHECKPOINT_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace solver {
+
+/// Progress of an unfinished auto-tuning. It is kept in the user perf-db under the id returned by
+/// GetDbId(), next to the record of the solver, and lets the next search of the same problem
+/// continue from where the previous one has stopped.
+struct TuningCheckpoint
+{
+    std::size_t next     = 0; // Index of the first config not evaluated yet.
+    std::size_t total    = 0; // Size of the search space, to detect that it has changed.
+    std::size_t n_failed = 0;
+    std::size_t n_best   = 0;
+    float best_time      = std::numeric_limits<float>::max();
+    std::string best_config; // Serialized performance config, empty if none has passed yet.
+
+    /// The shards of a tuning split across processes (see TuningShard) keep their own checkpoints.
+    /// A finished shard leaves the checkpoint in place, so that its best time is known when the
+    /// perf-dbs of the shards are merged.
+    static std::string GetDbId(const std::string& solver_db_id,
+                               std::size_t shard_index = 0,
+                               std::size_t shard_count = 1)
+    {
+        if(shard_count <= 1)
+            return solver_db_id + "_checkpoint";
+        return solver_db_id + "_checkpoint_" + std::to_string(shard_index) + '_' +
+               std::to_string(shard_count);
+    }
+
+    /// Tells if id is returned by GetDbId(solver_db_id, ...) for any shard.
+    static bool IsDbId(const std::string& id, const std::string& solver_db_id)
+    {
+        const auto prefix = GetDbId(solver_db_id);
+        return id.compare(0, prefix.size(), prefix) == 0 &&
+               (id.size() == prefix.size() || id[prefix.size()] == '_');
+    }
+
+    bool IsComplete() const { return next >= total; }
+
+    void Serialize(std::ostream& stream) const
+    {
+        const auto precision = stream.precision(std::numeric_limits<float>::max_digits10);
+        stream << next << ',' << total << ',' << n_failed << ',' << n_best << ',' << best_time;
+        stream.precision(precision);
+        if(!best_config.empty())
+            stream << ',' << best_config;
+    }
+
+    bool Deserialize(const std::string& str)
+    {
+        std::istringstream stream{str};
+        TuningCheckpoint out;
+        char sep[4] = {};
+
+        stream >> out.next >> sep[0] >> out.total >> sep[1] >> out.n_failed >> sep[2] >>
+            out.n_best >> sep[3] >> out.best_time;
+        if(stream.fail())
+            return false;
+        for(const auto c : sep)
+            if(c != ',')
+                return false;
+
+        if(!stream.eof())
+        {
+            if(stream.get() != ',' || !std::getline(stream, out.best_config) ||
+               out.best_config.empty())
+                return false;
+        }
+
+        *this = out;
+        return true;
+    }
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TUNING_CHECKPOINT_HPP_
@@ -27,108 +27,186 @@
 #include <miopen/invoker_cache.hpp>
 #include <miopen/logger.hpp>
 
+#include <mutex>
+
 namespace miopen {
 
-boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
+namespace {
+
+std::size_t Mix(std::size_t seed, std::size_t value)
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
-        return boost::none;
-    const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
-    if(invoker == item_invokers.end())
-        return boost::none;
-    return invoker->second;
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
-                                                          const std::string& algorithm) const
+} // namespace
+
+constexpr std::size_t InvokerCache::FlatIndex::npos;
+
+void InvokerCache::FlatIndex::Insert(std::size_t hash, std::size_t index)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    // Keep the load factor at 1/2 or below so probe sequences stay short.
+    if(2 * (size + 1) > slots.size())
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
-        return boost::none;
+        auto old = std::vector<Slot>(slots.empty() ? 16 : slots.size() * 2);
+        old.swap(slots);
+        size = 0;
+        for(const auto& slot : old)
+            if(slot.index != npos)
+                Insert(slot.hash, slot.index);
     }
-    if(item->second.found_1_0.empty())
-    {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
+
+    const auto mask = slots.size() - 1;
+    auto i          = hash & mask;
+    while(slots[i].index != npos)
+        i = (i + 1) & mask;
+    slots[i].hash  = hash;
+    slots[i].index = index;
+    ++size;
+}
+
+InvokerCache::InvokerCache(InvokerCache&& other) noexcept
+    : invokers(std::move(other.invokers)),
+      invokers_index(std::move(other.invokers_index)),
+      found_1_0(std::move(other.found_1_0)),
+      found_1_0_index(std::move(other.found_1_0_index))
+{
+    other.last_used = nullptr;
+}
+
+InvokerCache& InvokerCache::operator=(InvokerCache&& other) noexcept
+{
+    invokers        = std::move(other.invokers);
+    invokers_index  = std::move(other.invokers_index);
+    found_1_0       = std::move(other.found_1_0);
+    found_1_0_index = std::move(other.found_1_0_index);
+    last_used       = nullptr;
+    other.last_used = nullptr;
+    return *this;
+}
+
+std::size_t InvokerCache::HashOf(const NetworkConfig& network_config, const solver::Id& solver)
+{
+    return Mix(network_config.GetHash(), static_cast<std::size_t>(solver.Value()));
+}
+
+std::size_t InvokerCache::HashOf(const NetworkConfig& network_config,
+                                 const std::string& algorithm)
+{
+    return Mix(network_config.GetHash(), std::hash<std::string>{}(algorithm));
+}
+
+const InvokerCache::InvokerEntry* InvokerCache::FindUnsafe(const NetworkConfig& network_config,
+                                                           const solver::Id& solver) const
+{
+    const auto index =
+        invokers_index.Find(HashOf(network_config, solver), [&](std::size_t candidate) {
+            const auto& entry = invokers[candidate];
+            return entry.solver == solver && entry.network_config == network_config;
+        });
+    return index == FlatIndex::npos ? nullptr : &invokers[index];
+}
+
+std::size_t InvokerCache::FindFound1_0Unsafe(const NetworkConfig& network_config,
+                                             const std::string& algorithm) const
+{
+    return found_1_0_index.Find(HashOf(network_config, algorithm), [&](std::size_t candidate) {
+        const auto& entry = found_1_0[candidate];
+        return entry.algorithm == algorithm && entry.network_config == network_config;
+    });
+}
+
+boost::optional<const Invoker&> InvokerCache::Get(const NetworkConfig& network_config,
+                                                  const solver::Id& solver_id) const
+{
+    if(!solver_id.IsValid())
         return boost::none;
-    }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
+
+    const auto last = last_used.load(std::memory_order_acquire);
+    if(last != nullptr && last->solver == solver_id && last->network_config == network_config)
+        return last->invoker;
+
+    const std::shared_lock<std::shared_timed_mutex> lock{mutex};
+    const auto entry = FindUnsafe(network_config, solver_id);
+    if(entry == nullptr)
+        return boost::none;
+    last_used.store(entry, std::memory_order_release);
+    return entry->invoker;
+}
+
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const NetworkConfig& network_config,
+                                                          const std::string& algorithm) const
+{
+    const std::shared_lock<std::shared_timed_mutex> lock{mutex};
+    const auto found = FindFound1_0Unsafe(network_config, algorithm);
+    if(found == FlatIndex::npos)
     {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
+        MIOPEN_LOG_I2("No find 1.0 result for " << network_config.ToString()
+                                                << " and algorithm " << algorithm);
         return boost::none;
     }
-    const auto invoker = item_invokers.find(found_1_0_id->second);
-    if(invoker == item_invokers.end())
-        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
-    return invoker->second;
+    return found_1_0[found].best->invoker;
 }
 
 boost::optional<const std::string&>
-InvokerCache::GetFound1_0SolverId(const std::string& network_config,
+InvokerCache::GetFound1_0SolverId(const NetworkConfig& network_config,
                                   const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    const std::shared_lock<std::shared_timed_mutex> lock{mutex};
+    const auto found = FindFound1_0Unsafe(network_config, algorithm);
+    if(found == FlatIndex::npos)
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
+        MIOPEN_LOG_I2("No find 1.0 result for " << network_config.ToString()
+                                                << " and algorithm " << algorithm);
         return boost::none;
     }
-    if(item->second.found_1_0.empty())
-    {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
-        return boost::none;
-    }
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
-    {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
-        return boost::none;
-    }
-    return found_1_0_id->second;
+    return found_1_0[found].best->solver_id;
 }
 
-void InvokerCache::Register(const Key& key, const Invoker& invoker)
+void InvokerCache::Register(const NetworkConfig& network_config,
+                            const std::string& solver_id,
+                            const Invoker& invoker)
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
-    auto& item = invokers.insert({key.first, Item{}}).first->second;
-    item.invokers.insert({key.second, invoker});
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    const auto solver = solver::Id{solver_id};
+    if(!solver.IsValid())
+        MIOPEN_THROW("Invalid solver id " + solver_id + " for " + network_config.ToString());
+
+    {
+        const std::lock_guard<std::shared_timed_mutex> lock{mutex};
+        if(FindUnsafe(network_config, solver) != nullptr)
+            return;
+        invokers.push_back({network_config, solver, solver_id, invoker});
+        invokers_index.Insert(HashOf(network_config, solver), invokers.size() - 1);
+    }
+    MIOPEN_LOG_I2("Invoker registered for algorithm " << network_config.ToString()
+                                                      << " and solver " << solver_id);
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
+void InvokerCache::SetAsFound1_0(const NetworkConfig& network_config,
                                  const std::string& algorithm,
                                  const std::string& solver_id)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
-
     {
+        const std::lock_guard<std::shared_timed_mutex> lock{mutex};
+
         // Validating at find time
-        const auto& item_invokers = item->second.invokers;
-        const auto invoker        = item_invokers.find(solver_id);
-        if(invoker == item_invokers.end())
+        const auto best = FindUnsafe(network_config, solver::Id{solver_id});
+        if(best == nullptr)
             MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
-    }
+                         network_config.ToString());
 
-    item->second.found_1_0[algorithm] = solver_id;
+        const auto found = FindFound1_0Unsafe(network_config, algorithm);
+        if(found != FlatIndex::npos)
+        {
+            found_1_0[found].best = best;
+        }
+        else
+        {
+            found_1_0.push_back({network_config, algorithm, best});
+            found_1_0_index.Insert(HashOf(network_config, algorithm), found_1_0.size() - 1);
+        }
+    }
     MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
-                            << " in " << network_config);
+                            << " in " << network_config.ToString());
 }
 
 } // namespace miopen
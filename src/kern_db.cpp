@@ -24,13 +24,57 @@
  *
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
+#include <miopen/env.hpp>
+#include <miopen/lz.hpp>
+#include <miopen/version.h>
+
+#include <mutex>
+#include <set>
 
 namespace miopen {
-KernDb::KernDb(const std::string& filename_, bool is_system_)
-    : KernDb(filename_, is_system_, compress, decompress)
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_USER_KERNEL_DB_MAX_MB)
+
+namespace {
+
+const std::string& BlobTableQuery()
+{
+    static const auto query = std::string{
+        "CREATE TABLE IF NOT EXISTS `kern_blob` ("
+        "`hash` TEXT PRIMARY KEY NOT NULL"
+        ",`codec` INT NOT NULL"
+        ",`blob` BLOB NOT NULL"
+        ",`uncompressed_size` INT NOT NULL"
+        ",`stored_size` INT NOT NULL"
+        ",`last_access` INT NOT NULL"
+        ");"
+        "CREATE INDEX IF NOT EXISTS `idx_kern_blob_access` ON kern_blob(last_access);"
+        "CREATE INDEX IF NOT EXISTS `idx_kern_db_hash` ON kern_db(kernel_hash);"
+        "CREATE TABLE IF NOT EXISTS `kern_meta` ("
+        "`name` TEXT PRIMARY KEY NOT NULL"
+        ",`value` TEXT NOT NULL"
+        ");"};
+    return query;
+}
+
+// Binaries built by another MIOpen or another compiler are never looked up again.
+const std::string& CurrentVersion()
 {
+    static const auto version =
+        std::to_string(MIOPEN_VERSION_MAJOR) + "." + std::to_string(MIOPEN_VERSION_MINOR) + "." +
+        std::to_string(MIOPEN_VERSION_PATCH) + "." + MIOPEN_STRINGIZE(MIOPEN_VERSION_TWEAK) +
+        " hip " + std::to_string(HIP_PACKAGE_VERSION_FLAT);
+    return version;
 }
 
+const char* const unix_time = "CAST(strftime('%s', 'now') AS INTEGER)";
+
+} // namespace
+
+KernDb::KernDb(const std::string& filename_, bool is_system_)
+    : KernDb(filename_, is_system_, lz_compress, lz_decompress)
+{
+}
 KernDb::KernDb(const std::string& filename_,
                bool is_system_,
                std::function<std::string(std::string, bool*)> compress_fn_,
@@ -50,9 +94,13 @@ KernDb::KernDb(const std::string& filename_,
     }
     if(!is_system)
     {
+        // Only takes effect in a new database, lets the pages freed by evictions be returned.
+        sql.Exec("PRAGMA auto_vacuum = INCREMENTAL;");
         const std::string create_table = KernelConfig::CreateQuery();
         sql.Exec(create_table);
+        sql.Exec(BlobTableQuery());
         MIOPEN_LOG_I2("Database created successfully");
+        size_limit = Value(MIOPEN_USER_KERNEL_DB_MAX_MB{}, 2048) * 1024 * 1024;
     }
     if(!CheckTableColumns(KernelConfig::table_name(), KernelConfig::FieldNames()))
     {
@@ -61,7 +109,168 @@ KernDb::KernDb(const std::string& filename_,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
+    }
+
+    has_blob_table =
+        !sql.Exec("SELECT name FROM sqlite_master WHERE type = 'table' AND name = 'kern_blob';")
+             .empty();
+
+    if(!is_system && has_blob_table)
+        PurgeOtherVersions();
+}
+
+std::size_t KernDb::GetBlobsSize() const
+{
+    if(filename.empty() || !has_blob_table)
+        return 0;
+    auto stmt = SQLite::Statement{sql, "SELECT COALESCE(SUM(stored_size), 0) FROM kern_blob;"};
+    if(stmt.Step(sql) != SQLITE_ROW)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    return stmt.ColumnInt64(0);
+}
+
+boost::optional<std::string> KernDb::FindBlob(const std::string& md5_hash)
+{
+    static const auto select_query =
+        std::string{"SELECT codec, blob, uncompressed_size FROM kern_blob WHERE hash = ?;"};
+    auto stmt = SQLite::Statement{sql, select_query, {md5_hash}};
+    auto rc   = stmt.Step(sql);
+    if(rc == SQLITE_DONE)
+    {
+        MIOPEN_LOG_I2("Binary " << md5_hash << " has been evicted");
+        return boost::none;
+    }
+    if(rc != SQLITE_ROW)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+
+    const auto codec             = static_cast<Codec>(stmt.ColumnInt64(0));
+    auto blob                    = stmt.ColumnBlob(1);
+    const auto uncompressed_size = static_cast<unsigned int>(stmt.ColumnInt64(2));
+
+    switch(codec)
+    {
+    case Codec::None: break;
+    case Codec::Bz2: blob = decompress(blob, uncompressed_size); break;
+    case Codec::Lz: blob = decompress_fn(blob, uncompressed_size); break;
+    default: MIOPEN_THROW(miopenStatusInternalError, "Unknown kernel binary codec");
+    }
+
+    if(md5(blob) != md5_hash)
+        MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+
+    if(!is_system)
+    {
+        static const auto touch_query =
+            std::string{"UPDATE kern_blob SET last_access = "} + unix_time + " WHERE hash = ?;";
+        auto touch = SQLite::Statement{sql, touch_query, {md5_hash}};
+        if(touch.Step(sql) != SQLITE_DONE)
+            MIOPEN_LOG_I(sql.ErrorMessage());
+    }
+    return blob;
+}
+
+void KernDb::StoreBlob(const std::string& md5_hash, const std::string& blob)
+{
+    static const auto touch_query =
+        std::string{"UPDATE kern_blob SET last_access = "} + unix_time + " WHERE hash = ?;";
+    auto touch = SQLite::Statement{sql, touch_query, {md5_hash}};
+    if(touch.Step(sql) != SQLITE_DONE)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    if(sql.Changes() > 0)
+    {
+        MIOPEN_LOG_I2("Binary " << md5_hash << " is already stored");
+        return;
+    }
+
+    static const auto insert_query =
+        std::string{"INSERT INTO kern_blob(hash, codec, blob, uncompressed_size, stored_size, "
+                    "last_access) VALUES(?, ?, ?, ?, ?, "} +
+        unix_time + ");";
+    auto compressed            = false;
+    const auto compressed_blob = compress_fn(blob, &compressed);
+    const auto& stored         = compressed ? compressed_blob : blob;
+
+    auto stmt = SQLite::Statement{sql, insert_query};
+    stmt.BindText(1, md5_hash);
+    stmt.BindInt64(2, static_cast<int64_t>(compressed ? Codec::Lz : Codec::None));
+    stmt.BindBlob(3, stored);
+    stmt.BindInt64(4, compressed ? blob.size() : 0);
+    stmt.BindInt64(5, stored.size());
+    if(stmt.Step(sql) != SQLITE_DONE)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+}
+
+void KernDb::Evict()
+{
+    if(size_limit == 0 || GetBlobsSize() <= size_limit)
+        return;
+
+    sql.Exec("DELETE FROM kern_blob WHERE hash NOT IN (SELECT kernel_hash FROM kern_db);");
+
+    auto blobs  = std::vector<std::pair<std::string, std::size_t>>{};
+    auto total  = std::size_t{0};
+    auto select = SQLite::Statement{
+        sql, "SELECT hash, stored_size FROM kern_blob ORDER BY last_access, rowid;"};
+    while(select.Step(sql) == SQLITE_ROW)
+    {
+        blobs.emplace_back(select.ColumnText(0), select.ColumnInt64(1));
+        total += blobs.back().second;
+    }
+
+    // Go some way below the limit, not to evict again on the next store. The most recent binary,
+    // which is the one just stored, is kept anyway.
+    const auto target = size_limit - size_limit / 8;
+    auto evicted      = std::size_t{0};
+    auto freed        = std::size_t{0};
+    for(; evicted + 1 < blobs.size() && total - freed > target; ++evicted)
+    {
+        const auto& hash = blobs[evicted].first;
+        auto kernels = SQLite::Statement{sql, "DELETE FROM kern_db WHERE kernel_hash = ?;", {hash}};
+        auto blob    = SQLite::Statement{sql, "DELETE FROM kern_blob WHERE hash = ?;", {hash}};
+        if(kernels.Step(sql) != SQLITE_DONE || blob.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        freed += blobs[evicted].second;
+    }
+
+    sql.Exec("PRAGMA incremental_vacuum;");
+    MIOPEN_LOG_I("Evicted " << evicted << " kernel binaries (" << freed << " bytes) from "
+                            << filename);
+}
+
+void KernDb::PurgeOtherVersions()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::set<std::string> checked;
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        if(!checked.insert(filename).second)
+            return;
+    }
+
+    const auto stored = sql.Exec("SELECT value FROM kern_meta WHERE name = 'version';");
+    if(!stored.empty() && stored.front().at("value") == CurrentVersion())
+        return;
+
+    // Without the new version the purge is rolled back too, and is redone by the next process.
+    SQLite::Batch batch{sql};
+    // Databases written before the version was recorded are kept, their rows are still valid.
+    if(!stored.empty())
+    {
+        MIOPEN_LOG_I("Purging binaries of " << stored.front().at("value") << " from " << filename);
+        sql.Exec("DELETE FROM kern_db; DELETE FROM kern_blob;");
     }
+    auto stmt = SQLite::Statement{
+        sql, "INSERT OR REPLACE INTO kern_meta(name, value) VALUES('version', ?);"};
+    stmt.BindText(1, CurrentVersion());
+    if(stmt.Step(sql) != SQLITE_DONE)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    batch.Commit();
+
+    if(!stored.empty())
+        sql.Exec("PRAGMA incremental_vacuum;");
 }
 
 } // namespace miopen
@@ -39,19 +39,43 @@
  * limitations under the License.
  * ************************************************************************ */
 
+#include <miopen/compile_service.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/simulated_device.hpp>
 #include <miopen/stringutils.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_KERNEL_CACHE_MAX_BYTES)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_KERNEL_CACHE_MAX_PROGRAMS)
 
 namespace miopen {
 
+static std::size_t GetCodeObjectSize(const Program& program)
+{
+#if MIOPEN_BACKEND_OPENCL
+    // Programs are built for the single device of the handle.
+    std::size_t size = 0;
+    if(clGetProgramInfo(
+           program.get(), CL_PROGRAM_BINARY_SIZES, sizeof(size), &size, nullptr) != CL_SUCCESS)
+        return 0;
+    return size;
+#else
+    return program.GetCodeObjectSize();
+#endif
+}
+
+static void RemoveKey(std::vector<KernelCache::Key>& keys, const KernelCache::Key& key)
+{
+    keys.erase(std::remove(keys.begin(), keys.end(), key), keys.end());
+}
+
 const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
                                                    const std::string& network_config)
 {
@@ -63,9 +87,15 @@ const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
     {
         MIOPEN_LOG_I2(it->second.size()
                       << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        ++stats.hits;
+        const auto programs = kernel_programs.find(key);
+        if(programs != kernel_programs.end())
+            for(const auto& program : programs->second)
+                TouchProgram(program);
         return it->second;
     }
 
+    ++stats.misses;
     static const std::vector<Kernel> empty{};
     MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
     return empty;
@@ -97,16 +127,98 @@ bool KernelCache::HasProgram(const std::string& name, const std::string& params)
 
 void KernelCache::ClearProgram(const std::string& name, const std::string& params)
 {
-    if(HasProgram(name, params))
+    const auto it = program_map.find(std::make_pair(name, params));
+    if(it != program_map.end())
+        EraseProgram(it);
+}
+
+void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
+{
+    const auto key = std::make_pair(program_name, params);
+    InsertProgram(key, prog);
+    Evict(key);
+}
+
+KernelCacheStats KernelCache::GetStats() const
+{
+    auto ret     = stats;
+    ret.programs = program_map.size();
+    ret.kernels  = kernel_map.size();
+    return ret;
+}
+
+void KernelCache::SetLimits(std::size_t max_bytes, std::size_t max_programs)
+{
+    stats.max_bytes    = max_bytes;
+    stats.max_programs = max_programs;
+    Evict({});
+}
+
+void KernelCache::TouchProgram(const Key& key)
+{
+    const auto it = program_map.find(key);
+    if(it != program_map.end())
+        lru.splice(lru.begin(), lru, it->second.lru);
+}
+
+void KernelCache::InsertProgram(const Key& key, const Program& program)
+{
+    const auto it = program_map.find(key);
+    if(it != program_map.end())
+        EraseProgram(it);
+
+    const auto bytes = GetCodeObjectSize(program);
+    lru.push_front(key);
+    program_map.emplace(key, ProgramEntry{program, bytes, lru.begin()});
+    stats.bytes += bytes;
+}
+
+void KernelCache::EraseProgram(ProgramMap::iterator it)
+{
+    stats.bytes -= it->second.bytes;
+    lru.erase(it->second.lru);
+    program_map.erase(it);
+}
+
+void KernelCache::EraseKernels(const Key& key)
+{
+    kernel_map.erase(key);
+    const auto programs = kernel_programs.find(key);
+    if(programs == kernel_programs.end())
+        return;
+    for(const auto& program : programs->second)
     {
-        const auto key = std::make_pair(name, params);
-        program_map.erase(key);
+        const auto kernels = program_kernels.find(program);
+        if(kernels != program_kernels.end())
+            RemoveKey(kernels->second, key);
     }
+    kernel_programs.erase(programs);
 }
 
-void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
+void KernelCache::Evict(const Key& keep)
 {
-    program_map[std::make_pair(program_name, params)] = prog;
+    const auto over_limit = [&]() {
+        return (stats.max_programs != 0 && program_map.size() > stats.max_programs) ||
+               (stats.max_bytes != 0 && stats.bytes > stats.max_bytes);
+    };
+
+    while(over_limit() && !lru.empty() && lru.back() != keep)
+    {
+        const auto key = lru.back();
+        MIOPEN_LOG_I2("Evicting program: " << key.first << " \"" << key.second << '\"');
+
+        const auto kernels = program_kernels.find(key);
+        if(kernels != program_kernels.end())
+        {
+            const auto kernel_keys = kernels->second;
+            for(const auto& kernel_key : kernel_keys)
+                EraseKernels(kernel_key);
+            program_kernels.erase(key);
+        }
+
+        EraseProgram(program_map.find(key));
+        ++stats.evictions;
+    }
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -127,23 +239,29 @@ Kernel KernelCache::AddKernel(const Handle& h,
 
     Program program;
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
+    const auto program_key = std::make_pair(program_name, params);
+    auto program_it        = program_map.find(program_key);
     if(program_it != program_map.end())
     {
-        program = program_it->second;
+        ++stats.hits;
+        program = program_it->second.program;
+        TouchProgram(program_key);
     }
     else
     {
+        ++stats.misses;
         if(!is_kernel_miopengemm_str) // default value
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
                                        algorithm.find("GEMM") != std::string::npos;
-        program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+        program = CompileService::Get().Load(
+            h, program_name, params, is_kernel_miopengemm_str, kernel_src);
+        InsertProgram(program_key, program);
     }
 
     Kernel kernel{};
     const char* const arch = miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{});
-    if(arch != nullptr && strlen(arch) > 0)
+    // The simulated device needs the work sizes to tell the times.
+    if(arch != nullptr && strlen(arch) > 0 && !SimulatedDevice::IsEnabled())
     {
         kernel = Kernel{program, kernel_name};
     }
@@ -155,7 +273,16 @@ Kernel KernelCache::AddKernel(const Handle& h,
     if(!network_config.empty() && !algorithm.empty())
     {
         this->AddKernel(key, kernel, cache_index);
+
+        auto& programs = kernel_programs[key];
+        if(std::find(programs.begin(), programs.end(), program_key) == programs.end())
+        {
+            programs.push_back(program_key);
+            program_kernels[program_key].push_back(key);
+        }
     }
+
+    Evict(program_key);
     return kernel;
 }
 
@@ -184,6 +311,10 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
     v.clear();
 }
 
-KernelCache::KernelCache() {}
+KernelCache::KernelCache()
+{
+    stats.max_bytes    = Value(MIOPEN_DEBUG_KERNEL_CACHE_MAX_BYTES{});
+    stats.max_programs = Value(MIOPEN_DEBUG_KERNEL_CACHE_MAX_PROGRAMS{});
+}
 
 } // namespace miopen
@@ -0,0 +1,207 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/errors.hpp>
+#include <miopen/lz.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+
+constexpr std::size_t min_match      = 4;
+constexpr std::size_t max_offset     = 65535;
+constexpr std::size_t last_literals  = 5;  // the block ends with at least that many literals
+constexpr std::size_t match_limit    = 12; // no match starts closer to the end
+constexpr unsigned int hash_bits     = 16;
+constexpr std::size_t run_mask       = 15;
+constexpr unsigned char extra_length = 255;
+
+std::uint32_t Read32(const char* p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint32_t Hash(std::uint32_t v) { return (v * 2654435761U) >> (32 - hash_bits); }
+
+void WriteLength(std::string& out, std::size_t length)
+{
+    for(; length >= extra_length; length -= extra_length)
+        out.push_back(static_cast<char>(extra_length));
+    out.push_back(static_cast<char>(length));
+}
+
+void WriteSequence(std::string& out,
+                   const char* literals,
+                   std::size_t literal_length,
+                   std::size_t offset,
+                   std::size_t match_length)
+{
+    const auto has_match = match_length != 0;
+    const auto lit_token = std::min(literal_length, run_mask);
+    const auto match_token =
+        has_match ? std::min(match_length - min_match, run_mask) : std::size_t{0};
+    out.push_back(static_cast<char>((lit_token << 4) | match_token));
+    if(lit_token == run_mask)
+        WriteLength(out, literal_length - run_mask);
+    out.append(literals, literal_length);
+    if(!has_match)
+        return;
+    out.push_back(static_cast<char>(offset & 0xFF));
+    out.push_back(static_cast<char>(offset >> 8));
+    if(match_token == run_mask)
+        WriteLength(out, match_length - min_match - run_mask);
+}
+
+std::size_t ReadLength(const std::string& s, std::size_t& pos, std::size_t length)
+{
+    if(length != run_mask)
+        return length;
+    unsigned char byte;
+    do
+    {
+        if(pos >= s.size())
+            MIOPEN_THROW("lz_decompress failed: the compressed data ends unexpectedly");
+        byte = static_cast<unsigned char>(s[pos++]);
+        length += byte;
+    } while(byte == extra_length);
+    return length;
+}
+
+} // namespace
+
+std::string lz_compress(const std::string& s, bool* compressed)
+{
+    const auto n = s.size();
+    std::string result;
+    result.reserve(n / 2 + 16);
+
+    std::size_t anchor = 0;
+    if(n > match_limit)
+    {
+        std::vector<std::uint32_t> table(std::size_t{1} << hash_bits, 0);
+        const auto data        = s.data();
+        const auto match_end   = n - last_literals;
+        const auto search_last = n - match_limit;
+
+        // Positions are stored off by one, so that 0 means an empty slot.
+        for(std::size_t pos = 0; pos < search_last;)
+        {
+            const auto value     = Read32(data + pos);
+            auto& slot           = table[Hash(value)];
+            const auto candidate = static_cast<std::size_t>(slot);
+            slot                 = static_cast<std::uint32_t>(pos + 1);
+
+            if(candidate == 0 || pos + 1 - candidate > max_offset ||
+               Read32(data + candidate - 1) != value)
+            {
+                ++pos;
+                continue;
+            }
+
+            const auto match = candidate - 1;
+            auto length      = min_match;
+            while(pos + length < match_end && data[match + length] == data[pos + length])
+                ++length;
+
+            WriteSequence(result, data + anchor, pos - anchor, pos - match, length);
+            pos += length;
+            anchor = pos;
+
+            if(result.size() >= n)
+                break;
+        }
+    }
+
+    if(result.size() < n)
+        WriteSequence(result, s.data() + anchor, n - anchor, 0, 0);
+
+    if(result.size() >= n)
+    {
+        if(compressed != nullptr)
+            *compressed = false;
+        return s;
+    }
+
+    if(compressed != nullptr)
+        *compressed = true;
+    return result;
+}
+
+std::string lz_decompress(const std::string& s, unsigned int size)
+{
+    std::string result(size, '\0');
+    std::size_t out = 0;
+    std::size_t pos = 0;
+
+    while(pos < s.size())
+    {
+        const auto token = static_cast<unsigned char>(s[pos++]);
+
+        const auto literal_length = ReadLength(s, pos, token >> 4);
+        if(literal_length > s.size() - pos || literal_length > size - out)
+            MIOPEN_THROW("lz_decompress failed: a literal run exceeds the data");
+        std::memcpy(&result[out], &s[pos], literal_length);
+        out += literal_length;
+        pos += literal_length;
+
+        if(pos == s.size())
+            break; // the last sequence has no match
+
+        if(s.size() - pos < 2)
+            MIOPEN_THROW("lz_decompress failed: the compressed data ends unexpectedly");
+        const auto offset = static_cast<std::size_t>(static_cast<unsigned char>(s[pos])) |
+                            static_cast<std::size_t>(static_cast<unsigned char>(s[pos + 1])) << 8;
+        pos += 2;
+
+        const auto match_length = ReadLength(s, pos, token & run_mask) + min_match;
+        if(offset == 0 || offset > out || match_length > size - out)
+            MIOPEN_THROW("lz_decompress failed: a match is out of range");
+
+        if(offset >= match_length)
+        {
+            std::memcpy(&result[out], &result[out - offset], match_length);
+            out += match_length;
+        }
+        else
+        {
+            // The match overlaps the bytes it produces.
+            for(std::size_t i = 0; i < match_length; ++i, ++out)
+                result[out] = result[out - offset];
+        }
+    }
+
+    if(out != size)
+        MIOPEN_THROW("lz_decompress failed: unexpected size of the decompressed data");
+    return result;
+}
+
+} // namespace miopen
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/measurement_policy.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MEASURE_WARMUP_RUNS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MEASURE_MIN_RUNS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MEASURE_MAX_RUNS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MEASURE_CI_PERCENT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MEASURE_REDUCTION)
+
+namespace miopen {
+
+namespace {
+
+const char* ToCString(const TimingReduction reduction)
+{
+    switch(reduction)
+    {
+    case TimingReduction::Median: return "MEDIAN";
+    case TimingReduction::TrimmedMean: return "TRIMMED_MEAN";
+    case TimingReduction::Mean: return "MEAN";
+    }
+    return "<Unknown>";
+}
+
+TimingReduction GetDefaultReductionImpl()
+{
+    const char* const p_asciz = miopen::GetStringEnv(MIOPEN_MEASURE_REDUCTION{});
+    if(p_asciz == nullptr)
+        return TimingReduction::Median;
+    std::string str = p_asciz;
+    for(auto& c : str)
+        c = toupper(static_cast<unsigned char>(c));
+    for(const auto reduction :
+        {TimingReduction::Median, TimingReduction::TrimmedMean, TimingReduction::Mean})
+    {
+        if(str == ToCString(reduction))
+            return reduction;
+    }
+    MIOPEN_LOG_NQE("Wrong MIOPEN_MEASURE_REDUCTION, using MEDIAN.");
+    return TimingReduction::Median;
+}
+
+TimingReduction GetDefaultReduction()
+{
+    static const TimingReduction reduction = GetDefaultReductionImpl();
+    return reduction;
+}
+
+/// Two-sided 95% quantile of the Student's t-distribution.
+float StudentT95(const std::size_t degrees_of_freedom)
+{
+    static const std::array<float, 9> table = {
+        12.71f, 4.30f, 3.18f, 2.78f, 2.57f, 2.45f, 2.36f, 2.31f, 2.26f};
+    if(degrees_of_freedom == 0)
+        return std::numeric_limits<float>::infinity();
+    if(degrees_of_freedom <= table.size())
+        return table[degrees_of_freedom - 1];
+    return 1.96f + 2.4f / static_cast<float>(degrees_of_freedom);
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const TimingReduction reduction)
+{
+    return os << ToCString(reduction);
+}
+
+float TimingStats::RelativeCI() const
+{
+    // The outliers are not in the variance, so they shall not narrow the interval either.
+    if(inliers < 2 || !(time > 0.0f))
+        return std::numeric_limits<float>::max();
+    const auto half_width =
+        StudentT95(inliers - 1) * std::sqrt(variance / static_cast<float>(inliers));
+    return half_width / time;
+}
+
+std::ostream& operator<<(std::ostream& os, const TimingStats& stats)
+{
+    os << stats.time;
+    if(stats.runs > 1)
+        os << " +-" << stats.RelativeCI() * 100.0f << "% (" << stats.runs << " runs)";
+    return os;
+}
+
+MeasurementPolicy::MeasurementPolicy()
+    : warmup_runs(Value(MIOPEN_MEASURE_WARMUP_RUNS{}, 1)),
+      min_runs(std::max<std::size_t>(Value(MIOPEN_MEASURE_MIN_RUNS{}, 3), 1)),
+      max_runs(Value(MIOPEN_MEASURE_MAX_RUNS{}, 10)),
+      max_relative_ci(static_cast<float>(Value(MIOPEN_MEASURE_CI_PERCENT{}, 2)) / 100.0f),
+      reduction(GetDefaultReduction())
+{
+}
+
+TimingStats MeasurementPolicy::Measure(const std::function<float()>& run,
+                                       const std::size_t min_runs_) const
+{
+    for(std::size_t i = 0; i < warmup_runs; ++i)
+        std::ignore = run();
+
+    const auto n_min = std::max({min_runs, min_runs_, std::size_t{1}});
+    const auto n_max = std::max(max_runs, n_min);
+
+    std::vector<float> samples;
+    samples.reserve(n_max);
+    while(samples.size() < n_min)
+        samples.push_back(run());
+
+    auto stats = Reduce(samples);
+    while(samples.size() < n_max && stats.RelativeCI() > max_relative_ci)
+    {
+        samples.push_back(run());
+        stats = Reduce(samples);
+    }
+    return stats;
+}
+
+TimingStats MeasurementPolicy::Reduce(std::vector<float> samples) const
+{
+    TimingStats stats;
+    stats.runs = samples.size();
+    if(samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+    const auto n      = samples.size();
+    const auto median = n % 2 != 0 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+
+    // A stall of the device or the host shows up as a sample far above the others. Such samples
+    // are outliers if they are more than 3 standard deviations from the median, the deviation
+    // being estimated robustly as 1.4826 * median absolute deviation. Fewer than 5 samples are
+    // too few to tell the outliers, as are the samples most of which are equal.
+    auto inliers_begin = samples.begin();
+    auto inliers_end   = samples.end();
+    if(n >= 5)
+    {
+        std::vector<float> deviations(n);
+        std::transform(samples.begin(), samples.end(), deviations.begin(), [&](auto x) {
+            return std::abs(x - median);
+        });
+        std::nth_element(deviations.begin(), deviations.begin() + n / 2, deviations.end());
+        const auto threshold = 3.0f * 1.4826f * deviations[n / 2];
+        if(threshold > 0.0f)
+        {
+            inliers_begin = std::lower_bound(samples.begin(), samples.end(), median - threshold);
+            inliers_end   = std::upper_bound(inliers_begin, samples.end(), median + threshold);
+        }
+    }
+    stats.inliers        = std::distance(inliers_begin, inliers_end);
+    const auto n_inliers = static_cast<float>(stats.inliers);
+
+    switch(reduction)
+    {
+    case TimingReduction::Median: stats.time = median; break;
+    case TimingReduction::TrimmedMean: {
+        const auto trim = n / 5;
+        stats.time      = std::accumulate(samples.begin() + trim, samples.end() - trim, 0.0f) /
+                     static_cast<float>(n - 2 * trim);
+        break;
+    }
+    case TimingReduction::Mean:
+        stats.time = std::accumulate(samples.begin(), samples.end(), 0.0f) / static_cast<float>(n);
+        break;
+    }
+
+    if(n_inliers > 1.0f)
+    {
+        const auto mean = std::accumulate(inliers_begin, inliers_end, 0.0f) / n_inliers;
+        const auto sum_sq =
+            std::accumulate(inliers_begin, inliers_end, 0.0f, [&](auto acc, auto x) {
+                return acc + (x - mean) * (x - mean);
+            });
+        stats.variance = sum_sq / (n_inliers - 1.0f);
+    }
+    return stats;
+}
+
+std::ostream& operator<<(std::ostream& os, const MeasurementPolicy& policy)
+{
+    return os << "warmup " << policy.warmup_runs << ", runs " << policy.min_runs << ".."
+              << policy.max_runs << " until CI < " << policy.max_relative_ci * 100.0f << "%, "
+              << policy.reduction;
+}
+
+} // namespace miopen
@@ -34,6 +34,7 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/simulated_device.hpp>
 #include <miopen/timer.hpp>
 #include <miopen/hipoc_program.hpp>
 
@@ -51,16 +52,39 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <thread>
 #include <miopen/nogpu/handle_impl.hpp>
 namespace miopen {
 
+namespace {
+
+// The simulated device gives distinct addresses to the buffers, which are never dereferenced.
+void* SimulatedAllocate(void*, std::size_t sz)
+{
+    static std::atomic<std::uintptr_t> next{0x1000};
+    const auto aligned = (std::max<std::size_t>(sz, 1) + 255) & ~std::uintptr_t{255};
+    return reinterpret_cast<void*>(next.fetch_add(aligned)); // NOLINT (performance-no-int-to-ptr)
+}
+
+void SimulatedDeallocate(void*, void*) {}
+
+} // namespace
+
 Handle::Handle(miopenAcceleratorQueue_t /* stream */) : Handle::Handle() {}
 
 Handle::Handle() : impl(new HandleImpl())
 {
+    if(SimulatedDevice::IsEnabled())
+    {
+        this->impl->num_cu             = SimulatedDevice::GetComputeUnits();
+        this->impl->local_mem_size     = 65536;
+        this->impl->global_mem_size    = std::size_t{16} << 30;
+        this->impl->max_mem_alloc_size = this->impl->global_mem_size;
+        this->impl->allocator          = Allocator{SimulatedAllocate, SimulatedDeallocate, nullptr};
+    }
     this->impl->target_properties.Init(this);
     MIOPEN_LOG_NQI(*this);
 }
@@ -71,6 +95,8 @@ void Handle::SetStream(miopenAcceleratorQueue_t /* streamID */) const {}
 
 miopenAcceleratorQueue_t Handle::GetStream() const { return {}; }
 
+std::unique_ptr<Handle> Handle::CreateWorkerHandle() const { return std::make_unique<Handle>(); }
+
 void Handle::SetAllocator(miopenAllocatorFunction /* allocator */,
                           miopenDeallocatorFunction /* deallocator */,
                           void* /* allocatorContext */) const
@@ -163,7 +189,20 @@ bool Handle::HasKernel(const std::string& algorithm, const std::string& network_
     return this->impl->cache.HasKernels(algorithm, network_config);
 }
 
-KernelInvoke Handle::Run(Kernel /* k */) const { return {}; }
+KernelInvoke Handle::Run(Kernel k) const
+{
+    if(!SimulatedDevice::IsEnabled())
+        return {};
+
+    auto invoke      = k.Invoke(this->GetStream());
+    auto* const impl = this->impl.get();
+    invoke.simulate  = [impl, launch = k.GetLaunch()]() {
+        const auto time = SimulatedDevice::GetTime(launch);
+        if(impl->enable_profiling)
+            impl->profiling_result = time;
+    };
+    return invoke;
+}
 
 Program Handle::LoadProgram(const std::string& program_name,
                             std::string params,
@@ -183,9 +222,15 @@ Program Handle::LoadProgram(const std::string& program_name,
     auto pgmImpl     = std::make_shared<HIPOCProgramImpl>();
     pgmImpl->program = program_name;
     pgmImpl->target  = this->GetTargetProperties();
+    pgmImpl->options = params;
     auto p           = HIPOCProgram{};
     p.impl           = pgmImpl;
-    if(hsaco.empty())
+    if(hsaco.empty() && SimulatedDevice::IsEnabled())
+    {
+        // The simulated device runs no code, the build would only take time.
+        MIOPEN_LOG_I2("Not building " << program_name << " for the simulated device");
+    }
+    else if(hsaco.empty())
     {
         // avoid the constructor since it implicitly calls the HIP API
         pgmImpl->BuildCodeObject(params, is_kernel_str, kernel_src);
@@ -219,6 +264,8 @@ Program Handle::LoadProgram(const std::string& program_name,
     return p;
 }
 
+std::uintptr_t Handle::GetProgramScope() const { return 0; }
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -231,6 +278,13 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+KernelCacheStats Handle::GetKernelCacheStats() const { return this->impl->cache.GetStats(); }
+
+void Handle::SetKernelCacheLimits(std::size_t max_bytes, std::size_t max_programs) const
+{
+    this->impl->cache.SetLimits(max_bytes, max_programs);
+}
+
 void Handle::Finish() const {}
 void Handle::Flush() const {}
 
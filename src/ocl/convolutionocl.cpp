@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include <miopen/algorithm.hpp>
+#include <miopen/background_find.hpp>
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/config.h>
@@ -31,12 +32,16 @@
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
+#include <miopen/fallback_ranking.hpp>
 #include <miopen/find_db.hpp>
+#include <miopen/find_db_index.hpp>
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/invoker.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/measurement_policy.hpp>
+#include <miopen/simulated_device.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
@@ -49,7 +54,9 @@
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <type_traits>
 
 #include <boost/range/adaptors.hpp>
@@ -64,6 +71,7 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_NEAREST)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
 
 size_t GetKernelGlobalWorkDim(const KernelInvoke& kernel, int dim) { return kernel.gdims[dim]; }
@@ -283,16 +291,19 @@ static void EvaluateInvokers(Handle& handle,
 {
 
     const char* const arch = miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{});
-    if(arch != nullptr && strlen(arch) > 0)
+    if(arch != nullptr && strlen(arch) > 0 && !SimulatedDevice::IsEnabled())
     {
         return;
     }
     miopen::solver::ConvSolution selected{miopenStatusUnknownError};
-    float best = std::numeric_limits<float>::max();
+    TimingStats best;
+    best.time = std::numeric_limits<float>::max();
     Invoker best_invoker;
+    const MeasurementPolicy policy;
 
     for(const auto& sol : solutions)
     {
+        handle.ThrowIfCancelled();
         if(sol.workspace_sz > 0)
         {
             if(invoke_ctx.workSpace == nullptr)
@@ -317,11 +328,14 @@ static void EvaluateInvokers(Handle& handle,
         const auto invoker = handle.PrepareInvoker(*sol.invoker_factory, sol.construction_params);
         try
         {
-            invoker(handle, invoke_ctx);
-            const auto elapsed = handle.GetKernelTime();
-
-            MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed < best ? " < " : " >= ") << best);
-            if(elapsed < best)
+            const auto elapsed = policy.Measure([&]() {
+                invoker(handle, invoke_ctx);
+                return handle.GetKernelTime();
+            });
+
+            MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed.time < best.time ? " < " : " >= ")
+                             << best.time);
+            if(elapsed.time < best.time)
             {
                 best         = elapsed;
                 selected     = sol;
@@ -341,9 +355,10 @@ static void EvaluateInvokers(Handle& handle,
                                   << ", workspace_sz = " << selected.workspace_sz);
         record.SetValues(algorithm_name,
                          FindDbData{selected.solver_id,
-                                    best,
+                                    best.time,
                                     selected.workspace_sz,
-                                    FindDbKCacheKey::MakeUnused(algorithm_name)});
+                                    FindDbKCacheKey::MakeUnused(algorithm_name),
+                                    best.variance});
     }
 }
 
@@ -444,6 +459,112 @@ static void DirConvFindCore(Handle& handle,
                      record);
 }
 
+/// Runs the Find of the problem with the buffers in the order of its tensor descriptors.
+using BackgroundFindCall = std::function<void(Handle& handle,
+                                              const ConvolutionDescriptor& conv,
+                                              const std::vector<Data_t>& buffers,
+                                              Data_t workspace,
+                                              int request_count,
+                                              int* found,
+                                              miopenConvAlgoPerf_t* results)>;
+
+static std::string GetBackgroundFindKey(const Handle& handle, const ProblemDescription& problem)
+{
+    return handle.GetDbBasename() + "|" + problem.BuildConfKey().ToString();
+}
+
+/// Schedules the Normal Find of the problem on the background worker, with buffers of its own.
+/// The results are written to the user find-db, where the later Find calls find them, and used by
+/// UseBackgroundFindResult().
+static void FindInBackground(const Handle& handle,
+                             const ConvolutionDescriptor& conv,
+                             const ProblemDescription& problem,
+                             const std::vector<TensorDescriptor>& descriptors,
+                             std::size_t workspace_size,
+                             BackgroundFindCall find)
+{
+    auto background_conv = conv;
+    background_conv.findMode.Set(FindMode::Values::Normal);
+    const auto network_config = problem.BuildConfKey();
+    const auto direction      = problem.conv_problem.GetDirection();
+
+    handle.GetBackgroundFind().Schedule(
+        handle, GetBackgroundFindKey(handle, problem), [=](Handle& worker) {
+            auto buffers  = std::vector<Allocator::ManageDataPtr>{};
+            auto pointers = std::vector<Data_t>{};
+            for(const auto& descriptor : descriptors)
+            {
+                const auto element_size = get_data_size(descriptor.GetType());
+                buffers.push_back(worker.Create(descriptor.GetElementSpace() * element_size));
+                pointers.push_back(buffers.back().get());
+                visit_float(descriptor.GetType(), [&](auto as_float) {
+                    const auto zero = as_float(0.f);
+                    SetTensor(worker, descriptor, pointers.back(), &zero);
+                });
+            }
+            auto workspace = workspace_size != 0 ? worker.Create(workspace_size) : nullptr;
+
+            // Find 1.0 returns the fastest solution of each algorithm.
+            auto results = std::vector<miopenConvAlgoPerf_t>(miopenConvolutionAlgoImplicitGEMM + 1);
+            auto found   = 0;
+            find(worker,
+                 background_conv,
+                 pointers,
+                 workspace.get(),
+                 static_cast<int>(results.size()),
+                 &found,
+                 results.data());
+
+            auto solutions = std::vector<miopenConvSolution_t>{};
+            for(auto i = 0; i < found; ++i)
+            {
+                const auto algo = static_cast<miopenConvAlgorithm_t>(results[i].fwd_algo);
+                const auto algorithm_name =
+                    AlgorithmName{ConvolutionAlgoToDirectionalString(algo, direction)};
+                const auto solver_id = worker.GetFound1_0SolverId(network_config, algorithm_name);
+                if(!solver_id)
+                    continue;
+                solutions.push_back(
+                    {results[i].time, results[i].memory, solver::Id{*solver_id}.Value(), algo});
+            }
+            return solutions;
+        });
+}
+
+/// Once the background Find of the problem is done, makes the algorithm chosen by the caller run
+/// the fastest solution it has found within the workspace, so that the caller needs not to call
+/// Find again. Only the first call after the Find is done does so, the rest of them cost a single
+/// atomic load once all the results have been taken.
+static void UseBackgroundFindResult(Handle& handle,
+                                    ConvolutionContext& ctx,
+                                    const AlgorithmName& algorithm_name,
+                                    std::size_t workspace_size)
+{
+    auto& background = handle.GetBackgroundFind();
+    if(!background.HasResultsToTake())
+        return;
+    const auto solutions = background.TakeResult(GetBackgroundFindKey(handle, ctx.problem));
+    if(!solutions)
+        return;
+    const auto best = std::find_if(solutions->begin(), solutions->end(), [&](const auto& s) {
+        return s.workspace_size <= workspace_size;
+    });
+    if(best == solutions->end())
+        return;
+
+    const auto solver_id      = solver::Id{best->solution_id};
+    const auto network_config = ctx.problem.BuildConfKey();
+    const auto current        = handle.GetFound1_0SolverId(network_config, algorithm_name);
+    if(current && solver::Id{*current} == solver_id)
+        return;
+
+    MIOPEN_LOG_I("Switching " << algorithm_name.ToString() << " to " << solver_id.ToString()
+                              << " found in background");
+    const auto invoker =
+        LoadOrPrepareInvoker(handle, ctx, solver_id, ctx.problem.conv_problem.GetDirection());
+    handle.RegisterInvoker(invoker, network_config, solver_id.ToString(), algorithm_name);
+}
+
 void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                                  const TensorDescriptor& xDesc,
                                                  ConstData_t x,
@@ -477,14 +598,47 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
     std::vector<PerfField> perf_db;
 
     bool use_immediate_solution = false;
+    bool find_in_background     = false;
     miopenConvSolution_t sol;
-    if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx))
+    if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx) || findMode.IsBackground(ctx))
     {
         size_t count;
         bool fallback;
         GetForwardSolutions(handle, wDesc, xDesc, yDesc, 1, &count, &sol, &fallback);
         use_immediate_solution = (count > 0) && !(findMode.IsHybrid(ctx) && fallback);
         // In Hybrid Find mode, we use Normal Find instead of Immediate fallback kernels.
+        // In Background Find mode, Normal Find runs in background while they are used.
+        find_in_background = use_immediate_solution && fallback && findMode.IsBackground(ctx);
+    }
+
+    if(find_in_background)
+    {
+        FindInBackground(handle,
+                         *this,
+                         problem,
+                         {xDesc, wDesc, yDesc},
+                         workSpaceSize,
+                         [=](Handle& worker,
+                             const ConvolutionDescriptor& conv,
+                             const std::vector<Data_t>& buffers,
+                             Data_t workspace,
+                             int request_count,
+                             int* found,
+                             miopenConvAlgoPerf_t* results) {
+                             conv.FindConvFwdAlgorithm(worker,
+                                                       xDesc,
+                                                       buffers[0],
+                                                       wDesc,
+                                                       buffers[1],
+                                                       yDesc,
+                                                       buffers[2],
+                                                       request_count,
+                                                       found,
+                                                       results,
+                                                       workspace,
+                                                       workSpaceSize,
+                                                       exhaustiveSearch);
+                         });
     }
 
     if(use_immediate_solution)
@@ -628,6 +782,8 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
         auto ctx =
             ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward}; // forward
         ctx.SetStream(&handle);
+        if(findMode.IsBackground(ctx))
+            UseBackgroundFindResult(handle, ctx, algorithm_name, workSpaceSize);
         const auto network_config = ctx.problem.BuildConfKey();
         const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
 
@@ -771,6 +927,55 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
         return 10.0f / wti; // Assume WTI == 1.0 (100%) is 10 ms.
     };
 
+    // The solutions found for the most similar problems in the find-db come first, ranked by
+    // their times scaled by the flops. Then come the solvers the model learned from the find-db
+    // knows, ranked by the estimated times, and then the rest, ranked by WTI. WTI is not on the
+    // scale of the model, so the two are never compared.
+    static const auto no_index = FindDbIndex{};
+    const auto n_nearest       = Value(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_NEAREST{}, 3);
+    const auto& index          = n_nearest > 0 ? FindDbIndex::GetInstalled(handle) : no_index;
+    const auto& ranking        = FallbackRanking::GetInstalled(handle);
+    const auto features        = index.IsEmpty() && ranking.IsEmpty()
+                              ? ProblemFeatures{}
+                              : ProblemFeatures{problem.conv_problem};
+
+    std::vector<SolutionSortWrapper> nearest;
+    std::vector<SolutionSortWrapper> modelled;
+    const auto is_nearest = [&](const solver::Id& id) {
+        return std::any_of(nearest.begin(), nearest.end(), [&](const auto& entry) {
+            return entry.solution_id == id.Value();
+        });
+    };
+
+    for(const auto& neighbour : index.Query(features, n_nearest))
+    {
+        MIOPEN_LOG_I2("Similar problem: " << neighbour.entry->key
+                                          << ", distance: " << neighbour.distance);
+        const auto flops_ratio =
+            std::exp2(features.GetLog2Flops() - neighbour.entry->features.GetLog2Flops());
+
+        for(const auto& pair : neighbour.entry->values)
+        {
+            const auto solver_id = solver::Id{pair.second.solver_id};
+            if(!solver_id.IsValid() || is_nearest(solver_id))
+                continue;
+            const auto algo = solver_id.GetAlgo();
+            if(IsAlgorithmDisabled(algo))
+                continue;
+            const auto& s = solver_id.GetSolver();
+            if(s.IsEmpty())
+                continue;
+            if(!s.IsDynamic()) // The same as the solvers below.
+                continue;
+            if(!s.IsApplicable(ctx))
+                continue;
+
+            const auto time = pair.second.time * flops_ratio;
+            MIOPEN_LOG_I2(solver_id.ToString() << " Scaled time = " << time);
+            nearest.emplace_back(time, s.GetWorkspaceSize(ctx), solver_id.Value(), algo);
+        }
+    }
+
     for(const auto& solver_id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
     {
         // solver_id is always valid here, because taken from registry.
@@ -778,6 +983,8 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
         const auto algo = solver_id.GetAlgo();
         if(IsAlgorithmDisabled(algo)) // Algos can be disabled globally.
             continue;
+        if(is_nearest(solver_id))
+            continue;
         const auto& s = solver_id.GetSolver();
         if(s.IsEmpty())
             continue;
@@ -786,6 +993,14 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
         if(!s.IsApplicable(ctx))
             continue;
 
+        const auto estimated = ranking.Estimate(solver_id.ToString(), features);
+        if(estimated)
+        {
+            MIOPEN_LOG_I2(solver_id.ToString() << " Estimated time = " << *estimated);
+            modelled.emplace_back(*estimated, s.GetWorkspaceSize(ctx), solver_id.Value(), algo);
+            continue;
+        }
+
         const auto wti = s.GetWti(ctx);
         MIOPEN_LOG_I2(solver_id.ToString() << " Estimated WTI = " << wti);
         if(wti < 0.0f) // Skip unknown WTIs.
@@ -794,7 +1009,15 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
         interim.emplace_back(wti2time(wti), s.GetWorkspaceSize(ctx), solver_id.Value(), algo);
     }
 
-    MIOPEN_LOG_I2("maxSolutionCount = " << maxSolutionCount << ", available = " << interim.size());
+    std::sort(begin(nearest), end(nearest));
+    std::sort(begin(modelled), end(modelled));
+    std::sort(begin(interim), end(interim));
+    interim.insert(interim.begin(), modelled.begin(), modelled.end());
+    interim.insert(interim.begin(), nearest.begin(), nearest.end());
+
+    MIOPEN_LOG_I2("maxSolutionCount = " << maxSolutionCount << ", available = " << interim.size()
+                                        << ", of similar problems = " << nearest.size()
+                                        << ", estimated by the model = " << modelled.size());
     for(const auto& s : interim)
         MIOPEN_LOG_I2("id: " << s.solution_id << " algo: " << s.algorithm << ", time: " << s.time
                              << " ms, ws: " << s.workspace_size
@@ -803,7 +1026,6 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
     // * Used as index for writing into output array (solutions).
     // * Counts the number of entries written, yielding value for solutionsCount.
     auto i = std::size_t{0};
-    std::sort(begin(interim), end(interim));
     for(const auto& entry : interim)
     {
         if(i >= maxSolutionCount)
@@ -973,8 +1195,9 @@ Invoker LoadOrPrepareInvoker(Handle& handle,
                              solver::Id solver_id,
                              conv::Direction dir)
 {
-    const auto config = ctx.problem.BuildConfKey();
-    auto invoker      = handle.GetInvoker(config, solver_id);
+    const auto key     = ctx.problem.conv_problem.GetInternedKey();
+    const auto& config = key.GetNetworkConfig();
+    auto invoker       = handle.GetInvoker(config, solver_id);
     if(invoker)
         return *invoker;
     return PrepareInvoker(handle, ctx, config, solver_id, dir);
@@ -1105,14 +1328,46 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
     std::vector<PerfField> perf_db;
 
     bool use_immediate_solution = false;
+    bool find_in_background     = false;
     miopenConvSolution_t imm_sol;
     auto ctx = ConvolutionContext{problem};
-    if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx))
+    if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx) || findMode.IsBackground(ctx))
     {
         size_t count;
         bool fallback;
         GetBackwardSolutions(handle, dyDesc, wDesc, dxDesc, 1, &count, &imm_sol, &fallback);
         use_immediate_solution = (count > 0) && !(findMode.IsHybrid(ctx) && fallback);
+        find_in_background = use_immediate_solution && fallback && findMode.IsBackground(ctx);
+    }
+
+    if(find_in_background)
+    {
+        FindInBackground(handle,
+                         *this,
+                         problem,
+                         {dyDesc, wDesc, dxDesc},
+                         workSpaceSize,
+                         [=](Handle& worker,
+                             const ConvolutionDescriptor& conv,
+                             const std::vector<Data_t>& buffers,
+                             Data_t workspace,
+                             int request_count,
+                             int* found,
+                             miopenConvAlgoPerf_t* results) {
+                             conv.FindConvBwdDataAlgorithm(worker,
+                                                           dyDesc,
+                                                           buffers[0],
+                                                           wDesc,
+                                                           buffers[1],
+                                                           dxDesc,
+                                                           buffers[2],
+                                                           request_count,
+                                                           found,
+                                                           results,
+                                                           workspace,
+                                                           workSpaceSize,
+                                                           exhaustiveSearch);
+                         });
     }
 
     if(use_immediate_solution)
@@ -1288,6 +1543,8 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
 
         auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
         ctx.SetStream(&handle);
+        if(findMode.IsBackground(ctx))
+            UseBackgroundFindResult(handle, ctx, algorithm_name, workSpaceSize);
         const auto network_config = ctx.problem.BuildConfKey();
         const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
 
@@ -1463,13 +1720,45 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
 
     std::vector<PerfField> perf_db;
     bool use_immediate_solution = false;
+    bool find_in_background     = false;
     miopenConvSolution_t imm_sol;
-    if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx))
+    if(findMode.IsFast(ctx) || findMode.IsHybrid(ctx) || findMode.IsBackground(ctx))
     {
         size_t count;
         bool fallback;
         GetWrwSolutions(handle, dyDesc, xDesc, dwDesc, 1, &count, &imm_sol, &fallback);
         use_immediate_solution = (count > 0) && !(findMode.IsHybrid(ctx) && fallback);
+        find_in_background = use_immediate_solution && fallback && findMode.IsBackground(ctx);
+    }
+
+    if(find_in_background)
+    {
+        FindInBackground(handle,
+                         *this,
+                         problem,
+                         {dyDesc, xDesc, dwDesc},
+                         workSpaceSize,
+                         [=](Handle& worker,
+                             const ConvolutionDescriptor& conv,
+                             const std::vector<Data_t>& buffers,
+                             Data_t workspace,
+                             int request_count,
+                             int* found,
+                             miopenConvAlgoPerf_t* results) {
+                             conv.FindConvBwdWeightsAlgorithm(worker,
+                                                              dyDesc,
+                                                              buffers[0],
+                                                              xDesc,
+                                                              buffers[1],
+                                                              dwDesc,
+                                                              buffers[2],
+                                                              request_count,
+                                                              found,
+                                                              results,
+                                                              workspace,
+                                                              workSpaceSize,
+                                                              exhaustiveSearch);
+                         });
     }
 
     if(use_immediate_solution)
@@ -1597,7 +1886,7 @@ static void ConvWrwCheckNumerics(const Handle& handle,
 }
 
 // BackwardWeightsAlgorithm()
-void ConvolutionDescriptor::ConvolutionBackwardWeights(const Handle& handle,
+void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
                                                        const void* alpha,
                                                        const TensorDescriptor& dyDesc,
                                                        ConstData_t dy,
@@ -1625,6 +1914,13 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(const Handle& handle,
         decltype(auto) algorithm_name = AlgorithmName{ConvolutionAlgoToDirectionalString(
             static_cast<miopenConvAlgorithm_t>(algo), direction)};
         decltype(auto) ctx = conv::ProblemDescription{dyDesc, dwDesc, xDesc, *this, direction};
+        if(findMode.Get() == FindMode::Values::Background)
+        {
+            auto context = ConvolutionContext{xDesc, dwDesc, dyDesc, *this, direction};
+            context.SetStream(&handle);
+            if(findMode.IsBackground(context))
+                UseBackgroundFindResult(handle, context, algorithm_name, workSpaceSize);
+        }
         decltype(auto) network_config = ctx.BuildConfKey();
         decltype(auto) invoker = handle.GetInvoker(network_config, boost::none, algorithm_name);
 
@@ -288,6 +288,24 @@ void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 
 miopenAcceleratorQueue_t Handle::GetStream() const { return impl->queue.get(); }
 
+std::unique_ptr<Handle> Handle::CreateWorkerHandle() const
+{
+    cl_int status = 0;
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+    auto queue = HandleImpl::AqPtr{clCreateCommandQueue(
+        impl->context.get(), impl->device, CL_QUEUE_PROFILING_ENABLE, &status)};
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "Creating Command Queue. (clCreateCommandQueue)");
+    // The handle retains the queue.
+    return std::make_unique<Handle>(queue.get());
+}
+
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
                           void* allocatorContext) const
@@ -447,6 +465,11 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
+std::uintptr_t Handle::GetProgramScope() const
+{
+    return reinterpret_cast<std::uintptr_t>(miopen::GetContext(this->GetStream()));
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -459,6 +482,13 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+KernelCacheStats Handle::GetKernelCacheStats() const { return this->impl->cache.GetStats(); }
+
+void Handle::SetKernelCacheLimits(std::size_t max_bytes, std::size_t max_programs) const
+{
+    this->impl->cache.SetLimits(max_bytes, max_programs);
+}
+
 void Handle::Finish() const { clFinish(this->GetStream()); }
 
 void Handle::Flush() const { clFlush(this->GetStream()); }
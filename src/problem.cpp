@@ -39,6 +39,8 @@
 
 #include <boost/hof/match.hpp>
 
+#include <algorithm>
+
 namespace miopen {
 
 namespace detail {
@@ -110,24 +112,25 @@ Problem::FindSolutions(Handle& handle, const FindOptions& options, std::size_t m
         buffers.emplace(pair.first, std::move(buffer));
     }
 
-    const auto find = boost::hof::match([&](const ConvolutionDescriptor& op_desc) {
+    const auto find = boost::hof::match([&](ConvolutionDescriptor op_desc) {
+        op_desc.tuningBudget = options.tuning_budget;
         return FindSolutionsImpl(handle, options, max_solutions, buffers, op_desc);
     });
 
-    auto ret = boost::apply_visitor(find, operator_descriptor);
+    auto found = boost::apply_visitor(find, operator_descriptor);
 
-    const auto sorter = [&]() -> std::function<bool(const Solution&, const Solution&)> {
-        switch(options.results_order)
-        {
-        case miopenFindResultsOrderByTime:
-            return [](auto&& l, auto&& r) { return l.GetTime() < r.GetTime(); };
-        case miopenFindResultsOrderByWorkspaceSize:
-            return [](auto&& l, auto&& r) { return l.GetWorkspaceSize() < r.GetWorkspaceSize(); };
-        }
-        MIOPEN_THROW(miopenStatusNotImplemented);
-    }();
+    auto costs = std::vector<SolutionCost>{};
+    costs.reserve(found.size());
+    for(const auto& solution : found)
+        costs.push_back({solution.GetTime(), solution.GetWorkspaceSize()});
 
-    std::sort(ret.begin(), ret.end(), sorter);
+    auto ret = std::vector<Solution>{};
+    for(const auto i : options.Select(costs))
+    {
+        if(ret.size() >= max_solutions)
+            break;
+        ret.emplace_back(std::move(found[i]));
+    }
 
     return ret;
 }
@@ -206,8 +209,14 @@ std::vector<Solution> Problem::FindSolutionsImpl(Handle& handle,
     const auto workspace_size = std::min(options.workspace_limit, workspace_max);
     auto workspace            = workspace_size != 0 ? handle.Create(workspace_size) : nullptr;
 
+    // Find 1.0 returns the fastest solution of each algorithm. The selection policies other than
+    // the default one need all of them, to be truncated after the selection.
+    const auto find1_max_solutions =
+        options.selection_policy == miopenFindSelectionAll
+            ? max_solutions
+            : std::max<std::size_t>(max_solutions, miopenConvolutionAlgoImplicitGEMM + 1);
     auto find1_solutions = std::vector<miopenConvAlgoPerf_t>{};
-    find1_solutions.resize(max_solutions);
+    find1_solutions.resize(find1_max_solutions);
     int found;
 
     // auto log_tensor = [](auto name, const TensorDescriptor& tensor) {
@@ -240,7 +249,7 @@ std::vector<Solution> Problem::FindSolutionsImpl(Handle& handle,
                             w.get(),
                             y_desc,
                             y.get(),
-                            max_solutions,
+                            find1_max_solutions,
                             &found,
                             find1_solutions.data(),
                             workspace.get(),
@@ -260,7 +269,7 @@ std::vector<Solution> Problem::FindSolutionsImpl(Handle& handle,
                             w.get(),
                             x_desc,
                             x.get(),
-                            max_solutions,
+                            find1_max_solutions,
                             &found,
                             find1_solutions.data(),
                             workspace.get(),
@@ -281,7 +290,7 @@ std::vector<Solution> Problem::FindSolutionsImpl(Handle& handle,
                                               x_.get(),
                                               w_desc,
                                               w.get(),
-                                              max_solutions,
+                                              find1_max_solutions,
                                               &found,
                                               find1_solutions.data(),
                                               workspace.get(),
@@ -26,6 +26,7 @@
 
 #include <miopen/ramdb.hpp>
 
+#include <miopen/db_cache.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -46,7 +47,7 @@ namespace miopen {
 
 std::string RamDb::GetTimeFilePath(const std::string& path) { return path + ".time"; }
 
-static ramdb_clock::time_point GetDbModificationTime(const std::string& path)
+ramdb_clock::time_point RamDb::GetDbModificationTime(const std::string& path)
 {
     const auto time_file_path = RamDb::GetTimeFilePath(path);
     auto file                 = std::ifstream{time_file_path};
@@ -63,6 +64,7 @@ static ramdb_clock::time_point GetDbModificationTime(const std::string& path)
 static void UpdateDbModificationTime(const std::string& path)
 {
     MIOPEN_LOG_I2("Updating db modification time for " << path);
+    DbCache::Invalidate(path);
 
     const auto time           = ramdb_clock::now().time_since_epoch();
     const auto time_file_path = RamDb::GetTimeFilePath(path);
@@ -88,7 +90,16 @@ static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60};
 
 using exclusive_lock = std::unique_lock<LockFile>;
 
-RamDb::RamDb(std::string path, bool is_system) : PlainTextDb(path, is_system) {}
+RamDb::RamDb(std::string path, bool is_system) : PlainTextDb(path, is_system)
+{
+    if(DbJournal::IsEnabled())
+    {
+        journal = std::make_unique<DbJournal>(
+            GetFileName(), GetLockFile(), [this](bool is_complete) {
+                OnJournalFlushUnsafe(is_complete);
+            });
+    }
+}
 
 RamDb& RamDb::GetCached(const std::string& path, bool is_system)
 {
@@ -135,6 +146,22 @@ boost::optional<DbRecord> RamDb::FindRecord(const std::string& problem)
     return FindRecordUnsafe(problem);
 }
 
+void RamDb::ForEachRecord(const std::function<void(const DbRecord&)>& f)
+{
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    if(!ValidateUnsafe())
+        Prefetch();
+
+    for(const auto& item : cache)
+    {
+        auto record = DbRecord{item.first};
+        if(record.ParseContents(item.second.content))
+            f(record);
+    }
+}
+
 bool RamDb::StoreRecord(const DbRecord& record)
 {
     const auto& key = record.GetKey();
@@ -143,7 +170,11 @@ bool RamDb::StoreRecord(const DbRecord& record)
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
-    if(!DisableUserDbFileIO)
+    if(journal)
+    {
+        journal->AppendUnsafe(DbJournal::Op::From(DbJournal::Op::Store, record));
+    }
+    else if(!DisableUserDbFileIO)
     {
         if(!StoreRecordUnsafe(record))
             return false;
@@ -166,7 +197,17 @@ bool RamDb::UpdateRecord(DbRecord& record)
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
-    if(!DisableUserDbFileIO)
+    if(journal)
+    {
+        if(!ValidateUnsafe())
+            Prefetch();
+        const auto old_record = FindRecordUnsafe(key);
+        // Journaled unmerged, so values stored by other processes meanwhile are preserved.
+        journal->AppendUnsafe(DbJournal::Op::From(DbJournal::Op::Update, record));
+        if(old_record)
+            record.Merge(*old_record);
+    }
+    else if(!DisableUserDbFileIO)
     {
         if(!UpdateRecordUnsafe(record))
             return false;
@@ -192,7 +233,12 @@ bool RamDb::RemoveRecord(const std::string& key)
     const auto is_valid = ValidateUnsafe();
 #endif
 
-    if(!DisableUserDbFileIO)
+    if(journal)
+    {
+        journal->AppendUnsafe({DbJournal::Op::Remove, key, {}});
+        DbCache::Invalidate(GetFileName());
+    }
+    else if(!DisableUserDbFileIO)
     {
         if(!RemoveRecordUnsafe(key))
             return false;
@@ -228,7 +274,12 @@ bool RamDb::Remove(const std::string& key, const std::string& id)
     if(!record || !record->EraseValues(id))
         return false;
 
-    if(!DisableUserDbFileIO)
+    if(journal)
+    {
+        journal->AppendUnsafe({DbJournal::Op::RemoveId, key, id});
+        DbCache::Invalidate(GetFileName());
+    }
+    else if(!DisableUserDbFileIO)
     {
         if(!StoreRecordUnsafe(*record))
             return false;
@@ -297,7 +348,8 @@ bool RamDb::ValidateUnsafe()
     if(DisableUserDbFileIO)
         return true;
     if(!boost::filesystem::exists(GetFileName()))
-        return cache.empty();
+        // Journaled records are cached before the first flush creates the file.
+        return cache.empty() || (journal && !journal->GetPendingUnsafe().empty());
     const auto file_mod_time     = GetDbModificationTime(GetFileName());
     const auto validation_result = file_mod_time < file_read_time;
     MIOPEN_LOG_I2("DB file is " << (validation_result ? "older" : "newer")
@@ -349,16 +401,48 @@ void RamDb::Prefetch()
             cache.emplace(key, CacheItem{n_line, contents});
         }
 
+        if(journal)
+            ApplyJournalUnsafe();
         file_read_time = ramdb_clock::now();
     });
 }
 
+void RamDb::ApplyJournalUnsafe()
+{
+    for(const auto& op : journal->GetPendingUnsafe())
+    {
+        auto record = FindRecordUnsafe(op.key);
+        op.Apply(record);
+
+        if(!record)
+        {
+            cache.erase(op.key);
+            continue;
+        }
+
+        auto ss = std::ostringstream{};
+        record->WriteIdsAndValues(ss);
+        cache[op.key] = CacheItem{-1, ss.str()};
+    }
+}
+
+void RamDb::OnJournalFlushUnsafe(bool is_complete)
+{
+    // The file now holds what the cache does unless it has been changed by someone else.
+    const auto is_valid = is_complete && ValidateUnsafe();
+    UpdateDbModificationTime(GetFileName());
+    if(is_valid)
+        file_read_time = ramdb_clock::now();
+}
+
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
 void RamDb::UpdateCacheEntryUnsafe(const DbRecord& record)
 {
     const auto is_valid = ValidateUnsafe();
 
-    if(!DisableUserDbFileIO)
+    if(journal)
+        DbCache::Invalidate(GetFileName());
+    else if(!DisableUserDbFileIO)
         UpdateDbModificationTime(GetFileName());
 
     if(is_valid)
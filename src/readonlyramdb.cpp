@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
 
@@ -40,6 +41,8 @@
 #include <sstream>
 #include <map>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_COMPILED_DB)
+
 namespace miopen {
 
 namespace debug {
@@ -152,9 +155,58 @@ void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
         }
         else
         {
+            if(TryOpenCompiled())
+                return;
             auto input_stream = std::ifstream{db_path};
             ParseAndLoadDb(input_stream, warn_if_unreadable);
         }
     });
 }
+
+bool ReadonlyRamDb::TryOpenCompiled()
+{
+    if(IsEnabled(MIOPEN_DEBUG_DISABLE_COMPILED_DB{}))
+        return false;
+
+    return compiled.Open(CompiledDb::GetPath(db_path), db_path);
+}
+
+boost::optional<DbRecord> ReadonlyRamDb::FindCompiledRecord(const std::string& problem) const
+{
+    const auto found = compiled.Find(problem);
+
+    if(found == nullptr)
+        return boost::none;
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+
+    // The image holds already tokenized IDs and VALUES, so there is nothing to parse.
+    auto record = DbRecord{problem};
+    for(auto pair = compiled.begin(*found); pair != compiled.end(*found); ++pair)
+        record.map.emplace(compiled.Get(pair->id), compiled.Get(pair->values));
+
+    return record;
+}
+
+void ReadonlyRamDb::ForEachRecord(const std::function<void(const DbRecord&)>& f) const
+{
+    if(compiled.IsOpen())
+    {
+        for(const auto& found : compiled)
+        {
+            auto record = DbRecord{compiled.Get(found.key)};
+            for(auto pair = compiled.begin(found); pair != compiled.end(found); ++pair)
+                record.map.emplace(compiled.Get(pair->id), compiled.Get(pair->values));
+            f(record);
+        }
+        return;
+    }
+
+    for(const auto& item : cache)
+    {
+        auto record = DbRecord{item.first};
+        if(record.ParseContents(item.second.content))
+            f(record);
+    }
+}
 } // namespace miopen
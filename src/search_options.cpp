@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_options.hpp>
+
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace miopen {
+
+std::vector<std::size_t> FindOptions::Select(const std::vector<SolutionCost>& candidates) const
+{
+    auto selected = std::vector<std::size_t>{};
+    for(auto i = std::size_t{0}; i < candidates.size(); ++i)
+        if(candidates[i].workspace <= workspace_limit)
+            selected.push_back(i);
+
+    const auto by_time = [&](auto l, auto r) {
+        return std::tie(candidates[l].time, candidates[l].workspace) <
+               std::tie(candidates[r].time, candidates[r].workspace);
+    };
+    const auto by_workspace = [&](auto l, auto r) {
+        return std::tie(candidates[l].workspace, candidates[l].time) <
+               std::tie(candidates[r].workspace, candidates[r].time);
+    };
+
+    switch(selection_policy)
+    {
+    case miopenFindSelectionAll: break;
+    case miopenFindSelectionParetoFront: {
+        // Walking from the fastest one, each solution is on the front unless a faster one needs
+        // no more workspace.
+        std::sort(selected.begin(), selected.end(), by_time);
+        auto front         = std::vector<std::size_t>{};
+        auto min_workspace = std::numeric_limits<std::size_t>::max();
+        for(const auto i : selected)
+        {
+            if(!front.empty() && candidates[i].workspace >= min_workspace)
+                continue;
+            front.push_back(i);
+            min_workspace = candidates[i].workspace;
+        }
+        selected = std::move(front);
+        break;
+    }
+    case miopenFindSelectionMinWorkspaceWithinTimeTolerance: {
+        if(selected.empty())
+            break;
+        const auto fastest = *std::min_element(selected.begin(), selected.end(), by_time);
+        const auto limit   = candidates[fastest].time +
+                           std::abs(candidates[fastest].time) * time_tolerance;
+        selected.erase(std::remove_if(selected.begin(),
+                                      selected.end(),
+                                      [&](auto i) { return candidates[i].time > limit; }),
+                       selected.end());
+        std::sort(selected.begin(), selected.end(), by_workspace);
+        return selected;
+    }
+    default: MIOPEN_THROW(miopenStatusNotImplemented);
+    }
+
+    switch(results_order)
+    {
+    case miopenFindResultsOrderByTime:
+        std::stable_sort(selected.begin(), selected.end(), by_time);
+        break;
+    case miopenFindResultsOrderByWorkspaceSize:
+        std::stable_sort(selected.begin(), selected.end(), by_workspace);
+        break;
+    default: MIOPEN_THROW(miopenStatusNotImplemented);
+    }
+    return selected;
+}
+
+} // namespace miopen
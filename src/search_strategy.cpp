@@ -0,0 +1,443 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_strategy.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/make_unique.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_STRATEGY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_STRATEGY_PERCENT)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+const char* ToCString(const SearchStrategyKind kind)
+{
+    switch(kind)
+    {
+    case SearchStrategyKind::Exhaustive: return "EXHAUSTIVE";
+    case SearchStrategyKind::Random: return "RANDOM";
+    case SearchStrategyKind::Halving: return "HALVING";
+    case SearchStrategyKind::Coordinate: return "COORDINATE";
+    case SearchStrategyKind::Surrogate: return "SURROGATE";
+    }
+    return "<Unknown>";
+}
+
+SearchStrategyKind GetSearchStrategyKindImpl()
+{
+    const char* const p_asciz = miopen::GetStringEnv(MIOPEN_TUNING_STRATEGY{});
+    if(p_asciz == nullptr)
+        return SearchStrategyKind::Exhaustive;
+    std::string str = p_asciz;
+    for(auto& c : str)
+        c = toupper(static_cast<unsigned char>(c));
+    for(const auto kind : {SearchStrategyKind::Exhaustive,
+                           SearchStrategyKind::Random,
+                           SearchStrategyKind::Halving,
+                           SearchStrategyKind::Coordinate,
+                           SearchStrategyKind::Surrogate})
+    {
+        if(str == ToCString(kind))
+            return kind;
+    }
+    MIOPEN_LOG_NQE("Wrong MIOPEN_TUNING_STRATEGY, using EXHAUSTIVE.");
+    return SearchStrategyKind::Exhaustive;
+}
+
+constexpr auto failed_time = std::numeric_limits<float>::max();
+
+std::vector<std::size_t> ShuffledIndices(std::size_t n, std::mt19937& gen)
+{
+    std::vector<std::size_t> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::shuffle(indices.begin(), indices.end(), gen);
+    return indices;
+}
+
+class ExhaustiveStrategy : public SearchStrategy
+{
+public:
+    ExhaustiveStrategy(std::size_t space_size_) : space_size(space_size_) {}
+
+    SearchBatch Propose() override
+    {
+        SearchBatch batch;
+        if(!is_done)
+        {
+            batch.configs.resize(space_size);
+            std::iota(batch.configs.begin(), batch.configs.end(), 0);
+        }
+        is_done = true;
+        return batch;
+    }
+
+    void Report(const std::vector<float>&) override {}
+
+private:
+    std::size_t space_size;
+    bool is_done = false;
+};
+
+class RandomStrategy : public SearchStrategy
+{
+public:
+    RandomStrategy(std::size_t space_size, std::size_t budget, std::mt19937& gen)
+        : sample(ShuffledIndices(space_size, gen))
+    {
+        sample.resize(std::min(budget, sample.size()));
+    }
+
+    SearchBatch Propose() override
+    {
+        SearchBatch batch;
+        batch.configs.swap(sample);
+        return batch;
+    }
+
+    void Report(const std::vector<float>&) override {}
+
+private:
+    std::vector<std::size_t> sample;
+};
+
+/// Successive halving with the number of runs as the resource: each round keeps the best third of
+/// the configs and measures them three times as many times, until one config is left.
+class HalvingStrategy : public SearchStrategy
+{
+public:
+    HalvingStrategy(std::size_t space_size, std::size_t budget, std::mt19937& gen)
+        : survivors(ShuffledIndices(space_size, gen))
+    {
+        survivors.resize(std::min(budget, survivors.size()));
+    }
+
+    SearchBatch Propose() override
+    {
+        SearchBatch batch;
+        if(is_done)
+            return batch;
+        batch.configs = survivors;
+        batch.runs    = runs;
+        return batch;
+    }
+
+    void Report(const std::vector<float>& times) override
+    {
+        std::vector<std::size_t> order(survivors.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](auto l, auto r) {
+            return times[l] < times[r];
+        });
+
+        std::vector<std::size_t> kept;
+        const auto n_kept = (survivors.size() + eta - 1) / eta;
+        for(std::size_t i = 0; i < n_kept && times[order[i]] != failed_time; ++i)
+            kept.push_back(survivors[order[i]]);
+
+        survivors.swap(kept);
+        runs    = std::min(runs * eta, max_runs);
+        is_done = survivors.size() <= 1;
+    }
+
+private:
+    static constexpr std::size_t eta      = 3;
+    static constexpr std::size_t max_runs = 27;
+
+    std::vector<std::size_t> survivors;
+    std::size_t runs = 1;
+    bool is_done     = false;
+};
+
+constexpr std::size_t HalvingStrategy::eta;
+constexpr std::size_t HalvingStrategy::max_runs;
+
+/// Starts from the best of a few configs taken in the given order, then measures the configs that
+/// differ from the best one in a single field, field after field. When no field improves the best
+/// config, starts over from the next few configs, until the budget is spent.
+class CoordinateStrategy : public SearchStrategy
+{
+public:
+    CoordinateStrategy(const std::vector<ConfigFields>& space_,
+                       std::size_t budget_,
+                       std::vector<std::size_t> start_order_,
+                       std::size_t start_size_)
+        : space(space_),
+          budget(std::min(budget_, space_.size())),
+          start_order(std::move(start_order_)),
+          start_size(std::max<std::size_t>(start_size_, 1)),
+          times(space_.size(), failed_time),
+          is_measured(space_.size(), false)
+    {
+        std::size_t n_fields = 0;
+        for(const auto& config : space)
+            n_fields = std::max(n_fields, config.size());
+
+        // Configs that only differ in field f share the hash of all their other fields.
+        // They are grouped by that hash per field, collisions are filtered out by IsNeighbour().
+        group_keys.resize(space.size());
+        neighbours.resize(n_fields);
+        for(std::size_t i = 0; i < space.size(); ++i)
+        {
+            std::vector<std::size_t> hashes(n_fields, 0);
+            auto total = space[i].size();
+            for(std::size_t f = 0; f < space[i].size(); ++f)
+            {
+                hashes[f] = std::hash<std::string>{}(space[i][f]) * (2 * f + 1) + f;
+                total += hashes[f];
+            }
+            group_keys[i].resize(n_fields);
+            for(std::size_t f = 0; f < n_fields; ++f)
+            {
+                group_keys[i][f] = total - hashes[f];
+                neighbours[f][group_keys[i][f]].push_back(i);
+            }
+        }
+    }
+
+    SearchBatch Propose() override
+    {
+        batch.configs.clear();
+        if(n_measured >= budget)
+            return batch;
+
+        const auto n_fields = neighbours.size();
+        while(current != none && n_fields > 0 && n_stalled < n_fields)
+        {
+            const auto f = field;
+            field        = (field + 1) % n_fields;
+
+            const auto& group = neighbours[f][group_keys[current][f]];
+            for(const auto i : group)
+                if(!is_measured[i] && IsNeighbour(i, f))
+                    batch.configs.push_back(i);
+
+            if(!batch.configs.empty())
+                return Limited(batch);
+            ++n_stalled; // Nothing left to measure along this field.
+        }
+
+        // Starting over.
+        current = none;
+        const auto n_start =
+            n_restarts++ == 0 ? start_size : std::max<std::size_t>(start_size / 4, 1);
+        while(next_start < start_order.size() && batch.configs.size() < n_start)
+        {
+            const auto i = start_order[next_start++];
+            if(!is_measured[i])
+                batch.configs.push_back(i);
+        }
+        return Limited(batch);
+    }
+
+    void Report(const std::vector<float>& batch_times) override
+    {
+        auto is_improved = false;
+        for(std::size_t k = 0; k < batch.configs.size(); ++k)
+        {
+            const auto i   = batch.configs[k];
+            times[i]       = batch_times[k];
+            is_measured[i] = true;
+            ++n_measured;
+            if(times[i] != failed_time && (current == none || times[i] < times[current]))
+            {
+                current     = i;
+                is_improved = true;
+            }
+        }
+        n_stalled = is_improved ? 0 : n_stalled + 1;
+    }
+
+private:
+    static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    const std::vector<ConfigFields>& space;
+    std::size_t budget;
+    std::vector<std::size_t> start_order;
+    std::size_t start_size;
+    std::vector<float> times;
+    std::vector<bool> is_measured;
+    std::vector<std::vector<std::size_t>> group_keys;
+    std::vector<std::unordered_map<std::size_t, std::vector<std::size_t>>> neighbours;
+
+    SearchBatch batch;
+    std::size_t n_measured = 0;
+    std::size_t next_start = 0;
+    std::size_t n_restarts = 0;
+    std::size_t current    = none;
+    std::size_t field      = 0;
+    std::size_t n_stalled  = 0;
+
+    bool IsNeighbour(std::size_t i, std::size_t f) const
+    {
+        const auto& a = space[i];
+        const auto& b = space[current];
+        if(a.size() != b.size())
+            return false;
+        for(std::size_t g = 0; g < a.size(); ++g)
+            if(g != f && a[g] != b[g])
+                return false;
+        return true;
+    }
+
+    SearchBatch& Limited(SearchBatch& b) const
+    {
+        b.configs.resize(std::min(b.configs.size(), budget - n_measured));
+        return b;
+    }
+};
+
+/// Ranks the configs by how often their field values appear in the known best configs,
+/// as if the fields were independent: the sum of the log-frequencies with Laplace smoothing.
+std::vector<std::size_t> RankBySurrogate(const std::vector<ConfigFields>& space,
+                                         const std::vector<ConfigFields>& known_best,
+                                         std::mt19937& gen)
+{
+    std::size_t n_fields = 0;
+    for(const auto& config : space)
+        n_fields = std::max(n_fields, config.size());
+
+    std::vector<std::unordered_map<std::string, double>> counts(n_fields);
+    std::vector<std::unordered_map<std::string, double>> values(n_fields);
+    double n_known = 0;
+    for(const auto& config : known_best)
+    {
+        if(config.size() != n_fields)
+            continue;
+        for(std::size_t f = 0; f < n_fields; ++f)
+            counts[f][config[f]] += 1;
+        n_known += 1;
+    }
+    for(const auto& config : space)
+        for(std::size_t f = 0; f < config.size(); ++f)
+            values[f][config[f]] = 0;
+
+    std::vector<double> scores(space.size(), 0);
+    for(std::size_t i = 0; i < space.size(); ++i)
+    {
+        for(std::size_t f = 0; f < space[i].size(); ++f)
+        {
+            const auto found = counts[f].find(space[i][f]);
+            const auto count = found != counts[f].end() ? found->second : 0.0;
+            scores[i] += std::log((count + 1) / (n_known + static_cast<double>(values[f].size())));
+        }
+    }
+
+    auto order = ShuffledIndices(space.size(), gen); // Random order of the configs scored equally.
+    std::stable_sort(
+        order.begin(), order.end(), [&](auto l, auto r) { return scores[l] > scores[r]; });
+    return order;
+}
+
+std::size_t CountUsable(const std::vector<ConfigFields>& space,
+                        const std::vector<ConfigFields>& known_best)
+{
+    if(space.empty())
+        return 0;
+    return std::count_if(known_best.begin(), known_best.end(), [&](const auto& config) {
+        return config.size() == space.front().size();
+    });
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const SearchStrategyKind kind)
+{
+    return os << ToCString(kind);
+}
+
+SearchStrategyKind GetSearchStrategyKind()
+{
+    static const auto kind = GetSearchStrategyKindImpl();
+    return kind;
+}
+
+std::size_t GetSearchStrategyBudget(const std::size_t space_size)
+{
+    const auto percent = std::min<std::size_t>(Value(MIOPEN_TUNING_STRATEGY_PERCENT{}, 10), 100);
+    const auto budget  = (space_size * percent + 99) / 100;
+    return std::min(space_size, std::max<std::size_t>(budget, 16));
+}
+
+ConfigFields SplitConfigFields(const std::string& serialized)
+{
+    ConfigFields fields;
+    std::istringstream ss(serialized);
+    std::string field;
+    while(std::getline(ss, field, ','))
+        fields.push_back(field);
+    return fields;
+}
+
+std::unique_ptr<SearchStrategy> MakeSearchStrategy(const SearchStrategyKind kind,
+                                                   const std::vector<ConfigFields>& space,
+                                                   const std::size_t budget,
+                                                   const std::vector<ConfigFields>& known_best,
+                                                   const unsigned seed)
+{
+    std::mt19937 gen{seed};
+    // The descent starts from the best of 1/8 of the budget and restarts from fewer configs.
+    const auto start_size = std::max<std::size_t>(budget / 8, 4);
+
+    switch(kind)
+    {
+    case SearchStrategyKind::Exhaustive: return std::make_unique<ExhaustiveStrategy>(space.size());
+    case SearchStrategyKind::Random:
+        return std::make_unique<RandomStrategy>(space.size(), budget, gen);
+    case SearchStrategyKind::Halving:
+        return std::make_unique<HalvingStrategy>(space.size(), budget, gen);
+    case SearchStrategyKind::Coordinate:
+        return std::make_unique<CoordinateStrategy>(
+            space, budget, ShuffledIndices(space.size(), gen), start_size);
+    case SearchStrategyKind::Surrogate:
+        if(CountUsable(space, known_best) == 0)
+        {
+            MIOPEN_LOG_I("No known configs for the surrogate model, using COORDINATE");
+            return MakeSearchStrategy(
+                SearchStrategyKind::Coordinate, space, budget, known_best, seed);
+        }
+        return std::make_unique<CoordinateStrategy>(
+            space, budget, RankBySurrogate(space, known_best, gen), start_size);
+    }
+    MIOPEN_THROW(miopenStatusInternalError);
+}
+
+} // namespace solver
+} // namespace miopen
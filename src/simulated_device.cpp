@@ -0,0 +1,260 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/simulated_device.hpp>
+
+#include <miopen/config.h>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SIMULATED_DEVICE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SIMULATED_DEVICE_CU)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_KERNEL_TIME_RECORD)
+
+namespace miopen {
+
+std::string KernelLaunch::GetKey() const
+{
+    std::ostringstream ss;
+    ss << program << '|' << kernel << '|' << gdims[0] << ',' << gdims[1] << ',' << gdims[2] << '|'
+       << ldims[0] << ',' << ldims[1] << ',' << ldims[2] << '|' << options;
+    return ss.str();
+}
+
+namespace {
+
+std::size_t Product(const std::array<std::size_t, 3>& dims)
+{
+    return std::accumulate(dims.begin(), dims.end(), std::size_t{1}, [](auto l, auto r) {
+        return l * std::max<std::size_t>(r, 1);
+    });
+}
+
+std::size_t DivCeil(std::size_t numerator, std::size_t denominator)
+{
+    return (numerator + denominator - 1) / denominator;
+}
+
+} // namespace
+
+boost::optional<float> AnalyticCostModel::GetTime(const KernelLaunch& launch) const
+{
+    constexpr std::size_t wavefront_size    = 64;
+    constexpr std::size_t waves_per_cu      = 40;
+    constexpr std::size_t max_groups_per_cu = 16;
+    constexpr float launch_overhead         = 0.005f;  // ms
+    constexpr float wave_latency            = 0.01f;   // ms, a round of few waves.
+    constexpr float wave_issue_time         = 0.0005f; // ms per wave resident on the unit.
+
+    const auto cu_count        = std::max<std::size_t>(compute_units, 1);
+    const auto group_size      = Product(launch.ldims);
+    const auto groups          = DivCeil(Product(launch.gdims), group_size);
+    const auto waves_per_group = DivCeil(group_size, wavefront_size);
+
+    // The groups a unit runs at once are limited by its wave slots and by its group slots.
+    const auto groups_per_cu =
+        std::max<std::size_t>(std::min(max_groups_per_cu, waves_per_cu / waves_per_group), 1);
+    const auto rounds = DivCeil(groups, cu_count * groups_per_cu);
+
+    // A round lasts the latency of a wave, unless its waves keep the unit busy for longer: the
+    // unit hides the latency of a wave behind the work of the others.
+    const auto resident_waves =
+        std::min(groups_per_cu, DivCeil(groups, cu_count)) * waves_per_group;
+    const auto round_time =
+        std::max(wave_latency, static_cast<float>(resident_waves) * wave_issue_time);
+    return launch_overhead + static_cast<float>(rounds) * round_time;
+}
+
+void ReplayCostModel::Load(const std::string& path)
+{
+    std::ifstream file{path};
+    if(!file)
+        MIOPEN_THROW("Cannot open " + path);
+
+    auto line   = std::string{};
+    auto n_line = 0;
+    while(std::getline(file, line))
+    {
+        ++n_line;
+        const auto tab = line.find('\t');
+        auto time      = 0.0f;
+        std::istringstream ss{line.substr(0, tab)};
+        if(tab == std::string::npos || !(ss >> time) || time < 0.0f)
+        {
+            MIOPEN_LOG_W(path << ":" << n_line << ": malformed record");
+            continue;
+        }
+        Add(line.substr(tab + 1), time);
+    }
+}
+
+void ReplayCostModel::Add(const std::string& key, float time) { times[key].push_back(time); }
+
+boost::optional<float> ReplayCostModel::GetTime(const KernelLaunch& launch) const
+{
+    const auto it = times.find(launch.GetKey());
+    if(it == times.end())
+        return boost::none;
+
+    auto samples      = it->second;
+    const auto median = samples.begin() + samples.size() / 2;
+    std::nth_element(samples.begin(), median, samples.end());
+    return *median;
+}
+
+KernelTimeRecorder::KernelTimeRecorder(const std::string& path) : file(path, std::ios::app)
+{
+    if(!file)
+        MIOPEN_LOG_W("Cannot open " << path << ", the kernel times are not recorded");
+}
+
+KernelTimeRecorder* KernelTimeRecorder::Get()
+{
+    // The recorder shall be alive during the calling app lifetime, see ReadonlyRamDb::GetCached.
+    static auto* const recorder = []() -> KernelTimeRecorder* {
+        const auto path = GetStringEnv(MIOPEN_DEBUG_KERNEL_TIME_RECORD{});
+        if(path == nullptr || *path == '\0')
+            return nullptr;
+        MIOPEN_LOG_I("Recording the kernel times to " << path);
+        return new KernelTimeRecorder{path};
+    }();
+    return recorder;
+}
+
+void KernelTimeRecorder::Record(const KernelLaunch& launch, float time)
+{
+    const auto key = launch.GetKey();
+    const std::lock_guard<std::mutex> lock{mutex};
+    if(file)
+        file << time << '\t' << key << std::endl;
+}
+
+namespace {
+
+struct SimulationState
+{
+    std::mutex mutex;
+    bool initialized = false;
+    SimulatedDevice::CostModels models;
+};
+
+SimulationState& GetSimulationState()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static SimulationState state;
+    return state;
+}
+
+SimulatedDevice::CostModels GetCostModelsFromEnv()
+{
+    const auto spec = GetStringEnv(MIOPEN_DEBUG_SIMULATED_DEVICE{});
+    if(spec == nullptr || *spec == '\0')
+        return {};
+    if(!MIOPEN_MODE_NOGPU)
+    {
+        MIOPEN_LOG_W("MIOPEN_DEBUG_SIMULATED_DEVICE is supported by the HIPNOGPU backend only");
+        return {};
+    }
+
+    auto models = SimulatedDevice::CostModels{};
+    if(ToUpper(spec) != "ANALYTIC")
+    {
+        auto replay = std::make_shared<ReplayCostModel>();
+        try
+        {
+            replay->Load(spec);
+            MIOPEN_LOG_I("Replaying the times of " << replay->GetSize() << " kernel launches");
+            models.push_back(replay);
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_W(ex.what() << ", the kernel times are estimated");
+        }
+    }
+    models.push_back(std::make_shared<AnalyticCostModel>(SimulatedDevice::GetComputeUnits()));
+    return models;
+}
+
+/// The state shall be locked.
+void InitFromEnv(SimulationState& state)
+{
+    if(state.initialized)
+        return;
+    state.models      = GetCostModelsFromEnv();
+    state.initialized = true;
+}
+
+} // namespace
+
+bool SimulatedDevice::IsEnabled()
+{
+    auto& state = GetSimulationState();
+    const std::lock_guard<std::mutex> lock{state.mutex};
+    InitFromEnv(state);
+    return !state.models.empty();
+}
+
+std::size_t SimulatedDevice::GetComputeUnits()
+{
+    const auto compute_units = Value(MIOPEN_DEBUG_SIMULATED_DEVICE_CU{}, 64);
+    return compute_units > 0 ? compute_units : 64;
+}
+
+void SimulatedDevice::SetCostModels(CostModels models)
+{
+    auto& state = GetSimulationState();
+    const std::lock_guard<std::mutex> lock{state.mutex};
+    state.models      = std::move(models);
+    state.initialized = true;
+}
+
+float SimulatedDevice::GetTime(const KernelLaunch& launch)
+{
+    auto models = CostModels{};
+    {
+        auto& state = GetSimulationState();
+        const std::lock_guard<std::mutex> lock{state.mutex};
+        InitFromEnv(state);
+        models = state.models;
+    }
+
+    for(const auto& model : models)
+    {
+        const auto time = model->GetTime(launch);
+        if(time)
+            return *time;
+    }
+    MIOPEN_LOG_W("Unknown time of " << launch.GetKey());
+    return 0.0f;
+}
+
+} // namespace miopen
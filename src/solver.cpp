@@ -29,10 +29,10 @@
 #include <miopen/activ/solvers.hpp>
 #include <miopen/batchnorm/solvers.hpp>
 #include <miopen/pooling/solvers.hpp>
+#include <miopen/compile_service.hpp>
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/db.hpp>
 #include <miopen/solver_id.hpp>
-#include <miopen/par_for.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/timer.hpp>
@@ -43,8 +43,6 @@
 namespace miopen {
 namespace solver {
 
-MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
-
 std::ostream& operator<<(std::ostream& os, const KernelInfo& k)
 {
     os << k.kernel_file << ", " << k.kernel_name << " g_wk={ ";
@@ -56,25 +54,25 @@ std::ostream& operator<<(std::ostream& os, const KernelInfo& k)
     return os << "} '" << k.comp_options << '\'';
 }
 
-std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels)
+std::vector<Program> PrecompileKernels(const Handle& h,
+                                       const std::vector<KernelInfo>& kernels,
+                                       CompilePriority priority)
 {
     CompileTimer ct;
-    std::vector<Program> programs(kernels.size());
-
-    // clang-format off
-    par_for_strided(kernels.size(),
-                    max_threads{Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20)},
-                    [&](auto i) {
-                        const KernelInfo& k = kernels[i];
-                        programs[i]         = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
-                    });
-    // clang-format on
+    auto programs = CompileService::Get().Compile(h, kernels, priority);
     ct.Log("PrecompileKernels");
     return programs;
 }
 
+std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels)
+{
+    return PrecompileKernels(h, kernels, CompilePriority::Background);
+}
+
 void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>& sols)
 {
+    h.ThrowIfCancelled();
+
     // Find all kernels that need to be compiled from the solutions
     std::vector<KernelInfo> kernels;
     for(auto&& sol : sols)
@@ -90,7 +88,7 @@ void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>
     }
 
     // Precompile the kernels in parallel, but dont add them to the cache
-    std::vector<Program> programs = PrecompileKernels(h, kernels);
+    std::vector<Program> programs = PrecompileKernels(h, kernels, CompilePriority::Foreground);
 
     // Add programs to the cache
     for(std::size_t i = 0; i < programs.size(); i++)
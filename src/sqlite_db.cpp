@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <miopen/sqlite_db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -55,8 +56,15 @@
 extern "C" {
 int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
 }
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_SQL_STMT_CACHE)
+
 namespace miopen {
 
+// Queries are built from a fixed set of shapes, so the limit is never hit in practice.
+// It only protects from unbounded growth if a caller builds queries with inlined values.
+constexpr std::size_t MaxCachedStatements = 256;
+
 class SQLite::impl
 {
     struct SQLiteCloser
@@ -169,6 +177,8 @@ class SQLite::impl
     }
 
 public:
+    using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+
     impl(const std::string& filename_, bool is_system)
     {
         boost::filesystem::path filepath(filename_);
@@ -185,6 +195,48 @@ public:
 
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+
+    std::mutex batch_mutex;
+    int batch_depth          = 0;
+    bool batch_rollback_only = false;
+
+    /// Returns a prepared statement for the query from the cache, or null if there is none.
+    /// The statement is owned by the caller until it is returned by ReleaseStatement.
+    sqlite3_stmt_ptr AcquireStatement(const std::string& query)
+    {
+        const std::lock_guard<std::mutex> lock{statements_mutex};
+        const auto it = statements.find(query);
+        if(it == statements.end())
+            return nullptr;
+        return std::move(it->second);
+    }
+
+    void ReleaseStatement(const std::string& query, sqlite3_stmt_ptr stmt)
+    {
+        static const auto disabled = miopen::IsEnabled(MIOPEN_DEBUG_DISABLE_SQL_STMT_CACHE{});
+        if(disabled)
+            return;
+
+        sqlite3_reset(stmt.get());
+        sqlite3_clear_bindings(stmt.get());
+
+        const std::lock_guard<std::mutex> lock{statements_mutex};
+        auto it = statements.find(query);
+        if(it == statements.end())
+        {
+            if(statements.size() >= MaxCachedStatements)
+                return;
+            it = statements.emplace(query, nullptr).first;
+        }
+        // Another thread could have used the same query at the same time.
+        if(it->second == nullptr)
+            it->second = std::move(stmt);
+    }
+
+private:
+    std::mutex statements_mutex;
+    // Declared after ptrDb, as statements shall be finalized before the connection is closed.
+    std::unordered_map<std::string, sqlite3_stmt_ptr> statements;
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -267,6 +319,83 @@ int SQLite::Retry(std::function<int()> f) const
 
 int SQLite::Changes() const { return sqlite3_changes(pImpl->ptrDb.get()); }
 
+void SQLite::BeginBatch()
+{
+    const std::lock_guard<std::mutex> lock{pImpl->batch_mutex};
+    // IMMEDIATE takes the write lock right away, so the transaction cannot fail with SQLITE_BUSY
+    // on its first write once it has started.
+    if(pImpl->batch_depth == 0)
+        Exec("BEGIN IMMEDIATE;");
+    ++pImpl->batch_depth;
+}
+
+void SQLite::CommitBatch()
+{
+    const std::lock_guard<std::mutex> lock{pImpl->batch_mutex};
+    if(pImpl->batch_depth == 0)
+        MIOPEN_THROW(miopenStatusInternalError, "CommitBatch() without BeginBatch()");
+    if(--pImpl->batch_depth != 0)
+        return;
+
+    if(pImpl->batch_rollback_only)
+    {
+        pImpl->batch_rollback_only = false;
+        Exec("ROLLBACK;");
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Batch has been rolled back since a nested one has failed");
+    }
+
+    try
+    {
+        Exec("COMMIT;");
+    }
+    catch(...)
+    {
+        // A failed commit may leave the transaction open.
+        sqlite3_exec(pImpl->ptrDb.get(), "ROLLBACK;", nullptr, nullptr, nullptr);
+        throw;
+    }
+}
+
+void SQLite::RollbackBatch()
+{
+    const std::lock_guard<std::mutex> lock{pImpl->batch_mutex};
+    if(pImpl->batch_depth == 0)
+        MIOPEN_THROW(miopenStatusInternalError, "RollbackBatch() without BeginBatch()");
+    if(--pImpl->batch_depth != 0)
+    {
+        pImpl->batch_rollback_only = true;
+        return;
+    }
+
+    pImpl->batch_rollback_only = false;
+    Exec("ROLLBACK;");
+}
+
+SQLite::Batch::Batch(SQLite& sql_) : sql(sql_) { sql.BeginBatch(); }
+
+SQLite::Batch::~Batch()
+{
+    if(done)
+        return;
+
+    try
+    {
+        sql.RollbackBatch();
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to roll a batch back: " << ex.what());
+    }
+}
+
+void SQLite::Batch::Commit()
+{
+    // The batch is over even if the commit fails, see CommitBatch().
+    done = true;
+    sql.CommitBatch();
+}
+
 std::string SQLite::ErrorMessage() const
 {
     std::string errMsg = "Internal error while accessing SQLite database: ";
@@ -276,11 +405,15 @@ bool SQLite::Valid() const { return pImpl->isValid; }
 
 class SQLite::Statement::impl
 {
-    using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+    using sqlite3_stmt_ptr = SQLite::impl::sqlite3_stmt_ptr;
     sqlite3_stmt_ptr Prepare(const SQLite& sql, const std::string& query)
     {
-        sqlite3_stmt* ptr = nullptr;
         MIOPEN_LOG_I2(query);
+        auto cached = sql.pImpl->AcquireStatement(query);
+        if(cached != nullptr)
+            return cached;
+
+        sqlite3_stmt* ptr = nullptr;
         auto rc =
             sqlite3_prepare_v2(sql.pImpl->ptrDb.get(), query.c_str(), query.size(), &ptr, nullptr);
         if(rc != SQLITE_OK)
@@ -292,8 +425,12 @@ class SQLite::Statement::impl
     }
 
 public:
-    impl(const SQLite& sql, const std::string& query) { ptrStmt = Prepare(sql, query); }
-    impl(const SQLite& sql, const std::string& query, const std::vector<std::string>& vals)
+    impl(const SQLite& sql, const std::string& query_) : owner(sql.pImpl.get()), query(query_)
+    {
+        ptrStmt = Prepare(sql, query);
+    }
+    impl(const SQLite& sql, const std::string& query_, const std::vector<std::string>& vals)
+        : owner(sql.pImpl.get()), query(query_)
     {
         ptrStmt = Prepare(sql, query);
         int cnt = 1;
@@ -307,6 +444,17 @@ public:
         MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
     }
 
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
+    ~impl()
+    {
+        if(ptrStmt != nullptr)
+            owner->ReleaseStatement(query, std::move(ptrStmt));
+    }
+
+    SQLite::impl* owner;
+    std::string query;
     sqlite3_stmt_ptr ptrStmt = nullptr;
 };
 
@@ -433,6 +581,9 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system_)
                 sql.Exec(create_perfdb_sql);
             }
         }
+        // Records are looked up by config only. Without this index each lookup scans the whole
+        // perf_db table, as idx_perf_db starts with the solver. Older user dbs get it here too.
+        sql.Exec("CREATE INDEX IF NOT EXISTS `idx_perf_db_config` ON perf_db(config);");
         MIOPEN_LOG_T("Database created successfully");
     }
     // Check fields for the tables
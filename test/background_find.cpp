@@ -0,0 +1,233 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/background_find.hpp>
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/temp_file.hpp>
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+using miopen::BackgroundFind;
+using Solutions = std::vector<miopenConvSolution_t>;
+
+void test_schedule()
+{
+    auto&& handle = get_handle();
+    BackgroundFind background;
+    std::atomic<int> runs{0};
+
+    const auto job = [&](miopen::Handle& worker) {
+        EXPECT(&worker != &handle);
+        EXPECT(worker.GetStream() != handle.GetStream());
+        ++runs;
+        return Solutions{{0.5f, 128, 1, miopenConvolutionAlgoDirect}};
+    };
+
+    EXPECT(!background.GetResult("a"));
+    EXPECT(background.Schedule(handle, "a", job));
+    EXPECT(!background.Schedule(handle, "a", job));
+    background.Wait();
+    EXPECT_EQUAL(runs.load(), 1);
+
+    const auto result = background.GetResult("a");
+    EXPECT(result && result->size() == 1);
+    EXPECT_EQUAL(result->front().solution_id, 1u);
+
+    // Results are taken once, and then there is nothing left to take.
+    EXPECT(background.HasResultsToTake());
+    EXPECT(!background.TakeResult("c"));
+    const auto taken = background.TakeResult("a");
+    EXPECT(taken && taken->size() == 1);
+    EXPECT(!background.TakeResult("a"));
+    EXPECT(!background.HasResultsToTake());
+    EXPECT(background.GetResult("a"));
+
+    // A failed Find is not run again, and has no solutions.
+    EXPECT(background.Schedule(handle, "b", [](miopen::Handle&) -> Solutions {
+        MIOPEN_THROW("Find has failed");
+    }));
+    background.Wait();
+    EXPECT(background.GetResult("b") && background.GetResult("b")->empty());
+    EXPECT(!background.HasResultsToTake());
+    EXPECT(!background.Schedule(handle, "b", job));
+    EXPECT_EQUAL(runs.load(), 1);
+}
+
+void test_destroy()
+{
+    auto&& handle = get_handle();
+    std::atomic<bool> started{false};
+    std::atomic<bool> dropped_run{false};
+    {
+        BackgroundFind background;
+        background.Schedule(handle, "endless", [&](miopen::Handle& worker) -> Solutions {
+            started = true;
+            // A Find of many solvers, it gives up between them once cancelled.
+            while(true)
+            {
+                worker.ThrowIfCancelled();
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+        });
+        background.Schedule(handle, "dropped", [&](miopen::Handle&) {
+            dropped_run = true;
+            return Solutions{};
+        });
+        while(!started)
+            std::this_thread::yield();
+    }
+    // The running job is cancelled, the pending one is dropped.
+    EXPECT(!dropped_run);
+}
+
+void test_handle_lifetime()
+{
+    std::atomic<bool> started{false};
+    {
+        miopen::Handle handle{};
+        handle.GetBackgroundFind().Schedule(
+            handle, "endless", [&](miopen::Handle& worker) -> Solutions {
+                started = true;
+                while(true)
+                    worker.ThrowIfCancelled();
+            });
+        while(!started)
+            std::this_thread::yield();
+    }
+    // The Find is cancelled together with the handle it has been run for.
+}
+
+void test_convolution()
+{
+    // The find-db is empty, so the Find takes the immediate mode fallback.
+    const miopen::TempFile find_db{"miopen.test.background_find"};
+    miopen::debug::testing_find_db_path_override() = find_db.Path();
+
+    miopen::Handle handle{};
+    auto conv = miopen::ConvolutionDescriptor{
+        2, miopenConvolution, miopenPaddingDefault, {1, 1}, {1, 1}, {1, 1}};
+    conv.findMode.Set(miopen::FindMode::Values::Background);
+
+    const auto x = tensor<float>{2, 8, 13, 13}.generate(tensor_elem_gen_integer{17});
+    const auto w = tensor<float>{4, 8, 3, 3}.generate(tensor_elem_gen_integer{17});
+    const auto y = tensor<float>{conv.GetForwardOutputTensor(x.desc, w.desc)};
+    const auto x_dev          = handle.Write(x.data);
+    const auto w_dev          = handle.Write(w.data);
+    auto y_dev                = handle.Write(y.data);
+    const auto workspace_size = conv.ForwardGetWorkSpaceSize(handle, w.desc, x.desc, y.desc);
+    const auto workspace_dev  = workspace_size != 0 ? handle.Create(workspace_size) : nullptr;
+
+    auto count = 0;
+    auto perf  = miopenConvAlgoPerf_t{};
+    conv.FindConvFwdAlgorithm(handle,
+                              x.desc,
+                              x_dev.get(),
+                              w.desc,
+                              w_dev.get(),
+                              y.desc,
+                              y_dev.get(),
+                              1,
+                              &count,
+                              &perf,
+                              workspace_dev.get(),
+                              workspace_size,
+                              false);
+    EXPECT_EQUAL(count, 1);
+
+    const miopen::ProblemDescription problem(
+        x.desc, w.desc, y.desc, conv, miopen::conv::Direction::Forward);
+    const auto network_config = problem.BuildConfKey();
+    const auto algo           = static_cast<miopenConvFwdAlgorithm_t>(perf.fwd_algo);
+    const auto algorithm_name = miopen::AlgorithmName{miopen::ConvolutionAlgoToDirectionalString(
+        static_cast<miopenConvAlgorithm_t>(algo), miopen::conv::Direction::Forward)};
+
+    // The algorithm runs the fallback until the background Find is done.
+    EXPECT(handle.GetFound1_0SolverId(network_config, algorithm_name));
+    const auto forward = [&]() {
+        const auto alpha = 1.0f;
+        const auto beta  = 0.0f;
+        conv.ConvolutionForward(handle,
+                                &alpha,
+                                x.desc,
+                                x_dev.get(),
+                                w.desc,
+                                w_dev.get(),
+                                algo,
+                                &beta,
+                                y.desc,
+                                y_dev.get(),
+                                workspace_dev.get(),
+                                workspace_size);
+        return handle.Read<float>(y_dev, y.data.size());
+    };
+    const auto fallback_y = forward();
+
+    // Then it runs the fastest solution of the Find within the workspace, which has been written
+    // to the find-db.
+    handle.GetBackgroundFind().Wait();
+    auto expected = std::string{};
+    {
+        miopen::FindDbRecord record{handle, problem};
+        auto best_time = std::numeric_limits<float>::max();
+        for(const auto& pair : record)
+        {
+            if(pair.second.workspace > workspace_size || pair.second.time >= best_time)
+                continue;
+            best_time = pair.second.time;
+            expected  = pair.second.solver_id;
+        }
+    }
+    EXPECT(!expected.empty());
+
+    const auto found_y = forward();
+    const auto current = handle.GetFound1_0SolverId(network_config, algorithm_name);
+    EXPECT(current);
+    EXPECT_EQUAL(*current, expected);
+    EXPECT(miopen::rms_range(fallback_y, found_y) < 1e-5);
+}
+
+int main()
+{
+    test_schedule();
+    test_destroy();
+    test_handle_lifetime();
+    test_convolution();
+}
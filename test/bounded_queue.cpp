@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/bounded_queue.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using miopen::BoundedQueue;
+using miopen::QueueProducer;
+
+void test_order()
+{
+    BoundedQueue<int> queue{4};
+    QueueProducer<BoundedQueue<int>> producer{queue, [&]() {
+                                                  for(auto i = 0; i < 1000; ++i)
+                                                      EXPECT(queue.Push(i));
+                                              }};
+
+    std::vector<int> popped;
+    auto item = 0;
+    while(queue.Pop(item))
+        popped.push_back(item);
+    producer.Join();
+
+    EXPECT_EQUAL(popped.size(), std::size_t{1000});
+    for(auto i = 0; i < static_cast<int>(popped.size()); ++i)
+        EXPECT_EQUAL(popped[i], i);
+}
+
+void test_full()
+{
+    BoundedQueue<int> queue{2};
+    EXPECT(queue.Push(0));
+    EXPECT(queue.Push(1));
+
+    std::atomic<bool> pushed{false};
+    std::thread pusher{[&]() {
+        EXPECT(queue.Push(2));
+        pushed = true;
+    }};
+
+    // The push can't complete before a pop, however long it waits.
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT(!pushed);
+
+    auto item = -1;
+    EXPECT(queue.Pop(item));
+    EXPECT_EQUAL(item, 0);
+    pusher.join();
+    EXPECT(pushed);
+
+    // The items queued before the close are still popped.
+    queue.Close();
+    EXPECT(!queue.Push(3));
+    EXPECT(queue.Pop(item));
+    EXPECT_EQUAL(item, 1);
+    EXPECT(queue.Pop(item));
+    EXPECT_EQUAL(item, 2);
+    EXPECT(!queue.Pop(item));
+}
+
+void test_close()
+{
+    BoundedQueue<int> queue{1};
+    auto n_pushed  = 0;
+    auto is_closed = false;
+    QueueProducer<BoundedQueue<int>> producer{queue, [&]() {
+                                                  while(queue.Push(n_pushed))
+                                                      ++n_pushed;
+                                                  is_closed = true;
+                                              }};
+
+    auto item = -1;
+    EXPECT(queue.Pop(item));
+    EXPECT_EQUAL(item, 0);
+
+    // The consumer leaves while the producer waits for room.
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    queue.Close();
+    producer.Join();
+    EXPECT(is_closed);
+    EXPECT(n_pushed >= 1 && n_pushed <= 2);
+
+    // The producer of a consumer leaving without Join() is stopped by the destructor.
+    BoundedQueue<int> endless{1};
+    {
+        QueueProducer<BoundedQueue<int>> abandoned{endless, [&]() {
+                                                       while(endless.Push(0))
+                                                       {
+                                                       }
+                                                   }};
+        EXPECT(endless.Pop(item));
+    }
+    EXPECT(!endless.Push(0));
+}
+
+void test_error()
+{
+    BoundedQueue<int> queue{2};
+    QueueProducer<BoundedQueue<int>> producer{queue, [&]() {
+                                                  for(auto i = 0; i < 3; ++i)
+                                                      EXPECT(queue.Push(i));
+                                                  throw std::runtime_error("producer failed");
+                                              }};
+
+    // The items pushed before the error are still delivered.
+    auto n_popped = 0;
+    auto item     = -1;
+    while(queue.Pop(item))
+        EXPECT_EQUAL(item, n_popped++);
+    EXPECT_EQUAL(n_popped, 3);
+
+    auto message = std::string{};
+    try
+    {
+        producer.Join();
+    }
+    catch(const std::runtime_error& ex)
+    {
+        message = ex.what();
+    }
+    EXPECT_EQUAL(message, "producer failed");
+}
+
+int main()
+{
+    test_order();
+    test_full();
+    test_close();
+    test_error();
+}
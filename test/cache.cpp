@@ -26,6 +26,7 @@
 
 #include <miopen/binary_cache.hpp>
 #include <miopen/kern_db.hpp>
+#include <miopen/lz.hpp>
 #include <miopen/temp_file.hpp>
 
 #include <miopen/md5.hpp>
@@ -84,6 +85,66 @@ void check_bz2_decompress()
     EXPECT(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+void check_lz()
+{
+    auto pattern = random_string(512);
+    auto orig    = pattern + pattern + random_string(16) + pattern + pattern;
+    bool success = false;
+
+    auto compressed = miopen::lz_compress(orig, &success);
+    EXPECT(success);
+    EXPECT(compressed.size() < orig.size());
+    EXPECT(miopen::lz_decompress(compressed, orig.size()) == orig);
+    CHECK(throws([&]() { std::ignore = miopen::lz_decompress(compressed, orig.size() - 1); }));
+    CHECK(throws([&]() {
+        std::ignore = miopen::lz_decompress(compressed.substr(0, compressed.size() / 2),
+                                            orig.size());
+    }));
+
+    // Random data does not shrink and is returned as is.
+    auto random = random_string(12);
+    EXPECT(miopen::lz_compress(random, &success) == random);
+    EXPECT(!success);
+}
+
+void check_kern_db_dedup()
+{
+    miopen::KernelConfig cfg0{"kernel1", "-DARGS=0", random_string(8192)};
+    miopen::KernelConfig cfg1{"kernel2", "-DARGS=1", cfg0.kernel_blob};
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    miopen::KernDb db(std::string(temp_file), false);
+
+    CHECK(db.StoreRecordUnsafe(cfg0));
+    const auto size = db.GetBlobsSize();
+    CHECK(db.StoreRecordUnsafe(cfg1));
+    EXPECT_EQUAL(db.GetBlobsSize(), size); // the same binary is stored once
+
+    CHECK(db.RemoveRecordUnsafe(cfg0));
+    auto readout = db.FindRecordUnsafe(cfg1);
+    CHECK(readout);
+    CHECK(readout.get() == cfg0.kernel_blob);
+}
+
+void check_kern_db_eviction()
+{
+    miopen::TempFile temp_file("tmp-kerndb");
+    miopen::KernDb db(std::string(temp_file), false);
+    db.SetSizeLimit(3 * 8192);
+
+    std::vector<miopen::KernelConfig> cfgs;
+    for(auto i = 0; i < 5; ++i)
+    {
+        cfgs.push_back({"kernel" + std::to_string(i), "", random_string(8192)});
+        CHECK(db.StoreRecordUnsafe(cfgs.back()));
+        EXPECT(db.GetBlobsSize() <= 3 * 8192);
+    }
+
+    // The least recently stored ones go first.
+    CHECK(!db.FindRecordUnsafe(cfgs.front()));
+    CHECK(db.FindRecordUnsafe(cfgs.back()));
+}
+
 void check_kern_db()
 {
     miopen::KernelConfig cfg0;
@@ -152,6 +213,9 @@ int main()
 #if MIOPEN_ENABLE_SQLITE
     check_bz2_compress();
     check_bz2_decompress();
+    check_lz();
     check_kern_db();
+    check_kern_db_dedup();
+    check_kern_db_eviction();
 #endif
 }
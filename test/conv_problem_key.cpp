@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include "driver.hpp"
+
+#include <miopen/conv/problem_description.hpp>
+
+#include <thread>
+
+namespace miopen {
+namespace tests {
+
+struct ProblemKeyTestDriver : test_driver
+{
+    void run() const
+    {
+        const auto fwd = MakeProblem(14, conv::Direction::Forward);
+
+        EXPECT_EQUAL(fwd.BuildConfKey().ToString(),
+                     "16x14x14x3x3x32x14x14x8xNCHWxFP32x1x1x1x1x1x1x1xF");
+        EXPECT_EQUAL(DbKey(fwd), "16-14-14-3x3-32-14-14-8-1x1-1x1-1x1-0-NCHW-FP32-F");
+
+        // Same problem built separately interns to the same entry.
+        const auto same = MakeProblem(14, conv::Direction::Forward);
+        EXPECT(fwd.GetInternedKey().GetKey() == same.GetInternedKey().GetKey());
+        EXPECT_EQUAL(fwd.GetInternedKey().GetId(), same.GetInternedKey().GetId());
+        EXPECT(&fwd.GetInternedKey().GetNetworkConfig() ==
+               &same.GetInternedKey().GetNetworkConfig());
+        EXPECT_EQUAL(fwd.BuildConfKey().GetInternedId(), fwd.GetInternedKey().GetId());
+
+        const auto bwd   = MakeProblem(14, conv::Direction::BackwardData);
+        const auto other = MakeProblem(7, conv::Direction::Forward);
+        EXPECT(fwd.GetInternedKey().GetKey() != bwd.GetInternedKey().GetKey());
+        EXPECT(fwd.GetInternedKey().GetId() != bwd.GetInternedKey().GetId());
+        EXPECT(fwd.GetInternedKey().GetId() != other.GetInternedKey().GetId());
+        EXPECT(fwd.GetInternedKey().GetId() != 0);
+        EXPECT_EQUAL(other.BuildConfKey().ToString(),
+                     "16x7x7x3x3x32x7x7x8xNCHWxFP32x1x1x1x1x1x1x1xF");
+
+        // Interning on another thread sees the same ids.
+        std::size_t from_thread = 0;
+        std::thread([&]() { from_thread = other.GetInternedKey().GetId(); }).join();
+        EXPECT_EQUAL(from_thread, other.GetInternedKey().GetId());
+    }
+
+private:
+    static conv::ProblemDescription MakeProblem(std::size_t size, conv::Direction direction)
+    {
+        const auto in   = TensorDescriptor{miopenFloat, {8, 16, size, size}};
+        const auto wei  = TensorDescriptor{miopenFloat, {32, 16, 3, 3}};
+        const auto out  = TensorDescriptor{miopenFloat, {8, 32, size, size}};
+        const auto conv = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+        return {in, wei, out, conv, direction};
+    }
+
+    static std::string DbKey(const conv::ProblemDescription& problem)
+    {
+        std::ostringstream ss;
+        problem.Serialize(ss);
+        return ss.str();
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::ProblemKeyTestDriver>(argc, argn);
+}
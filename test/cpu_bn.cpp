@@ -0,0 +1,292 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_bn.hpp"
+#include "random.hpp"
+#include "test.hpp"
+
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_layout.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// The batch norm engine against the separate two-pass loops over every channel it replaces. The
+// data are small integers around an offset, which the statistics must not lose.
+
+struct naive_stats
+{
+    std::vector<double> mean;
+    std::vector<double> variance;
+};
+
+template <class T>
+naive_stats naive_bn_stats(const cpu_bn_layout& l, const std::vector<T>& x)
+{
+    naive_stats r;
+    const auto m = static_cast<double>(l.n * l.s);
+    for(std::size_t c = 0; c < l.c; ++c)
+    {
+        double mean = 0;
+        for(std::size_t n = 0; n < l.n; ++n)
+            for(std::size_t s = 0; s < l.s; ++s)
+                mean += x[n * l.n_stride + c * l.c_stride + s * l.s_stride];
+        mean /= m;
+        double variance = 0;
+        for(std::size_t n = 0; n < l.n; ++n)
+        {
+            for(std::size_t s = 0; s < l.s; ++s)
+            {
+                const auto d = x[n * l.n_stride + c * l.c_stride + s * l.s_stride] - mean;
+                variance += d * d;
+            }
+        }
+        r.mean.push_back(mean);
+        r.variance.push_back(variance / m);
+    }
+    return r;
+}
+
+std::vector<float> make_data(std::size_t size, float offset)
+{
+    std::vector<float> data(size);
+    for(auto& x : data)
+        x = offset + static_cast<float>(GET_RAND() % 17) - 8.f;
+    return data;
+}
+
+std::size_t element_space(const cpu_bn_layout& l)
+{
+    return (l.n - 1) * l.n_stride + (l.c - 1) * l.c_stride + (l.s - 1) * l.s_stride + 1;
+}
+
+// Two correct orders of summation agree up to the rounding of the values around the offset, times
+// the number of them.
+bool close(const std::vector<double>& x, const std::vector<double>& y, float offset)
+{
+    const auto tolerance = 1e-10 * (1. + offset / 1000.);
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin(), [&](auto a, auto b) {
+               return std::abs(a - b) <=
+                      tolerance * std::max(1., std::max(std::abs(a), std::abs(b)));
+           });
+}
+
+void test_forward(const cpu_bn_layout& l, float offset)
+{
+    const auto epsilon = 1e-5;
+    const auto factor  = 0.1;
+    const auto x       = make_data(element_space(l), offset);
+    const auto scale   = make_data(l.c, 0.f);
+    const auto bias    = make_data(l.c, 0.f);
+    const auto stats   = naive_bn_stats(l, x);
+    const auto m       = static_cast<double>(l.n * l.s);
+
+    std::vector<double> expected_y(x.size());
+    std::vector<double> expected_run_mean(l.c, 1.);
+    std::vector<double> expected_run_var(l.c, 2.);
+    std::vector<double> expected_inv_var(l.c);
+    for(std::size_t c = 0; c < l.c; ++c)
+    {
+        const auto inv_var  = 1. / std::sqrt(stats.variance[c] + epsilon);
+        const auto adjust   = m == 1 ? stats.variance[c] : m / (m - 1) * stats.variance[c];
+        expected_inv_var[c] = inv_var;
+        expected_run_mean[c] = stats.mean[c] * factor + expected_run_mean[c] * (1 - factor);
+        expected_run_var[c]  = (1 - factor) * expected_run_var[c] + factor * adjust;
+        for(std::size_t n = 0; n < l.n; ++n)
+        {
+            for(std::size_t s = 0; s < l.s; ++s)
+            {
+                const auto i  = n * l.n_stride + c * l.c_stride + s * l.s_stride;
+                expected_y[i] = scale[c] * (inv_var * (x[i] - stats.mean[c])) + bias[c];
+            }
+        }
+    }
+
+    std::vector<double> y(x.size());
+    std::vector<double> run_mean(l.c, 1.);
+    std::vector<double> run_var(l.c, 2.);
+    std::vector<double> save_mean(l.c);
+    std::vector<double> save_inv_var(l.c);
+    cpu_bn_forward_train(l,
+                         x.data(),
+                         y.data(),
+                         scale.data(),
+                         bias.data(),
+                         epsilon,
+                         factor,
+                         run_mean.data(),
+                         run_var.data(),
+                         save_mean.data(),
+                         save_inv_var.data());
+    EXPECT(close(y, expected_y, offset));
+    EXPECT(close(run_mean, expected_run_mean, offset));
+    EXPECT(close(run_var, expected_run_var, offset));
+    EXPECT(close(save_mean, stats.mean, offset));
+    EXPECT(close(save_inv_var, expected_inv_var, offset));
+
+    std::vector<double> infer_y(x.size());
+    cpu_bn_forward_infer(l, x.data(), infer_y.data(), scale.data(), bias.data(), epsilon);
+    EXPECT(close(infer_y, expected_y, offset));
+    std::fill(infer_y.begin(), infer_y.end(), 0.);
+    cpu_bn_forward_infer(l,
+                         x.data(),
+                         infer_y.data(),
+                         scale.data(),
+                         bias.data(),
+                         stats.mean.data(),
+                         stats.variance.data(),
+                         epsilon);
+    EXPECT(close(infer_y, expected_y, offset));
+}
+
+void test_backward(const cpu_bn_layout& l, float offset)
+{
+    const auto epsilon = 1e-5;
+    const auto x       = make_data(element_space(l), offset);
+    const auto dy      = make_data(x.size(), 0.5f);
+    const auto scale   = make_data(l.c, 0.f);
+    const auto stats   = naive_bn_stats(l, x);
+    const auto m       = static_cast<double>(l.n * l.s);
+
+    // Saved statistics a bit off the ones of the batch, as after a float forward pass.
+    std::vector<double> saved_mean(l.c);
+    std::vector<double> saved_inv_var(l.c);
+    for(std::size_t c = 0; c < l.c; ++c)
+    {
+        saved_mean[c]    = stats.mean[c] + 0.01;
+        saved_inv_var[c] = 1. / std::sqrt(stats.variance[c] + epsilon) * 1.01;
+    }
+
+    for(auto saved : {false, true})
+    {
+        std::vector<double> expected_dx(x.size());
+        std::vector<double> expected_dscale(l.c);
+        std::vector<double> expected_dbias(l.c);
+        for(std::size_t c = 0; c < l.c; ++c)
+        {
+            const auto mean    = saved ? saved_mean[c] : stats.mean[c];
+            const auto inv_var =
+                saved ? saved_inv_var[c] : 1. / std::sqrt(stats.variance[c] + epsilon);
+            for(std::size_t n = 0; n < l.n; ++n)
+            {
+                for(std::size_t s = 0; s < l.s; ++s)
+                {
+                    const auto i = n * l.n_stride + c * l.c_stride + s * l.s_stride;
+                    expected_dbias[c] += dy[i];
+                    expected_dscale[c] += (x[i] - mean) * inv_var * dy[i];
+                }
+            }
+            for(std::size_t n = 0; n < l.n; ++n)
+            {
+                for(std::size_t s = 0; s < l.s; ++s)
+                {
+                    const auto i    = n * l.n_stride + c * l.c_stride + s * l.s_stride;
+                    const auto xhat = (x[i] - mean) * inv_var;
+                    expected_dx[i]  = (scale[c] * inv_var) / m *
+                                     (m * dy[i] - expected_dbias[c] - xhat * expected_dscale[c]);
+                }
+            }
+        }
+
+        std::vector<double> dx(x.size());
+        std::vector<double> dscale(l.c);
+        std::vector<double> dbias(l.c);
+        if(saved)
+            cpu_bn_backward(l,
+                            x.data(),
+                            dy.data(),
+                            dx.data(),
+                            scale.data(),
+                            dscale.data(),
+                            dbias.data(),
+                            saved_mean.data(),
+                            saved_inv_var.data());
+        else
+            cpu_bn_backward(l,
+                            x.data(),
+                            dy.data(),
+                            dx.data(),
+                            scale.data(),
+                            dscale.data(),
+                            dbias.data(),
+                            epsilon);
+        EXPECT(close(dx, expected_dx, offset));
+        EXPECT(close(dscale, expected_dscale, offset));
+        EXPECT(close(dbias, expected_dbias, offset));
+    }
+}
+
+cpu_bn_layout nhwc_layout(std::size_t n, std::size_t c, std::size_t s)
+{
+    auto l     = cpu_bn_packed_layout(n, c, s);
+    l.c_stride = 1;
+    l.s_stride = c;
+    return l;
+}
+
+void test_layout_of()
+{
+    const auto nchw = cpu_bn_layout_of(miopen::TensorDescriptor{miopenFloat, {2, 3, 4, 5}});
+    EXPECT_EQUAL(nchw.s, 20u);
+    EXPECT_EQUAL(nchw.c_stride, 20u);
+    EXPECT(nchw.channel_major());
+
+    const auto ncdhw = cpu_bn_layout_of(miopen::TensorDescriptor{miopenFloat, {2, 3, 4, 5, 6}});
+    EXPECT_EQUAL(ncdhw.s, 120u);
+    EXPECT_EQUAL(ncdhw.n_stride, 360u);
+
+    std::vector<std::size_t> lens{2, 3, 4, 5};
+    std::vector<std::size_t> strides;
+    miopen::tensor_layout_to_strides(lens, "NCHW", "NHWC", strides);
+    const auto nhwc = cpu_bn_layout_of(miopen::TensorDescriptor{miopenFloat, lens, strides});
+    EXPECT_EQUAL(nhwc.s, 20u);
+    EXPECT_EQUAL(nhwc.c_stride, 1u);
+    EXPECT_EQUAL(nhwc.s_stride, 3u);
+    EXPECT(!nhwc.channel_major());
+}
+
+int main()
+{
+    test_layout_of();
+    for(auto offset : {0.f, 1e6f})
+    {
+        // Single elements, lane tails, blocks split within an image and channels wider than a
+        // block.
+        for(auto l : {cpu_bn_packed_layout(1, 1, 1),
+                      cpu_bn_packed_layout(3, 5, 63),
+                      cpu_bn_packed_layout(2, 3, 5000),
+                      nhwc_layout(1, 1, 1),
+                      nhwc_layout(3, 5, 63),
+                      nhwc_layout(7, 33, 1000),
+                      nhwc_layout(1, 4100, 3)})
+        {
+            test_forward(l, offset);
+            test_backward(l, offset);
+        }
+    }
+}
@@ -0,0 +1,494 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_BN_HPP
+#define GUARD_CPU_BN_HPP
+
+#include <miopen/errors.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Host reference of the spatial batch norm. A tensor is seen as n images of c channels of s
+// positions, the spatial dimensions fused into one, so 2d and 3d and the NCHW and NHWC layouts
+// share the code. x, y, dy and dx of a call have the same layout.
+struct cpu_bn_layout
+{
+    std::size_t n        = 0;
+    std::size_t c        = 0;
+    std::size_t s        = 0;
+    std::size_t n_stride = 0;
+    std::size_t c_stride = 0;
+    std::size_t s_stride = 0;
+
+    // The positions of an image are contiguous, the reductions and the updates go through the
+    // channels one by one. Otherwise (NHWC) they go through the positions and vectorize over the
+    // channels.
+    bool channel_major() const { return s_stride == 1; }
+
+    std::size_t position_offset(std::size_t p) const
+    {
+        return (p / s) * n_stride + (p % s) * s_stride;
+    }
+};
+
+inline cpu_bn_layout cpu_bn_packed_layout(std::size_t n, std::size_t c, std::size_t s)
+{
+    cpu_bn_layout l;
+    l.n        = n;
+    l.c        = c;
+    l.s        = s;
+    l.n_stride = c * s;
+    l.c_stride = s;
+    l.s_stride = 1;
+    return l;
+}
+
+inline cpu_bn_layout cpu_bn_layout_of(const miopen::TensorDescriptor& desc)
+{
+    const auto& lens    = desc.GetLengths();
+    const auto& strides = desc.GetStrides();
+    if(lens.size() < 3 || desc.IsVectorized())
+        MIOPEN_THROW("Batch norm reference needs a tensor with spatial dimensions");
+
+    cpu_bn_layout l;
+    l.n        = lens[0];
+    l.c        = lens[1];
+    l.s        = 1;
+    l.n_stride = strides[0];
+    l.c_stride = strides[1];
+    l.s_stride = strides.back();
+    for(auto i = lens.size() - 1; i >= 2; --i)
+    {
+        if(lens[i] != 1 && strides[i] != l.s_stride * l.s)
+            MIOPEN_THROW("Batch norm reference needs packed spatial dimensions");
+        l.s *= lens[i];
+    }
+    return l;
+}
+
+// Moments of the values of a channel: their count, the mean and the sum of the squared deviations
+// of x, and for the backward pass the mean of dy and the sum of (x - x_mean) * (dy - dy_mean).
+// Blocks are reduced around their own means while they are in the cache and merged with the
+// pairwise update of Chan et al., the parallel form of Welford's algorithm, so the statistics take
+// one pass over the memory and are as accurate as the two-pass ones.
+struct cpu_bn_moments
+{
+    double count   = 0;
+    double x_mean  = 0;
+    double x_m2    = 0;
+    double dy_mean = 0;
+    double co_m2   = 0;
+
+    void merge(const cpu_bn_moments& other)
+    {
+        if(other.count == 0)
+            return;
+        const auto total    = count + other.count;
+        const auto weight   = other.count / total;
+        const auto x_delta  = other.x_mean - x_mean;
+        const auto dy_delta = other.dy_mean - dy_mean;
+        x_m2 += other.x_m2 + x_delta * x_delta * count * weight;
+        co_m2 += other.co_m2 + x_delta * dy_delta * count * weight;
+        x_mean += x_delta * weight;
+        dy_mean += dy_delta * weight;
+        count = total;
+    }
+
+    double variance() const { return count == 0 ? 0. : x_m2 / count; }
+};
+
+static constexpr std::size_t cpu_bn_lanes = 8;
+// Elements reduced as a block, small enough to stay in the cache for the second look at them.
+static constexpr std::size_t cpu_bn_block = 4096;
+// The position-major reductions are split into at most that many parts, independently of the
+// number of threads, so the results do not depend on the machine.
+static constexpr std::size_t cpu_bn_parts = 64;
+
+inline double cpu_bn_sum_lanes(const double (&acc)[cpu_bn_lanes])
+{
+    auto sum = 0.;
+    for(auto a : acc)
+        sum += a;
+    return sum;
+}
+
+// Moments of m contiguous values. Without WithDy, dy is not read.
+template <bool WithDy, class Tx, class Tdy>
+cpu_bn_moments cpu_bn_run_moments(const Tx* x, const Tdy* dy, std::size_t m)
+{
+    constexpr auto lanes = cpu_bn_lanes;
+    const auto vm        = m - m % lanes;
+
+    double x_sum[lanes]  = {};
+    double dy_sum[lanes] = {};
+    for(std::size_t i = 0; i < vm; i += lanes)
+    {
+        for(std::size_t l = 0; l < lanes; ++l)
+        {
+            x_sum[l] += static_cast<double>(x[i + l]);
+            if(WithDy)
+                dy_sum[l] += static_cast<double>(dy[i + l]);
+        }
+    }
+    for(auto i = vm; i < m; ++i)
+    {
+        x_sum[0] += static_cast<double>(x[i]);
+        if(WithDy)
+            dy_sum[0] += static_cast<double>(dy[i]);
+    }
+
+    cpu_bn_moments r;
+    r.count   = static_cast<double>(m);
+    r.x_mean  = cpu_bn_sum_lanes(x_sum) / r.count;
+    r.dy_mean = cpu_bn_sum_lanes(dy_sum) / r.count;
+
+    double x_m2[lanes]  = {};
+    double co_m2[lanes] = {};
+    for(std::size_t i = 0; i < vm; i += lanes)
+    {
+        for(std::size_t l = 0; l < lanes; ++l)
+        {
+            const auto d = static_cast<double>(x[i + l]) - r.x_mean;
+            x_m2[l] += d * d;
+            if(WithDy)
+                co_m2[l] += d * (static_cast<double>(dy[i + l]) - r.dy_mean);
+        }
+    }
+    for(auto i = vm; i < m; ++i)
+    {
+        const auto d = static_cast<double>(x[i]) - r.x_mean;
+        x_m2[0] += d * d;
+        if(WithDy)
+            co_m2[0] += d * (static_cast<double>(dy[i]) - r.dy_mean);
+    }
+    r.x_m2  = cpu_bn_sum_lanes(x_m2);
+    r.co_m2 = cpu_bn_sum_lanes(co_m2);
+    return r;
+}
+
+/// Moments of every channel of x (and dy), in one parallel pass over the tensors: over the
+/// channels for the channel-major layouts, over parts of the positions for the other ones.
+template <bool WithDy, class Tx, class Tdy>
+std::vector<cpu_bn_moments>
+cpu_bn_channel_moments(const cpu_bn_layout& l, const Tx* x, const Tdy* dy)
+{
+    std::vector<cpu_bn_moments> result(l.c);
+    if(l.channel_major())
+    {
+        miopen::par_for(l.c, 1, [&](std::size_t c) {
+            cpu_bn_moments acc;
+            for(std::size_t n = 0; n < l.n; ++n)
+            {
+                const auto offset = n * l.n_stride + c * l.c_stride;
+                for(std::size_t i = 0; i < l.s; i += cpu_bn_block)
+                {
+                    acc.merge(cpu_bn_run_moments<WithDy>(
+                        x + offset + i, dy + offset + i, std::min(cpu_bn_block, l.s - i)));
+                }
+            }
+            result[c] = acc;
+        });
+        return result;
+    }
+
+    const auto positions = l.n * l.s;
+    const auto rows      = std::max<std::size_t>(1, cpu_bn_block / std::max<std::size_t>(l.c, 1));
+    const auto blocks    = (positions + rows - 1) / rows;
+    const auto parts     = std::min(blocks, cpu_bn_parts);
+    std::vector<std::vector<cpu_bn_moments>> partial(parts);
+
+    miopen::par_for(parts, 1, [&](std::size_t part) {
+        auto& acc = partial[part];
+        acc.resize(l.c);
+        std::vector<double> buffer(4 * l.c);
+        auto* x_mean  = buffer.data();
+        auto* dy_mean = x_mean + l.c;
+        auto* x_m2    = dy_mean + l.c;
+        auto* co_m2   = x_m2 + l.c;
+
+        for(auto b = blocks * part / parts; b < blocks * (part + 1) / parts; ++b)
+        {
+            const auto first = b * rows;
+            const auto last  = std::min(positions, first + rows);
+            std::fill(buffer.begin(), buffer.end(), 0.);
+
+            for(auto p = first; p < last; ++p)
+            {
+                const auto* xp  = x + l.position_offset(p);
+                const auto* dyp = dy + l.position_offset(p);
+                for(std::size_t c = 0; c < l.c; ++c)
+                {
+                    x_mean[c] += static_cast<double>(xp[c * l.c_stride]);
+                    if(WithDy)
+                        dy_mean[c] += static_cast<double>(dyp[c * l.c_stride]);
+                }
+            }
+            const auto count = static_cast<double>(last - first);
+            for(std::size_t c = 0; c < l.c; ++c)
+            {
+                x_mean[c] /= count;
+                dy_mean[c] /= count;
+            }
+
+            for(auto p = first; p < last; ++p)
+            {
+                const auto* xp  = x + l.position_offset(p);
+                const auto* dyp = dy + l.position_offset(p);
+                for(std::size_t c = 0; c < l.c; ++c)
+                {
+                    const auto d = static_cast<double>(xp[c * l.c_stride]) - x_mean[c];
+                    x_m2[c] += d * d;
+                    if(WithDy)
+                        co_m2[c] += d * (static_cast<double>(dyp[c * l.c_stride]) - dy_mean[c]);
+                }
+            }
+
+            for(std::size_t c = 0; c < l.c; ++c)
+            {
+                cpu_bn_moments block;
+                block.count   = count;
+                block.x_mean  = x_mean[c];
+                block.x_m2    = x_m2[c];
+                block.dy_mean = dy_mean[c];
+                block.co_m2   = co_m2[c];
+                acc[c].merge(block);
+            }
+        }
+    });
+
+    for(const auto& acc : partial)
+        for(std::size_t c = 0; c < l.c; ++c)
+            result[c].merge(acc[c]);
+    return result;
+}
+
+/// Calls f(i, c) for the offset i and the channel c of every element, in parallel.
+template <class F>
+void cpu_bn_for_each(const cpu_bn_layout& l, F f)
+{
+    if(l.channel_major())
+    {
+        const auto grain = std::max<std::size_t>(1, cpu_bn_block / std::max<std::size_t>(l.s, 1));
+        miopen::par_for(l.n * l.c, grain, [&](std::size_t nc) {
+            const auto c      = nc % l.c;
+            const auto offset = (nc / l.c) * l.n_stride + c * l.c_stride;
+            for(std::size_t i = 0; i < l.s; ++i)
+                f(offset + i, c);
+        });
+        return;
+    }
+
+    const auto grain = std::max<std::size_t>(1, cpu_bn_block / std::max<std::size_t>(l.c, 1));
+    miopen::par_for(l.n * l.s, grain, [&](std::size_t p) {
+        const auto offset = l.position_offset(p);
+        for(std::size_t c = 0; c < l.c; ++c)
+            f(offset + c * l.c_stride, c);
+    });
+}
+
+/// Forward training: y = scale * (x - mean) / sqrt(variance + epsilon) + bias with the statistics
+/// of the batch, which also update the running mean and variance (unbiased) and are saved, unless
+/// the pointers are null.
+template <class Tx, class Ty, class Tscale, class Tbias, class Tstat>
+void cpu_bn_forward_train(const cpu_bn_layout& l,
+                          const Tx* x,
+                          Ty* y,
+                          const Tscale* scale,
+                          const Tbias* bias,
+                          double epsilon,
+                          double exp_avg_factor,
+                          Tstat* run_mean,
+                          Tstat* run_var,
+                          Tstat* save_mean,
+                          Tstat* save_inv_var)
+{
+    const auto moments = cpu_bn_channel_moments<false>(l, x, x);
+    const auto keep    = 1 - exp_avg_factor;
+
+    std::vector<double> mean(l.c);
+    std::vector<double> factor(l.c);
+    std::vector<double> shift(l.c);
+    for(std::size_t c = 0; c < l.c; ++c)
+    {
+        const auto variance = moments[c].variance();
+        const auto inv_var  = 1. / std::sqrt(variance + epsilon);
+        mean[c]             = moments[c].x_mean;
+        factor[c]           = static_cast<double>(scale[c]) * inv_var;
+        shift[c]            = static_cast<double>(bias[c]);
+
+        if(save_mean != nullptr)
+            save_mean[c] = static_cast<Tstat>(mean[c]);
+        if(save_inv_var != nullptr)
+            save_inv_var[c] = static_cast<Tstat>(inv_var);
+        if(run_mean != nullptr)
+        {
+            const auto old = static_cast<double>(run_mean[c]);
+            run_mean[c]    = static_cast<Tstat>(exp_avg_factor * mean[c] + keep * old);
+        }
+        if(run_var != nullptr)
+        {
+            const auto old    = static_cast<double>(run_var[c]);
+            const auto count  = moments[c].count;
+            const auto adjust = count <= 1 ? variance : count / (count - 1) * variance;
+            run_var[c]        = static_cast<Tstat>(exp_avg_factor * adjust + keep * old);
+        }
+    }
+
+    cpu_bn_for_each(l, [&](std::size_t i, std::size_t c) {
+        y[i] = static_cast<Ty>((static_cast<double>(x[i]) - mean[c]) * factor[c] + shift[c]);
+    });
+}
+
+/// Forward inference with the estimated mean and variance.
+template <class Tx, class Ty, class Tscale, class Tbias, class Tstat>
+void cpu_bn_forward_infer(const cpu_bn_layout& l,
+                          const Tx* x,
+                          Ty* y,
+                          const Tscale* scale,
+                          const Tbias* bias,
+                          const Tstat* est_mean,
+                          const Tstat* est_var,
+                          double epsilon)
+{
+    std::vector<double> mean(l.c);
+    std::vector<double> factor(l.c);
+    std::vector<double> shift(l.c);
+    for(std::size_t c = 0; c < l.c; ++c)
+    {
+        mean[c]   = static_cast<double>(est_mean[c]);
+        factor[c] = static_cast<double>(scale[c]) /
+                    std::sqrt(static_cast<double>(est_var[c]) + epsilon);
+        shift[c]  = static_cast<double>(bias[c]);
+    }
+
+    cpu_bn_for_each(l, [&](std::size_t i, std::size_t c) {
+        y[i] = static_cast<Ty>((static_cast<double>(x[i]) - mean[c]) * factor[c] + shift[c]);
+    });
+}
+
+/// Forward inference with the statistics of the batch.
+template <class Tx, class Ty, class Tscale, class Tbias>
+void cpu_bn_forward_infer(const cpu_bn_layout& l,
+                          const Tx* x,
+                          Ty* y,
+                          const Tscale* scale,
+                          const Tbias* bias,
+                          double epsilon)
+{
+    const auto moments = cpu_bn_channel_moments<false>(l, x, x);
+    std::vector<double> mean(l.c);
+    std::vector<double> variance(l.c);
+    for(std::size_t c = 0; c < l.c; ++c)
+    {
+        mean[c]     = moments[c].x_mean;
+        variance[c] = moments[c].variance();
+    }
+    cpu_bn_forward_infer(l, x, y, scale, bias, mean.data(), variance.data(), epsilon);
+}
+
+// dscale = sum(dy * (x - mean) * inv_var), dbias = sum(dy) and
+// dx = scale * inv_var * (dy - dbias / m - (x - mean) * inv_var * dscale / m), m = n * s.
+template <class Tx, class Tdy, class Tdx, class Tscale, class Tgrad>
+void cpu_bn_backward_apply(const cpu_bn_layout& l,
+                           const Tx* x,
+                           const Tdy* dy,
+                           Tdx* dx,
+                           const Tscale* scale,
+                           Tgrad* dscale,
+                           Tgrad* dbias,
+                           const std::vector<cpu_bn_moments>& moments,
+                           const std::vector<double>& mean,
+                           const std::vector<double>& inv_var)
+{
+    std::vector<double> factor(l.c);
+    std::vector<double> dy_shift(l.c);
+    std::vector<double> x_factor(l.c);
+    for(std::size_t c = 0; c < l.c; ++c)
+    {
+        // sum(dy * (x - mean)) = co_m2 + count * (x_mean - mean) * dy_mean.
+        const auto& m   = moments[c];
+        const auto sum  = m.count * m.dy_mean;
+        const auto prod = m.co_m2 + m.count * (m.x_mean - mean[c]) * m.dy_mean;
+        const auto ds   = prod * inv_var[c];
+        dbias[c]        = static_cast<Tgrad>(sum);
+        dscale[c]       = static_cast<Tgrad>(ds);
+        factor[c]       = static_cast<double>(scale[c]) * inv_var[c];
+        dy_shift[c]     = m.count == 0 ? 0. : sum / m.count;
+        x_factor[c]     = m.count == 0 ? 0. : inv_var[c] * ds / m.count;
+    }
+
+    cpu_bn_for_each(l, [&](std::size_t i, std::size_t c) {
+        const auto d = static_cast<double>(x[i]) - mean[c];
+        dx[i] = static_cast<Tdx>(factor[c] *
+                                 (static_cast<double>(dy[i]) - dy_shift[c] - d * x_factor[c]));
+    });
+}
+
+/// Backward with the statistics of the batch, computed in the same pass as the sums of dy.
+template <class Tx, class Tdy, class Tdx, class Tscale, class Tgrad>
+void cpu_bn_backward(const cpu_bn_layout& l,
+                     const Tx* x,
+                     const Tdy* dy,
+                     Tdx* dx,
+                     const Tscale* scale,
+                     Tgrad* dscale,
+                     Tgrad* dbias,
+                     double epsilon)
+{
+    const auto moments = cpu_bn_channel_moments<true>(l, x, dy);
+    std::vector<double> mean(l.c);
+    std::vector<double> inv_var(l.c);
+    for(std::size_t c = 0; c < l.c; ++c)
+    {
+        mean[c]    = moments[c].x_mean;
+        inv_var[c] = 1. / std::sqrt(moments[c].variance() + epsilon);
+    }
+    cpu_bn_backward_apply(l, x, dy, dx, scale, dscale, dbias, moments, mean, inv_var);
+}
+
+/// Backward with the mean and the inverse variance saved by the forward training.
+template <class Tx, class Tdy, class Tdx, class Tscale, class Tgrad, class Tstat>
+void cpu_bn_backward(const cpu_bn_layout& l,
+                     const Tx* x,
+                     const Tdy* dy,
+                     Tdx* dx,
+                     const Tscale* scale,
+                     Tgrad* dscale,
+                     Tgrad* dbias,
+                     const Tstat* saved_mean,
+                     const Tstat* saved_inv_var)
+{
+    const auto moments = cpu_bn_channel_moments<true>(l, x, dy);
+    std::vector<double> mean(saved_mean, saved_mean + l.c);
+    std::vector<double> inv_var(saved_inv_var, saved_inv_var + l.c);
+    cpu_bn_backward_apply(l, x, dy, dx, scale, dscale, dbias, moments, mean, inv_var);
+}
+
+#endif
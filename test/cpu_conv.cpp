@@ -0,0 +1,207 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/bfloat16.hpp>
+#include <half.hpp>
+#include "test.hpp"
+#include "driver.hpp"
+#include "tensor_holder.hpp"
+#include "cpu_conv.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// The im2col convolutions against the direct ones. The data are small integers, so that both sum
+// them exactly and the results are the same regardless of the order of the sums.
+
+struct conv_case
+{
+    std::size_t n;
+    std::size_t c;
+    std::size_t k;
+    std::vector<std::size_t> in_spatial;
+    std::vector<std::size_t> filter;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    std::size_t groups;
+    bool channels_last;
+
+    std::vector<std::size_t> out_spatial() const
+    {
+        std::vector<std::size_t> out;
+        for(std::size_t i = 0; i < in_spatial.size(); ++i)
+        {
+            const auto extent = static_cast<int>(in_spatial[i]) + 2 * pads[i] -
+                                dilations[i] * (static_cast<int>(filter[i]) - 1) - 1;
+            out.push_back(extent / strides[i] + 1);
+        }
+        return out;
+    }
+};
+
+template <class T>
+tensor<T> make_conv_tensor(std::size_t outer,
+                           std::size_t channels,
+                           const std::vector<std::size_t>& spatial,
+                           bool channels_last)
+{
+    auto lens = std::vector<std::size_t>{outer, channels};
+    lens.insert(lens.end(), spatial.begin(), spatial.end());
+    if(!channels_last)
+        return tensor<T>{lens};
+
+    auto strides = std::vector<std::size_t>(lens.size());
+    auto stride  = channels;
+    strides[1]   = 1;
+    for(auto i = lens.size(); i-- > 2;)
+    {
+        strides[i] = stride;
+        stride *= lens[i];
+    }
+    strides[0] = stride;
+    return tensor<T>{lens, strides};
+}
+
+template <class T>
+void fill(tensor<T>& t)
+{
+    for(auto& x : t.data)
+        x = T(static_cast<float>(GET_RAND() % 5) - 2.f);
+}
+
+template <class T>
+bool same(const tensor<T>& a, const tensor<T>& b)
+{
+    return std::equal(a.data.begin(), a.data.end(), b.data.begin(), [](auto x, auto y) {
+        return static_cast<double>(x) == static_cast<double>(y);
+    });
+}
+
+template <class Tin, class Twei, class Tout>
+void test_forward(const conv_case& cc)
+{
+    const auto dim = cc.in_spatial.size();
+    auto in  = make_conv_tensor<Tin>(cc.n, cc.c, cc.in_spatial, cc.channels_last);
+    auto wei = make_conv_tensor<Twei>(cc.k, cc.c / cc.groups, cc.filter, cc.channels_last);
+    auto out = make_conv_tensor<Tout>(cc.n, cc.k, cc.out_spatial(), cc.channels_last);
+    auto ref = out;
+    fill(in);
+    fill(wei);
+
+    cpu_convolution_forward(dim, in, wei, out, cc.pads, cc.strides, cc.dilations, cc.groups);
+    cpu_convolution_forward_naive(dim, in, wei, ref, cc.pads, cc.strides, cc.dilations, cc.groups);
+    EXPECT(same(out, ref));
+}
+
+template <class T>
+void test_backward(const conv_case& cc)
+{
+    const auto dim = cc.in_spatial.size();
+    auto in  = make_conv_tensor<T>(cc.n, cc.c, cc.in_spatial, cc.channels_last);
+    auto wei = make_conv_tensor<T>(cc.k, cc.c / cc.groups, cc.filter, cc.channels_last);
+    auto out = make_conv_tensor<T>(cc.n, cc.k, cc.out_spatial(), cc.channels_last);
+    fill(in);
+    fill(wei);
+    fill(out);
+
+    auto din     = in;
+    auto din_ref = in;
+    cpu_convolution_backward_data(dim, din, wei, out, cc.pads, cc.strides, cc.dilations, cc.groups);
+    cpu_convolution_backward_data_naive(
+        dim, din_ref, wei, out, cc.pads, cc.strides, cc.dilations, cc.groups);
+    EXPECT(same(din, din_ref));
+
+    auto dwei     = wei;
+    auto dwei_ref = wei;
+    cpu_convolution_backward_weight(
+        dim, in, dwei, out, cc.pads, cc.strides, cc.dilations, cc.groups);
+    cpu_convolution_backward_weight_naive(
+        dim, in, dwei_ref, out, cc.pads, cc.strides, cc.dilations, cc.groups);
+    EXPECT(same(dwei, dwei_ref));
+}
+
+void test_vectorized()
+{
+    const std::vector<int> pads{1, 1};
+    const std::vector<int> strides{1, 2};
+    const std::vector<int> dilations{1, 1};
+
+    for(auto wei_layout : {miopenTensorNCHWc4, miopenTensorCHWNc4})
+    {
+        auto in  = tensor<int8_t>{miopenInt8, miopenTensorNCHWc4, 2, 8, 7, 9};
+        auto wei = wei_layout == miopenTensorNCHWc4
+                       ? tensor<int8_t>{miopenInt8, wei_layout, 12, 8, 3, 3}
+                       : tensor<int8_t>{miopenInt8, wei_layout, 8, 3, 3, 12};
+        auto out = tensor<int32_t>{miopenInt32, miopenTensorNCHWc4, 2, 12, 7, 5};
+        auto ref = out;
+        fill(in);
+        fill(wei);
+
+        cpu_convolution_forward(2, in, wei, out, pads, strides, dilations, 1);
+        cpu_convolution_forward_naive(2, in, wei, ref, pads, strides, dilations, 1);
+        EXPECT(same(out, ref));
+    }
+}
+
+int main()
+{
+    const std::vector<conv_case> cases = {
+        // 2d: plain, padded and strided, dilated, grouped, depthwise, 1x1.
+        {2, 8, 16, {9, 11}, {3, 3}, {0, 0}, {1, 1}, {1, 1}, 1, false},
+        {3, 6, 10, {13, 10}, {3, 5}, {1, 2}, {2, 3}, {1, 1}, 1, false},
+        {2, 8, 12, {12, 12}, {3, 3}, {2, 2}, {1, 2}, {2, 2}, 2, false},
+        {1, 12, 12, {8, 9}, {3, 3}, {1, 1}, {1, 1}, {1, 1}, 12, false},
+        {4, 40, 36, {7, 7}, {1, 1}, {0, 0}, {1, 1}, {1, 1}, 1, false},
+        {2, 8, 12, {12, 12}, {3, 3}, {2, 2}, {1, 2}, {2, 2}, 2, true},
+        // More rows than the blocks of the gemm.
+        {1, 48, 100, {14, 14}, {3, 3}, {1, 1}, {1, 1}, {1, 1}, 1, true},
+        // 1d and 3d.
+        {2, 4, 6, {31}, {5}, {2}, {3}, {1}, 1, false},
+        {2, 4, 8, {5, 6, 7}, {3, 3, 3}, {1, 0, 1}, {1, 2, 1}, {1, 1, 2}, 2, false},
+        {2, 4, 8, {5, 6, 7}, {3, 3, 3}, {1, 0, 1}, {1, 2, 1}, {1, 1, 2}, 2, true},
+    };
+
+    for(const auto& cc : cases)
+    {
+        test_forward<float, float, float>(cc);
+        test_backward<float>(cc);
+    }
+
+    for(const auto& cc : {cases[1], cases[2], cases[5]})
+    {
+        test_forward<half_float::half, half_float::half, half_float::half>(cc);
+        test_forward<bfloat16, bfloat16, bfloat16>(cc);
+        test_forward<int8_t, int8_t, int32_t>(cc);
+        test_forward<int8_t, int8_t, float>(cc);
+        test_backward<half_float::half>(cc);
+        test_backward<bfloat16>(cc);
+    }
+
+    test_vectorized();
+}
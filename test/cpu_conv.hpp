@@ -36,6 +36,7 @@
 #include <miopen/tensor.hpp>
 #include <utility>
 
+#include "cpu_conv_im2col.hpp"
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
 #include <miopen/functional.hpp>
@@ -362,6 +363,25 @@ void cpu_convolution_forward(std::size_t spatial_dim,
 {
     using acc_type = typename cpu_convolution_acc_type<Tin, Twei, Tout>::type;
 
+    if(spatial_dim == 0 || spatial_dim > cpu_conv_max_spatial_dim)
+        MIOPEN_THROW("not belong to any case");
+    cpu_convolution_forward_im2col<acc_type>(
+        spatial_dim, in, wei, out, pads, strides, dilations, group_count);
+}
+
+/// The direct implementation, the oracle of the im2col one.
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_naive(std::size_t spatial_dim,
+                                   const tensor<Tin>& in,
+                                   const tensor<Twei>& wei,
+                                   tensor<Tout>& out,
+                                   const Range& pads,
+                                   const Range& strides,
+                                   const Range& dilations,
+                                   std::size_t group_count)
+{
+    using acc_type = typename cpu_convolution_acc_type<Tin, Twei, Tout>::type;
+
     switch(spatial_dim)
     {
     case 1: {
@@ -402,6 +422,25 @@ void cpu_convolution_backward_data(std::size_t spatial_dim,
 {
     using acc_type = typename cpu_convolution_acc_type<Tin, Twei, Tout>::type;
 
+    if(spatial_dim == 0 || spatial_dim > cpu_conv_max_spatial_dim)
+        MIOPEN_THROW("not belong to any case");
+    cpu_convolution_backward_data_im2col<acc_type>(
+        spatial_dim, in, wei, out, pads, strides, dilations, group_count);
+}
+
+/// The direct implementation, the oracle of the im2col one.
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_data_naive(std::size_t spatial_dim,
+                                         tensor<Tin>& in,
+                                         const tensor<Twei>& wei,
+                                         const tensor<Tout>& out,
+                                         const Range& pads,
+                                         const Range& strides,
+                                         const Range& dilations,
+                                         std::size_t group_count)
+{
+    using acc_type = typename cpu_convolution_acc_type<Tin, Twei, Tout>::type;
+
     switch(spatial_dim)
     {
     case 1: {
@@ -442,6 +481,25 @@ void cpu_convolution_backward_weight(std::size_t spatial_dim,
 {
     using acc_type = typename cpu_convolution_acc_type<Tin, Twei, Tout>::type;
 
+    if(spatial_dim == 0 || spatial_dim > cpu_conv_max_spatial_dim)
+        MIOPEN_THROW("not belong to any case");
+    cpu_convolution_backward_weight_im2col<acc_type>(
+        spatial_dim, in, wei, out, pads, strides, dilations, group_count);
+}
+
+/// The direct implementation, the oracle of the im2col one.
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_weight_naive(std::size_t spatial_dim,
+                                           const tensor<Tin>& in,
+                                           tensor<Twei>& wei,
+                                           const tensor<Tout>& out,
+                                           const Range& pads,
+                                           const Range& strides,
+                                           const Range& dilations,
+                                           std::size_t group_count)
+{
+    using acc_type = typename cpu_convolution_acc_type<Tin, Twei, Tout>::type;
+
     switch(spatial_dim)
     {
     case 1: {
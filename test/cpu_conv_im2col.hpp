@@ -0,0 +1,500 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_CONV_IM2COL_HPP
+#define GUARD_CPU_CONV_IM2COL_HPP
+
+#include "cpu_gemm.hpp"
+#include "tensor_holder.hpp"
+
+#include <miopen/errors.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+static constexpr std::size_t cpu_conv_max_spatial_dim = 4;
+
+// Where the elements of a convolution tensor are, indexed by (outer, channel, spatial): outer is n
+// for the data and k for the weights. The channels of NCHWc and CHWNc are split into vectors the
+// way the direct implementation does, channel c is at (c % vector) + (c / vector) * stride.
+struct cpu_conv_view
+{
+    std::size_t outer_len      = 0;
+    std::size_t outer_stride   = 0;
+    std::size_t channel_len    = 0;
+    std::size_t channel_stride = 0;
+    std::size_t channel_vector = 1;
+    std::size_t spatial_dim    = 0;
+    std::size_t spatial_size   = 1;
+    std::array<std::size_t, cpu_conv_max_spatial_dim> spatial_len{};
+    std::array<std::size_t, cpu_conv_max_spatial_dim> spatial_stride{};
+    // The offsets of the spatial points in the row-major order of their indices.
+    std::vector<std::size_t> spatial_offsets;
+
+    cpu_conv_view(const miopen::TensorDescriptor& desc, std::size_t dim) : spatial_dim(dim)
+    {
+        const auto& lens    = desc.GetLengths();
+        const auto& strides = desc.GetStrides();
+        assert(lens.size() == dim + 2);
+
+        // CHWNc keeps the lengths and strides in the memory order.
+        const auto chwn    = desc.GetLayout_str() == "CHWNc";
+        const auto outer   = chwn ? dim + 1 : 0;
+        const auto channel = chwn ? 0 : 1;
+        const auto spatial = chwn ? 1 : 2;
+
+        outer_len      = lens[outer];
+        outer_stride   = strides[outer];
+        channel_vector = desc.GetVectorLength();
+        channel_len    = lens[channel] * channel_vector;
+        channel_stride = strides[channel];
+        for(std::size_t i = 0; i < dim; ++i)
+        {
+            spatial_len[i]    = lens[spatial + i];
+            spatial_stride[i] = strides[spatial + i];
+            spatial_size *= spatial_len[i];
+        }
+
+        spatial_offsets.resize(spatial_size);
+        for(std::size_t s = 0; s < spatial_size; ++s)
+        {
+            auto rest   = s;
+            auto offset = std::size_t{0};
+            for(auto i = dim; i-- > 0;)
+            {
+                offset += (rest % spatial_len[i]) * spatial_stride[i];
+                rest /= spatial_len[i];
+            }
+            spatial_offsets[s] = offset;
+        }
+    }
+
+    std::size_t offset(std::size_t outer, std::size_t channel) const
+    {
+        return outer * outer_stride + channel % channel_vector +
+               channel / channel_vector * channel_stride;
+    }
+};
+
+// The convolution as gemms of the weights of a group, [k x (c * filter)], and the im2col
+// columns of an image, [(c * filter) x out spatial].
+struct cpu_conv_geometry
+{
+    std::size_t dim;
+    cpu_conv_view in;
+    cpu_conv_view wei;
+    cpu_conv_view out;
+    std::size_t groups;
+    std::size_t k_per_group;
+    std::size_t c_per_group;
+    std::size_t filter_size;
+    std::size_t out_size;
+    // o * stride - pad of every output point, dim per point.
+    std::vector<std::ptrdiff_t> out_origin;
+    // f * dilation of every filter point, dim per point.
+    std::vector<std::ptrdiff_t> filter_shift;
+
+    template <class Range>
+    cpu_conv_geometry(std::size_t spatial_dim,
+                      const miopen::TensorDescriptor& in_desc,
+                      const miopen::TensorDescriptor& wei_desc,
+                      const miopen::TensorDescriptor& out_desc,
+                      const Range& pads,
+                      const Range& strides,
+                      const Range& dilations,
+                      std::size_t group_count)
+        : dim(spatial_dim),
+          in(in_desc, spatial_dim),
+          wei(wei_desc, spatial_dim),
+          out(out_desc, spatial_dim),
+          groups(group_count),
+          k_per_group(wei.outer_len / group_count),
+          c_per_group(wei.channel_len),
+          filter_size(wei.spatial_size),
+          out_size(out.spatial_size)
+    {
+        assert(pads.size() == dim && strides.size() == dim && dilations.size() == dim);
+
+        out_origin.resize(out_size * dim);
+        for(std::size_t p = 0; p < out_size; ++p)
+        {
+            auto rest = p;
+            for(auto i = dim; i-- > 0;)
+            {
+                const auto o = static_cast<std::ptrdiff_t>(rest % out.spatial_len[i]);
+                rest /= out.spatial_len[i];
+                out_origin[p * dim + i] = o * strides[i] - pads[i];
+            }
+        }
+
+        filter_shift.resize(filter_size * dim);
+        for(std::size_t f = 0; f < filter_size; ++f)
+        {
+            auto rest = f;
+            for(auto i = dim; i-- > 0;)
+            {
+                const auto x = static_cast<std::ptrdiff_t>(rest % wei.spatial_len[i]);
+                rest /= wei.spatial_len[i];
+                filter_shift[f * dim + i] = x * dilations[i];
+            }
+        }
+    }
+
+    std::size_t rows() const { return c_per_group * filter_size; }
+
+    // Calls f(row, p, c, offset) for the input element of every row of the channels [c0, c1) of
+    // the group and every output point of [p0, p0 + cols) within the input. The row is relative
+    // to the first one of c0, the offset to the first spatial point of the channel.
+    template <class F>
+    void for_each_input(std::size_t c0,
+                        std::size_t c1,
+                        std::size_t p0,
+                        std::size_t cols,
+                        const std::array<std::size_t, cpu_conv_max_spatial_dim>& in_stride,
+                        F f) const
+    {
+        // The same for all the channels, -1 out of the input.
+        thread_local std::vector<std::ptrdiff_t> offsets;
+        offsets.resize(filter_size * cols);
+        for(std::size_t f_id = 0; f_id < filter_size; ++f_id)
+        {
+            const auto* shift = &filter_shift[f_id * dim];
+            for(std::size_t p = 0; p < cols; ++p)
+            {
+                const auto* origin = &out_origin[(p0 + p) * dim];
+                auto offset        = std::ptrdiff_t{0};
+                for(std::size_t i = 0; i < dim; ++i)
+                {
+                    const auto x = origin[i] + shift[i];
+                    if(x < 0 || x >= static_cast<std::ptrdiff_t>(in.spatial_len[i]))
+                    {
+                        offset = -1;
+                        break;
+                    }
+                    offset += x * static_cast<std::ptrdiff_t>(in_stride[i]);
+                }
+                offsets[f_id * cols + p] = offset;
+            }
+        }
+
+        for(auto c = c0; c < c1; ++c)
+        {
+            for(std::size_t f_id = 0; f_id < filter_size; ++f_id)
+            {
+                const auto row = (c - c0) * filter_size + f_id;
+                for(std::size_t p = 0; p < cols; ++p)
+                {
+                    const auto offset = offsets[f_id * cols + p];
+                    if(offset >= 0)
+                        f(row, p, c, static_cast<std::size_t>(offset));
+                }
+            }
+        }
+    }
+
+    // Output points per block of the columns. It keeps the rows x cols accumulators in cache,
+    // makes at least the given number of blocks when there are enough points, and is a multiple
+    // of the width of the gemm tiles.
+    std::size_t column_block(std::size_t block_rows, std::size_t blocks) const
+    {
+        const std::size_t budget = 1 << 20;
+        const std::size_t align  = 32;
+        auto cols = budget / (std::max<std::size_t>(block_rows, 1) * sizeof(double));
+        blocks    = std::max<std::size_t>(blocks, 1);
+        cols      = std::min(cols, (out_size + blocks - 1) / blocks);
+        cols      = std::max(align, std::min<std::size_t>(cols, 512) / align * align);
+        return std::min(cols, out_size);
+    }
+
+    // Blocks per task of the other dimensions for two tasks per thread of the pool.
+    static std::size_t min_blocks(std::size_t other_tasks)
+    {
+        const auto threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        return (2 * threads + other_tasks - 1) / std::max<std::size_t>(other_tasks, 1);
+    }
+
+    // Channels per block of the rows, for the directions parallel over them.
+    std::size_t channel_block(std::size_t other_tasks) const
+    {
+        const auto blocks = min_blocks(other_tasks);
+        return std::max<std::size_t>(1, (c_per_group + blocks - 1) / blocks);
+    }
+};
+
+template <class Tacc, class Twei>
+std::vector<Tacc> cpu_conv_pack_weights(const cpu_conv_geometry& geo, const tensor<Twei>& wei)
+{
+    const auto rows = geo.rows();
+    auto packed     = std::vector<Tacc>(geo.wei.outer_len * rows);
+    miopen::par_for(geo.wei.outer_len, 1, [&](std::size_t k) {
+        for(std::size_t c = 0; c < geo.c_per_group; ++c)
+        {
+            const auto base = geo.wei.offset(k, c);
+            for(std::size_t f = 0; f < geo.filter_size; ++f)
+                packed[k * rows + c * geo.filter_size + f] =
+                    Tacc(wei.data[base + geo.wei.spatial_offsets[f]]);
+        }
+    });
+    return packed;
+}
+
+// col[row * cols + p] of the rows of the channels [c0, c1) of the group g of the image n.
+template <class Tacc, class Tin>
+void cpu_conv_im2col(const cpu_conv_geometry& geo,
+                     const tensor<Tin>& in,
+                     std::size_t n,
+                     std::size_t g,
+                     std::size_t c0,
+                     std::size_t c1,
+                     std::size_t p0,
+                     std::size_t cols,
+                     std::vector<Tacc>& col)
+{
+    col.assign((c1 - c0) * geo.filter_size * cols, Tacc(0));
+    auto bases = std::vector<std::size_t>(c1 - c0);
+    for(auto c = c0; c < c1; ++c)
+        bases[c - c0] = geo.in.offset(n, g * geo.c_per_group + c);
+    geo.for_each_input(
+        c0, c1, p0, cols, geo.in.spatial_stride, [&](auto row, auto p, auto c, auto offset) {
+            col[row * cols + p] = Tacc(in.data[bases[c - c0] + offset]);
+        });
+}
+
+// dy[k * cols + p] of the output channels of the group g of the image n.
+template <class Tacc, class Tout>
+void cpu_conv_gather_output(const cpu_conv_geometry& geo,
+                            const tensor<Tout>& out,
+                            std::size_t n,
+                            std::size_t g,
+                            std::size_t p0,
+                            std::size_t cols,
+                            std::vector<Tacc>& dy)
+{
+    dy.resize(geo.k_per_group * cols);
+    for(std::size_t kk = 0; kk < geo.k_per_group; ++kk)
+    {
+        const auto base = geo.out.offset(n, g * geo.k_per_group + kk);
+        for(std::size_t p = 0; p < cols; ++p)
+            dy[kk * cols + p] = Tacc(out.data[base + geo.out.spatial_offsets[p0 + p]]);
+    }
+}
+
+/// Same as cpu_convolution_forward_impl, as the gemms of the packed weights and the blocks of the
+/// im2col columns, parallel over the images, groups and blocks.
+template <typename Tacc, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_im2col(std::size_t spatial_dim,
+                                    const tensor<Tin>& in,
+                                    const tensor<Twei>& wei,
+                                    tensor<Tout>& out,
+                                    const Range& pads,
+                                    const Range& strides,
+                                    const Range& dilations,
+                                    std::size_t group_count)
+{
+    const auto geo = cpu_conv_geometry{
+        spatial_dim, in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+    const auto rows    = geo.rows();
+    const auto weights = cpu_conv_pack_weights<Tacc>(geo, wei);
+
+    const auto images = geo.out.outer_len;
+    const auto cols   = geo.column_block(rows, geo.min_blocks(images * geo.groups));
+    const auto blocks = (geo.out_size + cols - 1) / cols;
+
+    miopen::par_for(images * geo.groups * blocks, 1, [&](std::size_t task) {
+        const auto n     = task / (geo.groups * blocks);
+        const auto g     = task / blocks % geo.groups;
+        const auto p0    = task % blocks * cols;
+        const auto width = std::min(cols, geo.out_size - p0);
+
+        auto col = std::vector<Tacc>{};
+        cpu_conv_im2col(geo, in, n, g, 0, geo.c_per_group, p0, width, col);
+
+        auto y = std::vector<Tacc>(geo.k_per_group * width, Tacc(0));
+        cpu_gemm_block(geo.k_per_group,
+                       width,
+                       rows,
+                       weights.data() + g * geo.k_per_group * rows,
+                       rows,
+                       1,
+                       col.data(),
+                       width,
+                       1,
+                       y.data(),
+                       width);
+
+        for(std::size_t kk = 0; kk < geo.k_per_group; ++kk)
+        {
+            const auto base = geo.out.offset(n, g * geo.k_per_group + kk);
+            for(std::size_t p = 0; p < width; ++p)
+                out.data[base + geo.out.spatial_offsets[p0 + p]] = y[kk * width + p];
+        }
+    });
+}
+
+/// Same as cpu_convolution_backward_data_impl, as the gemms of the transposed weights and the
+/// output, scattered back to the input by col2im. Parallel over the images, groups and blocks of
+/// the input channels, which write disjoint parts of the input.
+template <typename Tacc, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_data_im2col(std::size_t spatial_dim,
+                                          tensor<Tin>& in,
+                                          const tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
+{
+    const auto geo = cpu_conv_geometry{
+        spatial_dim, in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+    const auto rows    = geo.rows();
+    const auto weights = cpu_conv_pack_weights<Tacc>(geo, wei);
+
+    const auto images   = geo.in.outer_len;
+    const auto channels = geo.channel_block(images * geo.groups);
+    const auto c_blocks = (geo.c_per_group + channels - 1) / channels;
+
+    // The accumulators of the input, packed.
+    auto packed_stride = std::array<std::size_t, cpu_conv_max_spatial_dim>{};
+    auto in_size       = std::size_t{1};
+    for(auto i = geo.dim; i-- > 0;)
+    {
+        packed_stride[i] = in_size;
+        in_size *= geo.in.spatial_len[i];
+    }
+
+    miopen::par_for(images * geo.groups * c_blocks, 1, [&](std::size_t task) {
+        const auto n          = task / (geo.groups * c_blocks);
+        const auto g          = task / c_blocks % geo.groups;
+        const auto c0         = task % c_blocks * channels;
+        const auto c1         = std::min(geo.c_per_group, c0 + channels);
+        const auto block_rows = (c1 - c0) * geo.filter_size;
+        const auto cols       = geo.column_block(block_rows + geo.k_per_group, 1);
+
+        auto dx   = std::vector<Tacc>((c1 - c0) * in_size, Tacc(0));
+        auto dy   = std::vector<Tacc>{};
+        auto dcol = std::vector<Tacc>{};
+        for(std::size_t p0 = 0; p0 < geo.out_size; p0 += cols)
+        {
+            const auto width = std::min(cols, geo.out_size - p0);
+            cpu_conv_gather_output(geo, out, n, g, p0, width, dy);
+
+            dcol.assign(block_rows * width, Tacc(0));
+            cpu_gemm_block(block_rows,
+                           width,
+                           geo.k_per_group,
+                           weights.data() + g * geo.k_per_group * rows + c0 * geo.filter_size,
+                           1,
+                           rows,
+                           dy.data(),
+                           width,
+                           1,
+                           dcol.data(),
+                           width);
+
+            geo.for_each_input(
+                c0, c1, p0, width, packed_stride, [&](auto row, auto p, auto c, auto offset) {
+                    dx[(c - c0) * in_size + offset] += dcol[row * width + p];
+                });
+        }
+
+        for(auto c = c0; c < c1; ++c)
+        {
+            const auto base = geo.in.offset(n, g * geo.c_per_group + c);
+            for(std::size_t s = 0; s < in_size; ++s)
+                in.data[base + geo.in.spatial_offsets[s]] = dx[(c - c0) * in_size + s];
+        }
+    });
+}
+
+/// Same as cpu_convolution_backward_weight_impl, as the gemms of the output and the transposed
+/// im2col columns, summed over the images and blocks. Parallel over the groups and blocks of the
+/// input channels, which write disjoint parts of the weights.
+template <typename Tacc, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_weight_im2col(std::size_t spatial_dim,
+                                            const tensor<Tin>& in,
+                                            tensor<Twei>& wei,
+                                            const tensor<Tout>& out,
+                                            const Range& pads,
+                                            const Range& strides,
+                                            const Range& dilations,
+                                            std::size_t group_count)
+{
+    const auto geo = cpu_conv_geometry{
+        spatial_dim, in.desc, wei.desc, out.desc, pads, strides, dilations, group_count};
+
+    const auto images   = geo.out.outer_len;
+    const auto channels = geo.channel_block(geo.groups);
+    const auto c_blocks = (geo.c_per_group + channels - 1) / channels;
+
+    miopen::par_for(geo.groups * c_blocks, 1, [&](std::size_t task) {
+        const auto g          = task / c_blocks;
+        const auto c0         = task % c_blocks * channels;
+        const auto c1         = std::min(geo.c_per_group, c0 + channels);
+        const auto block_rows = (c1 - c0) * geo.filter_size;
+        const auto cols       = geo.column_block(block_rows + geo.k_per_group, 1);
+
+        auto dw  = std::vector<Tacc>(geo.k_per_group * block_rows, Tacc(0));
+        auto dy  = std::vector<Tacc>{};
+        auto col = std::vector<Tacc>{};
+        for(std::size_t n = 0; n < images; ++n)
+        {
+            for(std::size_t p0 = 0; p0 < geo.out_size; p0 += cols)
+            {
+                const auto width = std::min(cols, geo.out_size - p0);
+                cpu_conv_gather_output(geo, out, n, g, p0, width, dy);
+                cpu_conv_im2col(geo, in, n, g, c0, c1, p0, width, col);
+                cpu_gemm_block(geo.k_per_group,
+                               block_rows,
+                               width,
+                               dy.data(),
+                               width,
+                               1,
+                               col.data(),
+                               1,
+                               width,
+                               dw.data(),
+                               block_rows);
+            }
+        }
+
+        for(std::size_t kk = 0; kk < geo.k_per_group; ++kk)
+        {
+            for(auto c = c0; c < c1; ++c)
+            {
+                const auto base = geo.wei.offset(g * geo.k_per_group + kk, c);
+                for(std::size_t f = 0; f < geo.filter_size; ++f)
+                    wei.data[base + geo.wei.spatial_offsets[f]] =
+                        dw[kk * block_rows + (c - c0) * geo.filter_size + f];
+            }
+        }
+    });
+}
+
+#endif
@@ -0,0 +1,205 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_gemm.hpp"
+#include "gemm.hpp"
+#include "random.hpp"
+#include "test.hpp"
+
+#include <half.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// The gemms against the triple loop. The data are small integers, so that the sums are exact and
+// the same regardless of their order.
+
+template <class T>
+std::vector<T> make_matrix(std::size_t size)
+{
+    std::vector<T> data(size);
+    for(auto& x : data)
+        x = T(static_cast<float>(GET_RAND() % 7) - 3.f);
+    return data;
+}
+
+template <class TA, class TC>
+std::vector<TC> naive_gemm(bool trans_a,
+                           bool trans_b,
+                           std::size_t m,
+                           std::size_t n,
+                           std::size_t k,
+                           double alpha,
+                           const TA* a,
+                           std::size_t lda,
+                           const TA* b,
+                           std::size_t ldb,
+                           double beta,
+                           std::vector<TC> c,
+                           std::size_t ldc)
+{
+    for(std::size_t i = 0; i < m; ++i)
+    {
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            double x = 0;
+            for(std::size_t kk = 0; kk < k; ++kk)
+            {
+                const auto av = trans_a ? a[kk * lda + i] : a[i * lda + kk];
+                const auto bv = trans_b ? b[j * ldb + kk] : b[kk * ldb + j];
+                x += static_cast<double>(av) * static_cast<double>(bv);
+            }
+            c[i * ldc + j] = TC(beta * static_cast<double>(c[i * ldc + j]) + alpha * x);
+        }
+    }
+    return c;
+}
+
+template <class T>
+bool same(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), [](auto x, auto y) {
+        return static_cast<double>(x) == static_cast<double>(y);
+    });
+}
+
+template <class Tacc, class T>
+void test_gemm(bool trans_a, bool trans_b, std::size_t m, std::size_t n, std::size_t k)
+{
+    // Padded leading dimensions.
+    const auto lda = (trans_a ? m : k) + 3;
+    const auto ldb = (trans_b ? k : n) + 1;
+    const auto ldc = n + 2;
+    const auto a   = make_matrix<T>((trans_a ? k : m) * lda);
+    const auto b   = make_matrix<T>((trans_b ? n : k) * ldb);
+    auto c         = make_matrix<T>(m * ldc);
+
+    const auto expected =
+        naive_gemm(trans_a, trans_b, m, n, k, 2., a.data(), lda, b.data(), ldb, -1., c, ldc);
+    cpu_gemm<Tacc>(
+        trans_a, trans_b, m, n, k, 2., a.data(), lda, b.data(), ldb, -1., c.data(), ldc);
+    EXPECT(same(c, expected));
+}
+
+void test_batched()
+{
+    const std::size_t batch = 5;
+    const std::size_t m     = 37;
+    const std::size_t n     = 300;
+    const std::size_t k     = 70;
+    const auto a            = make_matrix<float>(batch * m * k);
+    const auto b            = make_matrix<float>(batch * n * k);
+    auto c                  = make_matrix<float>(batch * m * n);
+
+    auto expected = c;
+    for(std::size_t bt = 0; bt < batch; ++bt)
+    {
+        const auto part = naive_gemm(false,
+                                     true,
+                                     m,
+                                     n,
+                                     k,
+                                     1.,
+                                     &a[bt * m * k],
+                                     k,
+                                     &b[bt * n * k],
+                                     k,
+                                     1.,
+                                     std::vector<float>(&c[bt * m * n], &c[(bt + 1) * m * n]),
+                                     n);
+        std::copy(part.begin(), part.end(), expected.begin() + bt * m * n);
+    }
+
+    auto strided = c;
+    cpu_gemm_strided_batched(false,
+                             true,
+                             m,
+                             n,
+                             k,
+                             1.,
+                             a.data(),
+                             k,
+                             m * k,
+                             b.data(),
+                             k,
+                             n * k,
+                             1.,
+                             strided.data(),
+                             n,
+                             m * n,
+                             batch);
+    EXPECT(same(strided, expected));
+
+    std::vector<const float*> a_ptrs;
+    std::vector<const float*> b_ptrs;
+    std::vector<float*> c_ptrs;
+    for(std::size_t bt = 0; bt < batch; ++bt)
+    {
+        a_ptrs.push_back(&a[bt * m * k]);
+        b_ptrs.push_back(&b[bt * n * k]);
+        c_ptrs.push_back(&c[bt * m * n]);
+    }
+    cpu_gemm_batched(
+        false, true, m, n, k, 1., a_ptrs.data(), k, b_ptrs.data(), k, 1., c_ptrs.data(), n, batch);
+    EXPECT(same(c, expected));
+}
+
+void test_accessors()
+{
+    const std::size_t m = 19;
+    const std::size_t n = 23;
+    const std::size_t k = 300;
+    auto a              = make_matrix<double>(m * k);
+    auto b              = make_matrix<double>(k * n);
+    std::vector<double> c(m * n);
+
+    gemm(m, n, k, with_stride(a, k), with_stride(b, n), [&](int i, int j, double x) {
+        c[i * n + j] = x;
+    });
+    const auto expected = naive_gemm(
+        false, false, m, n, k, 1., a.data(), k, b.data(), n, 0., std::vector<double>(m * n), n);
+    EXPECT(same(c, expected));
+}
+
+int main()
+{
+    for(auto trans_a : {false, true})
+    {
+        for(auto trans_b : {false, true})
+        {
+            // Tiles, blocks and their tails.
+            test_gemm<double, float>(trans_a, trans_b, 1, 1, 1);
+            test_gemm<double, float>(trans_a, trans_b, 5, 7, 3);
+            test_gemm<double, float>(trans_a, trans_b, 97, 261, 300);
+            test_gemm<double, double>(trans_a, trans_b, 200, 33, 513);
+            test_gemm<float, float>(trans_a, trans_b, 17, 1024, 129);
+            test_gemm<double, half_float::half>(trans_a, trans_b, 9, 40, 21);
+        }
+    }
+    test_batched();
+    test_accessors();
+}
@@ -0,0 +1,320 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_GEMM_HPP
+#define GUARD_CPU_GEMM_HPP
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Register tile of the packed gemm. The tile is as wide as two SIMD registers of the instruction
+// set the test is built for, so the compiler keeps the accumulators in registers and vectorizes
+// the update of a row, with a scalar fallback elsewhere.
+#if defined(__AVX512F__)
+static constexpr std::size_t cpu_gemm_simd_bytes = 64;
+#elif defined(__AVX__)
+static constexpr std::size_t cpu_gemm_simd_bytes = 32;
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+static constexpr std::size_t cpu_gemm_simd_bytes = 16;
+#else
+static constexpr std::size_t cpu_gemm_simd_bytes = 0;
+#endif
+
+template <class T>
+struct cpu_gemm_tile
+{
+    static constexpr std::size_t mr = 4;
+    static constexpr std::size_t nr = std::max<std::size_t>(4, 2 * cpu_gemm_simd_bytes / sizeof(T));
+    // Cache blocks: a kc x nc panel of b stays in L2/L3 while mc x kc blocks of a go through L1/L2.
+    static constexpr std::size_t kc = 256;
+    static constexpr std::size_t mc = 96;
+    static constexpr std::size_t nc = 2048;
+};
+
+template <class T>
+void cpu_gemm_micro_kernel(std::size_t k,
+                           const T* a,
+                           const T* b,
+                           T* c,
+                           std::size_t ldc,
+                           std::size_t m_tail,
+                           std::size_t n_tail)
+{
+    constexpr auto mr = cpu_gemm_tile<T>::mr;
+    constexpr auto nr = cpu_gemm_tile<T>::nr;
+
+    T acc[mr][nr] = {};
+    for(std::size_t kk = 0; kk < k; ++kk, a += mr, b += nr)
+    {
+        for(std::size_t i = 0; i < mr; ++i)
+        {
+            const auto ai = a[i];
+            for(std::size_t j = 0; j < nr; ++j)
+                acc[i][j] += ai * b[j];
+        }
+    }
+
+    for(std::size_t i = 0; i < m_tail; ++i)
+        for(std::size_t j = 0; j < n_tail; ++j)
+            c[i * ldc + j] += acc[i][j];
+}
+
+/// c[m x n] += a[m x k] * b[k x n] in Tacc, single-threaded: the callers parallelize over
+/// independent blocks. a(i, kk) and b(kk, j) return the elements of the operands, which are
+/// converted to Tacc as they are packed into the panels of the register tile, zero-padded at the
+/// edges. The panels are in the buffers of the calling thread, reused by the later calls. c is
+/// row-major with the leading dimension ldc.
+template <class Tacc, class A, class B>
+void cpu_gemm_block(std::size_t m, std::size_t n, std::size_t k, A a, B b, Tacc* c, std::size_t ldc)
+{
+    const std::size_t mr = cpu_gemm_tile<Tacc>::mr;
+    const std::size_t nr = cpu_gemm_tile<Tacc>::nr;
+    const std::size_t kc = cpu_gemm_tile<Tacc>::kc;
+    const std::size_t mc = cpu_gemm_tile<Tacc>::mc;
+    const std::size_t nc = cpu_gemm_tile<Tacc>::nc;
+
+    thread_local std::vector<Tacc> a_packed;
+    thread_local std::vector<Tacc> b_packed;
+
+    for(std::size_t jc = 0; jc < n; jc += nc)
+    {
+        const auto nb       = std::min(nc, n - jc);
+        const auto b_panels = (nb + nr - 1) / nr;
+
+        for(std::size_t pc = 0; pc < k; pc += kc)
+        {
+            const auto kb = std::min(kc, k - pc);
+
+            b_packed.assign(b_panels * kb * nr, Tacc(0));
+            for(std::size_t jp = 0; jp < b_panels; ++jp)
+            {
+                const auto cols = std::min(nr, nb - jp * nr);
+                auto* panel     = b_packed.data() + jp * kb * nr;
+                for(std::size_t kk = 0; kk < kb; ++kk)
+                    for(std::size_t j = 0; j < cols; ++j)
+                        panel[kk * nr + j] = static_cast<Tacc>(b(pc + kk, jc + jp * nr + j));
+            }
+
+            for(std::size_t ic = 0; ic < m; ic += mc)
+            {
+                const auto mb       = std::min(mc, m - ic);
+                const auto a_panels = (mb + mr - 1) / mr;
+
+                a_packed.assign(a_panels * kb * mr, Tacc(0));
+                for(std::size_t ip = 0; ip < a_panels; ++ip)
+                {
+                    const auto rows = std::min(mr, mb - ip * mr);
+                    auto* panel     = a_packed.data() + ip * kb * mr;
+                    for(std::size_t i = 0; i < rows; ++i)
+                        for(std::size_t kk = 0; kk < kb; ++kk)
+                            panel[kk * mr + i] = static_cast<Tacc>(a(ic + ip * mr + i, pc + kk));
+                }
+
+                for(std::size_t jp = 0; jp < b_panels; ++jp)
+                {
+                    for(std::size_t ip = 0; ip < a_panels; ++ip)
+                    {
+                        cpu_gemm_micro_kernel(kb,
+                                              a_packed.data() + ip * kb * mr,
+                                              b_packed.data() + jp * kb * nr,
+                                              c + (ic + ip * mr) * ldc + jc + jp * nr,
+                                              ldc,
+                                              std::min(mr, mb - ip * mr),
+                                              std::min(nr, nb - jp * nr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Same as above for the strided operands: a(i, kk) is at a[i * a_row + kk * a_col] and b(kk, j)
+/// at b[kk * b_row + j * b_col], so the transposed ones need no copy.
+template <class Tacc, class TA, class TB>
+void cpu_gemm_block(std::size_t m,
+                    std::size_t n,
+                    std::size_t k,
+                    const TA* a,
+                    std::size_t a_row,
+                    std::size_t a_col,
+                    const TB* b,
+                    std::size_t b_row,
+                    std::size_t b_col,
+                    Tacc* c,
+                    std::size_t ldc)
+{
+    cpu_gemm_block(
+        m,
+        n,
+        k,
+        [=](std::size_t i, std::size_t kk) { return a[i * a_row + kk * a_col]; },
+        [=](std::size_t kk, std::size_t j) { return b[kk * b_row + j * b_col]; },
+        c,
+        ldc);
+}
+
+/// Calls out(batch, i, j, x) once for every element of the batch of products, where x is the sum
+/// of a(batch, i, kk) * b(batch, kk, j) over kk in Tacc. The blocks of the products are computed
+/// in parallel on the shared pool, so out is called concurrently for different elements.
+template <class Tacc, class A, class B, class Out>
+void cpu_gemm_parallel(
+    std::size_t batch, std::size_t m, std::size_t n, std::size_t k, A a, B b, Out out)
+{
+    const std::size_t row_block = cpu_gemm_tile<Tacc>::mc;
+    const std::size_t col_block = 256;
+    const auto row_blocks       = (m + row_block - 1) / row_block;
+    const auto col_blocks       = (n + col_block - 1) / col_block;
+
+    miopen::par_for(batch * row_blocks * col_blocks, 1, [&](std::size_t task) {
+        const auto bt   = task / (row_blocks * col_blocks);
+        const auto i0   = task / col_blocks % row_blocks * row_block;
+        const auto j0   = task % col_blocks * col_block;
+        const auto rows = std::min(row_block, m - i0);
+        const auto cols = std::min(col_block, n - j0);
+
+        thread_local std::vector<Tacc> acc;
+        acc.assign(rows * cols, Tacc(0));
+        cpu_gemm_block(rows,
+                       cols,
+                       k,
+                       [&](std::size_t i, std::size_t kk) { return a(bt, i0 + i, kk); },
+                       [&](std::size_t kk, std::size_t j) { return b(bt, kk, j0 + j); },
+                       acc.data(),
+                       cols);
+
+        for(std::size_t i = 0; i < rows; ++i)
+            for(std::size_t j = 0; j < cols; ++j)
+                out(bt, i0 + i, j0 + j, acc[i * cols + j]);
+    });
+}
+
+/// The row-major BLAS gemm of the batch_count problems at the given distances from each other:
+/// c = alpha * op(a) * op(b) + beta * c, where op(a) is m x k, op(b) is k x n and op(x) is x^T
+/// when trans_x is set. The products are computed in Tacc, which defaults to double, and so are
+/// the scaling and the update of c.
+template <class Tacc = double, class TA, class TB, class TC>
+void cpu_gemm_strided_batched(bool trans_a,
+                              bool trans_b,
+                              std::size_t m,
+                              std::size_t n,
+                              std::size_t k,
+                              double alpha,
+                              const TA* a,
+                              std::size_t lda,
+                              std::size_t stride_a,
+                              const TB* b,
+                              std::size_t ldb,
+                              std::size_t stride_b,
+                              double beta,
+                              TC* c,
+                              std::size_t ldc,
+                              std::size_t stride_c,
+                              std::size_t batch_count)
+{
+    const auto a_row = trans_a ? 1 : lda;
+    const auto a_col = trans_a ? lda : 1;
+    const auto b_row = trans_b ? 1 : ldb;
+    const auto b_col = trans_b ? ldb : 1;
+
+    cpu_gemm_parallel<Tacc>(
+        batch_count,
+        m,
+        n,
+        k,
+        [&](std::size_t bt, std::size_t i, std::size_t kk) {
+            return a[bt * stride_a + i * a_row + kk * a_col];
+        },
+        [&](std::size_t bt, std::size_t kk, std::size_t j) {
+            return b[bt * stride_b + kk * b_row + j * b_col];
+        },
+        [&](std::size_t bt, std::size_t i, std::size_t j, Tacc x) {
+            auto& y = c[bt * stride_c + i * ldc + j];
+            y = static_cast<TC>(Tacc(beta) * static_cast<Tacc>(y) + Tacc(alpha) * x);
+        });
+}
+
+/// Same as cpu_gemm_strided_batched for the problems at the pointers of the arrays.
+template <class Tacc = double, class TA, class TB, class TC>
+void cpu_gemm_batched(bool trans_a,
+                      bool trans_b,
+                      std::size_t m,
+                      std::size_t n,
+                      std::size_t k,
+                      double alpha,
+                      const TA* const* a,
+                      std::size_t lda,
+                      const TB* const* b,
+                      std::size_t ldb,
+                      double beta,
+                      TC* const* c,
+                      std::size_t ldc,
+                      std::size_t batch_count)
+{
+    const auto a_row = trans_a ? 1 : lda;
+    const auto a_col = trans_a ? lda : 1;
+    const auto b_row = trans_b ? 1 : ldb;
+    const auto b_col = trans_b ? ldb : 1;
+
+    cpu_gemm_parallel<Tacc>(
+        batch_count,
+        m,
+        n,
+        k,
+        [&](std::size_t bt, std::size_t i, std::size_t kk) {
+            return a[bt][i * a_row + kk * a_col];
+        },
+        [&](std::size_t bt, std::size_t kk, std::size_t j) {
+            return b[bt][kk * b_row + j * b_col];
+        },
+        [&](std::size_t bt, std::size_t i, std::size_t j, Tacc x) {
+            auto& y = c[bt][i * ldc + j];
+            y = static_cast<TC>(Tacc(beta) * static_cast<Tacc>(y) + Tacc(alpha) * x);
+        });
+}
+
+/// The row-major BLAS gemm: c = alpha * op(a) * op(b) + beta * c, see cpu_gemm_strided_batched.
+template <class Tacc = double, class TA, class TB, class TC>
+void cpu_gemm(bool trans_a,
+              bool trans_b,
+              std::size_t m,
+              std::size_t n,
+              std::size_t k,
+              double alpha,
+              const TA* a,
+              std::size_t lda,
+              const TB* b,
+              std::size_t ldb,
+              double beta,
+              TC* c,
+              std::size_t ldc)
+{
+    cpu_gemm_strided_batched<Tacc>(
+        trans_a, trans_b, m, n, k, alpha, a, lda, 0, b, ldb, 0, beta, c, ldc, 0, 1);
+}
+
+#endif
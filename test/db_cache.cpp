@@ -0,0 +1,176 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_cache.hpp>
+
+#include "test.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using miopen::DbCache;
+using miopen::RcuMap;
+
+// Puts all the keys into the first shard.
+struct SameShardHash
+{
+    std::size_t operator()(int key) const
+    {
+        return static_cast<std::size_t>(key) * RcuMap<int, int>::shard_count;
+    }
+};
+
+template <class TMap>
+static int Get(const TMap& map, int key)
+{
+    auto ret = -1;
+    map.Visit(key, [&](int value) { return (ret = value), true; });
+    return ret;
+}
+
+void test_map()
+{
+    RcuMap<int, int, SameShardHash> map;
+
+    for(auto i = 0; i < 1000; ++i)
+        map.Insert(i, i * 2);
+    EXPECT_EQUAL(map.GetSize(), std::size_t{1000});
+    for(auto i = 0; i < 1000; ++i)
+        EXPECT_EQUAL(Get(map, i), i * 2);
+    EXPECT_EQUAL(Get(map, 1000), -1);
+
+    map.Insert(7, 1);
+    EXPECT_EQUAL(Get(map, 7), 1);
+    EXPECT_EQUAL(map.GetSize(), std::size_t{1000});
+
+    map.Clear();
+    EXPECT_EQUAL(map.GetSize(), std::size_t{0});
+    EXPECT_EQUAL(Get(map, 7), -1);
+    map.Insert(7, 2);
+    EXPECT_EQUAL(Get(map, 7), 2);
+}
+
+void test_eviction()
+{
+    RcuMap<int, int, SameShardHash> map{4};
+
+    // The key visited after each insert is never evicted, the rest go in turn.
+    for(auto i = 0; i < 1000; ++i)
+    {
+        map.Insert(i, i);
+        EXPECT_EQUAL(Get(map, 0), 0);
+        EXPECT(map.GetSize() <= 4);
+    }
+
+    EXPECT_EQUAL(map.GetSize(), std::size_t{4});
+    EXPECT_EQUAL(Get(map, 999), 999);
+    EXPECT_EQUAL(Get(map, 1), -1);
+}
+
+void test_concurrent()
+{
+    RcuMap<int, int> map{2};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+
+    for(auto t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&]() {
+            while(!done)
+            {
+                for(auto i = 0; i < 512; ++i)
+                {
+                    const auto value = Get(map, i);
+                    EXPECT(value == -1 || value / 2 == i);
+                }
+            }
+        });
+    }
+
+    // Both new keys and replaced values, with evictions due to the small capacity.
+    for(auto n = 0; n < 20; ++n)
+        for(auto i = 0; i < 512; ++i)
+            map.Insert(i, i * 2 + n % 2);
+
+    done = true;
+    for(auto& reader : readers)
+        reader.join();
+
+    EXPECT(map.GetSize() <= 2 * RcuMap<int, int>::shard_count);
+}
+
+void test_invalidation()
+{
+    auto* const first  = DbCache::GetCached("first.db", "test_db_cache/first.udb", true);
+    auto* const second = DbCache::GetCached("second.db", "test_db_cache/second.udb", true);
+    auto* const other  = DbCache::GetCached("other.db", "test_db_cache/first.udb", true);
+
+    if(first == nullptr)
+        return;
+
+    EXPECT(first != other);
+    EXPECT_EQUAL(first, DbCache::GetCached("first.db", "test_db_cache/first.udb", true));
+
+    auto fills = 0;
+    const auto find = [&](DbCache* cache) {
+        cache->Find("key", [&]() {
+            ++fills;
+            return boost::optional<miopen::DbRecord>{};
+        });
+    };
+
+    find(first);
+    find(second);
+    find(other);
+    EXPECT_EQUAL(fills, 3);
+
+    find(first);
+    find(second);
+    find(other);
+    EXPECT_EQUAL(fills, 3);
+
+    // Only the caches over the written user db are affected.
+    DbCache::Invalidate("test_db_cache/first.udb");
+    find(first);
+    find(second);
+    find(other);
+    EXPECT_EQUAL(fills, 5);
+
+    second->Invalidate();
+    find(first);
+    find(second);
+    EXPECT_EQUAL(fills, 6);
+}
+
+int main()
+{
+    test_map();
+    test_eviction();
+    test_concurrent();
+    test_invalidation();
+}
@@ -0,0 +1,292 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_merge.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/temp_file.hpp>
+#include <miopen/tuning_checkpoint.hpp>
+
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using miopen::solver::TuningCheckpoint;
+
+struct Space
+{
+    int size;
+};
+
+// Configs 0..size-1 of which every third is invalid.
+struct Config
+{
+    int value = 0;
+
+    Config(bool = false) {}
+    bool SetNextValue(const Space& space) { return ++value < space.size; }
+    bool IsValid(const Space&) const { return value % 3 != 2; }
+    bool operator==(const Config& other) const { return value == other.value; }
+};
+
+std::vector<int> Enumerate(const miopen::solver::ComputedContainer<Config, Space>& container)
+{
+    std::vector<int> values;
+    for(const auto& config : container)
+        values.push_back(config.value);
+    return values;
+}
+
+void test_shards()
+{
+    const miopen::solver::ComputedContainer<Config, Space> all{Space{100}};
+    const auto all_values = Enumerate(all);
+    EXPECT_EQUAL(all_values.size(), std::size_t{67});
+
+    for(const auto count : {1, 2, 3, 7, 67, 80})
+    {
+        std::vector<int> merged;
+        for(auto index = 0; index < count; ++index)
+        {
+            const auto shard = Enumerate(all.Shard(index, count));
+            for(std::size_t i = 0; i < shard.size(); ++i)
+                EXPECT_EQUAL(shard[i], all_values[index + i * count]);
+            merged.insert(merged.end(), shard.begin(), shard.end());
+        }
+        std::sort(merged.begin(), merged.end());
+        EXPECT(merged == all_values);
+    }
+
+    // Shards of a shard are shards of the whole.
+    EXPECT(Enumerate(all.Shard(1, 2).Shard(2, 3)) == Enumerate(all.Shard(5, 6)));
+}
+
+std::string Checkpoint(std::size_t next, std::size_t total, float best_time, std::string config)
+{
+    TuningCheckpoint checkpoint;
+    checkpoint.next        = next;
+    checkpoint.total       = total;
+    checkpoint.best_time   = best_time;
+    checkpoint.best_config = std::move(config);
+    std::ostringstream ss;
+    checkpoint.Serialize(ss);
+    return ss.str();
+}
+
+std::string Merge(miopen::DbKind kind, const std::vector<std::string>& dbs)
+{
+    std::vector<miopen::TempFile> files;
+    miopen::DbMerger merger{kind};
+    for(const auto& db : dbs)
+    {
+        files.emplace_back("miopen-test-db-merge");
+        std::ofstream{files.back().Path()} << db;
+        merger.Add(files.back().Path());
+    }
+
+    const miopen::TempFile out{"miopen-test-db-merge"};
+    merger.Write(out.Path());
+    std::ifstream file{out.Path()};
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+bool HasValue(const std::string& db, const std::string& line_start, const std::string& value)
+{
+    std::istringstream ss{db};
+    std::string line;
+    while(std::getline(ss, line))
+        if(line.compare(0, line_start.size(), line_start) == 0)
+            return line.find(value) != std::string::npos;
+    return false;
+}
+
+void test_perf_db()
+{
+    const auto id0 = TuningCheckpoint::GetDbId("Solver", 0, 2);
+    const auto id1 = TuningCheckpoint::GetDbId("Solver", 1, 2);
+
+    // Shard 1 has found the faster config of problem 1, shard 0 of problem 2.
+    const auto shard0 = "1-1=Solver:10,10;" + id0 + ':' + Checkpoint(5, 5, 2.0f, "10,10") +
+                        "\n"
+                        "2-2=Solver:20,20;" +
+                        id0 + ':' + Checkpoint(5, 5, 1.0f, "20,20") +
+                        "\n"
+                        "3-3=Other:1\n";
+    const auto shard1 = "1-1=Solver:11,11;" + id1 + ':' + Checkpoint(4, 4, 1.5f, "11,11") +
+                        "\n"
+                        "2-2=Solver:21,21;" +
+                        id1 + ':' + Checkpoint(4, 4, 3.0f, "21,21") +
+                        "\n"
+                        "3-3=Other:2\n"
+                        "4-4=Solver:40\n";
+
+    const auto merged = Merge(miopen::DbKind::Perf, {shard0, shard1});
+    EXPECT(HasValue(merged, "1-1=", "Solver:11,11"));
+    EXPECT(HasValue(merged, "2-2=", "Solver:20,20"));
+    EXPECT(HasValue(merged, "1-1=", id0) && HasValue(merged, "1-1=", id1));
+    // Without the times the first db wins.
+    EXPECT(HasValue(merged, "3-3=", "Other:1"));
+    EXPECT(HasValue(merged, "4-4=", "Solver:40"));
+
+    // The times of unfinished searches are not taken, the config is not the best of the shard.
+    const auto unfinished = "1-1=Solver:12,12;" + id1 + ':' + Checkpoint(2, 4, 0.5f, "12,12");
+    EXPECT(HasValue(Merge(miopen::DbKind::Perf, {shard0, unfinished}), "1-1=", "Solver:10,10"));
+
+    // The order of the dbs does not matter when the times are known.
+    const auto reversed = Merge(miopen::DbKind::Perf, {shard1, shard0});
+    EXPECT(HasValue(reversed, "1-1=", "Solver:11,11"));
+    EXPECT(HasValue(reversed, "2-2=", "Solver:20,20"));
+}
+
+void test_find_db()
+{
+    const auto data = [](const std::string& solver, float time) {
+        std::ostringstream ss;
+        miopen::FindDbData{solver, time, 0, miopen::FindDbKCacheKey::MakeUnused("Direct")}
+            .Serialize(ss);
+        return ss.str();
+    };
+
+    const auto db0 = "1-1=Direct:" + data("A", 2.0f) + ";GEMM:" + data("B", 1.0f) + '\n';
+    const auto db1 = "1-1=Direct:" + data("C", 1.0f) + ";GEMM:" + data("D", 3.0f) + '\n';
+
+    const auto merged = Merge(miopen::DbKind::Find, {db0, db1});
+    EXPECT(HasValue(merged, "1-1=", "Direct:" + data("C", 1.0f)));
+    EXPECT(HasValue(merged, "1-1=", "GEMM:" + data("B", 1.0f)));
+
+    EXPECT(miopen::DbMerger::GetKind("gfx90a.ufdb.txt") == miopen::DbKind::Find);
+    EXPECT(miopen::DbMerger::GetKind("gfx90a_68.fdb.txt") == miopen::DbKind::Find);
+    EXPECT(miopen::DbMerger::GetKind("gfx90a.cd.updb.txt") == miopen::DbKind::Perf);
+    EXPECT(miopen::DbMerger::GetKind("gfx90a_2.udb") == miopen::DbKind::Perf);
+}
+
+#if MIOPEN_ENABLE_SQLITE
+struct ProblemData : miopen::SQLiteSerializable<ProblemData>
+{
+    miopen::ProblemDescription prob;
+
+    ProblemData(int i) : prob(miopen::conv::Direction::Forward)
+    {
+        prob.n_inputs          = i;
+        prob.in_height         = i;
+        prob.in_width          = i;
+        prob.kernel_size_h     = i;
+        prob.kernel_size_w     = i;
+        prob.n_outputs         = i;
+        prob.batch_sz          = i;
+        prob.pad_h             = i;
+        prob.pad_w             = i;
+        prob.kernel_stride_h   = i;
+        prob.kernel_stride_w   = i;
+        prob.kernel_dilation_h = i;
+        prob.kernel_dilation_w = i;
+        prob.bias              = i;
+        prob.in_layout         = "NCHW";
+        prob.in_data_type      = miopenFloat;
+        prob.weights_data_type = miopenFloat;
+        prob.out_data_type     = miopenFloat;
+        prob.group_counts      = 1;
+    }
+
+    static std::string table_name() { return "config"; }
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        miopen::ProblemDescription::Visit(self.prob, f);
+    }
+};
+
+struct Value
+{
+    std::string value;
+
+    void Serialize(std::ostream& stream) const { stream << value; }
+    bool Deserialize(const std::string& s)
+    {
+        value = s;
+        return true;
+    }
+};
+
+void test_sqlite_perf_db()
+{
+    const auto id0 = TuningCheckpoint::GetDbId("Solver", 0, 2);
+    const auto id1 = TuningCheckpoint::GetDbId("Solver", 1, 2);
+    const miopen::TempFile file0{"miopen-test-db-merge"};
+    const miopen::TempFile file1{"miopen-test-db-merge"};
+    const miopen::TempFile out{"miopen-test-db-merge"};
+    {
+        miopen::SQLitePerfDb db0{file0.Path(), false};
+        EXPECT(db0.Update(ProblemData{1}, "Solver", Value{"10,10"}));
+        EXPECT(db0.Update(ProblemData{1}, id0, Value{Checkpoint(5, 5, 2.0f, "10,10")}));
+        EXPECT(db0.Update(ProblemData{2}, "Solver", Value{"20,20"}));
+        miopen::SQLitePerfDb db1{file1.Path(), false};
+        EXPECT(db1.Update(ProblemData{1}, "Solver", Value{"11,11"}));
+        EXPECT(db1.Update(ProblemData{1}, id1, Value{Checkpoint(4, 4, 1.0f, "11,11")}));
+        EXPECT(db1.Update(ProblemData{3}, "Solver", Value{"30,30"}));
+    }
+
+    miopen::DbMerger merger{miopen::DbKind::Perf};
+    merger.Add(file0.Path());
+    merger.Add(file1.Path());
+    merger.Write(out.Path());
+    EXPECT_EQUAL(merger.GetRecordCount(), std::size_t{3});
+    EXPECT_EQUAL(merger.GetReplacedCount(), std::size_t{1});
+
+    miopen::SQLitePerfDb db{out.Path(), false};
+    Value value;
+    EXPECT(db.Load(ProblemData{1}, "Solver", value) && value.value == "11,11");
+    EXPECT(db.Load(ProblemData{1}, id0, value));
+    EXPECT(db.Load(ProblemData{2}, "Solver", value) && value.value == "20,20");
+    EXPECT(db.Load(ProblemData{3}, "Solver", value) && value.value == "30,30");
+
+    // Text and SQLite dbs are not merged together.
+    const miopen::TempFile text{"miopen-test-db-merge"};
+    std::ofstream{text.Path()} << "1-1=Solver:1\n";
+    EXPECT(throws([&]() { merger.Add(text.Path()); }));
+}
+#endif
+
+int main()
+{
+    test_shards();
+    test_perf_db();
+    test_find_db();
+#if MIOPEN_ENABLE_SQLITE
+    test_sqlite_perf_db();
+#endif
+}
@@ -55,6 +55,8 @@ constexpr std::is_same<T, U> is_same(const T&)
 
 struct tensor_elem_gen_integer
 {
+    using index_generator = void;
+
     unsigned long max_value = 17;
 
     template <class... Ts>
@@ -72,6 +74,8 @@ struct tensor_elem_gen_integer
 
 struct tensor_elem_gen_checkboard_sign
 {
+    using index_generator = void;
+
     template <class... Ts>
     double operator()(Ts... Xs) const
     {
@@ -657,34 +661,44 @@ struct test_driver
                     }
                 }
 
-                auto mxdiff = miopen::max_diff(out_cpu, out_gpu);
-                std::cout << "Max diff: " << mxdiff << std::endl;
-                //            auto max_idx = miopen::mismatch_diff(out_cpu, out_gpu, mxdiff);
-                //            std::cout << "Max diff at " << max_idx << ": " << out_cpu[max_idx] <<
-                //            " !=
-                //            " << out_gpu[max_idx] << std::endl;
+                const auto errors = miopen::range_errors(out_cpu, out_gpu);
+                std::cout << "Max diff: " << errors.max_abs_diff
+                          << ", max relative diff: " << errors.max_rel_diff << std::endl;
 
-                if(miopen::range_zero(out_cpu))
+                if(errors.ref_zero())
                     std::cout << "Cpu data is all zeros" << std::endl;
-                if(miopen::range_zero(out_gpu))
+                if(errors.zero())
                     std::cout << "Gpu data is all zeros" << std::endl;
 
-                auto idx = miopen::mismatch_idx(out_cpu, out_gpu, miopen::float_equal);
+                auto idx = errors.mismatch;
                 if(idx < miopen::range_distance(out_cpu))
                 {
                     std::cout << "Mismatch at " << idx << ": " << out_cpu[idx]
                               << " != " << out_gpu[idx] << std::endl;
                 }
 
-                auto cpu_nan_idx = find_idx(out_cpu, miopen::not_finite);
+                auto cpu_nan_idx = errors.ref_not_finite;
                 if(cpu_nan_idx >= 0)
                     std::cout << "Non finite number found in cpu at " << cpu_nan_idx << ": "
-                              << out_cpu[cpu_nan_idx] << std::endl;
+                              << out_cpu[cpu_nan_idx] << " (" << errors.ref_nans << " NaNs, "
+                              << errors.ref_infs << " infinities)" << std::endl;
 
-                auto gpu_nan_idx = find_idx(out_gpu, miopen::not_finite);
+                auto gpu_nan_idx = errors.not_finite;
                 if(gpu_nan_idx >= 0)
                     std::cout << "Non finite number found in gpu at " << gpu_nan_idx << ": "
-                              << out_gpu[gpu_nan_idx] << std::endl;
+                              << out_gpu[gpu_nan_idx] << " (" << errors.nans << " NaNs, "
+                              << errors.infs << " infinities)" << std::endl;
+
+                std::cout << "Relative errors: " << errors.histogram[0] << " equal";
+                for(std::size_t i = 1; i < errors.histogram.size(); i++)
+                {
+                    if(errors.histogram[i] == 0)
+                        continue;
+                    std::cout << ", " << errors.histogram[i]
+                              << (i + 1 < errors.histogram.size() ? " below 1e" : " from 1e")
+                              << static_cast<int>(std::min<std::size_t>(i, 8)) - 8;
+                }
+                std::cout << std::endl;
             }
             else if(miopen::range_zero(out_cpu) and miopen::range_zero(out_gpu))
             {
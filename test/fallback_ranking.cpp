@@ -0,0 +1,206 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/fallback_ranking.hpp>
+#include <miopen/temp_file.hpp>
+
+#include "test.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using miopen::FallbackRanking;
+using miopen::FallbackRecord;
+using miopen::ProblemFeatures;
+
+std::string DbKey(const miopen::conv::ProblemDescription& problem)
+{
+    std::ostringstream ss;
+    problem.Serialize(ss);
+    return ss.str();
+}
+
+void test_features()
+{
+    using miopen::ConvolutionDescriptor;
+    using miopen::TensorDescriptor;
+    namespace conv = miopen::conv;
+
+    const auto in       = TensorDescriptor{miopenFloat, {8, 16, 14, 14}};
+    const auto wei      = TensorDescriptor{miopenFloat, {32, 16, 3, 3}};
+    const auto out      = TensorDescriptor{miopenFloat, {8, 32, 7, 7}};
+    const auto grouped  = TensorDescriptor{miopenHalf, {32, 4, 3, 3}};
+    const auto in_3d    = TensorDescriptor{miopenFloat, {2, 4, 6, 14, 14}};
+    const auto wei_3d   = TensorDescriptor{miopenFloat, {8, 4, 3, 3, 3}};
+    const auto out_3d   = TensorDescriptor{miopenFloat, {2, 8, 4, 7, 7}};
+    const auto strided  = ConvolutionDescriptor{{1, 1}, {2, 2}, {1, 1}};
+    const auto groups   = ConvolutionDescriptor{{1, 1}, {2, 2}, {1, 1}, {0, 0}, 4};
+    const auto conv_3d  = ConvolutionDescriptor{
+        3, miopenConvolution, miopenPaddingDefault, {0, 1, 1}, {1, 2, 2}, {1, 1, 1}, {0, 0, 0}};
+
+    const std::vector<conv::ProblemDescription> problems = {
+        {in, wei, out, strided, conv::Direction::Forward},
+        {out, wei, in, strided, conv::Direction::BackwardData},
+        {in, wei, out, strided, conv::Direction::BackwardWeights},
+        {TensorDescriptor{miopenHalf, {8, 16, 14, 14}},
+         grouped,
+         TensorDescriptor{miopenHalf, {8, 32, 7, 7}},
+         groups,
+         conv::Direction::Forward},
+        {in_3d, wei_3d, out_3d, conv_3d, conv::Direction::Forward},
+    };
+
+    for(const auto& problem : problems)
+    {
+        const auto key = DbKey(problem);
+        auto parsed    = ProblemFeatures{};
+        EXPECT(ProblemFeatures::Parse(key, parsed));
+        const auto features = ProblemFeatures{problem};
+        for(auto i = std::size_t{0}; i < ProblemFeatures::count; ++i)
+            EXPECT_EQUAL(features.values[i], parsed.values[i]);
+    }
+
+    auto features = ProblemFeatures{};
+    EXPECT(!ProblemFeatures::Parse("", features));
+    EXPECT(!ProblemFeatures::Parse("16-14-14-3x3-32-7-7-8", features));
+    EXPECT(!ProblemFeatures::Parse("16-14-14-3x3-32-7-7-8-1x1-2x2-1x1-0-NCHW-FP32-X", features));
+    EXPECT(!ProblemFeatures::Parse("16-14-14-3x3-32-7-7-8-1x1-2x2-1x1-0-NCHW-FP32-F_x", features));
+    EXPECT(!ProblemFeatures::Parse("a-14-14-3x3-32-7-7-8-1x1-2x2-1x1-0-NCHW-FP32-F", features));
+}
+
+// Solver A is faster on the small problems, solver B on the large ones.
+std::vector<FallbackRecord> MakeRecords()
+{
+    std::vector<FallbackRecord> records;
+    for(const auto c : {16, 32, 64, 128, 256, 512})
+    {
+        for(const auto hw : {7, 14, 28, 56})
+        {
+            for(const auto n : {1, 4, 16, 64})
+            {
+                auto record = FallbackRecord{};
+                record.key  = std::to_string(c) + "-" + std::to_string(hw) + "-" +
+                             std::to_string(hw) + "-3x3-" + std::to_string(c) + "-" +
+                             std::to_string(hw) + "-" + std::to_string(hw) + "-" +
+                             std::to_string(n) + "-1x1-1x1-1x1-0-NCHW-FP32-F";
+                EXPECT(ProblemFeatures::Parse(record.key, record.features));
+                const auto work = static_cast<float>(c) * c * hw * hw * n;
+                record.times    = {{"A", 0.01f + work * 2e-8f}, {"B", 0.2f + work * 2e-9f}};
+                records.push_back(record);
+            }
+        }
+    }
+    return records;
+}
+
+void test_ranking()
+{
+    const auto records = MakeRecords();
+    std::vector<FallbackRecord> training, held_out;
+    for(auto i = std::size_t{0}; i < records.size(); ++i)
+        (i % 5 == 2 ? held_out : training).push_back(records[i]);
+
+    auto options               = miopen::FallbackTrainingOptions{};
+    options.min_solver_records = 8;
+    const auto ranking         = FallbackRanking::Train(training, options);
+    EXPECT_EQUAL(ranking.GetSolverCount(), std::size_t{2});
+    EXPECT(!ranking.Estimate("C", records[0].features));
+
+    const auto report = ranking.Evaluate(held_out);
+    std::cout << "Held out: " << report << std::endl;
+    EXPECT_EQUAL(report.records, held_out.size());
+    EXPECT(report.top1 * 10 >= report.records * 9);
+    EXPECT(report.mean_slowdown < 1.1f);
+    EXPECT(report.rms_log2_error < 0.5f);
+
+    // Not enough records of any solver.
+    options.min_solver_records = training.size() + 1;
+    EXPECT(FallbackRanking::Train(training, options).IsEmpty());
+
+    std::stringstream stream;
+    ranking.Write(stream);
+    const auto read = FallbackRanking::Read(stream);
+    EXPECT_EQUAL(read.GetSolverCount(), ranking.GetSolverCount());
+    for(const auto& record : records)
+        for(const auto* solver : {"A", "B"})
+            EXPECT_EQUAL(*read.Estimate(solver, record.features),
+                         *ranking.Estimate(solver, record.features));
+
+    const auto throws = [](const std::string& model) {
+        std::istringstream malformed{model};
+        try
+        {
+            FallbackRanking::Read(malformed);
+        }
+        catch(const miopen::Exception&)
+        {
+            return true;
+        }
+        return false;
+    };
+    EXPECT(!throws("MIOpenFallbackRanking 1 25\nsolver A 1 1\ntree 1\n-1 0 -1 -1 0.5\n"));
+    EXPECT(throws("MIOpenFallbackRanking 2 25\n"));
+    EXPECT(throws("MIOpenFallbackRanking 1 24\n"));
+    EXPECT(throws("MIOpenFallbackRanking 1 25\nsolver A 1 1\ntree 1\n"));
+    EXPECT(throws("MIOpenFallbackRanking 1 25\nsolver A 1 1\ntree 1\n0 0 0 0 0\n"));
+    EXPECT(throws("MIOpenFallbackRanking 1 25\nsolver A 1 1\ntree 3\n25 0 1 2 0\n"));
+    EXPECT(throws("MIOpenFallbackRanking 1 25\nsolver A 1 -1\ntree 1\n-1 0 -1 -1 0.5\n"));
+    EXPECT(throws("MIOpenFallbackRanking 1 25\nsolver A 1 1000000\ntree 1\n-1 0 -1 -1 0.5\n"));
+    EXPECT(throws("MIOpenFallbackRanking 1 25\nsolver A 1 1\ntree -1\n-1 0 -1 -1 0.5\n"));
+    EXPECT(throws("MIOpenFallbackRanking 1 25\nsolver A 1 1\ntree 1000000\n-1 0 -1 -1 0.5\n"));
+}
+
+void test_read_records()
+{
+    const miopen::TempFile file{"miopen.test.fallback_ranking"};
+    {
+        std::ofstream db{file.Path()};
+        db << "16-14-14-3x3-32-14-14-8-1x1-1x1-1x1-0-NCHW-FP32-F="
+              "miopenConvolutionFwdAlgoGEMM:GemmFwd1x1_0_1,0.5,64,rocBlas,<unused>;"
+              "miopenConvolutionFwdAlgoWinograd:ConvBinWinogradRxSf2x3,0.25,0,"
+              "miopenConvolutionFwdAlgoWinograd,<unused>\n"
+           << "unsupported=miopenConvolutionFwdAlgoGEMM:GemmFwd1x1_0_1,0.5,64,rocBlas,<unused>\n"
+           << "16-14-14-3x3-32-14-14-8-1x1-1x1-1x1-0-NCHW-FP32-B="
+              "miopenConvolutionBwdDataAlgoGEMM:GemmBwd1x1_stride1,-1,64,rocBlas,<unused>\n";
+    }
+
+    const auto records = miopen::ReadFallbackRecords(file.Path());
+    EXPECT_EQUAL(records.size(), std::size_t{1});
+    EXPECT_EQUAL(records[0].times.size(), std::size_t{2});
+    EXPECT_EQUAL(records[0].times[1].first, "ConvBinWinogradRxSf2x3");
+    EXPECT_EQUAL(records[0].times[1].second, 0.25f);
+}
+
+int main()
+{
+    test_features();
+    test_ranking();
+    test_read_records();
+}
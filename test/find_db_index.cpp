@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_record.hpp>
+#include <miopen/find_db_index.hpp>
+
+#include "test.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+using miopen::FindDbIndex;
+using miopen::ProblemFeatures;
+
+std::string Key(int n, int hw, const std::string& filter = "3x3")
+{
+    return "64-" + std::to_string(hw) + "-" + std::to_string(hw) + "-" + filter + "-128-" +
+           std::to_string(hw) + "-" + std::to_string(hw) + "-" + std::to_string(n) +
+           "-1x1-1x1-1x1-0-NCHW-FP32-F";
+}
+
+struct DbKey
+{
+    std::string key;
+
+    void Serialize(std::ostream& stream) const { stream << key; }
+};
+
+miopen::DbRecord Record(const std::string& key, const std::string& solver, float time)
+{
+    auto record = miopen::DbRecord{DbKey{key}};
+    record.SetValues(
+        "miopenConvolutionFwdAlgoDirect",
+        miopen::FindDbData{solver,
+                           time,
+                           0,
+                           miopen::FindDbKCacheKey::MakeUnused("miopenConvolutionFwdAlgoDirect")});
+    return record;
+}
+
+ProblemFeatures Features(const std::string& key)
+{
+    auto features = ProblemFeatures{};
+    EXPECT(ProblemFeatures::Parse(key, features));
+    return features;
+}
+
+int main()
+{
+    auto index = FindDbIndex{};
+    EXPECT(index.IsEmpty());
+    EXPECT(index.Query(Features(Key(16, 28)), 3).empty());
+
+    EXPECT(index.Add(Record(Key(8, 28), "A", 1.0f)));
+    EXPECT(index.Add(Record(Key(64, 28), "B", 8.0f)));
+    EXPECT(index.Add(Record(Key(16, 112), "C", 8.0f)));
+    EXPECT(index.Add(Record(Key(16, 28, "1x1"), "D", 0.5f)));
+    EXPECT(!index.Add(Record("unsupported", "E", 1.0f)));
+    EXPECT_EQUAL(index.GetSize(), std::size_t{4});
+
+    // The problem of the other filter size is not similar.
+    const auto neighbours = index.Query(Features(Key(16, 28)), 5);
+    EXPECT_EQUAL(neighbours.size(), std::size_t{3});
+    EXPECT_EQUAL(neighbours[0].entry->key, Key(8, 28));
+    EXPECT_EQUAL(neighbours[0].distance, 1.0f);
+    EXPECT_EQUAL(neighbours[1].entry->key, Key(64, 28));
+    EXPECT_EQUAL(neighbours[1].distance, 2.0f);
+    EXPECT_EQUAL(neighbours[2].entry->key, Key(16, 112));
+    EXPECT_EQUAL(neighbours[2].distance, 4.0f);
+    EXPECT_EQUAL(neighbours[0].entry->values.size(), std::size_t{1});
+    EXPECT_EQUAL(neighbours[0].entry->values[0].first, "miopenConvolutionFwdAlgoDirect");
+    EXPECT_EQUAL(neighbours[0].entry->values[0].second.solver_id, "A");
+
+    // Twice the batch, twice the flops.
+    const auto& nearest_features = neighbours[0].entry->features;
+    EXPECT_EQUAL(Features(Key(16, 28)).GetLog2Flops() - nearest_features.GetLog2Flops(), 1.0f);
+
+    const auto nearest = index.Query(Features(Key(16, 28)), 1);
+    EXPECT_EQUAL(nearest.size(), std::size_t{1});
+    EXPECT_EQUAL(nearest[0].entry->key, Key(8, 28));
+    EXPECT(index.Query(Features(Key(16, 28)), 0).empty());
+    EXPECT(index.Query(Features(Key(16, 28, "5x5")), 3).empty());
+}
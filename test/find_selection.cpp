@@ -0,0 +1,123 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_options.hpp>
+#include "test.hpp"
+
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <vector>
+
+using miopen::FindOptions;
+using miopen::SolutionCost;
+using Indices = std::vector<std::size_t>;
+
+// The fastest needs the most workspace. 3 is dominated by 1, 4 by 2.
+const std::vector<SolutionCost>& GetCandidates()
+{
+    static const std::vector<SolutionCost> candidates = {
+        {1.0f, 4096}, {1.04f, 1024}, {1.5f, 0}, {1.2f, 2048}, {2.0f, 0}};
+    return candidates;
+}
+
+void test_all()
+{
+    FindOptions options;
+    EXPECT(options.Select(GetCandidates()) == Indices{0, 1, 3, 2, 4});
+
+    options.results_order = miopenFindResultsOrderByWorkspaceSize;
+    EXPECT(options.Select(GetCandidates()) == Indices{2, 4, 1, 3, 0});
+
+    // The best time under 2 KiB.
+    options.results_order   = miopenFindResultsOrderByTime;
+    options.workspace_limit = 2048;
+    EXPECT(options.Select(GetCandidates()) == Indices{1, 3, 2, 4});
+}
+
+void test_pareto_front()
+{
+    FindOptions options;
+    options.selection_policy = miopenFindSelectionParetoFront;
+    EXPECT(options.Select(GetCandidates()) == Indices{0, 1, 2});
+
+    options.results_order = miopenFindResultsOrderByWorkspaceSize;
+    EXPECT(options.Select(GetCandidates()) == Indices{2, 1, 0});
+
+    options.workspace_limit = 0;
+    EXPECT(options.Select(GetCandidates()) == Indices{2});
+    EXPECT(options.Select({}).empty());
+}
+
+void test_time_tolerance()
+{
+    FindOptions options;
+    options.selection_policy = miopenFindSelectionMinWorkspaceWithinTimeTolerance;
+    EXPECT(options.Select(GetCandidates()) == Indices{1, 0});
+
+    options.time_tolerance = 0.0f;
+    EXPECT(options.Select(GetCandidates()) == Indices{0});
+
+    options.time_tolerance = 0.5f;
+    EXPECT(options.Select(GetCandidates()) == Indices{2, 1, 3, 0});
+
+    // Within the tolerance of the fastest solution fitting the workspace limit.
+    options.time_tolerance  = 0.05f;
+    options.workspace_limit = 2048;
+    EXPECT(options.Select(GetCandidates()) == Indices{1});
+}
+
+void test_api()
+{
+    std::vector<miopenConvSolution_t> solutions;
+    for(const auto& candidate : GetCandidates())
+        solutions.push_back({candidate.time, candidate.workspace, solutions.size(), {}});
+
+    miopenFindOptions_t options;
+    EXPECT_EQUAL(miopenCreateFindOptions(&options), miopenStatusSuccess);
+    EXPECT_EQUAL(miopenSetFindOptionSelectionPolicy(options, miopenFindSelectionParetoFront),
+                 miopenStatusSuccess);
+    EXPECT_EQUAL(miopenSetFindOptionTimeTolerance(options, -1.0f), miopenStatusBadParm);
+
+    auto count = solutions.size();
+    EXPECT_EQUAL(miopenSelectConvSolutions(options, solutions.data(), &count),
+                 miopenStatusSuccess);
+    EXPECT_EQUAL(count, std::size_t{3});
+    EXPECT_EQUAL(solutions[0].solution_id, 0u);
+    EXPECT_EQUAL(solutions[1].solution_id, 1u);
+    EXPECT_EQUAL(solutions[2].solution_id, 2u);
+    EXPECT_EQUAL(miopenSelectConvSolutions(options, solutions.data(), nullptr),
+                 miopenStatusBadParm);
+    EXPECT_EQUAL(miopenDestroyFindOptions(options), miopenStatusSuccess);
+}
+
+int main()
+{
+    test_all();
+    test_pareto_front();
+    test_time_tolerance();
+    test_api();
+}
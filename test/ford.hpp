@@ -63,41 +63,6 @@ auto then(std::future<T> f, Work w) -> std::future<decltype(w(f.get()))>
                       [=, f = std::move(f)]() mutable { return w(f.get()); });
 }
 
-struct joinable_thread : std::thread
-{
-    template <class... Xs>
-    joinable_thread(Xs&&... xs) : std::thread(std::forward<Xs>(xs)...) // NOLINT
-    {
-    }
-
-    joinable_thread& operator=(joinable_thread&& other) = default;
-    joinable_thread(joinable_thread&& other)            = default;
-
-    ~joinable_thread()
-    {
-        if(this->joinable())
-            this->join();
-    }
-};
-
-struct thread_factory
-{
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
-    {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
-            {
-                f(i);
-            }
-        });
-        work += grainsize;
-        return result;
-    }
-};
-
 using miopen::par_for; // NOLINT
 
 template <class T>
@@ -131,25 +96,38 @@ static constexpr ford_wrapper<ford_impl> ford{};
 
 struct par_ford_impl
 {
+    // The threads take chunks of consecutive indices. The multi-index of the first one of a chunk
+    // is computed, the rest are incremented from it.
     template <class F, class... Ts>
     void operator()(F f, Ts... xs) const
     {
         using array_type = std::array<std::size_t, sizeof...(Ts)>;
         array_type lens  = {{static_cast<std::size_t>(xs)...}};
-        array_type strides;
-        strides.fill(1);
-        std::partial_sum(
-            lens.rbegin(), lens.rend() - 1, strides.rbegin() + 1, std::multiplies<std::size_t>());
-        auto size = std::accumulate(
+        auto size        = std::accumulate(
             lens.begin(), lens.end(), static_cast<std::size_t>(1), std::multiplies<std::size_t>());
-        par_for(size, [&](std::size_t i) {
+        const auto threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        const auto chunk   = std::max<std::size_t>(size / (8 * threads), 8);
+        const auto chunks  = (size + chunk - 1) / chunk;
+        par_for(chunks, 1, [&](std::size_t c) {
+            const auto first = c * chunk;
+            const auto last  = std::min(size, first + chunk);
             array_type indices;
-            std::transform(strides.begin(),
-                           strides.end(),
-                           lens.begin(),
-                           indices.begin(),
-                           [&](size_t stride, size_t len) { return (i / stride) % len; });
-            miopen::unpack(f, indices);
+            auto rest = first;
+            for(auto d = lens.size(); d-- > 0;)
+            {
+                indices[d] = rest % lens[d];
+                rest /= lens[d];
+            }
+            for(auto i = first; i < last; i++)
+            {
+                miopen::unpack(f, indices);
+                for(auto d = lens.size(); d-- > 0;)
+                {
+                    if(++indices[d] < lens[d])
+                        break;
+                    indices[d] = 0;
+                }
+            }
         });
     }
 };
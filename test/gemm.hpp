@@ -26,25 +26,23 @@
 #ifndef GUARD_GEMM_HPP
 #define GUARD_GEMM_HPP
 
+#include "cpu_gemm.hpp"
 #include "ford.hpp"
 #include <miopen/returns.hpp>
 
+/// c(i, j, x) with the sum x of a(i, kk) * b(kk, j) over kk, for every element of the n x m
+/// product, computed with the packed gemm of cpu_gemm.hpp on the shared pool.
 template <class AF, class BF, class CF>
 void gemm(std::size_t n, std::size_t m, std::size_t k, AF a, BF b, CF c)
 {
-    auto inner_loop = [&](int i, int j) {
-        double x = 0.0;
-        ford(k)([&](int kk) { x += a(i, kk) * b(kk, j); });
-        c(i, j, x);
-    };
-    if(n * m > 32)
-    {
-        par_ford(n, m)(inner_loop);
-    }
-    else
-    {
-        ford(n, m)(inner_loop);
-    }
+    cpu_gemm_parallel<double>(
+        1,
+        n,
+        m,
+        k,
+        [&](std::size_t, std::size_t i, std::size_t kk) { return a(i, kk); },
+        [&](std::size_t, std::size_t kk, std::size_t j) { return b(kk, j); },
+        [&](std::size_t, std::size_t i, std::size_t j, double x) { c(i, j, x); });
 }
 
 struct with_stride_impl
@@ -29,6 +29,7 @@
 #define WORKAROUND_SWDEV_257056_PCH_MISSING_MACROS 1
 
 #include <miopen/config.h>
+#include <miopen/compile_service.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/execution_context.hpp>
 
@@ -233,6 +234,71 @@ void test_warnings(kernel_type_t kern_type)
 #endif
 }
 
+void test_kernel_cache_limits()
+{
+    // Own handle, not to affect the kernels cached by the shared one.
+    miopen::Handle h;
+    h.SetKernelCacheLimits(0, 2);
+
+    const auto add = [&](int i) {
+        const auto src = Write2s(miopenOpenCLKernelType) + "// " + std::to_string(i) + "\n";
+        h.AddKernel("GEMM", std::to_string(i), src, "write", {1, 1, 1}, {1, 1, 1}, "");
+    };
+
+    add(0);
+    add(1);
+    h.GetKernels("GEMM", "0"); // 1 becomes the least recently used
+    add(2);
+
+    auto stats = h.GetKernelCacheStats();
+    EXPECT_EQUAL(stats.programs, std::size_t{2});
+    EXPECT_EQUAL(stats.kernels, std::size_t{2});
+    EXPECT_EQUAL(stats.evictions, std::size_t{1});
+    EXPECT_EQUAL(stats.hits, std::size_t{1});
+    EXPECT_EQUAL(stats.misses, std::size_t{3});
+    EXPECT(h.HasKernel("GEMM", "0"));
+    EXPECT(!h.HasKernel("GEMM", "1"));
+    EXPECT(h.HasKernel("GEMM", "2"));
+
+    h.SetKernelCacheLimits(0, 1);
+    stats = h.GetKernelCacheStats();
+    EXPECT_EQUAL(stats.programs, std::size_t{1});
+    EXPECT_EQUAL(stats.evictions, std::size_t{2});
+    EXPECT(!h.HasKernel("GEMM", "0"));
+    EXPECT(h.HasKernel("GEMM", "2"));
+}
+
+void test_compile_service()
+{
+    auto&& h       = get_handle();
+    const auto src = Write2s(miopenOpenCLKernelType) + "// compile service\n";
+    const auto bad = WriteError(miopenOpenCLKernelType) + "// compile service\n";
+
+    const auto load = [&](const std::string& program) {
+        return miopen::CompileService::Get().Load(h, program, "", true, "");
+    };
+
+    // Concurrent requests for the same program share a single build, and so do its errors.
+    std::vector<miopen::Program> programs(8);
+    std::vector<int> failures(programs.size(), 0);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < programs.size(); ++i)
+    {
+        threads.emplace_back([&, i] {
+            programs[i] = load(src);
+            failures[i] = throws([&] { load(bad); }) ? 1 : 0;
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT(std::all_of(failures.begin(), failures.end(), [](int f) { return f != 0; }));
+#if MIOPEN_BACKEND_OPENCL
+    EXPECT(std::all_of(
+        programs.begin(), programs.end(), [](const miopen::Program& p) { return p != nullptr; }));
+#endif
+}
+
 void test_arch_name()
 {
     auto&& h        = get_handle();
@@ -257,6 +323,8 @@ int main()
     test_multithreads(miopenOpenCLKernelType);
     test_multithreads(miopenOpenCLKernelType, true);
     test_errors(miopenOpenCLKernelType);
+    test_kernel_cache_limits();
+    test_compile_service();
     test_arch_name();
 // Warnings currently dont work in opencl
 #if !MIOPEN_BACKEND_OPENCL
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include "driver.hpp"
+
+#include <miopen/invoker_cache.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct TestInvoker
+{
+    int id;
+    void operator()(const Handle&, const AnyInvokeParams&) const {}
+};
+
+static int IdOf(const boost::optional<const Invoker&>& invoker)
+{
+    if(!invoker)
+        return -1;
+    return invoker->target<TestInvoker>()->id;
+}
+
+struct InvokerCacheTestDriver : test_driver
+{
+    void run() const
+    {
+        Basic();
+        Found1_0();
+        Growth();
+        ConcurrentReaders();
+    }
+
+private:
+    static const std::string& SolverA()
+    {
+        static const std::string solver = "ConvDirectNaiveConvFwd";
+        return solver;
+    }
+
+    static const std::string& SolverB()
+    {
+        static const std::string solver = "GemmFwd1x1_0_1";
+        return solver;
+    }
+
+    static void Basic()
+    {
+        InvokerCache cache;
+        const auto config   = NetworkConfig{"1x2x3"};
+        const auto interned = NetworkConfig{"1x2x3", 42};
+        const auto other    = NetworkConfig{"1x2x4"};
+
+        EXPECT_EQUAL(IdOf(cache.Get(config, SolverA())), -1);
+
+        cache.Register(config, SolverA(), TestInvoker{1});
+        cache.Register(config, SolverB(), TestInvoker{2});
+        cache.Register(other, SolverA(), TestInvoker{3});
+        // The first registration wins.
+        cache.Register(config, SolverA(), TestInvoker{4});
+
+        EXPECT_EQUAL(IdOf(cache.Get(config, SolverA())), 1);
+        EXPECT_EQUAL(IdOf(cache.Get(config, SolverB())), 2);
+        EXPECT_EQUAL(IdOf(cache.Get(other, SolverA())), 3);
+        EXPECT_EQUAL(IdOf(cache.Get(other, SolverB())), -1);
+        // Interned and plain configs with the same value are the same key.
+        EXPECT_EQUAL(IdOf(cache.Get(interned, SolverB())), 2);
+        // Last used fast path must not return a stale entry.
+        EXPECT_EQUAL(IdOf(cache.Get(interned, SolverA())), 1);
+        EXPECT_EQUAL(IdOf(cache.Get(other, SolverA())), 3);
+
+        const auto moved = std::move(cache);
+        EXPECT_EQUAL(IdOf(moved.Get(config, SolverB())), 2);
+    }
+
+    static void Found1_0()
+    {
+        InvokerCache cache;
+        const auto config = NetworkConfig{"1x2x3"};
+
+        EXPECT(!cache.GetFound1_0(config, "miopenConvolutionFwdAlgoDirect"));
+        EXPECT(throws([&]() {
+            cache.SetAsFound1_0(config, "miopenConvolutionFwdAlgoDirect", SolverA());
+        }));
+
+        cache.Register(config, SolverA(), TestInvoker{1});
+        cache.Register(config, SolverB(), TestInvoker{2});
+        cache.SetAsFound1_0(config, "miopenConvolutionFwdAlgoDirect", SolverA());
+        EXPECT_EQUAL(IdOf(cache.GetFound1_0(config, "miopenConvolutionFwdAlgoDirect")), 1);
+        EXPECT_EQUAL(*cache.GetFound1_0SolverId(config, "miopenConvolutionFwdAlgoDirect"),
+                     SolverA());
+        EXPECT(!cache.GetFound1_0(config, "miopenConvolutionFwdAlgoGEMM"));
+
+        cache.SetAsFound1_0(config, "miopenConvolutionFwdAlgoDirect", SolverB());
+        EXPECT_EQUAL(IdOf(cache.GetFound1_0(config, "miopenConvolutionFwdAlgoDirect")), 2);
+    }
+
+    static void Growth()
+    {
+        InvokerCache cache;
+        const auto count = 1000;
+        for(auto i = 0; i < count; ++i)
+            cache.Register(NetworkConfig{std::to_string(i)}, SolverA(), TestInvoker{i});
+        for(auto i = 0; i < count; ++i)
+            EXPECT_EQUAL(IdOf(cache.Get(NetworkConfig{std::to_string(i)}, SolverA())), i);
+        EXPECT_EQUAL(IdOf(cache.Get(NetworkConfig{std::to_string(count)}, SolverA())), -1);
+    }
+
+    static void ConcurrentReaders()
+    {
+        InvokerCache cache;
+        const auto count = 2000;
+        for(auto i = 0; i < count / 2; ++i)
+            cache.Register(NetworkConfig{std::to_string(i)}, SolverA(), TestInvoker{i});
+
+        std::atomic<bool> failed{false};
+        std::vector<std::thread> readers;
+        for(auto t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&]() {
+                for(auto round = 0; round < 10; ++round)
+                {
+                    for(auto i = 0; i < count / 2; ++i)
+                    {
+                        if(IdOf(cache.Get(NetworkConfig{std::to_string(i)}, SolverA())) != i)
+                            failed = true;
+                    }
+                }
+            });
+        }
+
+        for(auto i = count / 2; i < count; ++i)
+            cache.Register(NetworkConfig{std::to_string(i)}, SolverA(), TestInvoker{i});
+        for(auto& reader : readers)
+            reader.join();
+
+        EXPECT(!failed);
+        for(auto i = 0; i < count; ++i)
+            EXPECT_EQUAL(IdOf(cache.Get(NetworkConfig{std::to_string(i)}, SolverA())), i);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char** argn)
+{
+    test_drive<miopen::tests::InvokerCacheTestDriver>(argc, argn);
+}
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/measurement_policy.hpp>
+#include <miopen/perf_field.hpp>
+#include "test.hpp"
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using miopen::MeasurementPolicy;
+using miopen::TimingReduction;
+
+MeasurementPolicy MakePolicy(TimingReduction reduction)
+{
+    MeasurementPolicy policy;
+    policy.SetWarmupRuns(2);
+    policy.SetMinRuns(3);
+    policy.SetMaxRuns(10);
+    policy.SetMaxRelativeCI(0.02f);
+    policy.SetReduction(reduction);
+    return policy;
+}
+
+void test_reduce()
+{
+    // One stall among stable samples.
+    const std::vector<float> samples = {1.0f, 1.02f, 0.98f, 1.01f, 9.0f, 0.99f, 1.0f};
+
+    const auto median = MakePolicy(TimingReduction::Median).Reduce(samples);
+    EXPECT_EQUAL(median.time, 1.0f);
+    EXPECT_EQUAL(median.runs, samples.size());
+    EXPECT_EQUAL(median.inliers, samples.size() - 1);
+    EXPECT(median.variance > 0.0f && median.variance < 0.001f);
+
+    // The interval is that of the inliers, the stall does not narrow it.
+    auto inliers_only = median;
+    inliers_only.runs = median.inliers;
+    EXPECT_EQUAL(median.RelativeCI(), inliers_only.RelativeCI());
+    auto all_runs    = median;
+    all_runs.inliers = median.runs;
+    EXPECT(all_runs.RelativeCI() < median.RelativeCI());
+
+    const auto trimmed = MakePolicy(TimingReduction::TrimmedMean).Reduce(samples);
+    EXPECT(trimmed.time > 0.99f && trimmed.time < 1.01f);
+    EXPECT_EQUAL(trimmed.variance, median.variance);
+
+    const auto mean = MakePolicy(TimingReduction::Mean).Reduce(samples);
+    EXPECT(mean.time > 2.0f);
+
+    EXPECT_EQUAL(MakePolicy(TimingReduction::Median).Reduce({}).runs, std::size_t{0});
+    EXPECT_EQUAL(MakePolicy(TimingReduction::Median).Reduce({2.0f, 4.0f}).time, 3.0f);
+}
+
+void test_measure()
+{
+    const auto policy = MakePolicy(TimingReduction::Median);
+
+    // Stable kernel: warmup and the minimum of runs.
+    std::size_t n_calls = 0;
+    auto stats          = policy.Measure([&]() {
+        ++n_calls;
+        return 2.0f;
+    });
+    EXPECT_EQUAL(n_calls, std::size_t{5});
+    EXPECT_EQUAL(stats.runs, std::size_t{3});
+    EXPECT_EQUAL(stats.inliers, std::size_t{3});
+    EXPECT_EQUAL(stats.time, 2.0f);
+    EXPECT_EQUAL(stats.variance, 0.0f);
+
+    // Noisy kernel: runs until the maximum.
+    n_calls = 0;
+    stats   = policy.Measure([&]() {
+        ++n_calls;
+        return n_calls % 2 == 0 ? 1.0f : 1.5f;
+    });
+    EXPECT_EQUAL(n_calls, std::size_t{12});
+    EXPECT_EQUAL(stats.runs, std::size_t{10});
+    EXPECT(stats.RelativeCI() > 0.02f);
+
+    // Caller asks for more runs than the policy.
+    n_calls = 0;
+    stats   = policy.Measure([&]() { return static_cast<float>(++n_calls); }, 27);
+    EXPECT_EQUAL(stats.runs, std::size_t{27});
+
+    // The errors of the kernel are passed to the caller.
+    EXPECT(throws([&]() { policy.Measure([]() -> float { throw std::runtime_error("fail"); }); }));
+}
+
+void test_find_db_data()
+{
+    const auto key = miopen::FindDbKCacheKey::MakeUnused("miopenConvolutionFwdAlgoDirect");
+    const miopen::FindDbData data{"ConvAsm1x1U", 0.5f, 128, key, 0.25f};
+
+    std::ostringstream ss;
+    data.Serialize(ss);
+    miopen::FindDbData loaded;
+    EXPECT(loaded.Deserialize(ss.str()));
+    EXPECT_EQUAL(loaded.solver_id, "ConvAsm1x1U");
+    EXPECT_EQUAL(loaded.time, 0.5f);
+    EXPECT_EQUAL(loaded.variance, 0.25f);
+
+    // Written without the variance.
+    EXPECT(loaded.Deserialize("ConvAsm1x1U,0.75,128,miopenConvolutionFwdAlgoDirect,<unused>"));
+    EXPECT_EQUAL(loaded.time, 0.75f);
+    EXPECT_EQUAL(loaded.variance, 0.0f);
+    EXPECT(!loaded.Deserialize("ConvAsm1x1U,0.75"));
+}
+
+int main()
+{
+    test_reduce();
+    test_measure();
+    test_find_db_data();
+}
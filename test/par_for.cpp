@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/par_for.hpp>
+#include "test.hpp"
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+void test_every_index_once()
+{
+    std::vector<std::atomic<int>> hits(10007);
+    for(auto& hit : hits)
+        hit = 0;
+
+    miopen::par_for(hits.size(), 1, [&](std::size_t i) { ++hits[i]; });
+    EXPECT(std::all_of(hits.begin(), hits.end(), [](const auto& hit) { return hit == 1; }));
+
+    for(auto& hit : hits)
+        hit = 0;
+    miopen::par_for_strided(hits.size(), miopen::max_threads{3}, [&](std::size_t i) { ++hits[i]; });
+    EXPECT(std::all_of(hits.begin(), hits.end(), [](const auto& hit) { return hit == 1; }));
+}
+
+void test_nested()
+{
+    const std::size_t outer = 64;
+    const std::size_t inner = 1000;
+    std::vector<std::size_t> sums(outer, 0);
+
+    miopen::par_for(outer, 1, [&](std::size_t i) {
+        std::atomic<std::size_t> sum{0};
+        miopen::par_for(inner, 1, [&](std::size_t j) { sum += j; });
+        sums[i] = sum;
+    });
+
+    const auto expected = inner * (inner - 1) / 2;
+    EXPECT(std::all_of(sums.begin(), sums.end(), [&](auto sum) { return sum == expected; }));
+}
+
+void test_cancel()
+{
+    const std::size_t n = 1000000;
+    std::atomic<std::size_t> done{0};
+    miopen::cancel_token token;
+
+    miopen::par_for(n, miopen::min_grain{1}, token, [&](std::size_t i) {
+        if(i == 100)
+            token.cancel();
+        ++done;
+    });
+
+    EXPECT(token.cancelled());
+    EXPECT(done < n);
+}
+
+void test_exception()
+{
+    std::atomic<std::size_t> done{0};
+    EXPECT(throws([&] {
+        miopen::par_for(100000, 1, [&](std::size_t i) {
+            if(i == 10)
+                throw std::runtime_error("par_for");
+            ++done;
+        });
+    }));
+    EXPECT(done < 100000);
+
+    // The pool is still usable.
+    done = 0;
+    miopen::par_for(1000, 1, [&](std::size_t) { ++done; });
+    EXPECT_EQUAL(done.load(), std::size_t{1000});
+}
+
+int main()
+{
+    test_every_index_once();
+    test_nested();
+    test_cancel();
+    test_exception();
+}
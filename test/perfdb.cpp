@@ -27,7 +27,9 @@
 #include "test.hpp"
 #include "driver.hpp"
 
+#include <miopen/compiled_db.hpp>
 #include <miopen/db.hpp>
+#include <miopen/db_journal.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/ramdb.hpp>
@@ -41,6 +43,7 @@
 #include <array>
 #include <cstdio>
 #include <cstdlib>
+#include <ctime>
 #include <fstream>
 #include <mutex>
 #include <limits>
@@ -1051,6 +1054,8 @@ public:
         std::string p = temp_file;
         const auto c  = [&p]() MIOPEN_RETURNS(GetDbInstance<TDb>(p, false));
         DBMultiThreadedTestWork::FillForReading(c);
+        // Children shall see the data even if writes are journaled.
+        DbJournal::FlushAll();
 
         MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Launching test processes...");
         {
@@ -1405,6 +1410,238 @@ public:
     }
 };
 
+class DbMultiFileCacheTest : public DbMultiFileTest
+{
+public:
+    DbMultiFileCacheTest(TempFile& temp_file_) : DbMultiFileTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Running multifile cache test...");
+
+        RawWrite(temp_file, key(), common_data());
+
+        MultiFileDb<ReadonlyRamDb, RamDb, true> db(temp_file, user_db_path);
+        ValidateSingleEntry(key(), common_data(), db);
+
+        static const std::array<std::pair<const std::string, TestData>, 2> updated_data{{
+            {id1(), value2()},
+            {id0(), value0()},
+        }};
+
+        // Writes bypassing this instance shall invalidate cached records as well.
+        EXPECT(RamDb::GetCached(user_db_path, false).Update(key(), id1(), value2()));
+        ValidateSingleEntry(key(), updated_data, db);
+
+        EXPECT(db.RemoveRecord(key()));
+        ValidateSingleEntry(key(), common_data(), db);
+
+        const TestData missing_key(100, 200);
+        EXPECT(!db.FindRecord(missing_key));
+        EXPECT(db.Update(missing_key, id0(), value0()));
+        EXPECT(db.FindRecord(missing_key));
+    }
+};
+
+class DbJournalTest : public DbTest
+{
+public:
+    DbJournalTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run()
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Running db journal test...");
+
+        RawWrite(temp_file, key(), common_data());
+
+        static const std::array<std::pair<const std::string, TestData>, 2> updated_data{{
+            {id1(), value2()},
+            {id0(), value0()},
+        }};
+        static const std::array<std::pair<const std::string, TestData>, 1> other_data{
+            {{id2(), value1()}}};
+        const TestData other_key(100, 200);
+        const TestData removed_key(300, 400);
+
+        auto& lock_file = LockFile::Get(LockFilePath(temp_file.Path()).c_str());
+        auto flushes    = 0;
+
+        {
+            DbJournal journal{temp_file, lock_file, [&](bool is_complete) {
+                                  EXPECT(is_complete);
+                                  ++flushes;
+                              }};
+
+            {
+                const std::lock_guard<LockFile> lock{lock_file};
+
+                DbRecord update{key()};
+                EXPECT(update.SetValues(id1(), value2()));
+                journal.AppendUnsafe(DbJournal::Op::From(DbJournal::Op::Update, update));
+
+                DbRecord other{other_key};
+                EXPECT(other.SetValues(id2(), value1()));
+                journal.AppendUnsafe(DbJournal::Op::From(DbJournal::Op::Store, other));
+
+                DbRecord removed{removed_key};
+                EXPECT(removed.SetValues(id0(), value0()));
+                journal.AppendUnsafe(DbJournal::Op::From(DbJournal::Op::Store, removed));
+                journal.AppendUnsafe({DbJournal::Op::Remove, removed.GetKey(), {}});
+
+                EXPECT_EQUAL(journal.GetPendingUnsafe().size(), std::size_t{4});
+            }
+
+            EXPECT(journal.Flush());
+            EXPECT_EQUAL(flushes, 1);
+        }
+
+        EXPECT_EQUAL(flushes, 1);
+
+        PlainTextDb db(temp_file);
+        ValidateSingleEntry(key(), updated_data, db);
+        ValidateSingleEntry(other_key, other_data, db);
+        EXPECT(!db.FindRecord(removed_key));
+
+        ResetDb();
+        ReplayDeadLog(true);
+        ResetDb();
+        ReplayDeadLog(false);
+    }
+
+private:
+    /// The log of a dead process is found when the journal is opened. If it is replayed by
+    /// another process meanwhile, which then writes a newer value, the stale ops are skipped.
+    void ReplayDeadLog(bool replayed_elsewhere) const
+    {
+        static const std::array<std::pair<const std::string, TestData>, 1> stale_data{
+            {{id0(), value0()}}};
+        static const std::array<std::pair<const std::string, TestData>, 1> newer_data{
+            {{id0(), value1()}}};
+        static const std::array<std::pair<const std::string, TestData>, 1> other_data{
+            {{id2(), value2()}}};
+        const TestData other_key(100, 200);
+
+        // Above the largest pid_max of Linux, so never alive.
+        const auto dead_log = DbJournal::GetLogPath(temp_file, (1 << 22) + 1);
+        {
+            DbRecord stale{key()};
+            EXPECT(stale.SetValues(id0(), value0()));
+            const auto op = DbJournal::Op::From(DbJournal::Op::Store, stale);
+            std::ofstream{dead_log} << static_cast<char>(op.kind) << op.key << '=' << op.payload
+                                    << '\n';
+        }
+
+        auto& lock_file = LockFile::Get(LockFilePath(temp_file.Path()).c_str());
+        DbJournal journal{temp_file, lock_file, [&](bool is_complete) {
+                              EXPECT_EQUAL(is_complete, replayed_elsewhere);
+                          }};
+
+        {
+            const std::lock_guard<LockFile> lock{lock_file};
+            DbRecord other{other_key};
+            EXPECT(other.SetValues(id2(), value2()));
+            journal.AppendUnsafe(DbJournal::Op::From(DbJournal::Op::Store, other));
+        }
+
+        if(replayed_elsewhere)
+        {
+            const std::lock_guard<LockFile> lock{lock_file};
+            boost::filesystem::remove(dead_log);
+            RawWrite(temp_file, key(), newer_data);
+        }
+
+        EXPECT(journal.Flush());
+        EXPECT(!boost::filesystem::exists(dead_log));
+
+        PlainTextDb db(temp_file);
+        ValidateSingleEntry(key(), replayed_elsewhere ? newer_data : stale_data, db);
+        ValidateSingleEntry(other_key, other_data, db);
+    }
+};
+
+class DbCompiledReadTest : public DbTest
+{
+public:
+    DbCompiledReadTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run()
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Running compiled db read test...");
+
+        ReadCompiled();
+
+        ResetDb();
+        IgnoreOutdated();
+
+        ResetDb();
+        IgnoreSameSizeEdit();
+
+        ResetDb();
+        AcceptTouched();
+    }
+
+private:
+#if MIOPEN_EMBED_DB
+    TestRordbEmbedFsOverrideLock rordb_embed_fs_override;
+#endif
+
+    void ReadCompiled() const
+    {
+        RawWrite(temp_file, key(), common_data());
+        EXPECT(CompiledDb::Compile(temp_file, CompiledDb::GetPath(temp_file)));
+
+        const auto& db = ReadonlyRamDb::GetCached(temp_file, true);
+        ValidateSingleEntry(key(), common_data(), db);
+
+        const TestData invalid_key(100, 200);
+        EXPECT(!db.FindRecord(invalid_key));
+    }
+
+    void IgnoreOutdated() const
+    {
+        static const std::array<std::pair<const std::string, TestData>, 1> data{
+            {{id0(), value2()}}};
+        const TestData other_key(100, 200);
+
+        RawWrite(temp_file, key(), common_data());
+        EXPECT(CompiledDb::Compile(temp_file, CompiledDb::GetPath(temp_file)));
+        RawWrite(temp_file, other_key, data);
+
+        const auto& db = ReadonlyRamDb::GetCached(temp_file, true);
+        ValidateSingleEntry(other_key, data, db);
+    }
+
+    void IgnoreSameSizeEdit() const
+    {
+        static const std::array<std::pair<const std::string, TestData>, 1> original{
+            {{id0(), value0()}}};
+        static const std::array<std::pair<const std::string, TestData>, 1> edited{
+            {{id0(), value2()}}};
+
+        RawWrite(temp_file, key(), original);
+        EXPECT(CompiledDb::Compile(temp_file, CompiledDb::GetPath(temp_file)));
+        RawWrite(temp_file, key(), edited);
+
+        CompiledDb compiled;
+        EXPECT(!compiled.Open(CompiledDb::GetPath(temp_file), temp_file));
+
+        const auto& db = ReadonlyRamDb::GetCached(temp_file, true);
+        ValidateSingleEntry(key(), edited, db);
+    }
+
+    // E.g. installed, the text db has another mtime, but the same contents.
+    void AcceptTouched() const
+    {
+        RawWrite(temp_file, key(), common_data());
+        EXPECT(CompiledDb::Compile(temp_file, CompiledDb::GetPath(temp_file)));
+        boost::filesystem::last_write_time(temp_file.Path(), std::time(nullptr) + 100);
+
+        CompiledDb compiled;
+        EXPECT(compiled.Open(CompiledDb::GetPath(temp_file), temp_file));
+        EXPECT_EQUAL(compiled.GetSize(), std::size_t{1});
+    }
+};
+
 struct PerfDbDriver : test_driver
 {
     PerfDbDriver()
@@ -1489,6 +1726,12 @@ private:
         DbMultiFileOperationsTest{temp_file}.Run();
         DbMultiFileMultiThreadedReadTest{temp_file}.Run();
         DbMultiFileMultiThreadedTest{temp_file}.Run();
+        if(!DisableUserDbFileIO)
+        {
+            DbMultiFileCacheTest{temp_file}.Run();
+            DbJournalTest{temp_file}.Run();
+        }
+        DbCompiledReadTest{temp_file}.Run();
     }
 };
 
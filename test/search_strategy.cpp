@@ -0,0 +1,175 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/ramdb.hpp>
+#include <miopen/search_strategy.hpp>
+#include <miopen/temp_file.hpp>
+#include "test.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+using miopen::solver::ConfigFields;
+using miopen::solver::SearchStrategyKind;
+
+struct ProblemKey
+{
+    int n;
+    void Serialize(std::ostream& stream) const { stream << n << "-3-3"; }
+};
+
+struct Config
+{
+    int tile   = 0;
+    int unroll = 0;
+
+    void Serialize(std::ostream& stream) const { stream << tile << ',' << unroll; }
+    bool Deserialize(const std::string& s)
+    {
+        const auto fields = miopen::solver::SplitConfigFields(s);
+        if(fields.size() != 2)
+            return false;
+        tile   = std::stoi(fields[0]);
+        unroll = std::stoi(fields[1]);
+        return true;
+    }
+};
+
+// 16x16 grid with the optimum at (11, 5), some configs fail.
+std::vector<ConfigFields> MakeSpace()
+{
+    std::vector<ConfigFields> space;
+    for(int tile = 0; tile < 16; ++tile)
+        for(int unroll = 0; unroll < 16; ++unroll)
+            space.push_back(miopen::solver::GetConfigFields(Config{tile, unroll}));
+    return space;
+}
+
+float Measure(const ConfigFields& config)
+{
+    const auto tile   = std::stoi(config[0]);
+    const auto unroll = std::stoi(config[1]);
+    if(tile == 0 && unroll % 3 == 0)
+        return std::numeric_limits<float>::max();
+    const auto distance = (tile - 11) * (tile - 11) + (unroll - 5) * (unroll - 5);
+    return 1.0f + 0.1f * static_cast<float>(distance);
+}
+
+void test_split()
+{
+    EXPECT(miopen::solver::SplitConfigFields("").empty());
+    EXPECT((miopen::solver::SplitConfigFields("1,a,,2") == ConfigFields{"1", "a", "", "2"}));
+    EXPECT((miopen::solver::GetConfigFields(Config{4, 2}) == ConfigFields{"4", "2"}));
+}
+
+void test_strategy(SearchStrategyKind kind, const std::vector<ConfigFields>& known_best)
+{
+    const auto space       = MakeSpace();
+    const std::size_t goal = 40;
+    auto strategy          = miopen::solver::MakeSearchStrategy(kind, space, goal, known_best, 7);
+
+    std::set<std::size_t> measured;
+    std::size_t n_measurements = 0;
+    float best                 = std::numeric_limits<float>::max();
+    for(auto batch = strategy->Propose(); !batch.configs.empty(); batch = strategy->Propose())
+    {
+        EXPECT(batch.runs >= 1);
+        std::vector<float> times;
+        for(const auto i : batch.configs)
+        {
+            EXPECT(i < space.size());
+            // Only Halving re-measures the configs, with more runs.
+            EXPECT(kind == SearchStrategyKind::Halving || measured.count(i) == 0);
+            measured.insert(i);
+            times.push_back(Measure(space[i]));
+            best = std::min(best, times.back());
+            ++n_measurements;
+        }
+        strategy->Report(times);
+        EXPECT(n_measurements <= space.size() * 4);
+    }
+
+    if(kind == SearchStrategyKind::Exhaustive)
+    {
+        EXPECT(measured.size() == space.size());
+        EXPECT(best == 1.0f);
+        return;
+    }
+    EXPECT(measured.size() <= goal);
+    EXPECT(!measured.empty());
+    // The space is smooth, the descent must reach the optimum.
+    if(kind == SearchStrategyKind::Coordinate || kind == SearchStrategyKind::Surrogate)
+        EXPECT(best == 1.0f);
+}
+
+void test_strategies()
+{
+    const std::vector<ConfigFields> known_best = {{"11", "4"}, {"10", "5"}, {"12", "5"}};
+    for(const auto kind : {SearchStrategyKind::Exhaustive,
+                           SearchStrategyKind::Random,
+                           SearchStrategyKind::Halving,
+                           SearchStrategyKind::Coordinate,
+                           SearchStrategyKind::Surrogate})
+    {
+        test_strategy(kind, {});
+        test_strategy(kind, known_best);
+    }
+}
+
+void test_load_all()
+{
+    const miopen::TempFile file{"miopen-test-search-strategy"};
+    {
+        miopen::RamDb db{file.Path()};
+        EXPECT(db.Update(ProblemKey{1}, "Solver", Config{1, 2}));
+        EXPECT(db.Update(ProblemKey{2}, "Solver", Config{3, 4}));
+        EXPECT(db.Update(ProblemKey{2}, "Other", Config{5, 6}));
+    }
+
+    miopen::RamDb db{file.Path()};
+    std::vector<Config> configs;
+    EXPECT(db.LoadAll("Solver", configs));
+    EXPECT(configs.size() == 2);
+    std::sort(configs.begin(), configs.end(), [](const auto& l, const auto& r) {
+        return l.tile < r.tile;
+    });
+    EXPECT(configs[0].tile == 1 && configs[0].unroll == 2);
+    EXPECT(configs[1].tile == 3 && configs[1].unroll == 4);
+    EXPECT(!db.LoadAll("Missing", configs));
+    EXPECT(configs.size() == 2);
+}
+
+int main()
+{
+    test_split();
+    test_strategies();
+    test_load_all();
+}
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/simulated_device.hpp>
+#include <miopen/temp_file.hpp>
+#include "simulated_solver.hpp"
+#include "test.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+using miopen::AnalyticCostModel;
+using miopen::KernelLaunch;
+using miopen::ReplayCostModel;
+using miopen::SimulatedDevice;
+
+KernelLaunch MakeLaunch(std::size_t global,
+                        const std::string& options = "-DMIOPEN_USE_FP32=1",
+                        std::size_t local          = 256)
+{
+    KernelLaunch launch;
+    launch.program = "MIOpenConv1x1.cl";
+    launch.kernel  = "MIOpenConv1x1";
+    launch.options = options;
+    launch.ldims   = {local, 1, 1};
+    launch.gdims   = {global, 1, 1};
+    return launch;
+}
+
+void test_analytic()
+{
+    const AnalyticCostModel model{64};
+
+    const auto small = model.GetTime(MakeLaunch(256));
+    EXPECT(small && *small > 0.0f);
+    EXPECT_EQUAL(*small, *model.GetTime(MakeLaunch(256)));
+
+    // More rounds of waves take longer.
+    const auto large = model.GetTime(MakeLaunch(256 * 64 * 40));
+    EXPECT(large && *large > *small);
+
+    // Fewer compute units take longer.
+    EXPECT(*AnalyticCostModel{8}.GetTime(MakeLaunch(256 * 64 * 40)) > *large);
+
+    // The time depends on the geometry only.
+    EXPECT_EQUAL(*model.GetTime(MakeLaunch(256, "-DMIOPEN_USE_FP32=1 -DMLO_GRP_SZ=128")), *small);
+
+    // A round more for the tail.
+    const auto full_round = 256 * 64 * 10;
+    EXPECT(*model.GetTime(MakeLaunch(full_round + 256)) > *model.GetTime(MakeLaunch(full_round)));
+
+    // A partial wave takes the time of a full one.
+    EXPECT_EQUAL(*model.GetTime(MakeLaunch(96 * 64 * 16 * 4, "", 96)),
+                 *model.GetTime(MakeLaunch(128 * 64 * 16 * 4, "", 128)));
+
+    // The groups of a single wave leave most wave slots idle and hide the latency worse.
+    const auto items = std::size_t{256 * 64 * 10 * 8};
+    EXPECT(*model.GetTime(MakeLaunch(items, "", 64)) > *model.GetTime(MakeLaunch(items, "", 256)));
+}
+
+void test_replay()
+{
+    const auto recorded = MakeLaunch(1024);
+    const miopen::TempFile file{"simulated-device"};
+    {
+        miopen::KernelTimeRecorder recorder{file};
+        recorder.Record(recorded, 0.3f);
+        recorder.Record(recorded, 9.0f);
+        recorder.Record(recorded, 0.2f);
+    }
+
+    ReplayCostModel replay;
+    replay.Load(file);
+    EXPECT_EQUAL(replay.GetSize(), std::size_t{1});
+    EXPECT_EQUAL(*replay.GetTime(recorded), 0.3f);
+    EXPECT(!replay.GetTime(MakeLaunch(2048)));
+    EXPECT(throws([&]() { replay.Load(file.Path() + ".missing"); }));
+}
+
+void test_device()
+{
+    auto replay = std::make_shared<ReplayCostModel>();
+    replay->Add(MakeLaunch(1024).GetKey(), 0.5f);
+    const auto analytic = std::make_shared<AnalyticCostModel>(64);
+
+    SimulatedDevice::SetCostModels({replay, analytic});
+    EXPECT(SimulatedDevice::IsEnabled());
+    EXPECT_EQUAL(SimulatedDevice::GetTime(MakeLaunch(1024)), 0.5f);
+    EXPECT_EQUAL(SimulatedDevice::GetTime(MakeLaunch(2048)), *analytic->GetTime(MakeLaunch(2048)));
+
+    SimulatedDevice::SetCostModels({replay});
+    EXPECT_EQUAL(SimulatedDevice::GetTime(MakeLaunch(2048)), 0.0f);
+
+    SimulatedDevice::SetCostModels({});
+    EXPECT(!SimulatedDevice::IsEnabled());
+}
+
+#if MIOPEN_MODE_NOGPU
+/// The auto-tune on the simulated device finds the config the cost model tells to be the fastest.
+void test_search()
+{
+    const auto model = std::make_shared<AnalyticCostModel>(64);
+    SimulatedDevice::SetCostModels({model});
+    {
+        miopen::Handle handle{};
+        auto context                  = miopen::tests::GetSimulatedTestContext(handle);
+        context.disable_perfdb_access = true;
+
+        const auto solver   = miopen::tests::SimulatedTestSolver{};
+        const auto get_time = [&](const miopen::tests::SimulatedTestConfig& config) {
+            const auto solution = solver.GetSolution(context, config);
+            const auto& kernel  = solution.construction_params.front();
+            auto launch         = KernelLaunch{};
+            std::copy(kernel.l_wk.begin(), kernel.l_wk.end(), launch.ldims.begin());
+            std::copy(kernel.g_wk.begin(), kernel.g_wk.end(), launch.gdims.begin());
+            return *model->GetTime(launch);
+        };
+
+        auto best_time = std::numeric_limits<float>::max();
+        auto n_configs = 0;
+        for(const auto& config : miopen::solver::GetAllConfigs(solver, context))
+        {
+            best_time = std::min(best_time, get_time(config));
+            ++n_configs;
+        }
+        EXPECT(n_configs > 1);
+
+        const auto found = solver.Search(context, miopen::InvokeParams{});
+        EXPECT(solver.IsValidPerformanceConfig(context, found));
+        EXPECT(get_time(found) <= best_time * 1.0001f);
+    }
+    SimulatedDevice::SetCostModels({});
+}
+#endif
+
+int main()
+{
+    test_analytic();
+    test_replay();
+    test_device();
+#if MIOPEN_MODE_NOGPU
+    test_search();
+#endif
+}
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_SIMULATED_SOLVER_HPP
+#define GUARD_SIMULATED_SOLVER_HPP
+
+#include <miopen/convolution.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/invoke_params.hpp>
+#include <miopen/solver.hpp>
+
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+/// The group size and the outputs per work item of SimulatedTestSolver.
+struct SimulatedTestConfig : solver::PerfConfigBase<SimulatedTestConfig>
+{
+    int group_size = 0;
+    int tile       = 0;
+
+    SimulatedTestConfig() {}
+    SimulatedTestConfig(bool) : group_size(64), tile(1) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.group_size, "group_size");
+        f(self.tile, "tile");
+    }
+
+    bool SetNextValue(const ConvolutionContext&)
+    {
+        if((tile *= 2) <= 8)
+            return true;
+        tile = 1;
+        return (group_size *= 2) <= 1024;
+    }
+
+    bool IsValid(const ConvolutionContext&) const
+    {
+        return group_size >= 64 && tile >= 1 && group_size * tile <= 4096;
+    }
+
+    bool operator==(const SimulatedTestConfig& other) const
+    {
+        return group_size == other.group_size && tile == other.tile;
+    }
+};
+
+/// Each config launches one kernel of its own work sizes, so that the simulated device gives the
+/// configs different times.
+class SimulatedTestSolver final : public solver::ConvTunableSolver<SimulatedTestConfig>
+{
+public:
+    const std::string& SolverDbId() const override { return GetSolverDbId<SimulatedTestSolver>(); }
+
+    bool IsApplicable(const ConvolutionContext&) const override { return true; }
+
+    SimulatedTestConfig GetDefaultPerformanceConfig(const ConvolutionContext&) const override
+    {
+        return SimulatedTestConfig{true};
+    }
+
+    bool IsValidPerformanceConfig(const ConvolutionContext& context,
+                                  const SimulatedTestConfig& config) const override
+    {
+        return config.IsValid(context);
+    }
+
+    SimulatedTestConfig Search(const ConvolutionContext& context,
+                           const AnyInvokeParams& invoke_ctx) const override
+    {
+        return solver::GenericSearch(*this, context, invoke_ctx);
+    }
+
+    solver::ConvSolution GetSolution(const ConvolutionContext& context,
+                                     const SimulatedTestConfig& config) const override
+    {
+        const auto& problem  = context.problem;
+        const auto n_outputs = static_cast<std::size_t>(problem.batch_sz) * problem.n_outputs *
+                               problem.out_height * problem.out_width;
+        const auto group_size = static_cast<std::size_t>(config.group_size);
+        const auto n_items    = (n_outputs + config.tile - 1) / config.tile;
+
+        solver::KernelInfo kernel;
+        kernel.kernel_file  = "SimulatedTestSolver.cl";
+        kernel.kernel_name  = "SimulatedTestSolver";
+        kernel.comp_options = " -DTILE=" + std::to_string(config.tile);
+        kernel.l_wk         = {group_size, 1, 1};
+        kernel.g_wk         = {(n_items + group_size - 1) / group_size * group_size, 1, 1};
+
+        solver::ConvSolution solution;
+        solution.construction_params.push_back(kernel);
+        solution.invoker_factory = [](const std::vector<Kernel>& kernels) {
+            return [=](const Handle& handle, const AnyInvokeParams&) {
+                handle.Run(kernels.front())(0);
+            };
+        };
+        return solution;
+    }
+};
+
+inline ConvolutionContext GetSimulatedTestContext(Handle& handle)
+{
+    auto context = ConvolutionContext{TensorDescriptor{miopenFloat, {16, 64, 28, 28}},
+                                      TensorDescriptor{miopenFloat, {64, 64, 1, 1}},
+                                      TensorDescriptor{miopenFloat, {16, 64, 28, 28}},
+                                      ConvolutionDescriptor{},
+                                      conv::Direction::Forward};
+    context.SetStream(&handle);
+    return context;
+}
+
+} // namespace tests
+} // namespace miopen
+
+#endif
@@ -500,6 +500,90 @@ public:
     }
 };
 
+class DbBatchTest : public DbTest
+{
+public:
+    void Run() const
+    {
+        std::cout << "Testing db for batched updates..." << std::endl;
+
+        ProblemData p0(0);
+        ProblemData p1(1);
+
+        {
+            SQLitePerfDb db(std::string(temp_file), false);
+
+            db.BeginBatch();
+            EXPECT(db.Update(p0, id0(), value0()));
+            // Nested batches are merged into the outer one.
+            db.BeginBatch();
+            EXPECT(db.Update(p0, id1(), value1()));
+            db.CommitBatch();
+
+            // Writes of a batch are visible through the same connection before the commit.
+            SolverData read;
+            EXPECT(db.Load(p0, id1(), read));
+            EXPECT_EQUAL(read, value1());
+
+            EXPECT(db.Update(p1, id2(), value2()));
+            EXPECT(db.Remove(p0, id0()));
+            db.CommitBatch();
+        }
+
+        const std::array<std::pair<std::string, SolverData>, 1> data0{{{id1(), value1()}}};
+        const std::array<std::pair<std::string, SolverData>, 1> data1{{{id2(), value2()}}};
+
+        SQLitePerfDb db(std::string(temp_file), false);
+        SolverData read;
+        EXPECT(!db.Load(p0, id0(), read));
+        ValidateSingleEntry(p0, data0, SQLitePerfDb(temp_file, false));
+        ValidateSingleEntry(p1, data1, SQLitePerfDb(temp_file, false));
+
+        RunRollback();
+    }
+
+private:
+    void RunRollback() const
+    {
+        ProblemData p2(2);
+        ProblemData p3(3);
+
+        {
+            SQLitePerfDb db(std::string(temp_file), false);
+
+            db.BeginBatch();
+            EXPECT(db.Update(p2, id0(), value0()));
+            db.RollbackBatch();
+
+            // A rolled back nested batch fails the outer one.
+            db.BeginBatch();
+            EXPECT(db.Update(p2, id0(), value0()));
+            db.BeginBatch();
+            EXPECT(db.Update(p3, id0(), value0()));
+            db.RollbackBatch();
+            EXPECT(throws([&]() { db.CommitBatch(); }));
+
+            // An abandoned guard rolls back, as on an exception.
+            {
+                SQLite::Batch batch{db.sql};
+                EXPECT(db.Update(p2, id0(), value0()));
+            }
+
+            // The db is usable for new batches afterwards.
+            SQLite::Batch batch{db.sql};
+            EXPECT(db.Update(p3, id1(), value1()));
+            batch.Commit();
+        }
+
+        SQLitePerfDb db(std::string(temp_file), false);
+        SolverData read;
+        EXPECT(!db.Load(p2, id0(), read));
+        EXPECT(!db.Load(p3, id0(), read));
+        EXPECT(db.Load(p3, id1(), read));
+        EXPECT_EQUAL(read, value1());
+    }
+};
+
 class DBMultiThreadedTestWork
 {
 public:
@@ -1255,6 +1339,7 @@ struct PerfDbDriver : test_driver
         DbFindTest().Run();
         DbOperationsTest().Run();
         DbParallelTest().Run();
+        DbBatchTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiThreadedReadTest().Run();
         DbMultiProcessReadTest().Run();
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include "tensor_holder.hpp"
+#include "random.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// The views, the parallel loops and par_generate against the descriptor and the sequential
+// loops.
+
+void test_par_ford()
+{
+    const std::size_t lens[] = {3, 1, 70, 129};
+    const auto size          = lens[0] * lens[1] * lens[2] * lens[3];
+    std::vector<std::atomic<int>> visits(size);
+    for(auto& v : visits)
+        v = 0;
+    par_ford(lens[0], lens[1], lens[2], lens[3])([&](auto i, auto j, auto k, auto l) {
+        ++visits[((i * lens[1] + j) * lens[2] + k) * lens[3] + l];
+    });
+    for(auto& v : visits)
+        EXPECT_EQUAL(v.load(), 1);
+
+    std::atomic<int> calls{0};
+    par_ford(5, 0, 3)([&](auto, auto, auto) { ++calls; });
+    par_ford()([&]() { ++calls; });
+    EXPECT_EQUAL(calls.load(), 1);
+}
+
+template <class T>
+void test_indices(tensor<T>& t)
+{
+    t.for_each([&](auto... is) {
+        EXPECT_EQUAL(t.index(is...), t.desc.GetIndex(is...));
+        EXPECT(&t(is...) == &t.data[t.desc.GetIndex(is...)]);
+    });
+}
+
+void test_views()
+{
+    tensor<float> packed{std::vector<std::size_t>{2, 3, 4, 5}};
+    tensor<float> nhwc{std::vector<std::size_t>{2, 3, 4, 5},
+                       std::vector<std::size_t>{60, 1, 15, 3}};
+    tensor<float> padded{std::vector<std::size_t>{2, 3, 7}, std::vector<std::size_t>{40, 10, 1}};
+    for(auto* t : {&packed, &nhwc})
+    {
+        test_indices(*t);
+        const auto v = t->view<4>();
+        t->for_each([&](auto i, auto j, auto k, auto l) {
+            EXPECT(&v(i, j, k, l) == &(*t)(i, j, k, l));
+        });
+    }
+    test_indices(padded);
+    EXPECT(packed.is_row_major());
+    EXPECT(!nhwc.is_row_major());
+    EXPECT(!padded.is_row_major());
+
+    tensor<int8_t> nchwc{miopenInt8, miopenTensorNCHWc4, std::vector<std::size_t>{2, 8, 3, 5}};
+    tensor<int8_t> chwnc{miopenInt8, miopenTensorCHWNc4, std::vector<std::size_t>{8, 3, 5, 2}};
+    EXPECT(!nchwc.is_row_major());
+    for(auto* t : {&nchwc, &chwnc})
+    {
+        t->for_each([&](auto i, auto j, auto k, auto l) {
+            for(auto lane = 0; lane < 4; lane++)
+            {
+                EXPECT_EQUAL(t->index(lane, i, j, k, l), t->desc.GetIndex(lane, i, j, k, l));
+            }
+        });
+    }
+}
+
+void test_par_for_each()
+{
+    tensor<int> t{std::vector<std::size_t>{3, 4, 50, 60}, std::vector<std::size_t>{1, 3, 12, 600}};
+    std::vector<std::atomic<int>> visits(t.data.size());
+    for(auto& v : visits)
+        v = 0;
+    t.view<4>().par_for_each([&](int& x, auto i, auto j, auto k, auto l) {
+        x = ((i * 4 + j) * 50 + k) * 60 + l;
+        ++visits[&x - t.data.data()];
+    });
+    t.for_each([&](auto i, auto j, auto k, auto l) {
+        EXPECT_EQUAL(t(i, j, k, l), ((i * 4 + j) * 50 + k) * 60 + l);
+        EXPECT_EQUAL(visits[t.index(i, j, k, l)].load(), 1);
+    });
+}
+
+void test_par_generate()
+{
+    const auto g = tensor_elem_gen_integer{17};
+    for(const auto& lens : std::vector<std::vector<std::size_t>>{
+            {7}, {3, 1000}, {2, 3, 70, 70}, {2, 3, 4, 50, 60}, {1, 1, 1, 1}})
+    {
+        auto expected = tensor<float>{lens}.generate(g);
+        auto actual   = tensor<float>{lens}.par_generate(g);
+        EXPECT(expected.data == actual.data);
+
+        const auto after_generate = GET_RAND();
+        tensor_generate{}(actual, g);
+        EXPECT(expected.data == actual.data);
+        EXPECT_EQUAL(GET_RAND(), after_generate);
+    }
+
+    tensor<half_float::half> nhwc{std::vector<std::size_t>{2, 5, 6, 7},
+                                  std::vector<std::size_t>{210, 1, 35, 5}};
+    nhwc.par_generate(g);
+    nhwc.for_each([&](auto... is) { EXPECT_EQUAL(float(nhwc(is...)), float(g(is...))); });
+}
+
+int main()
+{
+    test_par_ford();
+    test_views();
+    test_par_for_each();
+    test_par_generate();
+}
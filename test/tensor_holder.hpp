@@ -71,6 +71,81 @@ void visit_tensor_size(std::size_t n, F f)
     }
 }
 
+/// A tensor of rank N with the lengths and strides in arrays, for the loops over the elements
+/// that would otherwise look the strides up in the descriptor for each one of them.
+template <class T, std::size_t N>
+struct tensor_view
+{
+    T* data = nullptr;
+    std::array<std::size_t, N> lens{};
+    std::array<std::size_t, N> strides{};
+
+    template <class... Ts>
+    std::size_t offset(Ts... xs) const
+    {
+        static_assert(sizeof...(Ts) == N, "The number of indices must match the tensor rank.");
+        const std::array<std::size_t, N> is = {{static_cast<std::size_t>(xs)...}};
+        return std::inner_product(is.begin(), is.end(), strides.begin(), std::size_t{0});
+    }
+
+    template <class... Ts>
+    T& operator()(Ts... xs) const
+    {
+        return data[this->offset(xs...)];
+    }
+
+    std::size_t size() const
+    {
+        return std::accumulate(
+            lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    }
+
+    /// Calls f(x, is...) for every element in parallel. The threads take rows of the innermost
+    /// dimension, so only the start of a row is computed from the indices and the elements of
+    /// the contiguous rows are stepped through one after the other.
+    template <class F>
+    void par_for_each(F f) const
+    {
+        this->par_for_each(f, std::integral_constant<bool, N == 0>{});
+    }
+
+private:
+    // A scalar has no rows. The overload keeps the row loop, which indexes lens[N - 1], from
+    // being instantiated for it: C++14 has no if constexpr.
+    template <class F>
+    void par_for_each(F f, std::true_type) const
+    {
+        f(data[0]);
+    }
+
+    template <class F>
+    void par_for_each(F f, std::false_type) const
+    {
+        const auto size = this->size();
+        if(size == 0)
+            return;
+        const auto row_len    = lens[N - 1];
+        const auto row_stride = strides[N - 1];
+        // Rows of at least 4k elements in a chunk, the smaller tensors are not worth the threads.
+        const auto grain = std::max<std::size_t>(4096 / row_len, 1);
+        miopen::par_for(size / row_len, grain, [&](std::size_t row) {
+            std::array<std::size_t, N> is;
+            std::size_t start = 0;
+            for(auto d = N - 1; d-- > 0;)
+            {
+                is[d] = row % lens[d];
+                row /= lens[d];
+                start += is[d] * strides[d];
+            }
+            for(std::size_t i = 0; i < row_len; i++)
+            {
+                is[N - 1] = i;
+                miopen::unpack([&](auto... js) { f(data[start + i * row_stride], js...); }, is);
+            }
+        });
+    }
+};
+
 template <class T>
 struct miopen_type;
 
@@ -189,8 +264,31 @@ struct tensor
         return std::move(*this);
     }
 
+    /// Same as generate for the generators that are a function of the indices only, such as
+    /// tensor_elem_gen_integer. The elements are computed in parallel and stored at their
+    /// indices, so the strides are respected.
     template <class G>
-    void generate_impl(G g)
+    tensor& par_generate(G g) &
+    {
+        if(this->desc.GetVectorLength() > 1)
+            this->generate_vect_impl(g);
+        else
+            this->par_generate_impl(g);
+        return *this;
+    }
+
+    template <class G>
+    tensor&& par_generate(G g) &&
+    {
+        if(this->desc.GetVectorLength() > 1)
+            this->generate_vect_impl(g);
+        else
+            this->par_generate_impl(g);
+        return std::move(*this);
+    }
+
+    // The rand() sequence after generating does not depend on the way it was done.
+    void seed_rand() const
     {
         auto seed = std::accumulate(desc.GetLengths().begin(),
                                     desc.GetLengths().end(),
@@ -202,6 +300,22 @@ struct tensor
         seed ^= data.size();
         seed ^= desc.GetLengths().size();
         std::srand(seed);
+    }
+
+    template <class G>
+    void par_generate_impl(G g)
+    {
+        this->seed_rand();
+        visit_tensor_size(desc.GetLengths().size(), [&](auto size) {
+            this->template view<decltype(size)::value>().par_for_each(
+                [&](T& x, auto... is) { x = miopen::cast_to<T>()(g(is...)); });
+        });
+    }
+
+    template <class G>
+    void generate_impl(G g)
+    {
+        this->seed_rand();
         auto iterator = data.begin();
         auto assign   = [&](T x) {
             *iterator = x;
@@ -214,16 +328,7 @@ struct tensor
     template <class G>
     void generate_vect_impl(G g)
     {
-        auto seed = std::accumulate(desc.GetLengths().begin(),
-                                    desc.GetLengths().end(),
-                                    std::size_t{521288629},
-                                    [](auto x, auto y) {
-                                        x ^= x << 1U;
-                                        return x ^ y;
-                                    });
-        seed ^= data.size();
-        seed ^= desc.GetLengths().size();
-        std::srand(seed);
+        this->seed_rand();
         auto iterator     = data.begin();
         auto vectorLength = desc.GetVectorLength();
         auto assign       = [&](T x) {
@@ -301,24 +406,75 @@ struct tensor
             std::bind(for_each_handler{}, this, par_ford, std::move(f), std::placeholders::_1));
     }
 
+    /// The view of a tensor that is not vectorized, with rank N.
+    template <std::size_t N>
+    tensor_view<T, N> view()
+    {
+        return this->make_view<T, N>(data.data());
+    }
+
+    template <std::size_t N>
+    tensor_view<const T, N> view() const
+    {
+        return this->make_view<const T, N>(data.data());
+    }
+
+    template <class U, std::size_t N>
+    tensor_view<U, N> make_view(U* p) const
+    {
+        assert(desc.GetVectorLength() == 1 && desc.GetLengths().size() == N);
+        tensor_view<U, N> v;
+        v.data = p;
+        std::copy_n(desc.GetLengths().begin(), N, v.lens.begin());
+        std::copy_n(desc.GetStrides().begin(), N, v.strides.begin());
+        return v;
+    }
+
+    /// Packed, with the strides decreasing with the dimension like the ones of NCHW.
+    bool is_row_major() const
+    {
+        if(desc.GetVectorLength() > 1)
+            return false;
+        std::size_t stride = 1;
+        for(auto d = desc.GetLengths().size(); d-- > 0;)
+        {
+            if(desc.GetLengths()[d] != 1 && desc.GetStrides()[d] != stride)
+                return false;
+            stride *= desc.GetLengths()[d];
+        }
+        return true;
+    }
+
+    // The strides of the tensors that are not vectorized are used directly, the layout logic of
+    // GetIndex is only needed for the vectorized ones.
+    template <class... Ts>
+    std::size_t index(Ts... xs) const
+    {
+        if(desc.GetVectorLength() > 1)
+            return desc.GetIndex(xs...);
+        const std::array<std::size_t, sizeof...(Ts)> is = {{static_cast<std::size_t>(xs)...}};
+        assert(is.size() <= desc.GetStrides().size());
+        return std::inner_product(is.begin(), is.end(), desc.GetStrides().begin(), std::size_t{0});
+    }
+
     template <class... Ts>
     T& operator()(Ts... xs)
     {
-        assert(this->desc.GetIndex(xs...) < data.size());
-        return this->data[this->desc.GetIndex(xs...)];
+        assert(this->index(xs...) < data.size());
+        return this->data[this->index(xs...)];
     }
 
     template <class... Ts>
     const T& operator()(Ts... xs) const
     {
-        assert(this->desc.GetIndex(xs...) < data.size());
-        return this->data[this->desc.GetIndex(xs...)];
+        assert(this->index(xs...) < data.size());
+        return this->data[this->index(xs...)];
     }
 
     template <class Integer, Integer N>
     const T& operator()(const std::array<Integer, N>& multi_id) const
     {
-        auto f = [&](auto... is) { return this->desc.GetIndex(is...); };
+        auto f = [&](auto... is) { return this->index(is...); };
         assert(miopen::unpack(f, multi_id) < data.size());
         return this->data[miopen::unpack(f, multi_id)];
     }
@@ -417,11 +573,26 @@ tensor<T> make_tensor(const std::vector<X>& dims, G g)
     return make_tensor<T>(dims).generate(g);
 }
 
+// The generators that are a function of the indices only declare an index_generator type.
+template <class G, class = void>
+struct is_index_generator : std::false_type
+{
+};
+
+template <class G>
+struct is_index_generator<G, typename G::index_generator> : std::true_type
+{
+};
+
 struct tensor_generate
 {
+    // generate writes the elements in memory order whatever the strides are, so par_generate
+    // gives the same data for the row major tensors only.
     template <class Tensor, class G>
     Tensor&& operator()(Tensor&& t, G g) const
     {
+        if(is_index_generator<G>{} && t.is_row_major())
+            return std::forward<Tensor>(t.par_generate(g));
         return std::forward<Tensor>(t.generate(g));
     }
 };
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db.hpp>
+#include <miopen/find_controls.hpp>
+#include <miopen/temp_file.hpp>
+#include <miopen/tuning_checkpoint.hpp>
+#include "test.hpp"
+
+#include <ostream>
+#include <string>
+
+using miopen::solver::TuningCheckpoint;
+
+struct ProblemKey
+{
+    void Serialize(std::ostream& stream) const { stream << "1-2-3"; }
+};
+
+bool operator==(const TuningCheckpoint& l, const TuningCheckpoint& r)
+{
+    return l.next == r.next && l.total == r.total && l.n_failed == r.n_failed &&
+           l.n_best == r.n_best && l.best_time == r.best_time && l.best_config == r.best_config;
+}
+
+TuningCheckpoint RoundTrip(const TuningCheckpoint& checkpoint)
+{
+    std::ostringstream stream;
+    checkpoint.Serialize(stream);
+    TuningCheckpoint out;
+    EXPECT(out.Deserialize(stream.str()));
+    return out;
+}
+
+void test_serialization()
+{
+    TuningCheckpoint checkpoint;
+    checkpoint.next     = 120;
+    checkpoint.total    = 4000;
+    checkpoint.n_failed = 3;
+    EXPECT(RoundTrip(checkpoint) == checkpoint);
+
+    checkpoint.n_best      = 77;
+    checkpoint.best_time   = 0.25f;
+    checkpoint.best_config = "16,8,4,1,0";
+    EXPECT(RoundTrip(checkpoint) == checkpoint);
+
+    TuningCheckpoint out;
+    EXPECT(!out.Deserialize(""));
+    EXPECT(!out.Deserialize("1,2,3"));
+    EXPECT(!out.Deserialize("1,2,3,4;0.5"));
+    EXPECT(!out.Deserialize("1,2,3,4,0.5,"));
+    EXPECT(!out.Deserialize("1,2,3,4,0.5 16,8"));
+    EXPECT(out == TuningCheckpoint{});
+}
+
+void test_perf_db()
+{
+    const miopen::TempFile file{"miopen-test-tuning-checkpoint"};
+    const auto id = TuningCheckpoint::GetDbId("ConvAsm1x1U");
+
+    TuningCheckpoint checkpoint;
+    checkpoint.next        = 10;
+    checkpoint.total       = 20;
+    checkpoint.n_best      = 5;
+    checkpoint.best_time   = 1.5f;
+    checkpoint.best_config = "1,2,3";
+
+    {
+        miopen::PlainTextDb db{file.Path()};
+        EXPECT(db.Update(ProblemKey{}, "ConvAsm1x1U", TuningCheckpoint{}));
+        EXPECT(db.Update(ProblemKey{}, id, checkpoint));
+    }
+
+    miopen::PlainTextDb db{file.Path()};
+    TuningCheckpoint loaded;
+    EXPECT(db.Load(ProblemKey{}, id, loaded));
+    EXPECT(loaded == checkpoint);
+
+    EXPECT(db.Remove(ProblemKey{}, id));
+    EXPECT(!db.Load(ProblemKey{}, id, loaded));
+    EXPECT(db.Load(ProblemKey{}, "ConvAsm1x1U", loaded));
+}
+
+void test_budget()
+{
+    miopen::TuningBudget budget;
+    budget.SetSeconds(0.0f);
+    budget.SetEvaluations(0);
+    EXPECT(!budget.IsLimited());
+    EXPECT(!budget.IsExhausted(1.0e6f, 1000000));
+
+    budget.SetEvaluations(10);
+    EXPECT(budget.IsLimited());
+    EXPECT(!budget.IsExhausted(1.0e6f, 9));
+    EXPECT(budget.IsExhausted(0.0f, 10));
+
+    budget.SetEvaluations(0);
+    budget.SetSeconds(2.5f);
+    EXPECT(!budget.IsExhausted(2.0f, 1000000));
+    EXPECT(budget.IsExhausted(2.5f, 0));
+}
+
+int main()
+{
+    test_serialization();
+    test_perf_db();
+    test_budget();
+}
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/db_merge.hpp>
+#include <miopen/find_solution.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/simulated_device.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/tuning_checkpoint.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+
+#include "get_handle.hpp"
+#include "simulated_solver.hpp"
+#include "test.hpp"
+
+namespace miopen {
+namespace tests {
+
+/// Tunes the shard set by MIOPEN_TUNING_SHARD into the user perf-db.
+void RunShard()
+{
+    EXPECT(SimulatedDevice::IsEnabled());
+
+    auto context      = GetSimulatedTestContext(get_handle());
+    context.do_search = true;
+    context.db_update = true;
+    auto db           = GetDb(context);
+
+    const auto solution = solver::FindSolution(SimulatedTestSolver{}, context, db, InvokeParams{});
+    EXPECT(solution.Succeeded());
+}
+
+std::string GetPath(const TmpDir& dir, const ConvolutionContext& context)
+{
+    const auto filename = boost::filesystem::path{context.GetUserPerfDbPath()}.filename();
+    return (dir.path / filename).string();
+}
+
+/// Tunes the shards in processes of their own, each with a user perf-db in its own directory, and
+/// checks that the merged perf-db holds the config of the shard with the lowest best time.
+void TestShards(const std::string& exe_path)
+{
+    constexpr std::size_t n_shards = 2;
+
+    SimulatedDevice::SetCostModels(
+        {std::make_shared<AnalyticCostModel>(SimulatedDevice::GetComputeUnits())});
+    const auto context   = GetSimulatedTestContext(get_handle());
+    const auto solver_id = SimulatedTestSolver{}.SolverDbId();
+
+    std::vector<TmpDir> dirs;
+    std::vector<FILE*> children;
+    for(std::size_t shard = 0; shard < n_shards; ++shard)
+    {
+        dirs.emplace_back("tuning-shard");
+        const auto command = "MIOPEN_DEBUG_SIMULATED_DEVICE=ANALYTIC MIOPEN_TUNING_SHARD=" +
+                             std::to_string(shard) + "/" + std::to_string(n_shards) +
+                             " MIOPEN_USER_DB_PATH=" + dirs.back().path.string() + " " +
+                             exe_path + " --shard";
+        children.push_back(popen(command.c_str(), "w"));
+        EXPECT(children.back() != nullptr);
+    }
+    for(auto* const child : children)
+    {
+        // A child killed by a signal, e.g. by abort() of a failed check, has no exit status.
+        const auto status = pclose(child);
+        EXPECT(status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    const solver::ComputedContainer<SimulatedTestConfig, ConvolutionContext> all_configs{context};
+    const auto n_configs = std::distance(all_configs.begin(), all_configs.end());
+
+    auto n_tuned     = std::size_t{0};
+    auto best_time   = std::numeric_limits<float>::max();
+    auto best_config = SimulatedTestConfig{};
+    auto merger      = DbMerger{DbKind::Perf};
+    for(std::size_t shard = 0; shard < n_shards; ++shard)
+    {
+        const auto path = GetPath(dirs[shard], context);
+        PerformanceDb db{context.GetPerfDbPath(), path};
+
+        const auto checkpoint_id = solver::TuningCheckpoint::GetDbId(solver_id, shard, n_shards);
+        solver::TuningCheckpoint checkpoint;
+        EXPECT(db.Load(context.problem, checkpoint_id, checkpoint));
+        EXPECT(checkpoint.IsComplete());
+        n_tuned += checkpoint.total;
+
+        SimulatedTestConfig config;
+        EXPECT(db.Load(context.problem, solver_id, config));
+        EXPECT_EQUAL(config.ToString(), checkpoint.best_config);
+        if(checkpoint.best_time < best_time)
+        {
+            best_time   = checkpoint.best_time;
+            best_config = config;
+        }
+
+        merger.Add(path);
+    }
+    EXPECT_EQUAL(n_tuned, static_cast<std::size_t>(n_configs));
+
+    const TmpDir merged_dir{"tuning-shard"};
+    const auto merged_path = GetPath(merged_dir, context);
+    merger.Write(merged_path);
+
+    PerformanceDb merged{context.GetPerfDbPath(), merged_path};
+    SimulatedTestConfig config;
+    EXPECT(merged.Load(context.problem, solver_id, config));
+    EXPECT(config == best_config);
+}
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    if(argc > 1 && std::string{argv[1]} == "--shard")
+    {
+        miopen::tests::RunShard();
+        return 0;
+    }
+
+#if MIOPEN_MODE_NOGPU && !MIOPEN_DISABLE_USERDB
+    miopen::tests::TestShards(argv[0]);
+#else
+    std::cout << "The tuning shards are simulated by the HIPNOGPU backend only, skipped"
+              << std::endl;
+#endif
+}
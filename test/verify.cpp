@@ -0,0 +1,188 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/bfloat16.hpp>
+#include <half.hpp>
+#include "test.hpp"
+#include "verify.hpp"
+#include "random.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+// range_errors against the element by element reductions it replaces.
+
+template <class T>
+std::vector<T> make_range(std::size_t size)
+{
+    std::vector<T> data(size);
+    for(auto& x : data)
+        x = T(static_cast<float>(GET_RAND() % 1000) / 8.f - 60.f);
+    return data;
+}
+
+template <class T>
+void check_errors(const std::vector<double>& ref, const std::vector<T>& out)
+{
+    const auto errors = miopen::range_errors(ref, out);
+    EXPECT_EQUAL(errors.size, ref.size());
+
+    double square_diff = 0;
+    double magnitude   = 0;
+    double max_abs     = 0;
+    double max_rel     = 0;
+    double max_mixed   = 0;
+    std::size_t nans   = 0;
+    std::size_t infs   = 0;
+    std::array<std::size_t, miopen::error_stats::histogram_size> histogram{};
+    for(std::size_t i = 0; i < ref.size(); i++)
+    {
+        const auto x = ref[i];
+        const auto y = static_cast<double>(out[i]);
+        square_diff += (x - y) * (x - y);
+        nans += std::isnan(y) ? 1 : 0;
+        infs += std::isinf(y) ? 1 : 0;
+        for(auto v : {x, y})
+        {
+            if(!std::isnan(v))
+                magnitude = std::max(magnitude, std::fabs(v));
+        }
+        if(std::isnan(x) || std::isnan(y))
+            continue;
+        max_abs   = std::max(max_abs, std::fabs(x - y));
+        const auto rel =
+            std::fabs(x - y) / std::max(std::fabs(x), std::numeric_limits<double>::min());
+        if(!std::isnan(rel))
+        {
+            max_rel   = std::max(max_rel, rel);
+            max_mixed = std::max(max_mixed, std::min(std::fabs(x - y), rel));
+        }
+        if(x == y)
+            histogram[0]++;
+        else if(!(rel >= 1e-7))
+            histogram[1]++;
+        else if(!(rel < 1.))
+            histogram.back()++;
+        else
+            histogram[static_cast<std::size_t>(std::floor(std::log10(rel))) + 9]++;
+    }
+
+    EXPECT(errors.square_diff == square_diff ||
+           std::fabs(errors.square_diff - square_diff) <= 1e-12 * square_diff ||
+           (std::isnan(errors.square_diff) && std::isnan(square_diff)));
+    EXPECT_EQUAL(errors.max_magnitude, magnitude);
+    EXPECT_EQUAL(errors.max_abs_diff, max_abs);
+    EXPECT_EQUAL(errors.max_rel_diff, max_rel);
+    EXPECT_EQUAL(errors.max_mixed_diff, max_mixed);
+    EXPECT_EQUAL(errors.nans, nans);
+    EXPECT_EQUAL(errors.infs, infs);
+    EXPECT(errors.histogram == histogram);
+    EXPECT_EQUAL(errors.mismatch, miopen::mismatch_idx(ref, out, miopen::float_equal));
+    EXPECT_EQUAL(errors.ref_not_finite, miopen::find_idx(ref, miopen::not_finite));
+    EXPECT_EQUAL(errors.not_finite, miopen::find_idx(out, miopen::not_finite));
+    EXPECT_EQUAL(errors.ref_zero(), miopen::range_zero(ref));
+    EXPECT_EQUAL(errors.zero(), miopen::range_zero(out));
+}
+
+template <class T>
+void test_errors(std::size_t size)
+{
+    const auto out = make_range<T>(size);
+    std::vector<double> ref(out.begin(), out.end());
+    check_errors(ref, out);
+
+    // Differences of all the magnitudes, the first one in a later block.
+    for(std::size_t i = size / 3; i < size; i += 7)
+        ref[i] *= 1. + std::pow(10., -static_cast<double>(i % 11));
+    check_errors(ref, out);
+
+    auto with_not_finite = out;
+    if(size > 100 && !std::is_integral<T>{})
+    {
+        with_not_finite[size - 5]  = T(std::numeric_limits<float>::infinity());
+        with_not_finite[size / 2]  = T(std::numeric_limits<float>::quiet_NaN());
+        with_not_finite[size - 20] = T(-std::numeric_limits<float>::infinity());
+        ref[size - 50]             = std::numeric_limits<double>::quiet_NaN();
+    }
+    check_errors(ref, with_not_finite);
+}
+
+void test_rms()
+{
+    const auto out = make_range<float>(10000);
+    auto ref       = std::vector<double>(out.begin(), out.end());
+    EXPECT_EQUAL(miopen::rms_range(ref, out), 0.0);
+    ref[1234] += 1.;
+    ref[9999] -= 2.;
+    const auto magnitude = std::fabs(*std::max_element(
+        ref.begin(), ref.end(), [](double x, double y) { return std::fabs(x) < std::fabs(y); }));
+    const auto expected  = std::sqrt(5.) / (std::sqrt(10000.) * magnitude);
+    EXPECT(std::fabs(miopen::rms_range(ref, out) - expected) <= 1e-15);
+    EXPECT_EQUAL(miopen::max_diff(ref, out), 2.0);
+    EXPECT_EQUAL(miopen::rms_range(ref, std::vector<float>(3)), std::numeric_limits<double>::max());
+
+    const std::vector<float> zeros(100);
+    EXPECT_EQUAL(miopen::rms_range(zeros, zeros), 0.0);
+    EXPECT(miopen::range_errors(zeros, zeros).zero());
+}
+
+void test_tolerance()
+{
+    const auto out = make_range<float>(10000);
+    auto ref       = std::vector<double>(out.begin(), out.end());
+    EXPECT_EQUAL(miopen::mismatch_tolerance(ref, out, 1e-6), ref.size());
+
+    // Within the tolerance relative to a large value, and absolute near zero.
+    ref[100] = 1e6;
+    ref[200] = 1e-9;
+    auto near = out;
+    near[100] = static_cast<float>(1e6 + 0.5);
+    near[200] = 2e-9f;
+    EXPECT(miopen::range_errors(ref, near).max_mixed_diff <= 1e-6);
+    EXPECT_EQUAL(miopen::mismatch_tolerance(ref, near, 1e-6), ref.size());
+
+    near[5000] += 1.f;
+    near[7000] += 1.f;
+    EXPECT_EQUAL(miopen::mismatch_tolerance(ref, near, 1e-6), std::size_t{5000});
+    near[3000] = std::numeric_limits<float>::infinity();
+    EXPECT_EQUAL(miopen::mismatch_tolerance(ref, near, 1e-6), std::size_t{3000});
+}
+
+int main()
+{
+    for(auto size : {1, 7, 2048, 2049, 10000})
+    {
+        test_errors<float>(size);
+        test_errors<half_float::half>(size);
+        test_errors<bfloat16>(size);
+        test_errors<int8_t>(size);
+    }
+    test_rms();
+    test_tolerance();
+}
@@ -27,12 +27,18 @@
 #define GUARD_VERIFY_HPP
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <miopen/float_equal.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/returns.hpp>
 #include <numeric>
+#include <vector>
 
 namespace miopen {
 
@@ -148,12 +154,6 @@ long find_idx(R1&& r1, Predicate p)
         return std::distance(r1.begin(), it);
 }
 
-template <class R1, class R2>
-double max_diff(R1&& r1, R2&& r2)
-{
-    return range_product(r1, r2, 0.0, max, abs_diff);
-}
-
 template <class R1, class R2, class T>
 std::size_t mismatch_diff(R1&& r1, R2&& r2, T diff)
 {
@@ -164,19 +164,299 @@ std::size_t mismatch_diff(R1&& r1, R2&& r2, T diff)
             float_equal, diff, std::bind(abs_diff, std::placeholders::_1, std::placeholders::_2)));
 }
 
+/// The errors of a range against a reference one, see range_errors.
+struct error_stats
+{
+    // histogram[0] counts the elements equal to the reference, histogram[1] the ones with a
+    // relative error below 1e-7, histogram[i] the ones from 10^(i-9) to 10^(i-8) and the last
+    // one the relative errors of 1 and more. The NaNs are not in it.
+    static constexpr std::size_t histogram_size = 10;
+
+    std::size_t size         = 0;
+    double square_diff       = 0;
+    double ref_max_magnitude = 0;
+    double max_magnitude     = 0;
+    double max_abs_diff      = 0;
+    double max_rel_diff      = 0;
+    // The largest of the smaller of the absolute and relative differences of each element. All of
+    // them are within a tolerance in absolute or relative terms when it is not greater.
+    double max_mixed_diff = 0;
+    // Indices of the first element that is not float_equal and of the first non finite ones, the
+    // size or -1 if there are none, like the ones of mismatch_idx and find_idx.
+    std::size_t mismatch = 0;
+    long ref_not_finite  = -1;
+    long not_finite      = -1;
+    std::size_t ref_nans = 0;
+    std::size_t ref_infs = 0;
+    std::size_t nans     = 0;
+    std::size_t infs     = 0;
+    std::array<std::size_t, histogram_size> histogram{};
+
+    /// Same as rms_range: the root mean square of the differences relative to the largest
+    /// magnitude of both ranges.
+    double rms() const
+    {
+        return std::sqrt(square_diff) /
+               (std::sqrt(size) * std::max(max_magnitude, std::numeric_limits<double>::min()));
+    }
+
+    bool ref_zero() const { return ref_max_magnitude == 0 && ref_nans == 0; }
+    bool zero() const { return max_magnitude == 0 && nans == 0; }
+
+    /// Appends the stats of the elements that follow these ones.
+    void merge(const error_stats& next)
+    {
+        if(mismatch == size)
+            mismatch = size + next.mismatch;
+        if(ref_not_finite < 0 && next.ref_not_finite >= 0)
+            ref_not_finite = size + next.ref_not_finite;
+        if(not_finite < 0 && next.not_finite >= 0)
+            not_finite = size + next.not_finite;
+        size += next.size;
+        square_diff += next.square_diff;
+        ref_max_magnitude = std::max(ref_max_magnitude, next.ref_max_magnitude);
+        max_magnitude     = std::max(max_magnitude, next.max_magnitude);
+        max_abs_diff      = std::max(max_abs_diff, next.max_abs_diff);
+        max_rel_diff      = std::max(max_rel_diff, next.max_rel_diff);
+        max_mixed_diff    = std::max(max_mixed_diff, next.max_mixed_diff);
+        ref_nans += next.ref_nans;
+        ref_infs += next.ref_infs;
+        nans += next.nans;
+        infs += next.infs;
+        for(std::size_t i = 0; i < histogram.size(); i++)
+            histogram[i] += next.histogram[i];
+    }
+};
+
+namespace range_errors_detail {
+
+// The elements are converted to double a block at a time, then the stats are reduced in lanes,
+// which the compilers keep in vector registers.
+constexpr std::size_t block = 1024;
+constexpr std::size_t lanes = 8;
+
+// The histogram bin of a relative error from its binary exponent: each power of 2 range has at
+// most one of the bounds of the bins in it, to compare with.
+struct histogram_table
+{
+    std::array<std::uint8_t, 2048> bin;
+    std::array<double, 2048> bound;
+
+    static const histogram_table& get()
+    {
+        static const histogram_table table{};
+        return table;
+    }
+
+    histogram_table()
+    {
+        const double bounds[] = {1e-7, 1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1.};
+        const auto last       = static_cast<int>(error_stats::histogram_size) - 1;
+        const auto clamp_bin  = [&](int b) { return std::min(std::max(b, 1), last); };
+        for(int e = 0; e < 2048; e++)
+        {
+            // Nothing compares greater or equal to it, not even the infinite errors.
+            bound[e] = std::numeric_limits<double>::quiet_NaN();
+            // Zero, the errors that are not exact are not that small. Or infinity and the NaNs.
+            if(e == 0 || e == 2047)
+            {
+                bin[e] = static_cast<std::uint8_t>(e == 0 ? 0 : last);
+                continue;
+            }
+            const auto decade = static_cast<int>(std::floor((e - 1023) * std::log10(2.)));
+            bin[e]            = static_cast<std::uint8_t>(clamp_bin(decade + 9));
+            if(clamp_bin(decade + 10) != bin[e])
+                bound[e] = bounds[decade + 8];
+        }
+    }
+};
+
+template <class I1, class I2>
+error_stats block_errors(I1 ref, I2 out, std::size_t n)
+{
+    std::array<double, block> x;
+    std::array<double, block> y;
+    std::array<double, block> rel;
+    const auto padded = (n + lanes - 1) / lanes * lanes;
+    for(std::size_t i = 0; i < n; i++)
+    {
+        x[i] = static_cast<double>(ref[i]);
+        y[i] = static_cast<double>(out[i]);
+    }
+    std::fill(x.begin() + n, x.begin() + padded, 0.);
+    std::fill(y.begin() + n, y.begin() + padded, 0.);
+
+    constexpr auto inf  = std::numeric_limits<double>::infinity();
+    constexpr auto tiny = std::numeric_limits<double>::min();
+    // The counts are doubles too, so that the whole loop runs on the same vectors.
+    double square_diff[lanes]       = {};
+    double ref_max_magnitude[lanes] = {};
+    double max_magnitude[lanes]     = {};
+    double max_abs_diff[lanes]      = {};
+    double max_rel_diff[lanes]      = {};
+    double max_mixed_diff[lanes]    = {};
+    double ref_nans[lanes]          = {};
+    double ref_infs[lanes]          = {};
+    double nans[lanes]              = {};
+    double infs[lanes]              = {};
+    double with_nan[lanes]          = {};
+    for(std::size_t i = 0; i < padded; i += lanes)
+    {
+        for(std::size_t l = 0; l < lanes; l++)
+        {
+            const auto a        = x[i + l];
+            const auto b        = y[i + l];
+            const auto abs_a    = std::fabs(a);
+            const auto abs_b    = std::fabs(b);
+            const auto abs_diff = std::fabs(a - b);
+            // Infinite against finite gives NaN or infinity, both go to the last bin. So do the
+            // equal infinities here, the histogram puts them in the first one.
+            const auto r     = abs_diff / (abs_a < tiny ? tiny : abs_a);
+            const auto mixed = abs_diff < r ? abs_diff : r;
+            rel[i + l]       = r;
+            // The comparisons are false for the NaNs, so these ignore them.
+            square_diff[l] += (a - b) * (a - b);
+            ref_max_magnitude[l] = ref_max_magnitude[l] < abs_a ? abs_a : ref_max_magnitude[l];
+            max_magnitude[l]     = max_magnitude[l] < abs_a ? abs_a : max_magnitude[l];
+            max_magnitude[l]     = max_magnitude[l] < abs_b ? abs_b : max_magnitude[l];
+            max_abs_diff[l]      = max_abs_diff[l] < abs_diff ? abs_diff : max_abs_diff[l];
+            max_rel_diff[l]      = max_rel_diff[l] < r ? r : max_rel_diff[l];
+            max_mixed_diff[l]    = max_mixed_diff[l] < mixed ? mixed : max_mixed_diff[l];
+            ref_nans[l] += a != a ? 1. : 0.; // NOLINT
+            nans[l] += b != b ? 1. : 0.;     // NOLINT
+            ref_infs[l] += abs_a == inf ? 1. : 0.;
+            infs[l] += abs_b == inf ? 1. : 0.;
+            with_nan[l] += (a != a) | (b != b) ? 1. : 0.; // NOLINT
+        }
+    }
+
+    error_stats stats;
+    stats.size       = n;
+    stats.mismatch   = n;
+    double counts[5] = {};
+    for(std::size_t l = 0; l < lanes; l++)
+    {
+        stats.square_diff += square_diff[l];
+        stats.ref_max_magnitude = std::max(stats.ref_max_magnitude, ref_max_magnitude[l]);
+        stats.max_magnitude     = std::max(stats.max_magnitude, max_magnitude[l]);
+        stats.max_abs_diff      = std::max(stats.max_abs_diff, max_abs_diff[l]);
+        stats.max_rel_diff      = std::max(stats.max_rel_diff, max_rel_diff[l]);
+        stats.max_mixed_diff    = std::max(stats.max_mixed_diff, max_mixed_diff[l]);
+        counts[0] += ref_nans[l];
+        counts[1] += ref_infs[l];
+        counts[2] += nans[l];
+        counts[3] += infs[l];
+        counts[4] += with_nan[l];
+    }
+    stats.ref_nans = static_cast<std::size_t>(counts[0]);
+    stats.ref_infs = static_cast<std::size_t>(counts[1]);
+    stats.nans     = static_cast<std::size_t>(counts[2]);
+    stats.infs     = static_cast<std::size_t>(counts[3]);
+
+    // Several histograms, so that the increments of the same bin do not wait for each other.
+    const auto& table = histogram_table::get();
+    std::size_t histograms[4][error_stats::histogram_size] = {};
+    for(std::size_t i = 0; i < n; i++)
+    {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &rel[i], sizeof(bits));
+        const auto e = x[i] == y[i] ? 0 : (bits >> 52U) & 0x7ffU;
+        histograms[i % 4][table.bin[e] + (rel[i] >= table.bound[e] ? 1 : 0)]++;
+    }
+    for(std::size_t b = 0; b < stats.histogram.size(); b++)
+        stats.histogram[b] = histograms[0][b] + histograms[1][b] + histograms[2][b] +
+                             histograms[3][b];
+    // The NaNs are in the last bin.
+    stats.histogram.back() -= static_cast<std::size_t>(counts[4]);
+
+    // float_equal is only evaluated where the doubles differ or are not finite, it holds for the
+    // other ones.
+    if(stats.histogram[0] < n || stats.ref_infs > 0 || stats.infs > 0)
+    {
+        for(std::size_t i = 0; i < n; i++)
+        {
+            if((x[i] != y[i] || !std::isfinite(x[i])) && !float_equal(ref[i], out[i]))
+            {
+                stats.mismatch = i;
+                break;
+            }
+        }
+    }
+    if(stats.ref_nans + stats.ref_infs > 0)
+        stats.ref_not_finite = std::find_if_not(x.begin(), x.begin() + n, [](double v) {
+                                   return std::isfinite(v);
+                               }) -
+                               x.begin();
+    if(stats.nans + stats.infs > 0)
+        stats.not_finite = std::find_if_not(y.begin(), y.begin() + n, [](double v) {
+                               return std::isfinite(v);
+                           }) -
+                           y.begin();
+    return stats;
+}
+
+} // namespace range_errors_detail
+
+/// Computes all the error_stats of the range r2 against the reference range r1 in one pass over
+/// them, in parallel blocks. The ranges need random access iterators and the same size.
+template <class R1, class R2>
+error_stats range_errors(R1&& r1, R2&& r2)
+{
+    const std::size_t n    = range_distance(r1);
+    const auto block       = range_errors_detail::block;
+    const auto block_count = (n + block - 1) / block;
+    std::vector<error_stats> blocks(block_count);
+    auto first1 = r1.begin();
+    auto first2 = r2.begin();
+    par_for(block_count, 1, [&](std::size_t i) {
+        const auto start = i * block;
+        blocks[i]        = range_errors_detail::block_errors(
+            first1 + start, first2 + start, std::min(block, n - start));
+    });
+    error_stats stats;
+    for(const auto& b : blocks)
+        stats.merge(b);
+    return stats;
+}
+
+/// Index of the first element of r2 that differs from the reference r1 by more than the
+/// tolerance both in absolute and relative terms, or that is not finite, the size if there is
+/// none. The elements are only searched when range_errors finds that there is such an element.
+template <class R1, class R2>
+std::size_t mismatch_tolerance(R1&& r1, R2&& r2, double tolerance)
+{
+    const std::size_t n = range_distance(r1);
+    const auto errors   = range_errors(r1, r2);
+    if(errors.max_mixed_diff <= tolerance &&
+       errors.ref_nans + errors.ref_infs + errors.nans + errors.infs == 0)
+        return n;
+
+    auto first1 = r1.begin();
+    auto first2 = r2.begin();
+    for(std::size_t i = 0; i < n; i++)
+    {
+        const auto a        = static_cast<double>(first1[i]);
+        const auto b        = static_cast<double>(first2[i]);
+        const auto abs_diff = std::fabs(a - b);
+        const auto rel_diff = abs_diff / std::max(std::fabs(a), std::numeric_limits<double>::min());
+        if(!std::isfinite(a) || !std::isfinite(b) || (abs_diff > tolerance && rel_diff > tolerance))
+            return i;
+    }
+    return n;
+}
+
+template <class R1, class R2>
+double max_diff(R1&& r1, R2&& r2)
+{
+    return range_errors(r1, r2).max_abs_diff;
+}
+
 template <class R1, class R2>
 double rms_range(R1&& r1, R2&& r2)
 {
     std::size_t n = range_distance(r1);
     if(n == range_distance(r2))
-    {
-        double square_difference = range_product(r1, r2, 0.0, sum_fn{}, square_diff);
-        double mag1              = *std::max_element(r1.begin(), r1.end(), compare_mag);
-        double mag2              = *std::max_element(r2.begin(), r2.end(), compare_mag);
-        double mag =
-            std::max({std::fabs(mag1), std::fabs(mag2), std::numeric_limits<double>::min()});
-        return std::sqrt(square_difference) / (std::sqrt(n) * mag);
-    }
+        return range_errors(r1, r2).rms();
     else
         return std::numeric_limits<range_value<R1>>::max();
 }
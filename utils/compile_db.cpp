@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Offline converter of readonly text dbs (system find-db and text perf-db) into the compiled
+// form which ReadonlyRamDb maps into memory instead of parsing, see compiled_db.hpp.
+//
+// Usage: MIOpenCompileDb <db.txt> [<db.txt>...]
+// Each "<name>.txt" is compiled into "<name>.bin" next to it.
+
+#include <miopen/compiled_db.hpp>
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <db.txt> [<db.txt>...]" << std::endl;
+        return 1;
+    }
+
+    auto failed = 0;
+
+    for(auto i = 1; i < argc; ++i)
+    {
+        const std::string source = argv[i];
+        const auto destination   = miopen::CompiledDb::GetPath(source);
+        const auto start         = std::chrono::steady_clock::now();
+
+        try
+        {
+            if(!miopen::CompiledDb::Compile(source, destination))
+            {
+                std::cerr << "Failed to compile " << source << std::endl;
+                ++failed;
+                continue;
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << "Failed to compile " << source << ": " << ex.what() << std::endl;
+            ++failed;
+            continue;
+        }
+
+        const auto time = std::chrono::duration<float, std::milli>{
+            std::chrono::steady_clock::now() - start}.count();
+        std::cout << source << " -> " << destination << " (" << time << " ms)" << std::endl;
+    }
+
+    return failed == 0 ? 0 : 1;
+}
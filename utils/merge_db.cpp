@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Combines the user dbs of the processes which have tuned the shards of the same search spaces
+// (see MIOPEN_TUNING_SHARD), or any other dbs of the same kind, keeping the fastest values.
+//
+// Usage: MIOpenMergeDb <output> <input> [<input>...]
+// The inputs are either all find-dbs (*.fdb.txt, *.ufdb.txt) or all perf-dbs, text or SQLite.
+// The output is replaced and may be one of the inputs.
+
+#include <miopen/db_merge.hpp>
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    if(argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <output> <input> [<input>...]" << std::endl;
+        return 1;
+    }
+
+    const std::string destination = argv[1];
+    const auto kind               = miopen::DbMerger::GetKind(argv[2]);
+    const auto start              = std::chrono::steady_clock::now();
+    miopen::DbMerger merger{kind};
+
+    try
+    {
+        for(auto i = 2; i < argc; ++i)
+        {
+            if(miopen::DbMerger::GetKind(argv[i]) != kind)
+            {
+                std::cerr << "Cannot merge find-dbs and perf-dbs: " << argv[i] << std::endl;
+                return 1;
+            }
+            merger.Add(argv[i]);
+        }
+        merger.Write(destination);
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << "Failed to merge into " << destination << ": " << ex.what() << std::endl;
+        return 1;
+    }
+
+    const auto time = std::chrono::duration<float, std::milli>{
+        std::chrono::steady_clock::now() - start}.count();
+    std::cout << destination << ": " << merger.GetRecordCount() << " records from " << argc - 2
+              << " dbs, " << merger.GetReplacedCount() << " values replaced by faster ones ("
+              << time << " ms)" << std::endl;
+    return 0;
+}
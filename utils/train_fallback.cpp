@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Trains the model the immediate mode fallback ranks the solvers with (see FallbackRanking) on
+// the records of the find-dbs of a device, and reports how well it ranks the solvers of the
+// records held out of the training.
+//
+// Usage: MIOpenTrainFallback [options] <output> <find-db> [<find-db>...]
+//   --holdout <percent>  Of the records held out for the report, 20 by default. The model is
+//                        trained on the rest.
+//   --trees <n>          Per solver, 64 by default.
+//   --depth <n>          Of the trees, 4 by default.
+// To be used by the library the output shall be installed next to the system find-db of the
+// device, e.g. gfx906_60.HIP.fdb.txt -> gfx906_60.HIP.fbr.txt.
+
+#include <miopen/fallback_ranking.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    auto options = miopen::FallbackTrainingOptions{};
+    auto holdout = 20;
+    auto i       = 1;
+    for(; i + 1 < argc && std::string{argv[i]}.compare(0, 2, "--") == 0; i += 2)
+    {
+        const std::string option = argv[i];
+        const auto value         = std::atoi(argv[i + 1]);
+        if(option == "--holdout" && value >= 0 && value < 100)
+            holdout = value;
+        else if(option == "--trees" && value > 0)
+            options.trees = value;
+        else if(option == "--depth" && value > 0)
+            options.depth = value;
+        else
+        {
+            std::cerr << "Invalid option: " << option << " " << argv[i + 1] << std::endl;
+            return 1;
+        }
+    }
+
+    if(argc - i < 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--holdout <percent>] [--trees <n>] [--depth <n>] <output> <find-db> "
+                     "[<find-db>...]"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::string destination = argv[i];
+    try
+    {
+        auto training = std::vector<miopen::FallbackRecord>{};
+        auto held_out = std::vector<miopen::FallbackRecord>{};
+        auto n_record = 0;
+        for(++i; i < argc; ++i)
+        {
+            for(auto& record : miopen::ReadFallbackRecords(argv[i]))
+            {
+                // Spreads the held out records evenly over the dbs.
+                auto& records = (n_record++ * holdout) % 100 < holdout ? held_out : training;
+                records.emplace_back(std::move(record));
+            }
+        }
+
+        const auto ranking = miopen::FallbackRanking::Train(training, options);
+        std::cout << "Trained the models of " << ranking.GetSolverCount() << " solvers on "
+                  << training.size() << " records" << std::endl;
+        std::cout << "Training: " << ranking.Evaluate(training) << std::endl;
+        if(!held_out.empty())
+            std::cout << "Held out: " << ranking.Evaluate(held_out) << std::endl;
+
+        std::ofstream file{destination};
+        ranking.Write(file);
+        if(!file)
+            throw std::runtime_error("Cannot write " + destination);
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << "Failed to train " << destination << ": " << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}